@@ -31,6 +31,16 @@ enum class AnimationFunc : uint8
 {
 	Linear, Pow, Gain, Count
 };
+/**
+ * @brief Baked animation property interpolation type.
+ */
+enum class AnimationInterp : uint8
+{
+	Lerp,  /**< Linear interpolation of the vector value. */
+	Slerp, /**< Spherical interpolation of the quaternion value. */
+	Step,  /**< Nearest keyframe value. (Discrete properties) */
+	Count  /**< Baked animation property interpolation type count. */
+};
 
 /**
  * @brief Base animation frame data container.
@@ -61,6 +71,8 @@ using Animatables = tsl::robin_map<System*, ID<AnimationFrame>>;
 class IAnimatable
 {
 public:
+	static constexpr uint8 maxBakedProps = 8; /**< Maximum baked animation frame property count. */
+
 	/**
 	 * @brief Creates a new system animation frame instance.
 	 */
@@ -107,17 +119,66 @@ public:
 	 * @param t time coefficient (from 0.0 to 1.0)
 	 */
 	virtual void animateAsync(View<Component> component, View<AnimationFrame> a, View<AnimationFrame> b, float t) = 0;
+
+	/**
+	 * @brief Returns system animation frame baked property count and their interpolation types.
+	 * @details Systems without baked properties are animated with the @ref animateAsync().
+	 * @param[out] interps property interpolation type array (maxBakedProps size)
+	 */
+	virtual uint8 getBakedProps(AnimationInterp* interps) { return 0; }
+	/**
+	 * @brief Writes system animation frame property values for the animation baking.
+	 * @return Bit mask of the properties animated by this frame.
+	 *
+	 * @param frame source animation frame data view
+	 * @param[out] values frame property value array (baked property count size)
+	 */
+	virtual uint32 bakeAnimation(View<AnimationFrame> frame, f32x4* values) { return 0; }
+	/**
+	 * @brief Asynchronously writes interpolated baked property values to the component. (From multiple threads)
+	 *
+	 * @param component target system component view
+	 * @param[in] values interpolated property value array
+	 * @param mask animated property bit mask (of the source frame)
+	 */
+	virtual void animateBaked(View<Component> component, const f32x4* values, uint32 mask) { abort(); }
 };
 
 /***********************************************************************************************************************
  * @brief Animation keyframes container.
+ * 
+ * @details Keyframes map is the authoring (serialized) representation of the animation. For the runtime it is baked 
+ *          into flat tracks: sorted keyframe frame (time) array and per system (track) contiguous property value 
+ *          arrays, stored property by property, so that all tracks of the clip are interpolated in one pass.
  */
 struct Animation final
 {
 public:
 	using Keyframes = map<int32, Animatables>;
+
+	/**
+	 * @brief Baked animation track data container.
+	 */
+	struct Track final
+	{
+		System* system = nullptr;                     /**< Animatable system instance. */
+		IAnimatable* animatable = nullptr;            /**< Animatable system interface. */
+		type_index componentType = typeid(Component); /**< Animatable system component type. */
+		uint32 valueOffset = 0;                       /**< Track first baked property value offset. */
+		uint8 propCount = 0;                          /**< Track baked property count. (0 = not baked) */
+		AnimationInterp interps[IAnimatable::maxBakedProps] = {}; /**< Baked property interpolation types. */
+	};
 private:
 	Keyframes keyframes;
+	vector<int32> frames;
+	vector<Track> tracks;
+	vector<ID<AnimationFrame>> trackFrames;
+	vector<f32x4> trackValues;
+	vector<uint32> trackMasks;
+	vector<float> trackCoeffs;
+	vector<AnimationFunc> trackFuncs;
+	uint32 bakedPropCount = 0;
+	bool isDirty = true;
 
 	/**
 	 * @brief Destroys animation keyframes.
@@ -135,6 +196,62 @@ public:
 	 */
 	const Keyframes& getKeyframes() const noexcept { return keyframes; }
 
+	/**
+	 * @brief Returns baked animation keyframe frame array. (Sorted)
+	 * @details See the @ref Animation::bake().
+	 */
+	const vector<int32>& getFrames() const noexcept { return frames; }
+	/**
+	 * @brief Returns baked animation track array.
+	 * @details See the @ref Animation::bake().
+	 */
+	const vector<Track>& getTracks() const noexcept { return tracks; }
+	/**
+	 * @brief Returns baked animation track frame array. [track * frameCount + keyframe]
+	 * @details See the @ref Animation::bake().
+	 */
+	const vector<ID<AnimationFrame>>& getTrackFrames() const noexcept { return trackFrames; }
+	/**
+	 * @brief Returns baked track property value array. [(valueOffset + prop) * frameCount + keyframe]
+	 * @details See the @ref Animation::bake().
+	 */
+	const vector<f32x4>& getTrackValues() const noexcept { return trackValues; }
+	/**
+	 * @brief Returns baked track animated property mask array. [track * frameCount + keyframe]
+	 * @details See the @ref Animation::bake().
+	 */
+	const vector<uint32>& getTrackMasks() const noexcept { return trackMasks; }
+	/**
+	 * @brief Returns baked track interpolation function coefficient array. [track * frameCount + keyframe]
+	 * @details See the @ref Animation::bake().
+	 */
+	const vector<float>& getTrackCoeffs() const noexcept { return trackCoeffs; }
+	/**
+	 * @brief Returns baked track interpolation function type array. [track * frameCount + keyframe]
+	 * @details See the @ref Animation::bake().
+	 */
+	const vector<AnimationFunc>& getTrackFuncs() const noexcept { return trackFuncs; }
+	/**
+	 * @brief Returns total baked property count of all tracks.
+	 */
+	uint32 getBakedPropCount() const noexcept { return bakedPropCount; }
+	/**
+	 * @brief Returns true if animation keyframes were changed after the last bake.
+	 */
+	bool isBakeDirty() const noexcept { return isDirty; }
+	/**
+	 * @brief Marks animation for the rebake.
+	 * @details Should be called after changing keyframe system animation frame data.
+	 */
+	void markBakeDirty() noexcept { isDirty = true; }
+
+	/**
+	 * @brief Bakes animation keyframes into the flat runtime tracks.
+	 * @details Tracks are created from the first keyframe systems, missing track frames are held from the previous.
+	 *          Properties of the systems implementing @ref IAnimatable::bakeAnimation() are copied to the value arrays.
+	 */
+	void bake();
+
 	/**
 	 * @brief Adds keyframe to the animation.
 	 * 
@@ -157,6 +274,7 @@ public:
 				GARDEN_ASSERT(animatables.find(keyframePair.first) != animatables.end());
 		}
 		#endif
+		isDirty = true;
 		return keyframes.emplace(index, std::move(animatables));
 	}
 
@@ -165,19 +283,19 @@ public:
 	 * @warning It does not destroys keyframe system frames!
 	 * @param index target keyframe index
 	 */
-	psize eraseKeyframe(int32 index) { return keyframes.erase(index); }
+	psize eraseKeyframe(int32 index) { isDirty = true; return keyframes.erase(index); }
 	/**
 	 * @brief Removes keyframe from the animation.
 	 * @warning It does not destroys keyframe system frames!
 	 * @param index target keyframe iterator
 	 */
-	auto eraseKeyframe(Keyframes::const_iterator i) { return keyframes.erase(i); }
+	auto eraseKeyframe(Keyframes::const_iterator i) { isDirty = true; return keyframes.erase(i); }
 
 	/**
 	 * @brief Removes all keyframes from the animation.
 	 * @warning It does not destroys keyframe system frames!
 	 */
-	void clearKeyframes() noexcept { keyframes.clear(); }
+	void clearKeyframes() noexcept { isDirty = true; keyframes.clear(); }
 
 	/**
 	 * @brief Destroys keyframe system animation frames.
@@ -0,0 +1,276 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Compiled binary scene format structures.
+ * 
+ * @details
+ * Binary scene is a flat, memory mappable representation of the JSON ".scene" file. Component types are stored
+ * as indices into the block table, so the loader resolves each system name only once. Component data is split into
+ * per-system blocks which can be deserialized in parallel. Transform and rigidbody components use fixed layout
+ * records, other components are stored as BSON records and deserialized using regular ISerializable interface.
+ * 
+ * File layout: [header][block table][entity component counts][component block indices][block names][block data]
+ *              [debug names]
+ */
+
+#pragma once
+#include "garden/defines.hpp"
+#include "math/vector.hpp"
+#include "math/flags.hpp"
+#include "math/quaternion.hpp"
+
+namespace garden
+{
+
+class JsonDeserializer;
+
+/**
+ * @brief Binary scene component record type.
+ */
+enum class BinaryRecordType : uint32
+{
+	Generic,   /**< BSON encoded component data. */
+	Transform, /**< Fixed layout transform component data. */
+	Rigidbody, /**< Fixed layout rigidbody component data. */
+	Count      /**< Binary scene record type count. */
+};
+
+/**
+ * @brief Binary scene file header.
+ */
+struct BinarySceneHeader final
+{
+	static constexpr uint32 magicValue = 0x4E435342; /**< "BSCN" */
+	static constexpr uint32 currentVersion = 2;
+
+	uint32 magic = magicValue;          /**< Binary scene file magic number. */
+	uint32 version = currentVersion;    /**< Binary scene format version. */
+	uint32 entityCount = 0;             /**< Scene entity count. */
+	uint32 blockCount = 0;              /**< Per-system component block count. */
+	uint64 componentCount = 0;          /**< Total scene component count. */
+	uint64 dataSize = 0;                /**< Total binary scene size in bytes. */
+};
+
+/**
+ * @brief Binary scene per-system component block.
+ * @details All block offsets are in bytes from the file start.
+ */
+struct BinarySceneBlock final
+{
+	uint64 dataOffset = 0;                                /**< Block records offset. */
+	uint64 dataSize = 0;                                  /**< Block records size in bytes. */
+	uint64 nameOffset = 0;                                /**< System component name offset. */
+	uint32 nameLength = 0;                                /**< System component name length. */
+	uint32 recordCount = 0;                               /**< Block component record count. */
+	BinaryRecordType recordType = BinaryRecordType::Generic; /**< Block component record type. */
+	uint32 _alignment = 0;
+};
+
+/**
+ * @brief Binary scene component record header.
+ * @details Records are 8 byte aligned, size includes header and any trailing record data.
+ */
+struct BinarySceneRecord final
+{
+	uint32 entityIndex = 0; /**< Owning scene entity index. */
+	uint32 size = 0;        /**< Record size in bytes. */
+};
+
+/**
+ * @brief Binary scene fixed layout transform component record.
+ */
+struct BinaryTransformRecord final
+{
+	static constexpr uint32 noParent = UINT32_MAX;
+
+	BinarySceneRecord header;
+	uint64 uid = 0;                             /**< Transform unique identifier or 0. */
+	uint64 parentUID = 0;                       /**< Parent unique identifier, if not found in the scene, or 0. */
+	float3 position = float3::zero;             /**< Transform local position. */
+	float4 rotation = float4(0.0f, 0.0f, 0.0f, 1.0f); /**< Transform local rotation quaternion. (XYZW) */
+	float3 scale = float3::one;                 /**< Transform local scale. */
+	uint32 parentIndex = noParent;              /**< Parent scene entity index. */
+	uint32 isActive = 1;                        /**< Is transform self active. */
+	uint32 debugNameOffset = 0;                 /**< Debug name offset in bytes from the record start. */
+	uint32 debugNameLength = 0;                 /**< Debug name length or 0. */
+
+	/**
+	 * @brief Returns transform debug name, stored in the file debug names section.
+	 */
+	string_view getDebugName() const noexcept
+	{
+		return string_view((const char*)this + debugNameOffset, debugNameLength);
+	}
+};
+
+static_assert(sizeof(BinaryTransformRecord) % 8 == 0, "Binary scene records should be 8 byte aligned");
+
+/**
+ * @brief Binary scene rigidbody shape type.
+ */
+enum class BinaryShapeType : uint8
+{
+	None, Box, RotatedTranslatedBox, Count
+};
+
+/**
+ * @brief Binary scene rigidbody record flags.
+ */
+enum class BinaryRigidbodyFlags : uint8
+{
+	None                    = 0x00,
+	IsActive                = 0x01,
+	AllowDynamicOrKinematic = 0x02,
+	IsSensor                = 0x04,
+	IsKinematicVsStatic     = 0x08,
+};
+DECLARE_ENUM_CLASS_FLAG_OPERATORS(BinaryRigidbodyFlags)
+
+/**
+ * @brief Binary scene rigidbody constraint record.
+ */
+struct BinaryConstraintRecord final
+{
+	uint64 otherUID = 0; /**< Other rigidbody unique identifier. */
+	uint32 type = 0;     /**< Constraint type. (Same values as ConstraintType) */
+	uint32 _alignment = 0;
+};
+
+/**
+ * @brief Binary scene fixed layout rigidbody component record.
+ * @details Followed by constraint records and then by the event listener name characters.
+ */
+struct BinaryRigidbodyRecord final
+{
+	BinarySceneRecord header;
+	uint64 uid = 0;                                   /**< Rigidbody unique identifier or 0. */
+	float3 position = float3::zero;                   /**< Rigidbody world position. */
+	float4 rotation = float4(0.0f, 0.0f, 0.0f, 1.0f); /**< Rigidbody world rotation. (XYZW) */
+	float3 linearVelocity = float3::zero;             /**< Rigidbody linear velocity. */
+	float3 angularVelocity = float3::zero;            /**< Rigidbody angular velocity. */
+	float3 halfExtent = float3(0.5f);                 /**< Box shape half extent. */
+	float convexRadius = 0.05f;                       /**< Box shape convex radius. */
+	float3 shapePosition = float3::zero;              /**< Decorated shape position. */
+	float4 shapeRotation = float4(0.0f, 0.0f, 0.0f, 1.0f); /**< Decorated shape rotation. (XYZW) */
+	int32 collisionLayer = -1;                        /**< Rigidbody collision layer or -1. */
+	uint32 eventListenerLength = 0;                   /**< Trailing event listener name length. */
+	uint32 constraintCount = 0;                       /**< Trailing constraint record count. */
+	uint8 motionType = 0;                             /**< Motion type. (Same values as MotionType) */
+	BinaryShapeType shapeType = BinaryShapeType::None; /**< Rigidbody shape type. */
+	uint8 allowedDOF = 0b111111;                      /**< Allowed degrees of freedom. (Same values as AllowedDOF) */
+	BinaryRigidbodyFlags flags = BinaryRigidbodyFlags::None; /**< Rigidbody record flags. */
+
+	/**
+	 * @brief Returns trailing constraint records.
+	 */
+	const BinaryConstraintRecord* getConstraints() const noexcept
+	{
+		return (const BinaryConstraintRecord*)((const uint8*)this + sizeof(BinaryRigidbodyRecord));
+	}
+	/**
+	 * @brief Returns trailing event listener name.
+	 */
+	string_view getEventListener() const noexcept
+	{
+		return string_view((const char*)(getConstraints() + constraintCount), eventListenerLength);
+	}
+};
+
+static_assert(sizeof(BinaryRigidbodyRecord) % 8 == 0, "Binary scene records should be 8 byte aligned");
+
+/***********************************************************************************************************************
+ * @brief Binary scene format converter and reader.
+ */
+class BinaryScene final
+{
+public:
+	/**
+	 * @brief Is the specified data a binary scene. (Checks header magic)
+	 * 
+	 * @param[in] data target scene data
+	 * @param size scene data size in bytes
+	 */
+	static bool isBinary(const uint8* data, psize size) noexcept
+	{
+		return size >= sizeof(BinarySceneHeader) && ((const BinarySceneHeader*)data)->magic == 
+			BinarySceneHeader::magicValue;
+	}
+
+	/**
+	 * @brief Returns binary scene block table.
+	 * @param[in] data target binary scene data
+	 */
+	static const BinarySceneBlock* getBlocks(const uint8* data) noexcept
+	{
+		return (const BinarySceneBlock*)(data + sizeof(BinarySceneHeader));
+	}
+	/**
+	 * @brief Returns binary scene per-entity component counts.
+	 * @param[in] data target binary scene data
+	 */
+	static const uint16* getComponentCounts(const uint8* data) noexcept
+	{
+		auto header = (const BinarySceneHeader*)data;
+		return (const uint16*)(getBlocks(data) + header->blockCount);
+	}
+	/**
+	 * @brief Returns binary scene component block indices. (In entity order)
+	 * @param[in] data target binary scene data
+	 */
+	static const uint16* getComponentTypes(const uint8* data) noexcept
+	{
+		auto header = (const BinarySceneHeader*)data;
+		return getComponentCounts(data) + header->entityCount;
+	}
+
+	/**
+	 * @brief Returns quaternion from the binary record XYZW rotation.
+	 * @param rotation target record rotation
+	 */
+	static quat toQuat(float4 rotation) noexcept
+	{
+		auto result = quat::identity;
+		result.setX(rotation.x); result.setY(rotation.y);
+		result.setZ(rotation.z); result.setW(rotation.w);
+		return result;
+	}
+
+	/**
+	 * @brief Validates binary scene structure. (header, block table and records bounds)
+	 * 
+	 * @param[in] data target binary scene data
+	 * @param size scene data size in bytes
+	 * @param[out] error validation error description
+	 * 
+	 * @return True if binary scene is valid, otherwise false.
+	 */
+	static bool validate(const uint8* data, psize size, string& error);
+
+	/**
+	 * @brief Converts JSON scene to the binary scene format.
+	 * @details Entity debug names are stripped from the all components, unless they are kept.
+	 * 
+	 * @param[in,out] deserializer loaded JSON scene deserializer
+	 * @param[out] data binary scene data
+	 * @param keepDebugNames store transform debug names (for the debug and editor builds)
+	 * 
+	 * @throw GardenError on scene conversion error.
+	 */
+	static void convert(JsonDeserializer& deserializer, vector<uint8>& data, bool keepDebugNames = false);
+};
+
+} // namespace garden
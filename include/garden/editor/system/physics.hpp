@@ -62,9 +62,12 @@ private:
 	void* debugRenderer = nullptr;
 	RigidbodyCache rigidbodyCache = {};
 	CharacterCache characterCache = {};
+	PhysicsSystem::NetLoopbackProperties netLoopbackProperties = {};
+	PhysicsSystem::NetLoopbackStats netLoopbackStats = {};
 	ID<Entity> rigidbodySelectedEntity = {};
 	ID<Entity> characterSelectedEntity = {};
 	bool showWindow = false;
+	bool hasNetLoopbackStats = false;
 
 	PhysicsEditorSystem();
 	void init();
@@ -145,6 +145,66 @@ public:
 	#endif
 };
 
+/**
+ * @brief Read-only memory mapped file.
+ * @details Maps the whole file into the process address space, OS loads its pages on first access.
+ */
+class MappedFile final
+{
+	const uint8* data = nullptr;
+	psize size = 0;
+	#if GARDEN_OS_WINDOWS
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+	#endif
+public:
+	/**
+	 * @brief Creates a new empty mapped file.
+	 */
+	MappedFile() = default;
+	/**
+	 * @brief Maps the specified file into the memory.
+	 * @param[in] filePath target file path
+	 * @throw GardenError if failed to map the file.
+	 */
+	MappedFile(const fs::path& filePath)
+	{
+		if (!tryMap(filePath))
+			throw GardenError("Failed to map file. (path: " + filePath.generic_string() + ")");
+	}
+	/**
+	 * @brief Unmaps the file from the memory.
+	 */
+	~MappedFile() { unmap(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile& operator=(MappedFile&&) = delete;
+
+	/**
+	 * @brief Returns mapped file data or null.
+	 */
+	const uint8* getData() const noexcept { return data; }
+	/**
+	 * @brief Returns mapped file size in bytes.
+	 */
+	psize getSize() const noexcept { return size; }
+
+	/**
+	 * @brief Maps the specified file into the memory.
+	 * @note Unmaps previously mapped file.
+	 * 
+	 * @param[in] filePath target file path
+	 * @return True on success, otherwise false.
+	 */
+	bool tryMap(const fs::path& filePath);
+	/**
+	 * @brief Unmaps the file from the memory.
+	 */
+	void unmap();
+};
+
 /**
  * @brief Converts binary size to the string representation. (KB, MB, GB, TB)
  * @param size target binary size
@@ -31,10 +31,11 @@ using namespace garden::graphics;
 
 /**
  * @brief Graphics API backend type.
+ * @details Null API is a headless backend without GPU device. (For CPU profiling and servers)
  */
 enum class GraphicsBackend : uint8
 {
-	VulkanAPI, Count
+	VulkanAPI, NullAPI, Count
 };
 /**
  * @brief Common GPU vendors. (Company, Manufacturer)
@@ -31,7 +31,7 @@ struct Command
 {
 	enum class Type : uint8
 	{
-		Unknown, BufferBarrier, BeginRenderPass, Execute, EndRenderPass, ClearAttachments,
+		Unknown, BufferBarrier, PipelineBarrier, BeginRenderPass, Execute, EndRenderPass, ClearAttachments,
 		BindPipeline, BindDescriptorSets, PushConstants, SetViewport, SetScissor,
 		SetViewportScissor, SetDepthBias, Draw, DrawIndexed, DrawIndirect, DrawIndexedIndirect, 
 		Dispatch, FillBuffer, CopyBuffer, ClearImage, CopyImage, CopyBufferImage, BlitImage,
@@ -64,6 +64,30 @@ struct BufferBarrierCommand final : public BufferBarrierCommandBase
 	const ID<Buffer>* buffers = nullptr;
 };
 
+/**
+ * @brief Precomputed image or buffer memory barrier.
+ * @details Layout is ignored for buffers. If old state is tracked, current resource state is used instead.
+ */
+struct ResourceBarrier final
+{
+	Image::LayoutState oldState = {};
+	Image::LayoutState newState = {};
+	ID<Resource> resource = {};
+	ResourceType type = {};
+	bool isTracked = false;
+};
+struct PipelineBarrierCommandBase : public Command
+{
+	uint8 _alignment0 = 0;
+	uint16 _alignment1 = 0;
+	uint32 barrierCount = 0;
+	PipelineBarrierCommandBase() noexcept : Command(Type::PipelineBarrier) { }
+};
+struct PipelineBarrierCommand final : public PipelineBarrierCommandBase
+{
+	const ResourceBarrier* barriers = nullptr;
+};
+
 //**********************************************************************************************************************
 struct BeginRenderPassCommandBase : public Command
 {
@@ -480,6 +504,7 @@ protected:
 	void processCommands();
 
 	virtual void processCommand(const BufferBarrierCommand& command) = 0;
+	virtual void processCommand(const PipelineBarrierCommand& command) = 0;
 	virtual void processCommand(const BeginRenderPassCommand& command) = 0;
 	virtual void processCommand(const ExecuteCommand& command) = 0;
 	virtual void processCommand(const EndRenderPassCommand& command) = 0;
@@ -536,6 +561,13 @@ public:
 		auto allocation = allocateCommand<BufferBarrierCommandBase>(command, (uint32)commandSize);
 		memcpy(allocation + 1, command.buffers, command.bufferCount * sizeof(ID<Buffer>));
 	}
+	void addCommand(const PipelineBarrierCommand& command)
+	{
+		auto commandSize = sizeof(PipelineBarrierCommandBase) + command.barrierCount * sizeof(ResourceBarrier);
+		auto allocation = allocateCommand<PipelineBarrierCommandBase>(command, (uint32)commandSize);
+		if (command.barrierCount > 0)
+			memcpy(allocation + 1, command.barriers, command.barrierCount * sizeof(ResourceBarrier));
+	}
 	void addCommand(const BeginRenderPassCommand& command)
 	{
 		GARDEN_ASSERT(type == CommandBufferType::Frame || type == CommandBufferType::Graphics);
@@ -295,7 +295,8 @@ private:
 	vector<LayoutState> barrierStates;
 	uint32 aspectFlags = 0;
 
-	Image(Type type, Format format, Usage usage, Strategy strategy, u32x4 size, uint64 version);
+	Image(Type type, Format format, Usage usage, Strategy strategy, 
+		u32x4 size, uint64 version, void* aliasMemory = nullptr);
 	Image(Usage usage, Strategy strategy, uint64 version) noexcept :
 		Memory(0, CpuAccess::None, Location::Auto, strategy, version), usage(usage) { }
 	Image(void* instance, Format format, Usage usage, Strategy strategy, uint2 size, uint8 backend);
@@ -1575,12 +1576,44 @@ public:
 	 * @param size image size in texels and mip count
 	 * @param mipCount image mipmap level count
 	 * @param version image instance version
+	 * @param[in] aliasMemory shared alias memory allocation (or null)
 	 */
 	static Image create(Image::Type type, Image::Format format, Image::Usage usage,
-		Image::Strategy strategy, u32x4 size, uint64 version)
+		Image::Strategy strategy, u32x4 size, uint64 version, void* aliasMemory = nullptr)
 	{
-		return Image(type, format, usage, strategy, size, version);
+		return Image(type, format, usage, strategy, size, version, aliasMemory);
 	}
+
+	/**
+	 * @brief Returns image memory requirements, without allocating it.
+	 * 
+	 * @param type image dimensionality type
+	 * @param format image data format
+	 * @param usage image usage flags
+	 * @param size image size in texels and mip count
+	 * @param[out] binarySize required memory size in bytes
+	 * @param[out] alignment required memory alignment in bytes
+	 * @param[out] memoryTypes supported memory type mask (Internal API format)
+	 */
+	static void getMemoryRequirements(Image::Type type, Image::Format format, Image::Usage usage, 
+		u32x4 size, uint64& binarySize, uint64& alignment, uint32& memoryTypes);
+	/**
+	 * @brief Allocates GPU memory which can be shared by the multiple aliased images.
+	 * @warning Images bound to the same memory should not be used at the same time!
+	 * 
+	 * @param binarySize memory size in bytes
+	 * @param alignment memory alignment in bytes
+	 * @param memoryTypes supported memory type mask (Internal API format)
+	 * 
+	 * @throw GardenError if failed to allocate memory.
+	 */
+	static void* allocateAliasMemory(uint64 binarySize, uint64 alignment, uint32 memoryTypes);
+	/**
+	 * @brief Destroys shared alias memory allocation. (Deferred until it is not used by the GPU)
+	 * @note Images created inside the shared memory should be destroyed too.
+	 * @param[in] aliasMemory target alias memory allocation
+	 */
+	static void destroyAliasMemory(void* aliasMemory);
 	/**
 	 * @brief Moves internal image objects.
 	 * @warning In most cases you should use @ref GraphicsSystem functions.
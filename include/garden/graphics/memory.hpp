@@ -92,6 +92,7 @@ protected:
 	CpuAccess cpuAccess = {};
 	Location location = {};
 	Strategy strategy = {};
+	bool graphOwned = false;
 	void* allocation = nullptr;
 	uint64 binarySize = 0;
 	uint64 version = 0;
@@ -257,6 +258,12 @@ public:
 	 * @param[in] memory target memory instance
 	 */
 	static Memory::Strategy& getStrategy(Memory& memory) noexcept { return memory.strategy; }
+	/**
+	 * @brief Is memory synchronized by the current render graph pass barrier.
+	 * @details Command barriers are not added for the graph owned resources until the pass end.
+	 * @param[in] memory target memory instance
+	 */
+	static bool& isGraphOwned(Memory& memory) noexcept { return memory.graphOwned; }
 };
 
 } // namespace garden::graphics
\ No newline at end of file
@@ -19,33 +19,124 @@
 
 #pragma once
 #include "garden/graphics/buffer.hpp"
+#include "garden/graphics/common.hpp"
 
 namespace garden::graphics
 {
 
 /**
  * @brief Garden 3D model converter. (Uses Assimp internally)
+ *
+ * @details
+ * Imports source 3D model (glTF, FBX, OBJ...) and converts it to the Garden model format. All model meshes are
+ * merged into the one vertex and index buffer. Triangle order is optimized for the post-transform vertex cache
+ * and for the overdraw, vertices are reordered for the fetch locality. Model also contains LOD chain, which
+ * shares the same vertex buffer, and meshlet clusters for each LOD level.
+ *
+ * Vertex data is stored quantized in the model file (unorm16 positions relative to the AABB, octahedral 16-bit
+ * directions, half float texture coordinates and unorm8 colors) and is expanded on load to the interleaved
+ * BufferChannel layout, so it can be copied to the buffer directly.
  */
 class ModelConverter final
 {
 public:
 	/**
-	 * @brief Loads 3D model data. (Vertices and indices)
+	 * @brief Model level of detail (LOD) description.
+	 */
+	struct Lod final
+	{
+		uint32 indexOffset = 0;   /**< LOD first index offset. */
+		uint32 indexCount = 0;    /**< LOD index count. */
+		uint32 meshletOffset = 0; /**< LOD first meshlet offset. */
+		uint32 meshletCount = 0;  /**< LOD meshlet count. */
+		float error = 0.0f;       /**< Simplification error relative to the model size. */
+	};
+	/**
+	 * @brief Model meshlet (triangle cluster) description.
+	 * @details Cone cutoff equal to 1.0 means that meshlet can't be cone culled.
+	 */
+	struct Meshlet final
+	{
+		uint32 vertexOffset = 0;         /**< First meshlet vertex offset. */
+		uint32 triangleOffset = 0;       /**< First meshlet triangle offset. (In indices) */
+		uint32 vertexCount = 0;          /**< Meshlet vertex count. */
+		uint32 triangleCount = 0;        /**< Meshlet triangle count. */
+		float3 center = float3::zero;    /**< Meshlet bounding sphere center. */
+		float radius = 0.0f;             /**< Meshlet bounding sphere radius. */
+		float3 coneAxis = float3::zero;  /**< Meshlet normal cone axis. */
+		float coneCutoff = 1.0f;         /**< Meshlet normal cone cutoff. (sin of the cone angle) */
+	};
+	/**
+	 * @brief Model data container.
+	 */
+	struct ModelData final
+	{
+		vector<BufferChannel> channels;  /**< Vertex data channels. (Interleaved) */
+		vector<uint8> vertexData;        /**< Vertex data in the BufferChannel layout. */
+		vector<uint8> indexData;         /**< Index data of all LODs. */
+		vector<Lod> lods;                /**< Model level of details. (From the most detailed) */
+		vector<Meshlet> meshlets;        /**< Meshlets of all LODs. */
+		vector<uint32> meshletVertices;  /**< Meshlet vertex indices. */
+		vector<uint8> meshletTriangles;  /**< Meshlet local triangle indices. */
+		float3 aabbMin = float3::zero;   /**< Model axis aligned bounding box minimum. */
+		float3 aabbMax = float3::zero;   /**< Model axis aligned bounding box maximum. */
+		uint32 vertexCount = 0;          /**< Model vertex count. */
+		IndexType indexType = {};        /**< Model index type. */
+	};
+
+	/**
+	 * @brief Garden model file magic number.
+	 */
+	static constexpr string_view modelMagic = "GMDL";
+	/**
+	 * @brief Garden model file extension.
+	 */
+	static constexpr string_view modelExtension = ".gmdl";
+	/**
+	 * @brief Maximum meshlet vertex count.
+	 */
+	static constexpr uint32 maxMeshletVertices = 64;
+	/**
+	 * @brief Maximum meshlet triangle count.
+	 */
+	static constexpr uint32 maxMeshletTriangles = 124;
+	/**
+	 * @brief Maximum model LOD count.
+	 */
+	static constexpr uint8 maxLodCount = 6;
+
+	/**
+	 * @brief Loads 3D model data. (Vertices, indices, LODs and meshlets)
+	 * @details Validates all LOD, meshlet and index ranges, so invalid data can't read out of the bounds.
+	 * @return True on success, otherwise false if data is invalid.
 	 *
-	 * @param[in,out] data target shader data container
+	 * @param[in] data target model file data
+	 * @param dataSize model file data size in bytes
+	 * @param[out] modelData loaded model data container
 	 */
-	// static void loadModel();
+	static bool loadModel(const uint8* data, psize dataSize, ModelData& modelData);
+	/**
+	 * @brief Loads 3D model data. (Vertices, indices, LODs and meshlets)
+	 * @return True on success, otherwise false if file is not found or invalid.
+	 *
+	 * @param filePath target model file path
+	 * @param[out] modelData loaded model data container
+	 */
+	static bool loadModel(const fs::path& filePath, ModelData& modelData);
 
 	#if GARDEN_DEBUG || defined(GARDEN_MODEL_CONVERTER)
 	/**
 	 * @brief Converts specified 3D model to the Garden model format.
-	 * 
+	 * @return True on success, otherwise false if model file is not found.
+	 *
 	 * @param filePath target model to convert path
 	 * @param inputPath input model directory path
 	 * @param outputPath output model directory path
+	 *
+	 * @throw GardenError on model import or conversion error.
 	 */
 	static bool convertModel(const fs::path& filePath, const fs::path& inputPath, const fs::path& outputPath);
 	#endif
 };
 
-} // namespace garden::graphics
\ No newline at end of file
+} // namespace garden::graphics
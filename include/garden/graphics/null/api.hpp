@@ -0,0 +1,75 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Null (headless) graphics API functions.
+ */
+
+#pragma once
+#include "garden/graphics/api.hpp"
+
+namespace garden
+{
+
+/**
+ * @brief Headless graphics API without a GPU device.
+ * 
+ * @details
+ * Null API implements the graphics API, command buffers and resource pools without creating any GPU device. 
+ * All resources get opaque unique instance handles, mappable buffers are backed by the host memory and recorded 
+ * commands are processed and dropped at submit. It allows to run and profile the CPU side of the rendering 
+ * systems (command recording, resource management, culling, sorting) on the machines without Vulkan driver.
+ * 
+ * @warning Use null graphics API directly with caution!
+ */
+class NullAPI final : public GraphicsAPI
+{
+	inline static NullAPI* nullInstance = nullptr;
+	inline static atomic<uint64> instanceCounter = 0;
+
+	NullAPI(const string& appName, uint2 windowSize, ThreadPool* threadPool, 
+		bool useVsync, bool useTripleBuffering, bool isFullscreen, bool isDecorated);
+	~NullAPI() override;
+
+	friend class GraphicsAPI;
+public:
+	/**
+	 * @brief Actually destroys unused GPU resources.
+	 */
+	void flushDestroyBuffer() override;
+	/**
+	 * @brief Wait for a GPU to become idle.
+	 * @note Null API has no device, so it is always idle.
+	 */
+	void waitIdle() override { }
+
+	/**
+	 * @brief Returns a new unique opaque resource instance handle.
+	 * @details Handle is never dereferenced, it is only used to mark resource as ready.
+	 */
+	static void* createInstance() noexcept { return (void*)(psize)++instanceCounter; }
+
+	/**
+	 * @brief Returns null graphics API instance.
+	 */
+	inline static NullAPI* get() noexcept
+	{
+		GARDEN_ASSERT_MSG(nullInstance, "Graphics API is not initialized");
+		return nullInstance;
+	}
+};
+
+} // namespace garden
@@ -0,0 +1,76 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Null (headless) rendering command buffer functions.
+ */
+
+#pragma once
+#include "garden/graphics/command-buffer.hpp"
+#include "garden/graphics/null/api.hpp"
+
+namespace garden::graphics
+{
+
+/**
+ * @brief Null rendering commands recorder.
+ * @details Processes recorded commands without a GPU, submitted work is instantly completed.
+ */
+class NullCommandBuffer final : public CommandBuffer
+{
+public:
+	void processCommand(const BufferBarrierCommand& command) override { }
+	void processCommand(const PipelineBarrierCommand& command) override { }
+	void processCommand(const BeginRenderPassCommand& command) override { }
+	void processCommand(const ExecuteCommand& command) override { }
+	void processCommand(const EndRenderPassCommand& command) override { }
+	void processCommand(const ClearAttachmentsCommand& command) override { }
+	void processCommand(const BindPipelineCommand& command) override { }
+	void processCommand(const BindDescriptorSetsCommand& command) override { }
+	void processCommand(const PushConstantsCommand& command) override { }
+	void processCommand(const SetViewportCommand& command) override { }
+	void processCommand(const SetScissorCommand& command) override { }
+	void processCommand(const SetViewportScissorCommand& command) override { }
+	void processCommand(const SetDepthBiasCommand& command) override { }
+	void processCommand(const DrawCommand& command) override { }
+	void processCommand(const DrawIndexedCommand& command) override { }
+	void processCommand(const DispatchCommand& command) override { }
+	void processCommand(const FillBufferCommand& command) override;
+	void processCommand(const CopyBufferCommand& command) override;
+	void processCommand(const ClearImageCommand& command) override { }
+	void processCommand(const CopyImageCommand& command) override { }
+	void processCommand(const CopyBufferImageCommand& command) override { }
+	void processCommand(const BlitImageCommand& command) override { }
+	
+	void processCommand(const BuildAccelerationStructureCommand& command) override { }
+	void processCommand(const CopyAccelerationStructureCommand& command) override { }
+	void processCommand(const TraceRaysCommand& command) override { }
+	void processCommand(const CustomRenderCommand& command) override { }
+
+	#if GARDEN_DEBUG
+	void processCommand(const BeginLabelCommand& command) override { }
+	void processCommand(const EndLabelCommand& command) override { }
+	void processCommand(const InsertLabelCommand& command) override { }
+	#endif
+
+	NullCommandBuffer(NullAPI* nullAPI, CommandBufferType type) : 
+		CommandBuffer(nullAPI->getThreadPool(), type) { }
+
+	void submit() override;
+	bool isBusy() override { return false; }
+};
+
+} // namespace garden::graphics
@@ -0,0 +1,51 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Null (headless) graphics swapchain functions.
+ */
+
+#pragma once
+#include "garden/graphics/swapchain.hpp"
+
+namespace garden
+{
+	class NullAPI;
+}
+
+namespace garden::graphics
+{
+
+/**
+ * @brief Null swapchain class.
+ * @details Rotates host side swapchain images without presenting them anywhere.
+ */
+class NullSwapchain final : public Swapchain
+{
+	NullAPI* nullAPI = nullptr;
+
+	NullSwapchain(NullAPI* nullAPI, uint2 framebufferSize, bool useVsync, bool useTripleBuffering);
+	~NullSwapchain() override;
+
+	friend class garden::NullAPI;
+public:
+	void recreate(uint2 framebufferSize, bool useVsync, bool useTripleBuffering) override;
+	bool acquireNextImage() override;
+	void submit() override { }
+	bool present() override;
+};
+
+} // namespace garden::graphics
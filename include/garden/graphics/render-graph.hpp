@@ -0,0 +1,264 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Frame render graph functions.
+ *
+ * @details
+ * Render passes declare which images and buffers they read and write. Graph culls passes whose results are never
+ * used, precomputes memory barriers between the passes and places transient images with not overlapping lifetimes
+ * into the same shared memory. Compiled plan is reused until the declared graph topology changes.
+ */
+
+#pragma once
+#include "garden/graphics/command-buffer.hpp"
+#include "garden/hash.hpp"
+#include <functional>
+
+namespace garden::graphics
+{
+
+/**
+ * @brief Frame graph layer over the command buffer.
+ *
+ * @details
+ * Declarations should be repeated each frame in the same order: clear graph, import or create resources,
+ * add passes with their reads and writes, then execute it. Resources and passes are referenced by the
+ * indices returned on declaration. Passes are recorded into the current command buffer, transient images
+ * get current command buffer queue usage flag, so that they never require queue ownership transfers.
+ *
+ * Passes writing imported resources are always executed, other passes are culled if none of the following
+ * executed passes reads their written transient images. Barriers computed by the graph are recorded before
+ * each pass, declared resources are owned by the graph until the pass end, so that pass commands do not add
+ * the same barriers again. Pass commands are still tracked for the resources not declared inside the graph.
+ *
+ * @warning Declared resources are not synchronized between the commands of the same pass!
+ */
+class RenderGraph final
+{
+public:
+	/**
+	 * @brief Render pass resource access type.
+	 */
+	enum class Access : uint8
+	{
+		ColorAttachment,        /**< Framebuffer color attachment. (Write only) */
+		DepthStencilAttachment, /**< Framebuffer depth or/and stencil attachment. (Read only if not written) */
+		Sampled,                /**< Shader sampled image. (Read only) */
+		Storage,                /**< Shader storage image or buffer. */
+		Uniform,                /**< Shader uniform buffer. (Read only) */
+		Vertex,                 /**< Vertex buffer. (Read only) */
+		Index,                  /**< Index buffer. (Read only) */
+		Indirect,               /**< Indirect draw or dispatch buffer. (Read only) */
+		Transfer,               /**< Transfer command source or destination. */
+		Count                   /**< Render pass resource access type count. */
+	};
+	/**
+	 * @brief Transient image description.
+	 */
+	struct ImageDesc final
+	{
+		u32x4 size = u32x4::zero;                        /**< Image size. (X, Y, layer or depth count, mip count) */
+		Image::Type type = Image::Type::Texture2D;       /**< Image dimensionality type. */
+		Image::Format format = Image::Format::Undefined; /**< Image data format. */
+		Image::Usage usage = Image::Usage::None;         /**< Additional image usage flags. */
+	};
+
+	/**
+	 * @brief Render pass commands recording function.
+	 */
+	typedef std::function<void()> OnExecute;
+private:
+	struct ResourceData final
+	{
+		ImageDesc desc = {};
+		ID<Image> image = {};
+		ID<Buffer> buffer = {};
+		bool isTransient = false;
+		#if GARDEN_DEBUG || GARDEN_EDITOR
+		string debugName;
+		#endif
+	};
+	struct PassData final
+	{
+		string name;
+		OnExecute onExecute;
+		bool isKept = false;
+	};
+	struct AccessData final
+	{
+		uint32 pass = 0;
+		uint32 resource = 0;
+		PipelineStage stages = {};
+		Access access = {};
+		bool isWrite = false;
+		uint16 _alignment = 0;
+	};
+	struct PlanPass final
+	{
+		uint32 pass = 0;
+		uint32 barrierOffset = 0;
+		uint32 barrierCount = 0;
+	};
+
+	vector<ResourceData> resources;
+	vector<PassData> passes;
+	vector<AccessData> accesses;
+	vector<PlanPass> planPasses;
+	vector<ResourceBarrier> planBarriers;
+	vector<uint32> barrierResources;
+	vector<ResourceBarrier> barrierBuffer;
+	vector<ID<Image>> transientImages;
+	vector<void*> aliasMemories;
+	vector<bool> culledPasses;
+	Hash128::State hashState = nullptr;
+	Hash128 topologyHash = {};
+	uint64 transientMemorySize = 0;
+	uint64 aliasedMemorySize = 0;
+	uint64 version = 0;
+
+	Hash128 calcTopologyHash(CommandBufferType commandBufferType);
+	void destroyTransients();
+public:
+	/**
+	 * @brief Creates a new empty render graph instance.
+	 */
+	RenderGraph();
+	/**
+	 * @brief Destroys render graph transient images and their shared memory.
+	 */
+	~RenderGraph();
+
+	RenderGraph(const RenderGraph&) = delete;
+	RenderGraph& operator=(const RenderGraph&) = delete;
+
+	/*******************************************************************************************************************
+	 * @brief Imports existing image to the render graph.
+	 * @return Render graph resource index.
+	 * @param image target image instance
+	 */
+	uint32 importImage(ID<Image> image);
+	/**
+	 * @brief Imports existing buffer to the render graph.
+	 * @return Render graph resource index.
+	 * @param buffer target buffer instance
+	 */
+	uint32 importBuffer(ID<Buffer> buffer);
+	/**
+	 * @brief Declares a new transient image, which content only lives inside the render graph.
+	 * @details Transient images with not overlapping lifetimes can share the same GPU memory.
+	 * @return Render graph resource index.
+	 *
+	 * @param[in] desc target image description
+	 * @param[in] debugName image debug name (visible in GPU profiler)
+	 */
+	uint32 createImage(const ImageDesc& desc, string_view debugName = "transient");
+
+	/**
+	 * @brief Returns render graph resource image instance.
+	 * @note Transient image is created only after graph compilation, and can change when topology changes.
+	 * @param resource target render graph resource index
+	 */
+	ID<Image> getImage(uint32 resource) const noexcept
+	{
+		GARDEN_ASSERT(resource < resources.size());
+		const auto& resourceData = resources[resource];
+		if (resourceData.isTransient)
+			return resource < transientImages.size() ? transientImages[resource] : ID<Image>();
+		return resourceData.image;
+	}
+	/**
+	 * @brief Returns render graph resource buffer instance.
+	 * @param resource target render graph resource index
+	 */
+	ID<Buffer> getBuffer(uint32 resource) const noexcept
+	{
+		GARDEN_ASSERT(resource < resources.size());
+		return resources[resource].buffer;
+	}
+
+	/*******************************************************************************************************************
+	 * @brief Adds a new render pass to the graph end.
+	 * @return Render graph pass index.
+	 *
+	 * @param[in] name render pass name (visible in GPU profiler)
+	 * @param[in] onExecute render pass commands recording function
+	 */
+	uint32 addPass(const string& name, OnExecute&& onExecute);
+	/**
+	 * @brief Declares render pass resource read.
+	 *
+	 * @param pass target render graph pass index
+	 * @param resource target render graph resource index
+	 * @param access resource access type
+	 * @param stages shader stages accessing the resource (for shader access types)
+	 */
+	void read(uint32 pass, uint32 resource, Access access, PipelineStage stages = PipelineStage::None);
+	/**
+	 * @brief Declares render pass resource write.
+	 *
+	 * @param pass target render graph pass index
+	 * @param resource target render graph resource index
+	 * @param access resource access type
+	 * @param stages shader stages accessing the resource (for shader access types)
+	 */
+	void write(uint32 pass, uint32 resource, Access access, PipelineStage stages = PipelineStage::None);
+	/**
+	 * @brief Marks render pass as having side effects, so it is never culled.
+	 * @param pass target render graph pass index
+	 */
+	void keepPass(uint32 pass);
+
+	/**
+	 * @brief Returns true if render pass was culled by the last graph compilation.
+	 * @param pass target render graph pass index
+	 */
+	bool isCulled(uint32 pass) const noexcept
+	{
+		return pass < culledPasses.size() ? (bool)culledPasses[pass] : false;
+	}
+	/**
+	 * @brief Returns render graph compiled plan version.
+	 * @details Increments each time transient images are recreated. (Descriptor sets should be updated)
+	 */
+	uint64 getVersion() const noexcept { return version; }
+	/**
+	 * @brief Returns total transient image memory size in bytes, without aliasing.
+	 */
+	uint64 getTransientMemorySize() const noexcept { return transientMemorySize; }
+	/**
+	 * @brief Returns allocated transient image shared memory size in bytes.
+	 */
+	uint64 getAliasedMemorySize() const noexcept { return aliasedMemorySize; }
+
+	/*******************************************************************************************************************
+	 * @brief Clears render graph pass and resource declarations.
+	 * @note Compiled plan and transient images are kept for the next declarations.
+	 */
+	void clear() noexcept;
+	/**
+	 * @brief Compiles render graph if declared topology has changed.
+	 * @details Culls unused passes, allocates transient images and precomputes barriers.
+	 * @throw GardenError if failed to allocate transient image memory.
+	 */
+	void compile();
+	/**
+	 * @brief Records not culled render passes and their barriers into the current command buffer.
+	 * @note Compiles render graph if declared topology has changed.
+	 */
+	void execute();
+};
+
+} // namespace garden::graphics
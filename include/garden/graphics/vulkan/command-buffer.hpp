@@ -33,6 +33,8 @@ public:
 	VulkanAPI* vulkanAPI = nullptr;
 	vk::CommandBuffer instance;
 	vk::Fence fence;
+	vector<ID<Image>> graphImages;
+	vector<ID<Buffer>> graphBuffers;
 
 	static void addBufferBarrier(VulkanAPI* vulkanAPI, Buffer::BarrierState& newBufferState, 
 		ID<Buffer> buffer, uint64 size = VK_WHOLE_SIZE, uint64 offset = 0);
@@ -45,8 +47,10 @@ public:
 	void addRenderPassBarriers(uint32 thisSize);
 	void addRenderPassBarriersAsync(uint32 thisSize);
 	void processPipelineBarriers();
+	void releaseGraphResources();
 
 	void processCommand(const BufferBarrierCommand& command) override;
+	void processCommand(const PipelineBarrierCommand& command) override;
 	void processCommand(const BeginRenderPassCommand& command) override;
 	void processCommand(const ExecuteCommand& command) override;
 	void processCommand(const EndRenderPassCommand& command) override;
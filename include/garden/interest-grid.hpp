@@ -0,0 +1,129 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Uniform spatial grid for network interest management.
+ * 
+ * @details
+ * Interest grid buckets world items into horizontal (XZ) cells once per tick, so that many observers can query
+ * nearby items without repeating the same broadphase work. Replication cost then scales with the number of
+ * visited cells and not with the observer count multiplied by physics queries.
+ */
+
+#pragma once
+#include "garden/defines.hpp"
+#include "math/vector.hpp"
+#include "tsl/robin_map.h"
+
+#include <vector>
+
+namespace garden
+{
+
+using namespace math;
+
+/**
+ * @brief Uniform XZ spatial grid of the interest items.
+ * @details Build it once per tick and query it from multiple threads, queries do not modify the grid.
+ */
+class InterestGrid final
+{
+public:
+	/**
+	 * @brief Interest grid item data.
+	 */
+	struct Item final
+	{
+		float3 position = float3::zero; /**< Item world space position. */
+		uint32 index = 0;                /**< User defined item index. */
+	};
+private:
+	struct Cell final
+	{
+		uint32 offset = 0;
+		uint32 count = 0;
+	};
+
+	std::vector<Item> items;
+	std::vector<std::pair<uint64, uint32>> keys;
+	std::vector<Item> sortedItems;
+	tsl::robin_map<uint64, Cell> cells;
+	float cellSize = 0.0f;
+	float invCellSize = 0.0f;
+public:
+	/**
+	 * @brief Creates a new interest grid instance.
+	 * @param cellSize grid cell size in world units
+	 */
+	InterestGrid(float cellSize = 100.0f) { setCellSize(cellSize); }
+
+	/**
+	 * @brief Returns grid cell size in world units.
+	 */
+	float getCellSize() const noexcept { return cellSize; }
+	/**
+	 * @brief Sets grid cell size in world units.
+	 * @note Takes effect on the next @ref build() call.
+	 * @param cellSize target grid cell size
+	 */
+	void setCellSize(float cellSize) noexcept
+	{
+		GARDEN_ASSERT(cellSize > 0.0f);
+		this->cellSize = cellSize;
+		this->invCellSize = 1.0f / cellSize;
+	}
+
+	/**
+	 * @brief Returns grid item count.
+	 */
+	uint32 getItemCount() const noexcept { return (uint32)sortedItems.size(); }
+	/**
+	 * @brief Returns non empty grid cell count.
+	 */
+	uint32 getCellCount() const noexcept { return (uint32)cells.size(); }
+
+	/**
+	 * @brief Adds a new item to the pending item array.
+	 * 
+	 * @param position item world space position
+	 * @param index user defined item index
+	 */
+	void add(float3 position, uint32 index)
+	{
+		Item item; item.position = position; item.index = index;
+		items.push_back(item);
+	}
+	/**
+	 * @brief Buckets pending items into the grid cells and clears pending item array.
+	 */
+	void build();
+	/**
+	 * @brief Removes all grid items and cells.
+	 */
+	void clear() noexcept;
+
+	/**
+	 * @brief Appends items inside the specified sphere to the array.
+	 * @details Visits only cells overlapping sphere bounds, then tests exact item distance.
+	 * 
+	 * @param center query sphere center position
+	 * @param radius query sphere radius
+	 * @param[out] result target item array
+	 */
+	void query(float3 center, float radius, std::vector<Item>& result) const;
+};
+
+} // namespace garden
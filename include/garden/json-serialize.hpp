@@ -89,10 +89,72 @@ public:
 	string toString() const;
 };
 
+/**
+ * @brief JSON and BSON document deserializer.
+ * 
+ * @details
+ * Parses the document into a flat, pre-order node tape instead of building a DOM tree. String values and object keys
+ * are views into the internal copy of the source buffer (escaped strings are decoded in place), and every node stores
+ * the index of the node after its last descendant, so siblings are skipped without visiting their children. Member
+ * and array element lookups continue from the previously accessed child, which keeps common in-order reads O(1).
+ */
 class JsonDeserializer final : public IDeserializer
 {
-	json data;
-	stack<json*, vector<json*>> hierarchy;
+public:
+	/**
+	 * @brief Document tape node value type.
+	 */
+	enum class NodeType : uint8
+	{
+		Null, Boolean, Integer, Unsigned, Float, String, Array, Object
+	};
+	/**
+	 * @brief Document tape node.
+	 * @details Node "next" is an index of the node after the last descendant.
+	 */
+	struct Node final
+	{
+		union
+		{
+			int64 intValue;
+			uint64 uintValue;
+			double floatValue;
+		};
+		uint32 nameOffset = 0;
+		uint32 nameLength = 0;
+		uint32 length = 0;
+		uint32 next = 0;
+		NodeType type = NodeType::Null;
+
+		Node() noexcept : uintValue(0) { }
+	};
+private:
+	struct Level final
+	{
+		uint32 node = 0;
+		uint32 lastChild = 0;
+		uint32 lastIndex = 0;
+	};
+
+	vector<char> source;
+	vector<Node> nodes;
+	vector<Level> hierarchy;
+	vector<uint32> parseStack;
+
+	void reset();
+	void parseText();
+	void parseBson(uint32 offset, uint32 size, NodeType type, uint32 nameOffset, uint32 nameLength);
+	void writeBson(uint32 nodeIndex, vector<uint8>& bson, string_view skipName) const;
+	string_view getString(const Node& node) const noexcept
+	{
+		return string_view(source.data() + node.uintValue, node.length);
+	}
+	string_view getName(const Node& node) const noexcept
+	{
+		return string_view(source.data() + node.nameOffset, node.nameLength);
+	}
+	const Node* findChild(uint32 nodeIndex, string_view name) const noexcept;
+	const Node* findMember(string_view name) noexcept;
 public:
 	JsonDeserializer();
 	JsonDeserializer(string_view json) { load(json); }
@@ -106,7 +168,9 @@ public:
 
 	void load(string_view json);
 	void load(const vector<uint8>& bson);
+	void load(const uint8* bson, psize size);
 	void load(const fs::path& filePath);
+	void toBson(vector<uint8>& bson, string_view skipName = {}) const;
 
 	bool beginChild(string_view name) override;
 	void endChild() override;
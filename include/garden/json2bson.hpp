@@ -24,7 +24,8 @@ namespace garden
 {
 
 /**
- * @brief JSON to binary JSON converter. 
+ * @brief JSON to binary JSON converter.
+ * @details Scene files are converted to the binary scene format. (see @ref BinaryScene)
  */
 class Json2Bson final
 {
@@ -33,14 +34,18 @@ public:
 	/**
 	 * @brief Converts input JSON file to binary JSON. 
 	 * 
+	 * @details Entity debug names are stripped from the scenes, unless they are kept.
+	 * 
 	 * @param filePath target JSON to convert path
 	 * @param inputPath input JSON directory path
 	 * @param outputPath output BSON directory path
+	 * @param keepDebugNames keep scene entity debug names
 	 * 
 	 * @return Returns false if failed to open JSON file.
 	 * @throw GardenError on JSON conversion error.
 	 */
-	static bool convertFile(const fs::path& filePath, const fs::path& inputPath, const fs::path& outputPath);
+	static bool convertFile(const fs::path& filePath, const fs::path& inputPath, 
+		const fs::path& outputPath, bool keepDebugNames = false);
 	#endif
 };
 
@@ -0,0 +1,118 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Unbounded lock-free multiple producer single consumer queue.
+ */
+
+#pragma once
+#include "garden/defines.hpp"
+#include <atomic>
+
+namespace garden
+{
+
+/**
+ * @brief Unbounded lock-free multiple producer single consumer (MPSC) queue.
+ *
+ * @details
+ * Linked list queue with a stub node (Dmitry Vyukov's MPSC algorithm). Any thread can push items, producers only
+ * do one atomic exchange and never wait for each other. Only one thread at a time is allowed to pop items.
+ *
+ * @tparam T type of the queue item (should be default constructible and movable)
+ */
+template<typename T>
+class MpscQueue final
+{
+	struct Node final
+	{
+		std::atomic<Node*> next = nullptr;
+		T value = {};
+	};
+
+	alignas(64) std::atomic<Node*> head = nullptr;
+	alignas(64) Node* tail = nullptr;
+public:
+	/**
+	 * @brief Creates a new empty MPSC queue.
+	 */
+	MpscQueue()
+	{
+		tail = new Node();
+		head.store(tail, std::memory_order_relaxed);
+	}
+	/**
+	 * @brief Destroys MPSC queue and all remaining items.
+	 */
+	~MpscQueue()
+	{
+		while (tail)
+		{
+			auto next = tail->next.load(std::memory_order_relaxed);
+			delete tail;
+			tail = next;
+		}
+	}
+
+	MpscQueue(const MpscQueue&) = delete;
+	MpscQueue& operator=(const MpscQueue&) = delete;
+
+	/**
+	 * @brief Pushes a new item to the queue end.
+	 * @note Can be called from any thread.
+	 * @param[in] value target item value
+	 */
+	void push(T&& value)
+	{
+		auto node = new Node();
+		node->value = std::move(value);
+		auto prevNode = head.exchange(node, std::memory_order_acq_rel);
+		prevNode->next.store(node, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Returns queue front item if it is not empty, otherwise null.
+	 * @warning Only the consumer thread can call this function.
+	 */
+	T* peek() noexcept
+	{
+		auto next = tail->next.load(std::memory_order_acquire);
+		return next ? &next->value : nullptr;
+	}
+	/**
+	 * @brief Pops queue front item.
+	 * @return True if item has been popped, otherwise false if queue is empty.
+	 * @warning Only the consumer thread can call this function.
+	 * @param[out] value popped item value
+	 */
+	bool tryPop(T& value)
+	{
+		auto next = tail->next.load(std::memory_order_acquire);
+		if (!next)
+			return false;
+
+		value = std::move(next->value);
+		delete tail;
+		tail = next; // Note: Popped node becomes the new stub node.
+		return true;
+	}
+	/**
+	 * @brief Returns true if queue has no items.
+	 * @note Result can be outdated if other threads are pushing items.
+	 */
+	bool isEmpty() const noexcept { return !tail->next.load(std::memory_order_acquire); }
+};
+
+} // namespace garden
@@ -26,6 +26,29 @@
 namespace garden
 {
 
+/**
+ * @brief Built-in network message identifiers.
+ * @details Other message IDs are assigned by the server and sent to the client on the session creation.
+ */
+struct NetMessageID final
+{
+	static constexpr uint16 enc = 0;
+	static constexpr uint16 ping = 1;
+	static constexpr uint16 pong = 2;
+	static constexpr uint16 types = 3;
+	static constexpr uint16 reservedCount = 4;
+	static constexpr uint16 max = 0x7FFF;      /**< Maximum ID encodable in the 2 byte header. */
+	static constexpr uint16 invalid = UINT16_MAX;
+};
+
+/**
+ * @brief Built-in network message type strings.
+ */
+static constexpr string_view netReservedMessageTypes[NetMessageID::reservedCount] =
+{
+	"enc", "ping", "pong", "types"
+};
+
 /**
  * @brief Network stream input data container.
  */
@@ -53,6 +76,28 @@ public:
 	 */
 	StreamInput() noexcept = default;
 
+	/**
+	 * @brief Reads message ID header from the stream message and advances offset.
+	 * @details IDs below 128 take 1 byte, other IDs take 2 bytes.
+	 * @return True if no more data to read, otherwise false.
+	 * @param[out] messageID reference to the message identifier
+	 */
+	bool readMessageID(uint16& messageID) noexcept
+	{
+		uint8 high, low;
+		if (nets::StreamMessage::read(high))
+			return true;
+		if (!(high & 0x80u))
+		{
+			messageID = high;
+			return false;
+		}
+		if (nets::StreamMessage::read(low))
+			return true;
+		messageID = (uint16)(((high & 0x7Fu) << 8u) | low);
+		return false;
+	}
+
 	/**
 	 * @brief Reads 32-bit uint 2 component vector from the stream message and advances offset.
 	 * @return True if no more data to read, otherwise false.
@@ -155,48 +200,57 @@ class StreamOutput : public nets::OutStreamMessage
 public:
 	using nets::OutStreamMessage::write;
 protected:
-	inline static psize fullSize(string_view type, psize messageSize) noexcept
+	inline static psize fullSize(uint16 messageID, psize messageSize) noexcept
 	{
-		return messageSize + type.size() + sizeof(uint8) * 2;
+		return messageSize + getMessageIdSize(messageID);
 	}
-	inline void writeHeader(string_view type, bool isSystem) noexcept
+	inline void writeHeader(uint16 messageID) noexcept
 	{
-		GARDEN_ASSERT(!type.empty());
-		GARDEN_ASSERT(type.size() <= UINT8_MAX);
-		auto result = write(isSystem);
-		result |= write(type, sizeof(uint8));
+		GARDEN_ASSERT(messageID <= NetMessageID::max);
+		bool result;
+		if (messageID < 0x80u)
+		{
+			result = write((uint8)messageID);
+		}
+		else
+		{
+			result = write((uint8)((messageID >> 8u) | 0x80u));
+			result |= write((uint8)(messageID & 0xFFu));
+		}
 		GARDEN_ASSERT_MSG(!result, "Stream message buffer is too small");
 	}
 public:
-	static constexpr uint8 baseTotalSize = maxLengthSize + 3; /**< 3 = type('c') + typeSize + isSystem */
+	static constexpr uint8 baseTotalSize = maxLengthSize + 2; /**< 2 = maximum message ID size */
+
+	/**
+	 * @brief Returns message ID header size in bytes.
+	 * @param messageID target message identifier
+	 */
+	static constexpr uint8 getMessageIdSize(uint16 messageID) noexcept { return messageID < 0x80u ? 1 : 2; }
 
 	/**
 	 * @brief Creates a new stream output container.
 	 *
-	 * @param type message type string
+	 * @param messageID message type identifier
 	 * @param[in,out] buffer message data buffer
 	 * @param bufferSize message buffer size in bytes
 	 * @param messageSize message size in bytes
 	 * @param lengthSize message header length size in bytes
-	 * @param isSystem is this system message
 	 */
-	StreamOutput(string_view type, uint8* buffer, psize bufferSize, 
-		psize messageSize, uint8 lengthSize, bool isSystem = false) noexcept :
-		nets::OutStreamMessage(buffer, bufferSize, fullSize(type, messageSize), lengthSize)
-	{ writeHeader(type, isSystem); }
+	StreamOutput(uint16 messageID, uint8* buffer, psize bufferSize, psize messageSize, uint8 lengthSize) noexcept :
+		nets::OutStreamMessage(buffer, bufferSize, fullSize(messageID, messageSize), lengthSize)
+	{ writeHeader(messageID); }
 	/**
 	 * @brief Creates a new stream output container.
 	 *
-	 * @param type message type string
+	 * @param messageID message type identifier
 	 * @param[in,out] buffer message data buffer
 	 * @param messageSize message size in bytes
 	 * @param lengthSize message header length size in bytes
-	 * @param isSystem is this system message
 	 */
-	StreamOutput(string_view type, vector<uint8>& buffer,
-		psize messageSize, uint8 lengthSize, bool isSystem = false) noexcept :
-		nets::OutStreamMessage(buffer, fullSize(type, messageSize), lengthSize)
-	{ writeHeader(type, isSystem); }
+	StreamOutput(uint16 messageID, vector<uint8>& buffer, psize messageSize, uint8 lengthSize) noexcept :
+		nets::OutStreamMessage(buffer, fullSize(messageID, messageSize), lengthSize)
+	{ writeHeader(messageID); }
 	/**
 	 * @brief Creates a new empty stream output container.
 	 */
@@ -306,13 +360,12 @@ public:
 	/**
 	 * @brief Creates a new stream output buffer container.
 	 *
-	 * @param type message type string
+	 * @param messageID message type identifier
 	 * @param messageSize message size in bytes
 	 * @param lengthSize message header length size in bytes
-	 * @param isSystem is this system message
 	 */
-	StreamOutputBuffer(string_view type, psize messageSize, uint8 lengthSize, bool isSystem = false) noexcept :
-		StreamOutput(type, buffer, S, messageSize, lengthSize, isSystem) { }
+	StreamOutputBuffer(uint16 messageID, psize messageSize, uint8 lengthSize) noexcept :
+		StreamOutput(messageID, buffer, S, messageSize, lengthSize) { }
 };
 
 /***********************************************************************************************************************
@@ -405,11 +458,19 @@ struct ClientSession
  */
 class INetworkable
 {
+	uint16 messageID = NetMessageID::invalid;
+	friend class ServerNetworkSystem;
+	friend class ClientNetworkSystem;
 public:
 	/**
 	 * @brief Returns system message type string.
 	 */
 	virtual string_view getMessageType() = 0;
+	/**
+	 * @brief Returns system message type identifier.
+	 * @details Assigned by the server, client receives it on the session creation.
+	 */
+	uint16 getMessageID() const noexcept { return messageID; }
 
 	/**
 	 * @brief On client message receive by the server. (Client->Server)
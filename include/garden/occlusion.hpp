@@ -0,0 +1,126 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Low resolution CPU occlusion depth buffer.
+ *
+ * @details
+ * Occluder boxes are rasterized on the CPU into a small reverse Z depth buffer, then bounding boxes of the
+ * other meshes are tested against it before recording any draw commands. Rasterization is conservative,
+ * each occluder writes only pixels fully covered by its triangles and only the farthest depth inside the
+ * pixel, so a visible mesh is never reported as occluded.
+ */
+
+#pragma once
+#include "garden/defines.hpp"
+#include "math/aabb.hpp"
+#include "math/matrix/transform.hpp"
+
+#include <vector>
+
+namespace garden
+{
+
+using namespace math;
+
+/**
+ * @brief Low resolution CPU occlusion depth buffer. (Reverse Z)
+ *
+ * @details
+ * Buffer rows are split into bands, so that each band can be cleared and rasterized by a separate thread
+ * without any synchronization. Visibility queries do not modify the buffer and can run from multiple threads.
+ */
+class OcclusionBuffer final
+{
+public:
+	/**
+	 * @brief Projected occluder box data. (Screen space)
+	 */
+	struct Box final
+	{
+		float3 vertices[8]; /**< Box corners. (X and Y in pixels, Z is depth) */
+		float minY = 0.0f;  /**< Box minimum screen space Y coordinate. */
+		float maxY = 0.0f;  /**< Box maximum screen space Y coordinate. */
+	};
+
+	/**
+	 * @brief Buffer row count rasterized by one band task.
+	 */
+	static constexpr uint32 bandHeight = 8;
+private:
+	std::vector<float> depthData;
+	uint2 size = uint2::zero;
+public:
+	/**
+	 * @brief Creates a new occlusion buffer instance.
+	 * @param size target buffer size in pixels
+	 */
+	OcclusionBuffer(uint2 size = uint2(256, 128)) { setSize(size); }
+
+	/**
+	 * @brief Returns occlusion buffer size in pixels.
+	 */
+	uint2 getSize() const noexcept { return size; }
+	/**
+	 * @brief Sets occlusion buffer size in pixels.
+	 * @note Clears buffer depth data.
+	 * @param size target buffer size
+	 */
+	void setSize(uint2 size);
+
+	/**
+	 * @brief Returns occlusion buffer band count.
+	 */
+	uint32 getBandCount() const noexcept { return (size.y + bandHeight - 1) / bandHeight; }
+	/**
+	 * @brief Returns occlusion buffer depth data. (Row major)
+	 */
+	const float* getDepthData() const noexcept { return depthData.data(); }
+
+	/**
+	 * @brief Clears specified buffer band to the far depth.
+	 * @param bandIndex target band index
+	 */
+	void clear(uint32 bandIndex) noexcept;
+	/**
+	 * @brief Projects occluder box to the buffer screen space.
+	 * @return True on success, otherwise false if box crosses camera near plane.
+	 *
+	 * @param[in] mvp occluder model view projection matrix
+	 * @param[in] aabb occluder local space bounding box
+	 * @param[out] box projected occluder box
+	 */
+	bool projectBox(const f32x4x4& mvp, const Aabb& aabb, Box& box) const noexcept;
+	/**
+	 * @brief Rasterizes projected occluder box into the specified buffer band.
+	 * @warning Only one thread at a time can rasterize the same band!
+	 *
+	 * @param[in] box target projected occluder box
+	 * @param bandIndex target band index
+	 */
+	void rasterizeBox(const Box& box, uint32 bandIndex) noexcept;
+
+	/**
+	 * @brief Returns true if bounding box is not fully hidden behind rasterized occluders.
+	 * @details Boxes crossing camera near plane or fully outside the buffer are always treated as visible.
+	 *
+	 * @param[in] viewProj camera view projection matrix
+	 * @param center world space bounding box center
+	 * @param extent world space bounding box half extent
+	 */
+	bool isVisible(const f32x4x4& viewProj, f32x4 center, f32x4 extent) const noexcept;
+};
+
+} // namespace garden
@@ -36,6 +36,8 @@ namespace garden
 
 using namespace ecsm;
 
+struct BinarySceneRecord;
+
 /**
  * @brief Base serializer interface.
  */
@@ -191,6 +193,20 @@ public:
 	 * @param component system component view
 	 */
 	virtual void deserialize(IDeserializer& deserializer, View<Component> component) { }
+	/**
+	 * @brief Deserializes specified system component from the fixed layout binary scene record.
+	 * @details Called instead of the deserialize() for binary scene blocks with a non generic record type.
+	 * 
+	 * @param[in] record target binary scene record
+	 * @param component system component view
+	 */
+	virtual void deserializeRecord(const BinarySceneRecord& record, View<Component> component) { }
+	/**
+	 * @brief Can system components be deserialized on a thread pool worker.
+	 * @details Binary scene loader deserializes such systems in parallel with each other.
+	 *          System deserialize() should only modify its own components and internal state.
+	 */
+	virtual bool isDeserializeAsync() const noexcept { return false; }
 	/**
 	 * @brief Finalizes system after components deserialization.
 	 * @param[in,out] deserializer target deserializer instance
@@ -34,13 +34,16 @@ struct AnimationComponent final : public Component
 {
 	using Animations = tsl::robin_map<string, Ref<Animation>, SvHash, SvEqual>;
 
-	string active;               /**< Active animation path */
 	float frame = 0.0f;          /**< Current animation frame */
 	bool isPlaying = true;       /**< Is animation playing */
 	bool randomizeStart = false; /**< Set random frame on copy/deserialization */
 private:
-	uint16 _alignment = 0;
+	bool isActiveDirty = true;
+	uint8 transformIndex = UINT8_MAX;
 	Animations animations;
+	string active;
+	vector<uint8> trackIndices;
+	ID<Animation> activeAnimation = {};
 
 	friend class AnimationSystem;
 public:
@@ -54,11 +57,33 @@ public:
 	 */
 	bool hasAnimation(string_view path) const noexcept { return animations.find(path) != animations.end(); }
 
+	/**
+	 * @brief Returns active animation path.
+	 */
+	const string& getActive() const noexcept { return active; }
+	/**
+	 * @brief Sets active animation path.
+	 * @details Active animation instance is searched only once after the path change.
+	 * @param[in] path target animation path or empty
+	 */
+	void setActive(string_view path)
+	{
+		if (active == path)
+			return;
+		active = path;
+		isActiveDirty = true;
+	}
+
 	/**
 	 * @brief Returns active animation loop state.
 	 * @return True if active animation is not empty and found.
 	 */
-	bool getActiveLooped(bool& isLooped) const;
+	bool getActiveLooped(bool& isLooped);
+	/**
+	 * @brief Returns active animation instance, or null if not found.
+	 * @details Search result is cached until the active path or animations map is changed.
+	 */
+	ID<Animation> getActiveAnimation();
 
 	/**
 	 * @brief Adds a new animation to the map.
@@ -70,6 +95,7 @@ public:
 	{
 		GARDEN_ASSERT(!path.empty());
 		GARDEN_ASSERT_MSG(animation, "Assert " + path);
+		isActiveDirty = true;
 		return animations.emplace(std::move(path), std::move(animation));
 	}
 
@@ -77,17 +103,17 @@ public:
 	 * @brief Removes animation from the map.
 	 * @param path target animation path
 	 */
-	psize eraseAnimation(string_view path) noexcept { return animations.erase(path); }
+	psize eraseAnimation(string_view path) noexcept { isActiveDirty = true; return animations.erase(path); }
 	/**
 	 * @brief Removes animation from the map.
 	 * @param i target animation iterator
 	 */
-	auto eraseAnimation(Animations::const_iterator i) noexcept { return animations.erase(i); }
+	auto eraseAnimation(Animations::const_iterator i) noexcept { isActiveDirty = true; return animations.erase(i); }
 
 	/**
 	 * @brief Clears animations map.
 	 */
-	void clearAnimations() noexcept { animations.clear(); }
+	void clearAnimations() noexcept { isActiveDirty = true; animations.clear(); }
 };
 
 /***********************************************************************************************************************
@@ -20,6 +20,7 @@
 #pragma once
 #include "garden/system/input.hpp"
 #include "garden/graphics/constants.hpp"
+#include "garden/graphics/api.hpp"
 #include "garden/graphics/pipeline/compute.hpp"
 #include "garden/graphics/pipeline/graphics.hpp"
 #include "garden/graphics/pipeline/ray-tracing.hpp"
@@ -114,11 +115,12 @@ class GraphicsSystem final : public System, public Singleton<GraphicsSystem>
 	 * @param isFullscreen create a fullscreen window
 	 * @param isDecorated decorate window with top bar and borders
 	 * @param useAsyncRecording use multithreaded render commands recording
+	 * @param backendType graphics API backend type (Null API runs without GPU)
 	 * @param setSingleton set system singleton instance
 	 */
 	GraphicsSystem(uint2 windowSize = InputSystem::defaultWindowSize, 
-		bool isFullscreen = !GARDEN_DEBUG & !GARDEN_OS_LINUX, bool isDecorated = true,
-		bool useAsyncRecording = true, bool setSingleton = true);
+		bool isFullscreen = !GARDEN_DEBUG & !GARDEN_OS_LINUX, bool isDecorated = true, bool useAsyncRecording = true, 
+		GraphicsBackend backendType = GraphicsBackend::VulkanAPI, bool setSingleton = true);
 
 	void preInit();
 	void preDeinit();
@@ -95,6 +95,7 @@ private:
 
 	void serialize(ISerializer& serializer, const View<Component> component) override;
 	void deserialize(IDeserializer& deserializer, View<Component> component) override;
+	bool isDeserializeAsync() const noexcept override { return true; }
 	
 	friend class ecsm::Manager;
 	friend struct LinkComponent;
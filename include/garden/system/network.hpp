@@ -90,6 +90,7 @@ class NetworkSystem final : public ComponentSystem<NetworkComponent, false>,
 	
 	void serialize(ISerializer& serializer, const View<Component> component) override;
 	void deserialize(IDeserializer& deserializer, View<Component> component) override;
+	bool isDeserializeAsync() const noexcept override { return true; }
 
 	friend class ecsm::Manager;
 	friend class NetworkComponent;
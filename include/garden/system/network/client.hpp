@@ -43,10 +43,18 @@ public:
 	 */
 	using OnReceive = std::function<int(StreamInput message, bool isDatagram)>;
 private:
-	tsl::robin_map<string, INetworkable*, SvHash, SvEqual> networkables;
-	tsl::robin_map<string, OnReceive, SvHash, SvEqual> listeners;
+	struct Receiver final
+	{
+		INetworkable* networkable = nullptr;
+		OnReceive onReceive = nullptr;
+	};
+
+	tsl::robin_map<string, Receiver, SvHash, SvEqual> localReceivers;
+	tsl::robin_map<string, uint16, SvHash, SvEqual> messageIDs;
+	vector<Receiver> receivers;
 	vector<uint8> datagramBuffer;
 	mutex datagramLocker;
+	mutable mutex messageLocker;
 	void* cipher = nullptr;
 	uint8* encKey = nullptr;
 	uint8* decKey = nullptr;
@@ -87,7 +95,10 @@ private:
 	int onDatagramReceive(const uint8_t* receiveBuffer, size_t byteCount) override;
 	static int onMessageReceive(::StreamMessage message, void* argument);
 
+	void resetMessageTypes();
+	void addMessageType(string_view messageType, const Receiver& receiver);
 	int onEncResponse(StreamInput response, bool isDatagram);
+	int onTypesResponse(StreamInput response, bool isDatagram);
 	friend class ecsm::Manager;
 public:
 	/**
@@ -101,19 +112,26 @@ public:
 	volatile bool isAuthorized = false;
 
 	/**
-	 * @brief Adds network message listener to the map.
+	 * @brief Adds network message listener to the message table.
+	 * @details Listener is bound to the message ID received from the server on the session creation.
 	 * 
 	 * @param messageType target message type string
 	 * @param[in] onReceive on message receive function
+	 * 
+	 * @throw GardenError if message listener is already registered.
 	 */
 	void addListener(string_view messageType, const OnReceive& onReceive)
 	{
-		GARDEN_ASSERT(!messageType.empty());
 		GARDEN_ASSERT(onReceive);
-
-		if (!listeners.emplace(messageType, onReceive).second)
-			throw GardenError("Client message listener already registered.");
+		Receiver receiver; receiver.onReceive = onReceive;
+		addMessageType(messageType, receiver);
 	}
+	/**
+	 * @brief Returns server message type identifier, or @ref NetMessageID::invalid if not received yet.
+	 * @note Cache returned value until the next connection to reduce message type string hashing.
+	 * @param messageType target message type string
+	 */
+	uint16 getMessageID(string_view messageType) const;
 
 	/**
 	 * @brief Returns client stream message length size in bytes.
@@ -72,6 +72,7 @@ private:
 
 	int onEncRequest(ClientSession* session, StreamInput request);
 	int onPingRequest(ClientSession* session, StreamInput request);
+	NetsResult sendTypesMessage(ClientSession* clientSession);
 
 	friend class garden::ServerNetworkSystem;
 };
@@ -92,8 +93,15 @@ public:
 	 */
 	using OnReceive = std::function<int(ClientSession*, StreamInput)>;
 private:
-	tsl::robin_map<string, INetworkable*, SvHash, SvEqual> networkables;
-	tsl::robin_map<string, OnReceive, SvHash, SvEqual> listeners;
+	struct Receiver final
+	{
+		INetworkable* networkable = nullptr;
+		OnReceive onReceive = nullptr;
+	};
+
+	tsl::robin_map<string, uint16, SvHash, SvEqual> messageIDs;
+	vector<Receiver> receivers;
+	vector<string> messageTypes;
 	StreamServerHandle* streamServer = nullptr;
 
 	/**
@@ -106,6 +114,8 @@ private:
 	void preDeinit();
 	void update();
 
+	uint16 addMessageType(string_view messageType, const Receiver& receiver);
+
 	friend class ecsm::Manager;
 	friend class garden::StreamServerHandle;
 public:
@@ -126,18 +136,31 @@ public:
 	std::function<int(ClientSession*)> onSessionUpdate = nullptr;
 
 	/**
-	 * @brief Adds network message listener to the map.
+	 * @brief Adds network message listener to the message table.
+	 * @details Assigns a new message ID which is sent to the clients on the session creation.
+	 * @warning Listeners should be added before the server start!
 	 * 
 	 * @param messageType target message type string
 	 * @param[in] onReceive on message receive function
+	 * 
+	 * @return Assigned message type identifier.
+	 * @throw GardenError if message listener is already registered.
 	 */
-	void addListener(string_view messageType, const OnReceive& onReceive)
+	uint16 addListener(string_view messageType, const OnReceive& onReceive)
 	{
-		GARDEN_ASSERT(!messageType.empty());
 		GARDEN_ASSERT(onReceive);
-
-		if (!listeners.emplace(messageType, onReceive).second)
-			throw GardenError("Server message listener already registered.");
+		Receiver receiver; receiver.onReceive = onReceive;
+		return addMessageType(messageType, receiver);
+	}
+	/**
+	 * @brief Returns message type identifier, or @ref NetMessageID::invalid if not registered.
+	 * @note Cache returned value, it does not change while the server is running.
+	 * @param messageType target message type string
+	 */
+	uint16 getMessageID(string_view messageType) const noexcept
+	{
+		auto searchResult = messageIDs.find(messageType);
+		return searchResult != messageIDs.end() ? searchResult->second : NetMessageID::invalid;
 	}
 
 	/**
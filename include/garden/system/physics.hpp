@@ -22,6 +22,7 @@
 #include "garden/hash.hpp"
 #include "garden/animate.hpp"
 #include "garden/network.hpp"
+#include "garden/interest-grid.hpp"
 
 #include "math/flags.hpp"
 #include "math/sphere.hpp"
@@ -706,7 +707,109 @@ public:
 		float3 linearVelocity;
 		float3 angularVelocity;
 	};
+	/**
+	 * @brief Quantized network rigidbody state. (Delta compression baseline)
+	 * @details Position is stored as a world cell index and a 16-bit offset inside that cell.
+	 */
+	struct NetBodyState final
+	{
+		int3 cell = int3::zero;
+		uint16 offset[3] = {};
+		uint16 _alignment = 0;
+		uint32 rotationData = 0;
+		uint32 linearData = 0;
+		uint32 angularData = 0;
+		float linearMagnitude = 0.0f;
+		float angularMagnitude = 0.0f;
+	};
+
 	static constexpr const char* messageType = "r";
+	static constexpr float netCellSize = 64.0f;        /**< Network position quantization cell size. */
+	static constexpr uint32 netSnapshotHistory = 64;   /**< Server sent snapshot history size per client. */
+	static constexpr uint32 netBodyHistory = 32;       /**< Client received body state history size. */
+	/**
+	 * @brief Maximum baseline snapshot age for delta encoding.
+	 * @details Older client history entries can be overwritten, so full body state is sent instead.
+	 */
+	static constexpr uint32 netMaxBaselineAge = netBodyHistory - 1;
+
+	struct NetBaseline final
+	{
+		NetBodyState state = {};
+		uint32 snapshotID = 0;
+		uint32 interestTick = 0;
+	};
+	struct NetSnapshot final
+	{
+		vector<pair<uint32, NetBodyState>> bodies;
+		uint32 snapshotID = 0;
+	};
+	struct NetInterestBody final
+	{
+		NetBodyState state = {};
+		float3 position = float3::zero;
+		float speed = 0.0f;
+		uint32 entityUID = 0;
+	};
+	struct NetClientState final
+	{
+		tsl::robin_map<uint32, NetBaseline> baselines;
+		vector<NetSnapshot> snapshots;
+		uint32 nextSnapshotID = 1;
+		uint32 interestTick = 0;
+		bool isVisited = false;
+	};
+	struct NetBodyHistory final
+	{
+		NetBodyState states[netBodyHistory];
+		uint32 snapshotIDs[netBodyHistory] = {};
+		uint32 lastSnapshotID = 0;
+	};
+	/**
+	 * @brief Client side received rigidbody snapshots state.
+	 */
+	struct NetReceiver final
+	{
+		tsl::robin_map<uint32, NetBodyHistory> histories;
+		tsl::robin_map<uint32, NetRigidbody> rigidbodies;
+		vector<uint32> acks;
+		uint32 lastSnapshotID = 0;
+		uint32 prunedSnapshotID = 0;
+	};
+
+	#if GARDEN_DEBUG || GARDEN_EDITOR
+	/**
+	 * @brief Network replication loopback run properties.
+	 */
+	struct NetLoopbackProperties final
+	{
+		uint32 bodyCount = 256;    /**< Simulated replicated body count. */
+		uint32 tickCount = 600;    /**< Simulated server tick count. */
+		uint32 latencyTicks = 3;   /**< One way datagram delivery latency in ticks. */
+		uint32 jitterTicks = 2;    /**< Random extra datagram latency in ticks. (Reorders datagrams) */
+		uint32 seed = 1;           /**< Channel and body motion random generator seed. */
+		float lossRate = 0.05f;    /**< Datagram drop probability in both directions. */
+		float restRate = 0.5f;     /**< Fraction of simulated bodies at rest. */
+	};
+	/**
+	 * @brief Network replication loopback run results.
+	 */
+	struct NetLoopbackStats final
+	{
+		uint64 sentBytes = 0;       /**< Server to client datagram byte count. */
+		uint64 fullStateBytes = 0;  /**< Byte count of sending full state of all visible bodies every tick. */
+		uint32 sentDatagrams = 0;   /**< Server to client datagram count. */
+		uint32 lostDatagrams = 0;   /**< Dropped datagram count in both directions. */
+		uint32 ackCount = 0;        /**< Server received snapshot acknowledgement count. */
+		uint32 badDataCount = 0;    /**< Client rejected snapshot count. */
+		uint32 reorderedCount = 0;  /**< Server datagrams received after a newer snapshot. */
+		uint32 staleCount = 0;      /**< Pending bodies older than their newest received state. (Should be 0) */
+		uint32 mismatchCount = 0;   /**< Visible bodies with different client state after the channel drained. */
+		uint32 baselineCount = 0;   /**< Server baseline count left for the client after the run. */
+		uint32 historyCount = 0;    /**< Client body history count left after the run. */
+		uint32 visibleCount = 0;    /**< Bodies left inside the client view after the run. */
+	};
+	#endif
 private:
 	struct EntityConstraint final
 	{
@@ -728,7 +831,13 @@ private:
 	set<ID<Entity>> serializedConstraints;
 	tsl::robin_map<uint64, ID<Entity>> deserializedEntities;
 	vector<EntityConstraint> deserializedConstraints;
-	tsl::robin_map<uint32, NetRigidbody> netRigidbodies;
+	vector<ID<Entity>> batchedBodies, batchedActiveBodies;
+	tsl::robin_map<uint32, NetClientState> netClients;
+	vector<NetClientState*> netClientStates;
+	vector<NetInterestBody> netInterestBodies;
+	InterestGrid interestGrid;
+	vector<pair<uint32, uint32>> netServerAcks, netServerAckCache;
+	NetReceiver netReceiver;
 	mutex bodyEventLocker, netRigidbodyLocker;
 	string valueStringCache;
 	void* tempAllocator = nullptr;
@@ -746,6 +855,7 @@ private:
 	ID<Entity> thisBody = {}, otherBody = {};
 	float deltaTimeAccum = 0.0f;
 	uint32 cascadeLagCount = 0;
+	bool isBatchingBodies = false;
 
 	#if GARDEN_DEBUG
 	set<uint64> serializedEntities;
@@ -767,6 +877,7 @@ private:
 	void processSimulate();
 	void interpolateResult(float t);
 	void flushNetRigidbodies();
+	void processServerAcks();
 	void sendServerMessages();
 
 	void resetComponent(View<Component> component, bool full) override;
@@ -779,6 +890,8 @@ private:
 	void postSerialize(ISerializer& serializer) override;
 	ID<Shape> deserializeDecoratedShape(IDeserializer& deserializer, string& valueStringCache);
 	void deserialize(IDeserializer& deserializer, View<Component> component) override;
+	void deserializeRecord(const BinarySceneRecord& record, View<Component> component) override;
+	bool isDeserializeAsync() const noexcept override { return true; }
 	void postDeserialize(IDeserializer& deserializer) override;
 
 	string_view getMessageType() override;
@@ -793,6 +906,9 @@ public:
 	/******************************************************************************************************************/
 	float cascadeLagThreshold = 0.1f;  /**< Underperforming simulation frames threshold to try recover performance. */
 	float networkViewRadius = 1000.0f; /**< Network world bodies synchronization radius. */
+	float networkViewMargin = 50.0f;   /**< Network view radius hysteresis for already replicated bodies. */
+	float networkCellSize = 100.0f;    /**< Network interest grid cell size. */
+	uint32 networkBandwidth = 8192;    /**< Network per client replication budget in bytes per simulation tick. */
 	int32 collisionSteps = 1;          /**< Collision step count during simulation step. */
 	uint16 simulationRate = 60;        /**< Simulation update count per second. */
 	
@@ -1053,6 +1169,20 @@ public:
 	 */
 	void setWorldTransformRecursive(ID<Entity> entity, bool activate = true);
 
+	/**
+	 * @brief Begins rigidbody simulation batch.
+	 * 
+	 * @details
+	 * Rigidbodies duplicated inside the batch are not added to the simulation one by one, instead they are
+	 * added at once by the @ref endSimulationBatch() call using a single broad phase update. Useful when
+	 * spawning a lot of the rigidbodies during one frame.
+	 */
+	void beginSimulationBatch();
+	/**
+	 * @brief Adds all batched rigidbodies to the simulation.
+	 */
+	void endSimulationBatch();
+
 	/**
 	 * @brief Enabled collision between two rigidbody layers.
 	 */
@@ -1078,6 +1208,16 @@ public:
 	void setBroadPhaseLayerName(uint8 broadPhaseLayer, const string& debugName);
 	#endif
 
+	#if GARDEN_DEBUG || GARDEN_EDITOR
+	/**
+	 * @brief Replicates simulated bodies from server to client through an in-process lossy channel. (Debug only)
+	 * @details Runs the same snapshot encoding, decoding and acknowledgement code as the real network path.
+	 *          Half of the bodies leave the client view in the middle of the run to check state pruning.
+	 * @param[in] properties target loopback run properties
+	 */
+	NetLoopbackStats runNetLoopback(const NetLoopbackProperties& properties);
+	#endif
+
 	/**
 	 * @brief Returns physics system internal instance.
 	 * @warning Use only if you know what you are doing!
@@ -19,6 +19,8 @@
 
 #pragma once
 #include "garden/system/graphics.hpp"
+#include "garden/thread-pool.hpp"
+#include "garden/occlusion.hpp"
 #include "math/aabb.hpp"
 
 namespace garden
@@ -46,11 +48,12 @@ struct MeshRenderComponent : public Component
 {
 protected:
 	uint32 reserved0 = 0;
-	uint32 reserved1 = 0;
-	uint16 reserved2 = 0;
+	uint8 reserved1 = 0;
 public:
 	volatile bool isEnabled = true;  /**< Is mesh should be rendered. */
 	volatile bool isVisible = false; /**< Is mesh visible on camera after last frustum culling. */
+	bool isOccluder = false;         /**< Is mesh AABB used as a CPU occluder. (Only for solid box like meshes) */
+	volatile uint32 viewMask = 0;    /**< Mesh visibility bitmask of each view. (Camera, shadow passes) */
 	Aabb aabb = Aabb::one;           /**< Mesh axis aligned bounding box. */
 };
 
@@ -132,18 +135,22 @@ public:
 
 	/**
 	 * @brief Returns ready for rendering mesh instance count. (If mesh resources loaded)
+	 * @details Called once per frame for a mesh that passed frustum culling in any of the views.
 	 * @warning This function is called asynchronously from the thread pool!
 	 *
 	 * @param meshRenderView target mesh render view
 	 * @param[in] cameraPosition camera world position for model matrix
-	 * @param[in] frustum camera frustum planes for mesh culling
 	 * @param[in,out] model mesh model matrix (position, scale, rotation, etc.)
 	 */
 	virtual uint32 getReadyMeshesAsync(MeshRenderComponent* meshRenderView, 
-		const f32x4& cameraPosition, const Frustum& frustum, f32x4x4& model)
-	{
-		return isBehindFrustum(frustum, meshRenderView->aabb, model) ? 0 : 1;
-	}
+		const f32x4& cameraPosition, f32x4x4& model) { return 1; }
+	/**
+	 * @brief Returns mesh render state key. (Pipeline, material, descriptor set, etc.)
+	 * @details Unsorted meshes are grouped by this key before depth to reduce state changes when drawing.
+	 * @warning This function is called asynchronously from the thread pool!
+	 * @param meshRenderView target mesh render view
+	 */
+	virtual uint32 getMeshStateAsync(MeshRenderComponent* meshRenderView) const { return 0; }
 };
 
 /***********************************************************************************************************************
@@ -188,42 +195,145 @@ protected:
 class MeshRenderSystem final : public System, public Singleton<MeshRenderSystem>
 {
 public:
+	/**
+	 * @brief Maximum culled view count per frame. (Main camera and all shadow passes)
+	 */
+	static constexpr uint8 maxViewCount = 32;
+
 	struct UnsortedMesh final
 	{
 		psize componentOffset = 0;
 		float4x3 bakedModel = float4x3::zero;
-		float distanceSq = 0.0f;
-		bool operator<(const UnsortedMesh& m) const noexcept { return distanceSq < m.distanceSq; }
+		uint64 sortKey = 0; /**< Render state and quantized front-to-back depth. */
+		bool operator<(const UnsortedMesh& m) const noexcept { return sortKey < m.sortKey; }
 	};
 	struct SortedMesh final
 	{
 		psize componentOffset = 0;
 		float4x3 bakedModel = float4x3::zero;
-		float distanceSq = 0.0f;
+		uint64 sortKey = 0; /**< Quantized back-to-front depth. */
 		uint32 bufferIndex = 0;
-		bool operator<(const SortedMesh& m) const noexcept { return distanceSq > m.distanceSq; }
+		bool operator<(const SortedMesh& m) const noexcept { return sortKey < m.sortKey; }
 	};
 
-	struct MeshBuffer
+	/**
+	 * @brief Culled view data. (Main camera or shadow pass)
+	 * @details First view is always the main camera, the following ones are shadow passes.
+	 */
+	struct MeshView final
+	{
+		f32x4x4 viewProj = f32x4x4::identity;
+		f32x4 cameraOffset = f32x4::zero;
+		f32x4 planes[6];      /**< Frustum planes. (Camera relative space) */
+		f32x4 worldPlanes[6]; /**< Frustum planes. (World space) */
+		IShadowMeshRenderSystem* shadowSystem = nullptr;
+		vector<SortedMesh> transMeshes;
+		vector<SortedMesh> transTempMeshes;
+		int8 shadowPass = -1;
+		alignas(64) atomic<uint32> transDrawIndex = 0;
+	};
+	struct DrawCounter final
 	{
-		IMeshRenderSystem* meshSystem = nullptr;
 		atomic<uint32> drawCount = 0;
 		alignas(64) atomic<uint32> instanceCount = 0;
 	};
+	/**
+	 * @brief Packed mesh culling data. (Structure of arrays)
+	 * 
+	 * @details
+	 * All arrays are indexed the same way as mesh system component pool items and persist between frames. 
+	 * Bounds are updated only when the mesh entity, its AABB or the transform model stamp is changed.
+	 */
+	struct CullingData final
+	{
+		vector<float> centerX, centerY, centerZ; /**< World space AABB centers. */
+		vector<float> extentX, extentY, extentZ; /**< World space AABB half extents. */
+		vector<Aabb> aabbs;                      /**< Mesh AABBs of the cached bounds. */
+		vector<ID<Entity>> entities;             /**< Mesh entities of the cached bounds. */
+		vector<uint32> transformItems;           /**< Transform component pool item indices. */
+		vector<uint32> modelStamps;              /**< Transform model stamps of the cached bounds. */
+		vector<uint32> viewMasks;                /**< Mesh visibility bitmask of each view. (0 = culled) */
+		vector<uint32> drawMasks;                /**< Mesh visibility bitmask written to the component. */
+		vector<float4x3> models;                 /**< Mesh model matrices. (Camera relative, visible only) */
+	};
+	/**
+	 * @brief Static mesh bounding volume hierarchy node. (World space)
+	 * @details Inner node children are stored at the offset and offset + 1 indices.
+	 */
+	struct StaticNode final
+	{
+		float3 min = float3::zero;
+		uint32 offset = 0; /**< Left child node index or leaf item index. */
+		float3 max = float3::zero;
+		uint32 count = 0;  /**< Leaf item count. (0 = inner node) */
+	};
+	/**
+	 * @brief Static mesh spatial index. (Bounding volume hierarchy)
+	 * 
+	 * @details
+	 * Contains meshes of the entities with a StaticTransformComponent. It is rebuilt only when static entities 
+	 * are added or removed, all other meshes are culled linearly using the dynamic item array.
+	 */
+	struct StaticTree final
+	{
+		vector<StaticNode> nodes;
+		vector<uint32> items;        /**< Static mesh item indices in the leaf order. */
+		vector<ID<Entity>> entities; /**< Static mesh entities in the leaf order. */
+		vector<uint32> taskNodes;    /**< Subtree root nodes traversed in parallel. */
+		vector<uint32> dynamicItems; /**< Non static mesh item indices. */
+		IMeshRenderSystem* meshSystem = nullptr;
+		uint64 staticVersion = 0;
+		uint32 componentCount = 0;
+		uint32 occupancy = 0;
+		atomic<bool> isDirty = true;
+	};
+	struct MeshBuffer
+	{
+		IMeshRenderSystem* meshSystem = nullptr;
+		ThreadPool::Job prepareJob = {};
+		ThreadPool::Job cullJob = {};
+		uint32 viewMask = 0;           /**< Views in which mesh system is ready to draw. */
+		bool useStatic = false;        /**< Is static meshes culled using the static tree. */
+		bool collectOccluders = false; /**< Is occluder meshes collected during culling. */
+		DrawCounter counters[maxViewCount];
+		CullingData culling;
+		StaticTree staticTree;
+		vector<uint32> occluders;      /**< Occluder mesh item indices. (Before frustum culling) */
+		alignas(64) atomic<uint32> occluderCount = 0;
+	};
 	struct UnsortedBuffer final : public MeshBuffer
 	{
 		vector<vector<UnsortedMesh>> threadMeshes;
-		vector<UnsortedMesh> combinedMeshes;
+		vector<UnsortedMesh> combinedMeshes[maxViewCount];
+		vector<UnsortedMesh> tempMeshes[maxViewCount];
 	};
 	struct SortedBuffer final : MeshBuffer { };
+	/**
+	 * @brief Occluder mesh selected for the CPU occlusion culling.
+	 */
+	struct Occluder final
+	{
+		const MeshBuffer* meshBuffer = nullptr;
+		uint32 item = 0;
+		float weight = 0.0f; /**< Occluder selection weight. (Approximate screen size) */
+	};
 private:
 	vector<UnsortedBuffer*> unsortedBuffers;
 	vector<SortedBuffer*> sortedBuffers;
-	vector<SortedMesh> transSortedMeshes;
+	vector<MeshView*> views;
 	vector<SortedMesh> uiSortedMeshes;
+	vector<SortedMesh> uiTempMeshes;
+	vector<uint32> sortHistograms;
 	vector<vector<SortedMesh>> sortedThreadMeshes;
+	vector<ThreadPool::Job> transPrepareJobs;
+	vector<ThreadPool::Job> uiPrepareJobs;
 	vector<IMeshRenderSystem*> meshSystems;
-	atomic<uint32> transDrawIndex = 0;
+	vector<ThreadPool::Job> cullJobs;
+	vector<Occluder> occluders;
+	vector<OcclusionBuffer::Box> occluderBoxes;
+	OcclusionBuffer occlusionBuffer;
+	f32x4 uiPlanes[6];
+	uint32 viewCount = 0;
 	uint32 unsortedBufferCount = 0;
 	uint32 sortedBufferCount = 0;
 	bool hasOIT = false;
@@ -232,6 +342,7 @@ private:
 	bool hasAnyRefr = false;
 	bool hasAnyOIT = false;
 	bool hasAnyTD = false;
+	bool hasOccluders = false;
 	alignas(64) atomic<uint32> uiDrawIndex = 0;
 
 	/**
@@ -246,11 +357,14 @@ private:
 		bool useAsyncPreparing = true, bool setSingleton = true);
 
 	void prepareSystems();
+	void addView(const f32x4x4& viewProj, f32x4 cameraOffset, IShadowMeshRenderSystem* shadowSystem, int8 shadowPass);
+	void prepareViews();
 	void sortMeshes();
-	void prepareMeshes(const Frustum& viewFrustum, const Frustum* uiFrustum, f32x4 cameraOffset, int8 shadowPass);
-	void renderUnsorted(const f32x4x4& viewProj, MeshRenderType renderType, int8 shadowPass);
-	void renderSorted(const f32x4x4& viewProj, MeshRenderType renderType, int8 shadowPass);
-	void cleanupMeshes();
+	ThreadPool::Job prepareOcclusion(ThreadPool* threadPool);
+	void prepareMeshes();
+	void renderUnsorted(const f32x4x4& viewProj, MeshRenderType renderType, uint8 viewIndex);
+	void renderSorted(const f32x4x4& viewProj, MeshRenderType renderType, uint8 viewIndex);
+	void cleanupMeshes(uint8 viewOffset, uint8 viewCount);
 	void renderShadows();
 
 	void init();
@@ -272,7 +386,9 @@ private:
 	friend class GizmosEditorSystem;
 	friend class SelectorEditorSystem;
 public:
-	bool isNonTranslucent = false; /** Render only non translucent meshes. */
+	bool isNonTranslucent = false;    /** Render only non translucent meshes. */
+	bool useOcclusionCulling = false; /**< Cull meshes hidden behind occluders on the CPU. (Main camera only) */
+	uint32 occluderBudget = 256;      /**< Maximum occluder count rasterized each frame. */
 
 	/**
 	 * @brief Use multithreaded command buffer recording.
@@ -284,6 +400,23 @@ public:
 	 * @warning Be careful when writing asynchronous code!
 	 */
 	bool useAsyncPreparing() const noexcept { return asyncPreparing; }
+
+	/**
+	 * @brief Requests static mesh spatial index rebuild.
+	 * @details Call it after changing static mesh bounds, entity add and remove is detected automatically.
+	 */
+	void markStaticMeshesDirty() noexcept;
+
+	/**
+	 * @brief Returns CPU occlusion culling depth buffer.
+	 * @details Contains occluders rasterized for the last prepared frame.
+	 */
+	const OcclusionBuffer& getOcclusionBuffer() const noexcept { return occlusionBuffer; }
+	/**
+	 * @brief Sets CPU occlusion culling depth buffer size in pixels.
+	 * @param size target occlusion buffer size
+	 */
+	void setOcclusionBufferSize(uint2 size) { occlusionBuffer.setSize(size); }
 };
 
 /***********************************************************************************************************************
@@ -339,6 +339,7 @@ public:
 
 	/**
 	 * @brief Creates IBL specular cubemap cache buffer. (Image Based Lighting)
+	 * @details Sample data is stored in the app cache directory and reused for the same cubemap size.
 	 * 
 	 * @param cubemapSize cubemap size along one axis in pixels
 	 * @param[out] iblWeightBuffer sample weight per mip level
@@ -398,6 +399,7 @@ public:
 	/**
 	 * @brief Loads cubemap rendering data from the resource pack.
 	 * @note Loads from the scenes directory in debug build.
+	 * @details Diffuse SH coefficients are cached on disk, keyed by the skybox data hash.
 	 * 
 	 * @param[in] path target cubemap resource path
 	 * @param format required image data format
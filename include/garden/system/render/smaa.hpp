@@ -20,6 +20,7 @@
 
 #pragma once
 #include "garden/system/graphics.hpp"
+#include "garden/graphics/render-graph.hpp"
 
 namespace garden
 {
@@ -44,9 +45,10 @@ public:
 	};
 
 	static constexpr Image::Format edgesBufferFormat = Image::Format::UnormR8G8;
+	static constexpr Image::Format weightsBufferFormat = Image::Format::UnormR8G8B8A8;
 private:
 	Ref<Image> searchLUT = {}, areaLUT = {};
-	ID<Image> edgesBuffer = {};
+	ID<Image> edgesBuffer = {}, weightsBuffer = {};
 	ID<Framebuffer> edgesFramebuffer = {};
 	ID<Framebuffer> weightsFramebuffer = {};
 	ID<Framebuffer> blendFramebuffer = {};
@@ -54,6 +56,8 @@ private:
 	ID<GraphicsPipeline> weightsPipeline = {};
 	ID<GraphicsPipeline> blendPipeline = {};
 	ID<DescriptorSet> edgesDS = {}, weightsDS = {}, blendDS = {};
+	RenderGraph renderGraph;
+	uint64 graphVersion = 0;
 	int32 cornerRounding = 25;
 	GraphicsQuality quality = GraphicsQuality::High;
 	bool isInitialized = false;
@@ -69,6 +73,9 @@ private:
 	void gBufferRecreate();
 	void qualityChange();
 
+	void updateGraphImages(ID<Image> edgesBuffer, ID<Image> weightsBuffer);
+	bool isReady();
+
 	friend class ecsm::Manager;
 public:
 	bool isEnabled = true; /**< Is subpixel morphological anti-aliasing rendering enabled. */
@@ -95,17 +102,25 @@ public:
 
 	/**
 	 * @brief Returns SMAA edges buffer.
+	 * @note Render graph transient image, it is null before the first render and changes on graph recompilation.
+	 */
+	ID<Image> getEdgesBuffer() const noexcept { return edgesBuffer; }
+	/**
+	 * @brief Returns SMAA weights buffer.
+	 * @note Render graph transient image, it is null before the first render and changes on graph recompilation.
 	 */
-	ID<Image> getEdgesBuffer();
+	ID<Image> getWeightsBuffer() const noexcept { return weightsBuffer; }
 
 	/**
 	 * @brief Returns SMAA edges framebuffer.
+	 * @note It is null before the first render. (Attachment is a render graph transient image)
 	 */
-	ID<Framebuffer> getEdgesFramebuffer();
+	ID<Framebuffer> getEdgesFramebuffer() const noexcept { return edgesFramebuffer; }
 	/**
 	 * @brief Returns SMAA weights framebuffer.
+	 * @note It is null before the first render. (Attachment is a render graph transient image)
 	 */
-	ID<Framebuffer> getWeightsFramebuffer();
+	ID<Framebuffer> getWeightsFramebuffer() const noexcept { return weightsFramebuffer; }
 	/**
 	 * @brief Returns SMAA blend framebuffer.
 	 */
@@ -113,12 +128,14 @@ public:
 
 	/**
 	 * @brief Returns SMAA edges graphics pipeline.
+	 * @note It is null before the first render.
 	 */
-	ID<GraphicsPipeline> getEdgesPipeline();
+	ID<GraphicsPipeline> getEdgesPipeline() const noexcept { return edgesPipeline; }
 	/**
 	 * @brief Returns SMAA weights graphics pipeline.
+	 * @note It is null before the first render.
 	 */
-	ID<GraphicsPipeline> getWeightsPipeline();
+	ID<GraphicsPipeline> getWeightsPipeline() const noexcept { return weightsPipeline; }
 	/**
 	 * @brief Returns SMAA blend graphics pipeline.
 	 */
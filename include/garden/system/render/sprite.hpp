@@ -113,11 +113,14 @@ protected:
 
 	void init() override;
 	virtual void imageLoaded();
+	virtual void imageRestreamed();
+	void updateColorMapDS(bool isRestreamed);
 
 	static void resetComponent(View<Component> component);
 
 	uint32 getReadyMeshesAsync(MeshRenderComponent* meshRenderView, 
-		const f32x4& cameraPosition, const Frustum& frustum, f32x4x4& model) override;
+		const f32x4& cameraPosition, f32x4x4& model) override;
+	uint32 getMeshStateAsync(MeshRenderComponent* meshRenderView) const override;
 	void drawAsync(MeshRenderComponent* meshRenderView, const f32x4x4& viewProj,
 		const f32x4x4& model, uint32 instanceIndex, int32 taskIndex) override;
 
@@ -20,10 +20,11 @@
 #include "garden/hash.hpp"
 #include "garden/font.hpp"
 #include "garden/animate.hpp"
+#include "garden/mpsc-queue.hpp"
 #include "garden/graphics/pipeline/compute.hpp"
 #include "garden/graphics/pipeline/graphics.hpp"
 #include "garden/graphics/pipeline/ray-tracing.hpp"
-#include <queue>
+#include "garden/graphics/modelc.hpp"
 
 #if GARDEN_PACK_RESOURCES
 #include "pack/reader.hpp"
@@ -32,6 +33,8 @@
 namespace garden
 {
 
+namespace graphics { struct ImageLoadData; struct ModelLoadData; }
+
 using namespace garden::graphics;
 
 /**
@@ -50,17 +53,18 @@ DECLARE_ENUM_CLASS_FLAG_OPERATORS(BufferLoadFlags)
 /**
  * @brief Additional image load flags.
  */
-enum class ImageLoadFlags : uint8
+enum class ImageLoadFlags : uint16
 {
-	None        = 0x00, /**< No additional image load flags. */
-	LoadSync    = 0x01, /**< Load image synchronously. (Blocking call) */
-	LoadShared  = 0x02, /**< Load and share instance on second load call. */
-	LoadAsArray = 0x04, /**< Load as image array. (Slice to layers) */
-	LoadAs3D    = 0x08, /**< Load as 3D image. (Slice to layers) */
-	LoadAsSrgb  = 0x10, /**< Load as sRGB data. (No format conversion) */
-	TypeArray   = 0x20, /**< Load with array image type. (Texture2DArray) */
-	Type3D      = 0x40, /**< Load with 3D image type. (Texture3D) */
-	TypeCubemap = 0x80, /**< Load with cubemap image type. (Cubemap) */
+	None         = 0x00,  /**< No additional image load flags. */
+	LoadSync     = 0x01,  /**< Load image synchronously. (Blocking call) */
+	LoadShared   = 0x02,  /**< Load and share instance on second load call. */
+	LoadAsArray  = 0x04,  /**< Load as image array. (Slice to layers) */
+	LoadAs3D     = 0x08,  /**< Load as 3D image. (Slice to layers) */
+	LoadAsSrgb   = 0x10,  /**< Load as sRGB data. (No format conversion) */
+	TypeArray    = 0x20,  /**< Load with array image type. (Texture2DArray) */
+	Type3D       = 0x40,  /**< Load with 3D image type. (Texture3D) */
+	TypeCubemap  = 0x80,  /**< Load with cubemap image type. (Cubemap) */
+	LoadStreamed = 0x100, /**< Stream image mips based on the requested on-screen size. (Async, "ImageRestreamed") */
 };
 
 DECLARE_ENUM_CLASS_FLAG_OPERATORS(ImageLoadFlags)
@@ -116,6 +120,19 @@ public:
 	{
 		RayTracingPipeline::ShaderOverrides* shaderOverrides = nullptr; /**< Pipeline shader code overrides or null. */
 	};
+	/**
+	 * @brief Loaded 3D model description. (See the @ref ModelConverter)
+	 * @details LOD index ranges share the one index buffer, draw them using the model index type.
+	 */
+	struct ModelInfo final
+	{
+		vector<BufferChannel> channels;   /**< Vertex buffer channels. (Interleaved) */
+		vector<ModelConverter::Lod> lods; /**< Model level of details. (From the most detailed) */
+		float3 aabbMin = float3::zero;    /**< Model axis aligned bounding box minimum. */
+		float3 aabbMax = float3::zero;    /**< Model axis aligned bounding box maximum. */
+		uint32 vertexCount = 0;           /**< Model vertex count. */
+		IndexType indexType = {};         /**< Model index buffer type. (16 or 32 bit) */
+	};
 protected:
 	//******************************************************************************************************************
 	struct GraphicsQueueItem final
@@ -139,6 +156,7 @@ protected:
 		Buffer staging;
 		fs::path path = "";
 		ID<Buffer> bufferInstance = {};
+		ModelInfo* modelInfo = nullptr;
 	};
 	struct ImageQueueItem final
 	{
@@ -148,6 +166,28 @@ protected:
 		uint2 realSize = uint2::zero;
 		ID<Image> instance = {};
 		ImageLoadFlags flags = {};
+		uint8 fullMipCount = 0;
+		uint8 streamMip = 0;
+		uint64 fullMipSize = 0;
+	};
+	struct StreamedImage final
+	{
+		vector<fs::path> paths = {};
+		uint64 imageVersion = 0;
+		uint64 fullMipSize = 0;
+		uint64 lastRequestFrame = 0;
+		std::atomic<uint32> requestedSize = 0;
+		uint32 screenSize = 0;
+		uint2 fullSize = uint2::zero;
+		float taskPriority = 0.0f;
+		Image::Format format = {};
+		Image::Usage usage = {};
+		Image::Strategy strategy = {};
+		ImageLoadFlags flags = {};
+		uint8 maxMipCount = 0;
+		uint8 fullMipCount = 0;
+		uint8 residentMip = UINT8_MAX;
+		bool isLoading = true;
 	};
 
 	struct LoadedBufferItem final
@@ -162,18 +202,21 @@ protected:
 	};
 	
 	tsl::robin_map<Hash128, Ref<Buffer>> sharedBuffers;
+	tsl::robin_map<ID<Buffer>, ModelInfo> modelInfos;
 	tsl::robin_map<Hash128, Ref<Image>> sharedImages;
 	tsl::robin_map<Hash128, Ref<DescriptorSet>> sharedDescriptorSets;
 	tsl::robin_map<Hash128, Ref<Animation>> sharedAnimations;
 	tsl::robin_map<Hash128, Ref<Font>> sharedFonts;
-	queue<GraphicsQueueItem> loadedGraphicsQueue; // TODO: We can use here lock free concurrent queue.
-	queue<ComputeQueueItem> loadedComputeQueue;
-	queue<RayTracingQueueItem> loadedRayTracingQueue;
-	queue<BufferQueueItem> loadedBufferQueue;
-	queue<ImageQueueItem> loadedImageQueue;
+	MpscQueue<GraphicsQueueItem> loadedGraphicsQueue;
+	MpscQueue<ComputeQueueItem> loadedComputeQueue;
+	MpscQueue<RayTracingQueueItem> loadedRayTracingQueue;
+	MpscQueue<BufferQueueItem> loadedBufferQueue;
+	MpscQueue<ImageQueueItem> loadedImageQueue;
 	vector<LoadedBufferItem> loadedBufferArray;
 	vector<LoadedImageItem> loadedImageArray;
-	mutex queueLocker = {};
+	tsl::robin_map<ID<Image>, StreamedImage*> streamedImages;
+	uint64 streamedImageSize = 0;
+	uint32 streamLoadCount = 0;
 	ID<Buffer> loadedBuffer = {};
 	ID<Image> loadedImage = {};
 	vector<fs::path> loadedImagePaths = {};
@@ -193,10 +236,18 @@ protected:
 	 * @param setSingleton set system singleton instance
 	 */
 	ResourceSystem(bool setSingleton = true);
+	/**
+	 * @brief Destroys resource system instance.
+	 */
+	~ResourceSystem();
 
+	void addImageLoadTask(ImageLoadData* data, float taskPriority);
+	void addModelLoadTask(ModelLoadData* data, float taskPriority);
+	void updateStreamedImages();
 	void dequeuePipelines();
-	void dequeueBuffers();
-	void dequeueImages();
+	void dequeueBuffers(uint64& uploadSize, uint32& uploadCount);
+	void dequeueImages(uint64& uploadSize, uint32& uploadCount);
+	void evictSharedDescriptorSets(Image& image);
 
 	virtual void init();
 	virtual void input();
@@ -217,6 +268,33 @@ public:
 		"noto-sans/korean", "noto-sans/arabic", "noto-sans/devanagari", "noto-sans/hebrew", 
 		"noto-sans/thai", "noto-sans/bengali", "noto-sans/urdu"
 	};
+	/**
+	 * @brief Maximum loaded buffer and image data size uploaded to the GPU per frame in bytes. (0 = unlimited)
+	 * @details Remaining loaded resources are uploaded on the next frames, which prevents frame time spikes.
+	 * @note At least one resource is uploaded each frame, even if it is bigger than the budget.
+	 */
+	uint64 dequeueSizeBudget = 64 * 1024 * 1024;
+	/**
+	 * @brief Maximum loaded buffer and image count uploaded to the GPU per frame. (0 = unlimited)
+	 */
+	uint32 dequeueItemBudget = 64;
+	/**
+	 * @brief Maximum streamed image GPU memory size in bytes.
+	 * @details Highest mips of the lowest priority streamed images are dropped when budget is exceeded.
+	 */
+	uint64 imageStreamBudget = 512 * 1024 * 1024;
+	/**
+	 * @brief Streamed image initial (lowest) resolution in pixels. (Largest side)
+	 */
+	uint32 imageStreamBaseSize = 64;
+	/**
+	 * @brief Frame count after which not requested streamed image can be dropped to the base resolution.
+	 */
+	uint32 imageStreamTimeout = 300;
+	/**
+	 * @brief Maximum streamed image refine or drop loads in flight.
+	 */
+	uint32 maxImageStreamLoads = 4;
 
 	/**
 	 * @brief Loads image pixels from the resource pack.
@@ -244,6 +322,17 @@ public:
 	void loadImageData(const fs::path* paths, psize pathCount, vector<vector<uint8>>& pixelArrays, 
 		uint2& size, Image::Format& format, int32 threadIndex = -1) const noexcept;
 
+	/**
+	 * @brief Loads 3D model data from the resource pack.
+	 * @note Loads from the models directory in debug build. (Converts source model if it has changed)
+	 * 
+	 * @param[in] path target model resource path
+	 * @param[out] modelData loaded model data container (Missing model on error)
+	 * @param threadIndex thread index in the pool (-1 = single threaded)
+	 */
+	void loadModelData(const fs::path& path, 
+		ModelConverter::ModelData& modelData, int32 threadIndex = -1) const noexcept;
+
 	/**
 	 * @brief Loads cubemap image pixels the resource pack.
 	 * @note Loads from the images directory in debug build.
@@ -360,7 +449,10 @@ public:
 
 	/**
 	 * @brief Returns current loaded image instance.
-	 * @details Useful inside "ImageLoaded" event.
+	 * 
+	 * @details
+	 * Useful inside "ImageLoaded" and "ImageRestreamed" events. Streamed image views are destroyed on the resolution
+	 * change, so every system holding descriptor sets with them should recreate them inside "ImageRestreamed" event.
 	 */
 	ID<Image> getLoadedImage() const noexcept { return loadedImage; }
 	/**
@@ -369,6 +461,20 @@ public:
 	 */
 	const vector<fs::path>& getLoadedImagePaths() const noexcept { return loadedImagePaths; }
 
+	/**
+	 * @brief Requests streamed image resolution for the current frame.
+	 * @details Mesh render systems should report image on-screen size, largest request of the frame is used.
+	 * @note It is safe to call from the render threads. Ignores not streamed images.
+	 *
+	 * @param image target streamed image instance
+	 * @param screenSize image projected on-screen size in pixels (largest side)
+	 */
+	void requestImageSize(ID<Image> image, uint32 screenSize) noexcept;
+	/**
+	 * @brief Returns total streamed image GPU memory size in bytes. (Estimated)
+	 */
+	uint64 getStreamedImageSize() const noexcept { return streamedImageSize; }
+
 	/*******************************************************************************************************************
 	 * @brief Loads buffer from the resource pack.
 	 * @note Loads from the models directory in debug build.
@@ -380,12 +486,41 @@ public:
 	 */
 	Ref<Buffer> loadBuffer(const fs::path& path, Buffer::Strategy strategy = Buffer::Strategy::Default, 
 		BufferLoadFlags flags = BufferLoadFlags::None, float taskPriority = 0.0f);
+	/**
+	 * @brief Loads 3D model vertex and index buffers from the resource pack.
+	 * 
+	 * @details
+	 * Vertex data is in the model BufferChannel layout. (See the @ref ModelConverter) Model index type, LOD ranges
+	 * and bounds are returned by the @ref getModelInfo() after the index buffer "BufferLoaded" event.
+	 * 
+	 * @note Loads from the models directory in debug build. (Converts source model if it has changed)
+	 *
+	 * @param[in] path target model resource path (without extension)
+	 * @param[out] vertexBuffer loaded model vertex buffer
+	 * @param[out] indexBuffer loaded model index buffer
+	 * @param strategy buffers memory allocation strategy
+	 * @param flags additional buffer load flags
+	 * @param taskPriority thread pool model load task priority
+	 */
+	void loadModel(const fs::path& path, Ref<Buffer>& vertexBuffer, Ref<Buffer>& indexBuffer, 
+		Buffer::Strategy strategy = Buffer::Strategy::Default, 
+		BufferLoadFlags flags = BufferLoadFlags::None, float taskPriority = 0.0f);
 	/**
 	 * @brief Destroys shared buffer if it's the last one.
 	 * @param[in] buffer target shared buffer reference
 	 */
 	void destroyShared(Ref<Buffer>& buffer);
 
+	/**
+	 * @brief Returns loaded 3D model description, or null if model is not loaded yet.
+	 * @param indexBuffer target model index buffer (See the @ref loadModel())
+	 */
+	const ModelInfo* getModelInfo(ID<Buffer> indexBuffer) const noexcept
+	{
+		auto result = modelInfos.find(indexBuffer);
+		return result != modelInfos.end() ? &result->second : nullptr;
+	}
+
 	/**
 	 * @brief Returns current loaded buffer instance.
 	 * @details Useful inside "BufferLoaded" event.
@@ -102,6 +102,7 @@ public:
 	ID<Entity> loadPrefab();
 	/**
 	 * @brief Spawns a new prefab instance.
+	 * @details Prefab hierarchy is duplicated in one batch, rigidbodies are added to the simulation at once.
 	 * @note If prefab entity was destroyed this call recreates it.
 	 * 
 	 * @param count how many entity instances to spawn
@@ -126,6 +127,7 @@ public:
 	using SharedPrefabs = tsl::robin_map<string, Hash128, SvHash, SvEqual>;
 private:
 	SharedPrefabs sharedPrefabs;
+	vector<ID<Entity>> spawnDuplicates;
 	string valueStringCache;
 
 	/**
@@ -143,9 +145,11 @@ private:
 
 	void serialize(ISerializer& serializer, const View<Component> component) override;
 	void deserialize(IDeserializer& deserializer, View<Component> component) override;
+	bool isDeserializeAsync() const noexcept override { return true; }
 	
 	friend class ecsm::Manager;
 	friend struct LinkComponent;
+	friend struct SpawnerComponent;
 public:
 	/**
 	 * @brief Returns shared prefab map.
@@ -22,8 +22,6 @@
 #include "garden/font.hpp"
 #include "garden/graphics/image.hpp"
 
-// TODO: implement font atlas tight glyphs packing. 
-
 namespace garden
 {
 
@@ -48,6 +46,10 @@ struct Glyph final
 
 /**
  * @brief Font texture atlas container.
+ * 
+ * @details Glyphs are packed into the atlas texture rows (shelves) and kept between updates. Only newly seen 
+ *          glyphs are rasterized and only their texture regions are uploaded. When atlas runs out of free space 
+ *          the least recently used glyphs are evicted, or the atlas is rebuilt with a bigger texture size.
  */
 struct FontAtlas final
 {
@@ -58,13 +60,44 @@ struct FontAtlas final
 	 */
 	static constexpr Image::Usage defaultImageFlags = 
 		Image::Usage::TransferDst | Image::Usage::TransferQ | Image::Usage::Sampled;
+	/**
+	 * @brief Empty space between atlas glyphs in pixels. (Prevents filtering bleeding)
+	 */
+	static constexpr uint32 glyphPadding = 1;
 private:
+	struct Rect final
+	{
+		uint2 position = uint2::zero;
+		uint2 size = uint2::zero;
+	};
+	struct Slot final
+	{
+		Rect rect = {};
+		uint64 lastUse = 0;
+	};
+	struct Shelf final
+	{
+		uint32 posY = 0;
+		uint32 height = 0;
+		uint32 width = 0;
+	};
+
 	FontArray fonts;
 	vector<GlyphMap> glyphs;
+	tsl::robin_map<uint32, Slot> slots;
+	vector<Shelf> shelves;
+	vector<Rect> freeRects;
 	ID<Image> image = {};
+	uint2 pixelSize = uint2::zero;
+	uint64 useCounter = 0;
 	uint32 fontSize = 0;
 	float newLineAdvance = 0.0f;
 
+	bool packGlyph(uint2 size, uint2& position);
+	bool evictGlyphs(uint2 size, uint64 useIndex, uint2& position);
+	void resetLayout(uint2 pixelSize);
+	bool updateAtlas(u32string_view chars, uint32 fontSize, Image::Usage imageUsage, bool shrink, bool canRelayout);
+
 	friend class garden::TextSystem;
 public:
 	/**
@@ -79,6 +112,10 @@ public:
 	 * @brief Returns font texture atlas image.
 	 */
 	const ID<Image>& getImage() const noexcept { return image; }
+	/**
+	 * @brief Returns font texture atlas image size in pixels.
+	 */
+	uint2 getPixelSize() const noexcept { return pixelSize; }
 	/**
 	 * @brief Returns font texture atlas font size in pixels.
 	 */
@@ -89,16 +126,30 @@ public:
 	float getNewLineAdvance() const noexcept { return newLineAdvance; }
 
 	/**
-	 * @brief Regenerates font atlas texture.
+	 * @brief Updates font atlas texture with the missing glyphs.
+	 * @details Existing glyphs may be evicted or moved if there is not enough free atlas space.
 	 * @return True on success, otherwise false.
 	 * 
-	 * @param value target text string value
+	 * @param chars target text chars
 	 * @param fontSize font size in pixels
 	 * @param imageUsage atlas texture usage flags
 	 * @param shrink reduce internal memory usage
 	 */
 	bool update(u32string_view chars, uint32 fontSize, 
-		Image::Usage imageUsage = defaultImageFlags, bool shrink = false);
+		Image::Usage imageUsage = defaultImageFlags, bool shrink = false)
+	{
+		return updateAtlas(chars, fontSize, imageUsage, shrink, true);
+	}
+	/**
+	 * @brief Adds missing glyphs to the font atlas texture without moving or evicting existing ones.
+	 * @details Safe to use with the atlas shared between several texts.
+	 * @return True on success, false if there is not enough free atlas space.
+	 * @param chars target text chars
+	 */
+	bool append(u32string_view chars)
+	{
+		return updateAtlas(chars, fontSize, defaultImageFlags, false, false);
+	}
 };
 
 /***********************************************************************************************************************
@@ -39,15 +39,38 @@ private:
 	f32x4 posChildCount = f32x4::zero;
 	f32x4 scaleChildCap = f32x4(1.0f, 1.0f, 1.0f, 0.0f);
 	quat rotation = quat::identity;
+	float4x3 worldModel = float4x3::identity;
 	ID<Entity>* childs = nullptr;
+	uint32 modelStamp = 0;
 	volatile bool selfActive = true;
 	volatile bool ancestorsActive = true;
+	volatile bool modelDirty = true;
 
 	/**
 	 * @brief Destroys childs array memory block, if allocated. 
 	 */
 	bool destroy();
 
+	/**
+	 * @brief Marks cached world model matrix of this entity and all its descendants as dirty.
+	 * 
+	 * @details
+	 * Descendants are marked only when this entity becomes dirty, so that all descendants of the dirty entity are 
+	 * always dirty too. This way clean entity cached matrix can be trusted without checking its ancestors.
+	 */
+	void markModelDirty() noexcept
+	{
+		if (modelDirty)
+			return;
+		modelDirty = true;
+		if (childCount() > 0)
+			markDescendantsDirty();
+	}
+	void markDescendantsDirty() noexcept;
+	bool hasDirtyAncestor() const noexcept { return parent && isParentDirty(); }
+	bool isParentDirty() const noexcept;
+	f32x4x4 calcWorldModel() const noexcept;
+
 	uint32& childCount() noexcept { return posChildCount.uints.w; }
 	uint32& childCapacity() noexcept { return scaleChildCap.uints.w; }
 	uint32 childCount() const noexcept { return posChildCount.uints.w; }
@@ -71,12 +94,18 @@ public:
 	 * @brief Sets entity position in the 3D space relative to the parent.
 	 * @param position target entity position in 3D space
 	 */
-	void setPosition(f32x4 position) noexcept { posChildCount = f32x4(position, posChildCount.getW()); }
+	void setPosition(f32x4 position) noexcept
+	{
+		posChildCount = f32x4(position, posChildCount.getW()); markModelDirty();
+	}
 	/**
 	 * @brief Sets entity position in the 3D space relative to the parent.
 	 * @param position target entity position in 3D space
 	 */
-	void setPosition(float3 position) noexcept { posChildCount = f32x4(f32x4(position), posChildCount.getW()); }
+	void setPosition(float3 position) noexcept
+	{
+		posChildCount = f32x4(f32x4(position), posChildCount.getW()); markModelDirty();
+	}
 
 	/**
 	 * @brief Returns entity scale in the 3D space relative to the parent.
@@ -86,12 +115,15 @@ public:
 	 * @brief Sets entity scale in the 3D space relative to the parent.
 	 * @param scale target entity scale in 3D space
 	 */
-	void setScale(f32x4 scale) noexcept { scaleChildCap = f32x4(scale, scaleChildCap.getW()); }
+	void setScale(f32x4 scale) noexcept { scaleChildCap = f32x4(scale, scaleChildCap.getW()); markModelDirty(); }
 	/**
 	 * @brief Sets entity scale in the 3D space relative to the parent.
 	 * @param scale target entity scale in 3D space
 	 */
-	void setScale(float3 scale) noexcept { scaleChildCap = f32x4(f32x4(scale), scaleChildCap.getW()); }
+	void setScale(float3 scale) noexcept
+	{
+		scaleChildCap = f32x4(f32x4(scale), scaleChildCap.getW()); markModelDirty();
+	}
 
 	/**
 	 * @brief Returns entity rotation in the 3D space relative to the parent.
@@ -101,7 +133,7 @@ public:
 	 * @brief Sets entity rotation in the 3D space relative to the parent.
 	 * @param rotation target entity rotation in 3D space
 	 */
-	void setRotation(quat rotation) noexcept { this->rotation = rotation; }
+	void setRotation(quat rotation) noexcept { this->rotation = rotation; markModelDirty(); }
 
 	/*******************************************************************************************************************
 	 * @brief Is this entity and its ancestors active.
@@ -129,6 +161,18 @@ public:
 	 */
 	void setActive(bool isActive) noexcept;
 
+	/**
+	 * @brief Was this entity transform changed since the last cached world model matrix update.
+	 * @details It is recalculated by the @ref TransformSystem::updateModels().
+	 * @note Entity is also marked as dirty when any of its ancestors is changed.
+	 */
+	bool isModelDirty() const noexcept { return modelDirty; }
+	/**
+	 * @brief Returns stamp of the last cached world model matrix update.
+	 * @details Changes each time the matrix is recalculated, can be used to detect moved entities.
+	 */
+	uint32 getModelStamp() const noexcept { return modelStamp; }
+
 	/**
 	 * @brief Returns this entity parent object, or null if it is root entity.
 	 * @details Entity parent affects it transformation in the space.
@@ -174,42 +218,43 @@ public:
 	 */
 	void translate(f32x4 translation) noexcept
 	{
-		posChildCount = f32x4(posChildCount + translation, posChildCount.getW());
+		posChildCount = f32x4(posChildCount + translation, posChildCount.getW()); markModelDirty();
 	}
 	/**
 	 * @brief Scales this entity by the specified scale.
 	 * @param scale target entity scale
 	 */
-	void scale(f32x4 scale) noexcept { scaleChildCap = f32x4(scaleChildCap * scale, scaleChildCap.getW()); }
+	void scale(f32x4 scale) noexcept
+	{
+		scaleChildCap = f32x4(scaleChildCap * scale, scaleChildCap.getW()); markModelDirty();
+	}
 	/**
 	 * @brief Rotates this entity by the specified rotation.
 	 * @param rotation target entity rotation
 	 */
-	void rotate(quat rotation) noexcept { this->rotation *= rotation; }
+	void rotate(quat rotation) noexcept { this->rotation *= rotation; markModelDirty(); }
 
 	/**
 	 * @brief Calculates entity model matrix from it position, scale and rotation.
 	 * @note It also takes into account parent and grandparent transforms.
 	 * 
+	 * @details
+	 * Returns cached world model matrix if it is up to date, which is filled by the @ref TransformSystem once 
+	 * per frame. Otherwise multiplies entity transforms up to the topmost dirty ancestor by its parent cached matrix.
+	 * Entity is also dirty if any of its ancestors is dirty, so clean entity matrix is a plain cached read.
+	 * 
 	 * @param cameraPosition rendering camera position or zero
 	 * @return Entity model 4x4 float matrix.
 	 */
 	f32x4x4 calcModel(f32x4 cameraPosition = f32x4::zero) const noexcept
 	{
-		auto model = math::calcModel(posChildCount, rotation, scaleChildCap);
 		if (modelWithAncestors)
 		{
-			auto manager = Manager::Instance::get();
-			auto nextParent = parent;
-			while (nextParent)
-			{
-				auto nextTransformView = manager->get<TransformComponent>(nextParent);
-				auto parentModel = math::calcModel(nextTransformView->posChildCount,
-					nextTransformView->rotation, nextTransformView->scaleChildCap);
-				model = parentModel * model; nextParent = nextTransformView->parent;
-			}
-			return math::translate(-cameraPosition, model);
+			if (modelDirty)
+				return math::translate(-cameraPosition, calcWorldModel());
+			return math::translate(-cameraPosition, f32x4x4(worldModel, f32x4(0.0f, 0.0f, 0.0f, 1.0f)));
 		}
+		auto model = math::calcModel(posChildCount, rotation, scaleChildCap);
 		return math::translate(-cameraPosition, model);
 	}
 	/**
@@ -457,12 +502,19 @@ class TransformSystem final : public CompAnimSystem<TransformComponent, Transfor
 {
 	using EntityParentPair = pair<ID<Entity>, uint64>;
 	using EntityDuplicatePair = pair<ID<Entity>, ID<Entity>>;
+	using TemplateEntityPair = pair<ID<Entity>, uint32>;
 
 	stack<ID<Entity>, vector<ID<Entity>>> entityStack;
 	vector<EntityDuplicatePair> entityDuplicateStack;
+	vector<TemplateEntityPair> duplicateTemplate;
+	vector<ID<Entity>> templateDuplicates;
+	vector<vector<TransformComponent*>> threadDirtyRoots;
+	vector<TransformComponent*> dirtyRoots;
 	tsl::robin_map<uint64, ID<Entity>> deserializedEntities;
 	vector<EntityParentPair> deserializedParents;
+	mutex deserializeLocker;
 	string uidStringCache;
+	uint32 modelStamp = 0;
 
 	#if GARDEN_DEBUG
 	set<uint64> serializedEntities;
@@ -474,6 +526,9 @@ class TransformSystem final : public CompAnimSystem<TransformComponent, Transfor
 	 */
 	TransformSystem(bool setSingleton = true);
 
+	void preInit();
+	static bool updateDirtySubtree(Manager* manager, TransformComponent* rootView, uint32 modelStamp, bool checkStatic);
+
 	void destroyComponent(ID<Component> instance) override;
 	void resetComponent(View<Component> component, bool full) override;
 	void copyComponent(View<Component> source, View<Component> destination) override;
@@ -482,11 +537,15 @@ class TransformSystem final : public CompAnimSystem<TransformComponent, Transfor
 	void serialize(ISerializer& serializer, const View<Component> component) override;
 	void postSerialize(ISerializer& serializer) override;
 	void deserialize(IDeserializer& deserializer, View<Component> component) override;
+	void deserializeRecord(const BinarySceneRecord& record, View<Component> component) override;
 	void postDeserialize(IDeserializer& deserializer) override;
 
 	void serializeAnimation(ISerializer& serializer, View<AnimationFrame> frame) override;
 	void deserializeAnimation(IDeserializer& deserializer, View<AnimationFrame> frame) override;
 	void animateAsync(View<Component> component, View<AnimationFrame> a, View<AnimationFrame> b, float t) override;
+	uint8 getBakedProps(AnimationInterp* interps) override;
+	uint32 bakeAnimation(View<AnimationFrame> frame, f32x4* values) override;
+	void animateBaked(View<Component> component, const f32x4* values, uint32 mask) override;
 	
 	friend class ecsm::Manager;
 public:
@@ -500,6 +559,25 @@ public:
 	 * @param entity target entity to duplicate from
 	 */
 	ID<Entity> duplicateRecursive(ID<Entity> entity);
+	/**
+	 * @brief Creates several duplicates of entity with all descendants.
+	 * @details Entity hierarchy is flattened only once, which is faster than calling duplicate for each instance.
+	 * 
+	 * @param entity target entity to duplicate from
+	 * @param count duplicate instance count
+	 * @param[out] duplicates appended duplicated root entity array
+	 */
+	void duplicateRecursive(ID<Entity> entity, uint32 count, vector<ID<Entity>>& duplicates);
+
+	/**
+	 * @brief Recalculates all outdated cached world model matrices.
+	 * 
+	 * @details
+	 * Called automatically at the beginning of the each frame rendering. Dirty subtrees are 
+	 * updated breadth-first in parallel, so the following @ref TransformComponent::calcModel() 
+	 * calls are just a cached matrix read. Transforms should not be changed during this call.
+	 */
+	void updateModels();
 };
 
 /***********************************************************************************************************************
@@ -513,14 +591,28 @@ struct StaticTransformComponent final : public Component { };
 class StaticTransformSystem final : public ComponentSystem<StaticTransformComponent, false>, 
 	public Singleton<StaticTransformSystem>, public ISerializable
 {
+	uint64 version = 0;
+
 	/**
 	 * @brief Creates a new static transform system instance.
 	 * @param setSingleton set system singleton instance
 	 */
 	StaticTransformSystem(bool setSingleton = true);
 
+	ID<Component> createComponent(ID<Entity> entity) override;
+	void destroyComponent(ID<Component> instance) override;
 	string_view getComponentName() const override;
 	friend class ecsm::Manager;
+	friend class TransformSystem;
+public:
+	/**
+	 * @brief Returns static entity set version. (Incremented on each component add, remove or entity move)
+	 * 
+	 * @details
+	 * Useful for rebuilding static spatial structures only when required. Static entity move is 
+	 * detected by the @ref TransformSystem::updateModels() when its cached world model is recalculated.
+	 */
+	uint64 getVersion() const noexcept { return version; }
 };
 
 } // namespace garden
\ No newline at end of file
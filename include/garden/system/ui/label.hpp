@@ -135,7 +135,7 @@ private:
 
 	bool isDrawReady(int8 shadowPass) override;
 	uint32 getReadyMeshesAsync(MeshRenderComponent* meshRenderView, 
-		const f32x4& cameraPosition, const Frustum& frustum, f32x4x4& model) override;
+		const f32x4& cameraPosition, f32x4x4& model) override;
 	void prepareDraw(const f32x4x4& viewProj, uint32 drawCount, 
 		uint32 instanceCount, int8 shadowPass) override;
 	void beginDrawAsync(int32 taskIndex) override;
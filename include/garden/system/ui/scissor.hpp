@@ -66,6 +66,7 @@ class UiScissorSystem final : public CompAnimSystem<UiScissorComponent, UiScisso
 	
 	void serialize(ISerializer& serializer, const View<Component> component) override;
 	void deserialize(IDeserializer& deserializer, View<Component> component) override;
+	bool isDeserializeAsync() const noexcept override { return true; }
 
 	void serializeAnimation(ISerializer& serializer, View<AnimationFrame> frame) override;
 	void deserializeAnimation(IDeserializer& deserializer, View<AnimationFrame> frame) override;
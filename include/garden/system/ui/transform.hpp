@@ -138,10 +138,14 @@ class UiTransformSystem final : public CompAnimSystem<UiTransformComponent, UiTr
 	
 	void serialize(ISerializer& serializer, const View<Component> component) override;
 	void deserialize(IDeserializer& deserializer, View<Component> component) override;
+	bool isDeserializeAsync() const noexcept override { return true; }
 
 	void serializeAnimation(ISerializer& serializer, View<AnimationFrame> frame) override;
 	void deserializeAnimation(IDeserializer& deserializer, View<AnimationFrame> frame) override;
 	void animateAsync(View<Component> component, View<AnimationFrame> a, View<AnimationFrame> b, float t) override;
+	uint8 getBakedProps(AnimationInterp* interps) override;
+	uint32 bakeAnimation(View<AnimationFrame> frame, f32x4* values) override;
+	void animateBaked(View<Component> component, const f32x4* values, uint32 mask) override;
 
 	friend class ecsm::Manager;
 public:
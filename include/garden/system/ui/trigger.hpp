@@ -67,8 +67,32 @@ struct UiTriggerFrame final : public AnimationFrame
 class UiTriggerSystem final : public CompAnimSystem<UiTriggerComponent, UiTriggerFrame, false, false>,
 	public Singleton<UiTriggerSystem>, public ISerializable
 {
-	vector<pair<ID<Entity>, float>> newElements;
-	ID<Entity> currElement = {};
+public:
+	static constexpr float gridCellSize = 64.0f; /**< UI trigger grid cell size in UI units. */
+	static constexpr uint32 maxItemCells = 64;   /**< Bigger triggers are tested for every query point. */
+private:
+	struct Item final
+	{
+		f32x4x4 model = f32x4x4::zero;
+		f32x4x4 invModel = f32x4x4::zero;
+		float2 offset = float2::zero;
+		float2 scale = float2::zero;
+		float2 boundsMin = float2::zero;
+		float2 boundsMax = float2::zero;
+		int2 cellMin = int2::zero;
+		int2 cellMax = int2::zero;
+		ID<Entity> entity = {};
+		uint32 modelStamp = 0;
+		float posZ = 0.0f;
+		bool isInGrid = false;
+		bool isOversized = false;
+	};
+
+	vector<Item> items;
+	vector<vector<uint32>> threadChangedItems;
+	tsl::robin_map<uint64, vector<uint32>> gridCells;
+	vector<uint32> oversizedItems;
+	vector<ID<Entity>> hoveredElements;
 
 	/**
 	 * @brief Creates a new user interface element trigger system instance. (UI, GUI)
@@ -77,12 +101,18 @@ class UiTriggerSystem final : public CompAnimSystem<UiTriggerComponent, UiTrigge
 	UiTriggerSystem(bool setSingleton = true);
 
 	void update();
+	void updateGrid();
+	void addGridItem(uint32 index);
+	void removeGridItem(uint32 index);
+	static bool updateItem(Manager* manager, const UiTriggerComponent& uiTriggerComp, Item& item);
+	static bool isInside(const Item& item, float2 point) noexcept;
 
 	void destroyComponent(ID<Component> instance) override;
 	string_view getComponentName() const override;
 	
 	void serialize(ISerializer& serializer, const View<Component> component) override;
 	void deserialize(IDeserializer& deserializer, View<Component> component) override;
+	bool isDeserializeAsync() const noexcept override { return true; }
 
 	void serializeAnimation(ISerializer& serializer, View<AnimationFrame> frame) override;
 	void deserializeAnimation(IDeserializer& deserializer, View<AnimationFrame> frame) override;
@@ -90,10 +120,35 @@ class UiTriggerSystem final : public CompAnimSystem<UiTriggerComponent, UiTrigge
 
 	friend class ecsm::Manager;
 public:
+	/**
+	 * @brief Additional UI space query points. (Touches, gamepad virtual cursors)
+	 * @details Each point tracks its own hovered element and runs enter, stay and exit events.
+	 */
+	vector<float2> virtualCursors;
+
 	/**
 	 * @brief Returns current hovered with cursor UI element.
+	 * @param cursorIndex cursor index (0 = mouse, 1+ = virtual cursors)
+	 */
+	ID<Entity> getHovered(uint32 cursorIndex = 0) const noexcept
+	{
+		return cursorIndex < hoveredElements.size() ? hoveredElements[cursorIndex] : ID<Entity>();
+	}
+
+	/**
+	 * @brief Returns top UI trigger element at the specified point, or null.
+	 * @details Uses trigger grid built on the last update, visits only one grid cell.
+	 * @param point target point in UI space
+	 */
+	ID<Entity> findElement(float2 point) const;
+	/**
+	 * @brief Finds top UI trigger element for each point.
+	 * 
+	 * @param[in] points target point array in UI space
+	 * @param pointCount point array size
+	 * @param[out] elements found element array (null if none)
 	 */
-	ID<Entity> getHovered() const noexcept { return currElement; }
+	void findElements(const float2* points, uint32 pointCount, ID<Entity>* elements) const;
 };
 
 } // namespace garden
\ No newline at end of file
@@ -20,8 +20,9 @@
 #pragma once
 #include "garden/defines.hpp"
 
-#include <map>
 #include <mutex>
+#include <deque>
+#include <atomic>
 #include <thread>
 #include <vector>
 #include <functional>
@@ -39,6 +40,9 @@ namespace garden
  * fixed number of threads at startup and maintains a queue of tasks. When a task is submitted to the thread pool, 
  * it's assigned to one of the available threads. Once the task is completed, the thread becomes available to 
  * execute another task from the queue.
+ * 
+ * Each pool thread owns a set of lock-free task queues, one for each priority lane. Idle threads steal 
+ * tasks from the other thread queues, so the mutex is only touched when a thread goes to sleep or wakes up.
  */
 class ThreadPool final
 {
@@ -48,24 +52,127 @@ public:
 	static constexpr float priorityCritical = 10.0f;
 	static constexpr float priorityLow = -1.0f;
 
+	/**
+	 * @brief Discrete task priority lane count. (Critical, high, normal, low)
+	 */
+	static constexpr uint8 laneCount = 4;
+	/**
+	 * @brief Lock-free task queue capacity of the each thread priority lane.
+	 * 
+	 * @details
+	 * Tasks that do not fit into the queues are stored in the overflow queue. One queue cell takes 32 bytes,
+	 * so all priority lanes of the one thread take 32 KB.
+	 */
+	static constexpr uint32 queueCapacity = 256;
+	/**
+	 * @brief Maximum released job block count kept for the reuse.
+	 * @details Job blocks are shared by all thread pools, so that submissions do not allocate memory.
+	 */
+	static constexpr uint32 blockPoolCapacity = 1024;
+	/**
+	 * @brief Recommended item chunk size for the load balanced parallel-for.
+	 * @details Suitable for the loops with a cheap per item work, like mesh culling.
+	 */
+	static constexpr uint32 defaultGrainSize = 64;
+
+	class Task;
+	using TaskFunction = std::function<void(const Task& task)>;
+private:
+	/**
+	 * @brief Job data shared by all tasks of the same submission.
+	 * @details Task function is stored once, instead of being copied to each task instance.
+	 */
+	struct JobBlock final
+	{
+		TaskFunction function = {};
+		ThreadPool* threadPool = nullptr;
+		vector<JobBlock*> continuations;
+		std::mutex mutex = {};
+		float priority = 0.0f;
+		uint32 taskCount = 0;
+		uint32 countPerTask = 0;
+		uint32 itemCount = 0;
+		uint32 grainSize = 0;
+		atomic<uint32> refCount = 0;
+		atomic<uint32> remainingCount = 0;
+		atomic<uint32> dependencyCount = 0;
+		atomic<bool> isDone = false;
+		alignas(64) atomic<uint32> nextItemOffset = 0;
+	};
+public:
+	/*******************************************************************************************************************
+	 * @brief Handle of the submitted tasks group.
+	 * 
+	 * @details
+	 * Job is done when all its tasks are completed. It can be used as a dependency for the other tasks, which
+	 * will be added to the queue only when the dependency job is done, without blocking any thread.
+	 */
+	class Job final
+	{
+		JobBlock* block = nullptr;
+
+		Job(JobBlock* block) noexcept : block(block) { if (block) block->refCount.fetch_add(1); }
+		friend class ThreadPool;
+	public:
+		/**
+		 * @brief Creates a new empty job handle. (Always done)
+		 */
+		Job() noexcept = default;
+		/**
+		 * @brief Destroys job handle.
+		 */
+		~Job() { release(); }
+
+		Job(const Job& job) noexcept : Job(job.block) { }
+		Job(Job&& job) noexcept : block(job.block) { job.block = nullptr; }
+		Job& operator=(const Job& job) noexcept
+		{
+			if (this != &job) { release(); block = job.block; if (block) block->refCount.fetch_add(1); }
+			return *this;
+		}
+		Job& operator=(Job&& job) noexcept
+		{
+			if (this != &job) { release(); block = job.block; job.block = nullptr; }
+			return *this;
+		}
+
+		/**
+		 * @brief Returns true if job handle is not empty.
+		 */
+		bool isValid() const noexcept { return block; }
+		/**
+		 * @brief Returns true if all job tasks are completed. (MT-Safe)
+		 * @details Empty job is always done.
+		 */
+		bool isDone() const noexcept { return !block || block->isDone.load(); }
+		/**
+		 * @brief Releases job handle.
+		 * @details Job tasks are still executed after handle release.
+		 */
+		void release() noexcept
+		{
+			if (block && block->refCount.fetch_sub(1) == 1)
+				releaseBlock(block);
+			block = nullptr;
+		}
+	};
+
+public:
 	/*******************************************************************************************************************
 	 * @brief Task is a unit of work that needs to be performed asynchronously.
 	 */
 	class Task final
 	{
 	public:
-		using Function = std::function<void(const Task& task)>;
+		using Function = TaskFunction;
 	private:
-		Function function = {};
-		float priority = 0.0f;
+		JobBlock* block = nullptr;
 		uint32 threadIndex = 0;
 		uint32 taskIndex = 0;
 		uint32 itemOffset = 0;
 		uint32 itemCount = 0;
 
-		template<class T>
-		Task(const T& function, float priority = 0.0f) noexcept : 
-			function(function), priority(priority) { }
+		Task(JobBlock* block) noexcept : block(block) { }
 		friend class ThreadPool;
 	public:
 		/**
@@ -77,12 +184,12 @@ public:
 		 * @brief Returns function that should be executed by a thread
 		 * @details This function is mainly useful for debugging purposes.
 		 */
-		Function getFunction() const noexcept { return function; }
+		Function getFunction() const noexcept { return block ? block->function : Function(); }
 		/**
 		 * @brief Returns task execution priority in the pool.
 		 * @details You can use this inside a task function.
 		 */
-		float getPriority() const noexcept { return priority; }
+		float getPriority() const noexcept { return block ? block->priority : 0.0f; }
 
 		/**
 		 * @brief Returns current thread index in the pool.
@@ -106,21 +213,79 @@ public:
 		uint32 getItemCount() const noexcept { return itemCount; }
 	};
 private:
-	using TaskQueue = multimap<float, Task, std::greater<float>>;
+	/**
+	 * @brief Bounded multi-producer multi-consumer lock-free queue.
+	 */
+	template<typename T, uint32 Capacity>
+	class BoundedQueue final
+	{
+		struct Cell final
+		{
+			atomic<uint32> sequence = 0;
+			T value = {};
+		};
+
+		Cell* cells = nullptr;
+		alignas(64) atomic<uint32> enqueuePos = 0;
+		alignas(64) atomic<uint32> dequeuePos = 0;
+	public:
+		BoundedQueue();
+		~BoundedQueue();
+
+		BoundedQueue(BoundedQueue&&) = delete;
+		BoundedQueue(const BoundedQueue&) = delete;
+		BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+		bool tryPush(const T& value) noexcept;
+		bool tryPop(T& value) noexcept;
+	};
+	using TaskQueue = BoundedQueue<Task, queueCapacity>;
+
+	/**
+	 * @brief Released job blocks reused by the next submissions.
+	 */
+	struct BlockPool final
+	{
+		BoundedQueue<JobBlock*, blockPoolCapacity> blocks;
+		~BlockPool();
+	};
+	static BlockPool blockPool;
+
+	struct alignas(64) ThreadQueues final
+	{
+		TaskQueue lanes[laneCount];
+	};
 
 	string name;
 	std::mutex mutex = {};
+	std::mutex waitMutex = {};
+	std::mutex overflowMutex = {};
 	condition_variable workCond = {};
-	condition_variable workingCond = {};
+	condition_variable waitCond = {};
 	vector<thread> threads;
-	TaskQueue taskQueue;
+	ThreadQueues* threadQueues = nullptr;
+	std::deque<Task> overflowQueues[laneCount];
 	uint32 threadCount = 0;
-	uint32 workingCount = 0;
 	bool background = false;
 	bool isRunning = false;
+	alignas(64) atomic<uint32> laneCounts[laneCount];
+	alignas(64) atomic<uint32> unfinishedCount = 0;
+	atomic<uint32> overflowCount = 0;
+	atomic<uint32> sleepingCount = 0;
+	atomic<uint32> nextQueueIndex = 0;
+
+	alignas(64) atomic<uint32> jobWaitingCount = 0;
 
 	void threadFunction(uint32 threadIndex);
-	void executeTask(uint32 threadIndex);
+	void executeTask(Task& task, uint32 threadIndex);
+	bool tryPopTask(uint32 threadIndex, Task& task);
+	bool hasPendingTasks() const noexcept;
+	Job submitJob(JobBlock* block, const Job* dependencies, uint32 dependencyCount);
+	void pushTasks(JobBlock* block);
+	void finishTask(JobBlock* block);
+	static void completeJob(JobBlock* block);
+	static JobBlock* allocateBlock();
+	static void releaseBlock(JobBlock* block) noexcept;
 public:
 	/*******************************************************************************************************************
 	 * @brief Creates a new thread pool.
@@ -159,12 +324,12 @@ public:
 
 	/**
 	 * @brief Returns curent task queue pending task count. (MT-Safe)
-	 * @details Locks mutex inside to get current task count.
+	 * @details Sums atomic priority lane counters, result can be outdated.
 	 */
 	uint32 getPendingTaskCount();
 	/**
 	 * @brief Returns curent thread working task count. (MT-Safe)
-	 * @details Locks mutex inside to get working task count.
+	 * @details Uses atomic counters, result can be outdated.
 	 */
 	uint32 getWorkingTaskCount();
 
@@ -174,16 +339,22 @@ public:
 	 * 
 	 * @param[in] function target task function
 	 * @param priority task execution priority
+	 * @param[in] dependency job that should be done before the task is queued
+	 * 
+	 * @return Handle of the added task job.
 	 */
-	void addTask(const Task::Function& function, float priority = 0.0f);
+	Job addTask(Task::Function function, float priority = 0.0f, const Job& dependency = {});
 	/**
 	 * @brief Adds new tasks to the pending task queue. (MT-Safe)
 	 * @warning You should manually synchronize data access and prevent race conditions!
 	 * 
 	 * @param[in] functions target task function array
 	 * @param priority tasks execution priority
+	 * @param[in] dependency job that should be done before the tasks are queued
+	 * 
+	 * @return Handle of the added tasks job.
 	 */
-	void addTasks(const vector<Task::Function>& functions, float priority = 0.0f);
+	Job addTasks(vector<Task::Function> functions, float priority = 0.0f, const Job& dependency = {});
 	/**
 	 * @brief Adds a new task count to the pending task queue. (MT-Safe)
 	 * @warning You should manually synchronize data access and prevent race conditions!
@@ -191,8 +362,11 @@ public:
 	 * @param[in] task target task function
 	 * @param count task instance count
 	 * @param priority tasks execution priority
+	 * @param[in] dependency job that should be done before the tasks are queued
+	 * 
+	 * @return Handle of the added tasks job.
 	 */
-	void addTasks(const Task::Function& function, uint32 count, float priority = 0.0f);
+	Job addTasks(Task::Function function, uint32 count, float priority = 0.0f, const Job& dependency = {});
 	/**
 	 * @brief Adds a new items to the pending task queue. (MT-Safe)
 	 * @warning You should manually synchronize data access and prevent race conditions!
@@ -201,20 +375,44 @@ public:
 	 * This function distributes items among all threads in the pool, and creates 
 	 * a number of tasks equal to the number of threads in the pool.
 	 * 
+	 * If grain size is not zero, tasks atomically claim item chunks until all items are processed instead of 
+	 * receiving a fixed item range. Chunk size decreases from a fraction of the remaining items down to the grain 
+	 * size, which balances uneven per item workloads across the threads. In this mode task function is called 
+	 * once for each claimed chunk, with the chunk range in the @ref Task::getItemOffset() and 
+	 * @ref Task::getItemCount(), and the same task index for all chunks claimed by the task.
+	 * 
 	 * @param[in] task target task function
 	 * @param count target item count
 	 * @param priority tasks execution priority
+	 * @param[in] dependency job that should be done before the tasks are queued
+	 * @param grainSize minimal claimed item chunk size (0 = split items evenly)
+	 * 
+	 * @return Handle of the added tasks job.
 	 */
-	void addItems(const Task::Function& task, uint32 count, float priority = 0.0f);
+	Job addItems(Task::Function task, uint32 count, float priority = 0.0f, 
+		const Job& dependency = {}, uint32 grainSize = 0);
+	/**
+	 * @brief Returns a new job that is done when all specified jobs are done. (MT-Safe)
+	 * @details Use it to make tasks depend on the several jobs at once.
+	 * @param[in] jobs target job array
+	 */
+	Job whenAll(const vector<Job>& jobs);
 
 	/**
 	 * @brief Waits until all pending in the queue and running tasks are completed. (Blocking)
 	 * @details Use it wait until all running and pending tasks are completed.
 	 */
 	void wait();
+	/**
+	 * @brief Waits until all specified job tasks are completed. (Blocking)
+	 * @details Foreground pool executes pending tasks on the calling thread while waiting.
+	 * @param[in] job target job to wait for
+	 */
+	void wait(const Job& job);
 	/**
 	 * @brief Drops all pending tasks in the queue. (MT-Safe)
-	 * @details Locks mutex inside to clear the queue.
+	 * @details Pops all tasks from the thread queues without executing them.
+	 * @note Jobs of the dropped tasks are marked as done, and their dependent tasks are also dropped.
 	 */
 	void removeAll();
 	/**
@@ -26,6 +26,72 @@ bool Animation::destroy()
 	return true;
 }
 
+void Animation::bake()
+{
+	frames.clear(); tracks.clear(); trackFrames.clear();
+	trackValues.clear(); trackMasks.clear(); trackCoeffs.clear(); trackFuncs.clear();
+	bakedPropCount = 0; isDirty = false;
+
+	if (keyframes.empty())
+		return;
+
+	const auto& firstAnimatables = keyframes.begin()->second;
+	tracks.reserve(firstAnimatables.size());
+	for (const auto& pair : firstAnimatables)
+	{
+		Track track;
+		track.system = pair.first;
+		track.animatable = dynamic_cast<IAnimatable*>(pair.first);
+		track.componentType = pair.first->getComponentType();
+		track.propCount = track.animatable->getBakedProps(track.interps);
+		GARDEN_ASSERT(track.propCount <= IAnimatable::maxBakedProps);
+		track.valueOffset = bakedPropCount;
+		bakedPropCount += track.propCount;
+		tracks.push_back(track);
+	}
+
+	frames.reserve(keyframes.size());
+	for (const auto& keyframe : keyframes)
+		frames.push_back(keyframe.first);
+
+	auto frameCount = frames.size();
+	trackFrames.resize(tracks.size() * frameCount);
+	trackMasks.resize(trackFrames.size());
+	trackCoeffs.resize(trackFrames.size());
+	trackFuncs.resize(trackFrames.size());
+	trackValues.resize(bakedPropCount * frameCount);
+
+	for (psize i = 0; i < tracks.size(); i++)
+	{
+		auto system = tracks[i].system;
+		auto frameData = trackFrames.data() + i * frameCount;
+		ID<AnimationFrame> animationFrame = {}; psize index = 0;
+
+		for (const auto& keyframe : keyframes)
+		{
+			auto searchResult = keyframe.second.find(system);
+			if (searchResult != keyframe.second.end())
+				animationFrame = searchResult->second;
+			frameData[index++] = animationFrame;
+		}
+
+		const auto& track = tracks[i];
+		for (psize j = 0; j < frameCount; j++)
+		{
+			auto trackIndex = i * frameCount + j;
+			auto frameView = track.animatable->getAnimation(frameData[j]);
+			trackCoeffs[trackIndex] = frameView->funcCoeff;
+			trackFuncs[trackIndex] = frameView->funcType;
+			if (track.propCount == 0)
+				continue;
+
+			f32x4 values[IAnimatable::maxBakedProps];
+			trackMasks[trackIndex] = track.animatable->bakeAnimation(frameView, values);
+			for (uint8 k = 0; k < track.propCount; k++)
+				trackValues[(track.valueOffset + k) * frameCount + j] = values[k];
+		}
+	}
+}
 void Animation::destroyKeyframes(const Keyframes& keyframes)
 {
 	for (const auto& keyframe : keyframes)
@@ -0,0 +1,557 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "garden/binary-scene.hpp"
+#include "garden/json-serialize.hpp"
+#include "garden/base64.hpp"
+
+using namespace garden;
+
+//**********************************************************************************************************************
+static bool validateRecords(const uint8* data, psize size, 
+	uint32 entityCount, const BinarySceneBlock& block, string& error)
+{
+	auto record = data + block.dataOffset;
+	auto blockEnd = record + block.dataSize;
+	uint32 recordCount = 0;
+
+	while (record < blockEnd)
+	{
+		if ((uint64)(blockEnd - record) < sizeof(BinarySceneRecord))
+		{
+			error = "truncated record header";
+			return false;
+		}
+
+		auto header = (const BinarySceneRecord*)record;
+		if (header->size < sizeof(BinarySceneRecord) || header->size % 8 != 0 || 
+			header->size > (uint64)(blockEnd - record))
+		{
+			error = "invalid record size";
+			return false;
+		}
+		if (header->entityIndex >= entityCount)
+		{
+			error = "invalid record entity index";
+			return false;
+		}
+
+		if (block.recordType == BinaryRecordType::Generic)
+		{
+			constexpr uint32 minBsonSize = 5;
+			auto bsonSize = header->size >= sizeof(BinarySceneRecord) + minBsonSize ? 
+				*(const uint32*)(record + sizeof(BinarySceneRecord)) : 0;
+			if (bsonSize < minBsonSize || bsonSize > header->size - sizeof(BinarySceneRecord))
+			{
+				error = "invalid generic record size";
+				return false;
+			}
+		}
+		else if (block.recordType == BinaryRecordType::Transform)
+		{
+			if (header->size != sizeof(BinaryTransformRecord))
+			{
+				error = "invalid transform record size";
+				return false;
+			}
+			auto transformRecord = (const BinaryTransformRecord*)record;
+			if (transformRecord->parentIndex != BinaryTransformRecord::noParent && 
+				transformRecord->parentIndex >= entityCount)
+			{
+				error = "invalid transform parent index";
+				return false;
+			}
+			if (transformRecord->debugNameLength > 0 && (uint64)(record - data) + 
+				transformRecord->debugNameOffset + transformRecord->debugNameLength > size)
+			{
+				error = "invalid transform debug name";
+				return false;
+			}
+		}
+		else if (block.recordType == BinaryRecordType::Rigidbody)
+		{
+			if (header->size < sizeof(BinaryRigidbodyRecord))
+			{
+				error = "invalid rigidbody record size";
+				return false;
+			}
+			auto rigidbodyRecord = (const BinaryRigidbodyRecord*)record;
+			if (sizeof(BinaryRigidbodyRecord) + (uint64)rigidbodyRecord->constraintCount * 
+				sizeof(BinaryConstraintRecord) + rigidbodyRecord->eventListenerLength > header->size)
+			{
+				error = "invalid rigidbody record trailing data";
+				return false;
+			}
+		}
+
+		record += header->size;
+		recordCount++;
+	}
+
+	if (recordCount != block.recordCount)
+	{
+		error = "invalid block record count";
+		return false;
+	}
+	return true;
+}
+
+bool BinaryScene::validate(const uint8* data, psize size, string& error)
+{
+	GARDEN_ASSERT(data);
+
+	if (!isBinary(data, size))
+	{
+		error = "invalid header";
+		return false;
+	}
+
+	auto header = (const BinarySceneHeader*)data;
+	if (header->version != BinarySceneHeader::currentVersion)
+	{
+		error = "unsupported version";
+		return false;
+	}
+	if (header->dataSize != size)
+	{
+		error = "invalid data size";
+		return false;
+	}
+
+	auto tableSize = sizeof(BinarySceneHeader) + (uint64)header->blockCount * sizeof(BinarySceneBlock) + 
+		(uint64)header->entityCount * sizeof(uint16) + header->componentCount * sizeof(uint16);
+	if (tableSize > size)
+	{
+		error = "truncated tables";
+		return false;
+	}
+
+	auto componentCounts = getComponentCounts(data);
+	uint64 componentCount = 0;
+	for (uint32 i = 0; i < header->entityCount; i++)
+		componentCount += componentCounts[i];
+
+	if (componentCount != header->componentCount)
+	{
+		error = "invalid component count";
+		return false;
+	}
+
+	auto componentTypes = getComponentTypes(data);
+	for (uint64 i = 0; i < componentCount; i++)
+	{
+		if (componentTypes[i] >= header->blockCount)
+		{
+			error = "invalid component type index";
+			return false;
+		}
+	}
+
+	auto blocks = getBlocks(data);
+	for (uint32 i = 0; i < header->blockCount; i++)
+	{
+		const auto& block = blocks[i];
+		if (block.recordType >= BinaryRecordType::Count || block.nameLength == 0 ||
+			block.nameOffset > size || block.nameLength > size - block.nameOffset)
+		{
+			error = "invalid block";
+			return false;
+		}
+		if (block.dataOffset % 8 != 0 || block.dataOffset > size || block.dataSize > size - block.dataOffset)
+		{
+			error = "invalid block data";
+			return false;
+		}
+		if (!validateRecords(data, size, header->entityCount, block, error))
+			return false;
+	}
+
+	return true;
+}
+
+//**********************************************************************************************************************
+namespace
+{
+	struct ConvertBlock final
+	{
+		string name;
+		vector<uint8> records;
+		BinaryRecordType recordType = BinaryRecordType::Generic;
+		uint32 recordCount = 0;
+	};
+}
+
+static void addRecord(ConvertBlock& block, uint32 entityIndex, const void* record, 
+	psize recordSize, const void* trailing = nullptr, psize trailingSize = 0)
+{
+	auto totalSize = (recordSize + trailingSize + 7) & ~(psize)7;
+	if (totalSize > UINT32_MAX)
+		throw GardenError("Too big scene component record. (type: " + block.name + ")");
+
+	auto offset = block.records.size();
+	block.records.resize(offset + totalSize);
+	auto data = block.records.data() + offset;
+	memcpy(data, record, recordSize);
+	if (trailingSize > 0)
+		memcpy(data + recordSize, trailing, trailingSize);
+
+	auto header = (BinarySceneRecord*)data;
+	header->entityIndex = entityIndex;
+	header->size = (uint32)totalSize;
+	block.recordCount++;
+}
+
+static bool readUID(JsonDeserializer& deserializer, string_view name, string& valueString, uint64& uid)
+{
+	if (!deserializer.read(name, valueString) || 
+		valueString.size() + 1 != modp_b64_encode_data_len(sizeof(uint64)))
+	{
+		return false;
+	}
+	return decodeBase64URL(&uid, valueString, ModpDecodePolicy::kForgiving);
+}
+
+//**********************************************************************************************************************
+static void convertTransform(JsonDeserializer& deserializer, string& valueString, BinaryTransformRecord& record)
+{
+	readUID(deserializer, "uid", valueString, record.uid);
+
+	auto f32x4Value = f32x4::zero; auto rotation = quat::identity;
+	deserializer.read("position", f32x4Value, 3);
+	record.position = (float3)f32x4Value;
+	deserializer.read("rotation", rotation);
+	record.rotation = (float4)rotation;
+	f32x4Value = f32x4::one;
+	deserializer.read("scale", f32x4Value, 3);
+	record.scale = (float3)f32x4Value;
+
+	auto boolValue = true;
+	deserializer.read("isActive", boolValue);
+	record.isActive = boolValue;
+
+	if (!readUID(deserializer, "parent", valueString, record.parentUID) || record.parentUID == record.uid)
+		record.parentUID = 0;
+}
+
+static void convertRigidbody(JsonDeserializer& deserializer, string& valueString, 
+	BinaryRigidbodyRecord& record, vector<BinaryConstraintRecord>& constraints, string& eventListener)
+{
+	readUID(deserializer, "uid", valueString, record.uid);
+
+	if (deserializer.read("motionType", valueString))
+	{
+		if (valueString == "Kinematic")
+			record.motionType = 1;
+		else if (valueString == "Dynamic")
+			record.motionType = 2;
+	}
+
+	eventListener.clear();
+	deserializer.read("eventListener", eventListener);
+
+	if (deserializer.read("shapeType", valueString))
+	{
+		auto f32x4Value = f32x4::zero; auto rotation = quat::identity;
+		if (valueString == "RotatedTranslated")
+		{
+			if (deserializer.read("innerShapeType", valueString) && valueString == "Box")
+			{
+				record.shapeType = BinaryShapeType::RotatedTranslatedBox;
+				f32x4Value = f32x4(0.5f);
+				deserializer.read("innerHalfExtent", f32x4Value, 3);
+				record.halfExtent = (float3)f32x4Value;
+				deserializer.read("innerConvexRadius", record.convexRadius);
+				f32x4Value = f32x4::zero;
+				deserializer.read("shapePosition", f32x4Value, 3);
+				record.shapePosition = (float3)f32x4Value;
+				deserializer.read("shapeRotation", rotation);
+				record.shapeRotation = (float4)rotation;
+			}
+		}
+		else if (valueString == "Box")
+		{
+			record.shapeType = BinaryShapeType::Box;
+			f32x4Value = f32x4(0.5f);
+			deserializer.read("halfExtent", f32x4Value, 3);
+			record.halfExtent = (float3)f32x4Value;
+			deserializer.read("convexRadius", record.convexRadius);
+		}
+
+		if (record.shapeType != BinaryShapeType::None)
+		{
+			auto boolValue = false;
+			if (deserializer.read("isActive", boolValue) && boolValue)
+				record.flags |= BinaryRigidbodyFlags::IsActive;
+			if (deserializer.read("allowDynamicOrKinematic", boolValue) && boolValue)
+				record.flags |= BinaryRigidbodyFlags::AllowDynamicOrKinematic;
+			if (deserializer.read("isSensor", boolValue) && boolValue)
+				record.flags |= BinaryRigidbodyFlags::IsSensor;
+			if (deserializer.read("isKinematicVsStatic", boolValue) && boolValue)
+				record.flags |= BinaryRigidbodyFlags::IsKinematicVsStatic;
+			deserializer.read("collisionLayer", record.collisionLayer);
+
+			constexpr const char* dofNames[6] =
+			{
+				"allowedDofTransX", "allowedDofTransY", "allowedDofTransZ",
+				"allowedDofRotX", "allowedDofRotY", "allowedDofRotZ"
+			};
+			for (uint8 i = 0; i < 6; i++)
+			{
+				if (deserializer.read(dofNames[i], boolValue) && !boolValue)
+					record.allowedDOF &= ~(uint8)(1u << i);
+			}
+
+			f32x4Value = f32x4::zero; rotation = quat::identity;
+			deserializer.read("position", f32x4Value, 3);
+			record.position = (float3)f32x4Value;
+			deserializer.read("rotation", rotation);
+			record.rotation = (float4)rotation;
+
+			f32x4Value = f32x4::zero;
+			deserializer.read("linearVelocity", f32x4Value, 3);
+			record.linearVelocity = (float3)f32x4Value;
+			f32x4Value = f32x4::zero;
+			deserializer.read("angularVelocity", f32x4Value, 3);
+			record.angularVelocity = (float3)f32x4Value;
+		}
+	}
+
+	constraints.clear();
+	if (deserializer.beginChild("constraints"))
+	{
+		auto constraintCount = (uint32)deserializer.getArraySize();
+		for (uint32 i = 0; i < constraintCount; i++)
+		{
+			if (!deserializer.beginArrayElement(i))
+				break;
+
+			BinaryConstraintRecord constraint;
+			if (readUID(deserializer, "uid", valueString, constraint.otherUID) && constraint.otherUID != record.uid)
+			{
+				if (deserializer.read("type", valueString) && valueString == "Point")
+					constraint.type = 1;
+				constraints.push_back(constraint);
+			}
+			deserializer.endArrayElement();
+		}
+		deserializer.endChild();
+	}
+
+	record.constraintCount = (uint32)constraints.size();
+	record.eventListenerLength = (uint32)eventListener.size();
+}
+
+//**********************************************************************************************************************
+void BinaryScene::convert(JsonDeserializer& deserializer, vector<uint8>& data, bool keepDebugNames)
+{
+	vector<ConvertBlock> blocks;
+	tsl::robin_map<string, uint16> blockIndices;
+	tsl::robin_map<uint64, uint32> transformEntities;
+	vector<pair<psize, uint64>> transformParents;
+	vector<pair<psize, psize>> transformDebugNames;
+	vector<uint16> componentCounts, componentTypes;
+	vector<BinaryConstraintRecord> constraints;
+	vector<uint8> bson, trailing;
+	string type, valueString, eventListener, debugNames;
+
+	if (deserializer.beginChild("entities"))
+	{
+		auto entityCount = (uint32)deserializer.getArraySize();
+		for (uint32 i = 0; i < entityCount; i++)
+		{
+			if (!deserializer.beginArrayElement(i))
+				break;
+
+			if (!deserializer.beginChild("components"))
+			{
+				deserializer.endArrayElement();
+				continue;
+			}
+
+			auto entityIndex = (uint32)componentCounts.size();
+			auto componentCount = (uint32)deserializer.getArraySize();
+			uint32 entityComponentCount = 0;
+
+			for (uint32 j = 0; j < componentCount; j++)
+			{
+				if (!deserializer.beginArrayElement(j))
+					break;
+
+				if (!deserializer.read(".type", type) || type.empty())
+				{
+					deserializer.endArrayElement();
+					continue;
+				}
+
+				auto result = blockIndices.find(type);
+				if (result == blockIndices.end())
+				{
+					if (blocks.size() >= UINT16_MAX)
+						throw GardenError("Too many scene component types.");
+
+					ConvertBlock block;
+					block.name = type;
+					if (type == "Transform")
+						block.recordType = BinaryRecordType::Transform;
+					else if (type == "Rigidbody")
+						block.recordType = BinaryRecordType::Rigidbody;
+					result = blockIndices.emplace(type, (uint16)blocks.size()).first;
+					blocks.push_back(std::move(block));
+				}
+
+				auto& block = blocks[result->second];
+				if (block.recordType == BinaryRecordType::Transform)
+				{
+					BinaryTransformRecord record;
+					convertTransform(deserializer, valueString, record);
+
+					if (record.uid)
+						transformEntities.emplace(record.uid, entityIndex);
+					if (record.parentUID)
+						transformParents.emplace_back(block.records.size(), record.parentUID);
+
+					if (keepDebugNames && deserializer.read("debugName", valueString) && !valueString.empty())
+					{
+						if (valueString.size() > UINT32_MAX)
+							throw GardenError("Too long scene entity debug name. (entity: " + to_string(i) + ")");
+						transformDebugNames.emplace_back(block.records.size(), debugNames.size());
+						record.debugNameLength = (uint32)valueString.size();
+						debugNames += valueString;
+					}
+					addRecord(block, entityIndex, &record, sizeof(BinaryTransformRecord));
+				}
+				else if (block.recordType == BinaryRecordType::Rigidbody)
+				{
+					BinaryRigidbodyRecord record;
+					convertRigidbody(deserializer, valueString, record, constraints, eventListener);
+
+					auto constraintsSize = constraints.size() * sizeof(BinaryConstraintRecord);
+					trailing.resize(constraintsSize + eventListener.size());
+					if (constraintsSize > 0)
+						memcpy(trailing.data(), constraints.data(), constraintsSize);
+					if (!eventListener.empty())
+						memcpy(trailing.data() + constraintsSize, eventListener.data(), eventListener.size());
+					addRecord(block, entityIndex, &record, sizeof(BinaryRigidbodyRecord), 
+						trailing.data(), trailing.size());
+				}
+				else
+				{
+					deserializer.toBson(bson, keepDebugNames ? string_view() : "debugName");
+					BinarySceneRecord record;
+					addRecord(block, entityIndex, &record, sizeof(BinarySceneRecord), bson.data(), bson.size());
+				}
+
+				componentTypes.push_back(result->second);
+				entityComponentCount++;
+				deserializer.endArrayElement();
+			}
+
+			deserializer.endChild();
+			deserializer.endArrayElement();
+
+			if (entityComponentCount == 0)
+				continue;
+			if (entityComponentCount > UINT16_MAX)
+				throw GardenError("Too many scene entity components. (entity: " + to_string(i) + ")");
+			componentCounts.push_back((uint16)entityComponentCount);
+		}
+		deserializer.endChild();
+	}
+
+	auto transformBlock = blockIndices.find("Transform");
+	if (transformBlock != blockIndices.end())
+	{
+		auto records = blocks[transformBlock->second].records.data();
+		for (auto pair : transformParents)
+		{
+			auto result = transformEntities.find(pair.second);
+			if (result == transformEntities.end())
+				continue; // Note: Parent is resolved by UID on load, same as in the JSON scene.
+			auto record = (BinaryTransformRecord*)(records + pair.first);
+			record->parentIndex = result->second;
+			record->parentUID = 0;
+		}
+	}
+
+	BinarySceneHeader header;
+	header.entityCount = (uint32)componentCounts.size();
+	header.blockCount = (uint32)blocks.size();
+	header.componentCount = componentTypes.size();
+
+	auto namesOffset = sizeof(BinarySceneHeader) + blocks.size() * sizeof(BinarySceneBlock) + 
+		(componentCounts.size() + componentTypes.size()) * sizeof(uint16);
+	auto dataOffset = namesOffset;
+	for (const auto& block : blocks)
+		dataOffset += block.name.size();
+	dataOffset = (dataOffset + 7) & ~(psize)7;
+
+	auto dataSize = dataOffset;
+	for (const auto& block : blocks)
+		dataSize += block.records.size();
+	auto debugNamesOffset = dataSize;
+	dataSize += debugNames.size();
+	header.dataSize = dataSize;
+
+	data.assign(dataSize, 0);
+	auto binaryData = data.data();
+	memcpy(binaryData, &header, sizeof(BinarySceneHeader));
+
+	auto binaryBlocks = (BinarySceneBlock*)(binaryData + sizeof(BinarySceneHeader));
+	psize transformDataOffset = 0;
+
+	for (psize i = 0; i < blocks.size(); i++)
+	{
+		const auto& block = blocks[i];
+		if (block.recordType == BinaryRecordType::Transform)
+			transformDataOffset = dataOffset;
+
+		BinarySceneBlock binaryBlock;
+		binaryBlock.dataOffset = dataOffset;
+		binaryBlock.dataSize = block.records.size();
+		binaryBlock.nameOffset = namesOffset;
+		binaryBlock.nameLength = (uint32)block.name.size();
+		binaryBlock.recordCount = block.recordCount;
+		binaryBlock.recordType = block.recordType;
+		memcpy(binaryBlocks + i, &binaryBlock, sizeof(BinarySceneBlock));
+
+		memcpy(binaryData + namesOffset, block.name.data(), block.name.size());
+		if (!block.records.empty())
+			memcpy(binaryData + dataOffset, block.records.data(), block.records.size());
+		namesOffset += block.name.size();
+		dataOffset += block.records.size();
+	}
+
+	auto tables = (uint8*)(binaryBlocks + blocks.size());
+	if (!componentCounts.empty())
+		memcpy(tables, componentCounts.data(), componentCounts.size() * sizeof(uint16));
+	tables += componentCounts.size() * sizeof(uint16);
+	if (!componentTypes.empty())
+		memcpy(tables, componentTypes.data(), componentTypes.size() * sizeof(uint16));
+
+	if (debugNames.empty())
+		return;
+
+	memcpy(binaryData + debugNamesOffset, debugNames.data(), debugNames.size());
+	for (auto pair : transformDebugNames)
+	{
+		auto recordOffset = transformDataOffset + pair.first;
+		auto nameOffset = debugNamesOffset + pair.second - recordOffset;
+		if (nameOffset > UINT32_MAX)
+			throw GardenError("Too big scene debug names offset.");
+
+		auto record = (BinaryTransformRecord*)(binaryData + recordOffset);
+		record->debugNameOffset = (uint32)nameOffset;
+	}
+}
@@ -84,7 +84,7 @@ void AnimationEditorSystem::onEntityInspector(ID<Entity> entity, bool isOpened)
 	{
 		auto animationView = Manager::Instance::get()->get<AnimationComponent>(entity);
 		ImGui::Text("Playing: %s, Frame: %f", animationView->isPlaying ?
-			animationView->active.c_str() : "none", animationView->frame);
+			animationView->getActive().c_str() : "none", animationView->frame);
 		ImGui::EndTooltip();
 	}
 
@@ -102,18 +102,20 @@ void AnimationEditorSystem::onEntityInspector(ID<Entity> entity, bool isOpened)
 	ImGui::SameLine();
 	ImGui::Checkbox("Randomize Start", &animationView->randomizeStart);
 
-	ImGui::InputText("Active", &animationView->active); // TODO: dropdown selector
+	auto active = animationView->getActive();
+	if (ImGui::InputText("Active", &active)) // TODO: dropdown selector
+		animationView->setActive(active);
 	if (ImGui::BeginPopupContextItem("active"))
 	{
 		if (ImGui::MenuItem("Reset Default"))
-			animationView->active = "";
+			animationView->setActive("");
 		ImGui::EndPopup();
 	}
 	if (ImGui::BeginDragDropTarget())
 	{
 		auto payload = ImGui::AcceptDragDropPayload("AnimationPath");
 		if (payload)
-			animationView->active = string((const char*)payload->Data, payload->DataSize);
+			animationView->setActive(string_view((const char*)payload->Data, payload->DataSize));
 		ImGui::EndDragDropTarget();
 	}
 
@@ -154,7 +156,7 @@ void AnimationEditorSystem::onEntityInspector(ID<Entity> entity, bool isOpened)
 			if (ImGui::BeginPopupContextItem(i->first.c_str()))
 			{
 				if (ImGui::MenuItem("Set As Active"))
-					animationView->active = i->first;
+					animationView->setActive(i->first);
 				if (ImGui::MenuItem("Copy Animation Path"))
 					ImGui::SetClipboardText(i->first.c_str());
 
@@ -95,6 +95,43 @@ void PhysicsEditorSystem::preDsLdrRender()
 			ImGui::Spacing();
 		}
 
+		if (ImGui::CollapsingHeader("Network Loopback"))
+		{
+			auto& properties = netLoopbackProperties;
+			int bodyCount = properties.bodyCount, tickCount = properties.tickCount;
+			int latencyTicks = properties.latencyTicks, jitterTicks = properties.jitterTicks;
+			if (ImGui::DragInt("Body Count", &bodyCount))
+				properties.bodyCount = clamp(bodyCount, 1, 65536);
+			if (ImGui::DragInt("Tick Count", &tickCount))
+				properties.tickCount = clamp(tickCount, 1, 65536);
+			if (ImGui::DragInt("Latency", &latencyTicks, 1.0f, 0, 0, "%d ticks"))
+				properties.latencyTicks = clamp(latencyTicks, 0, 1000);
+			if (ImGui::DragInt("Jitter", &jitterTicks, 1.0f, 0, 0, "%d ticks"))
+				properties.jitterTicks = clamp(jitterTicks, 0, 1000);
+			ImGui::SliderFloat("Loss Rate", &properties.lossRate, 0.0f, 1.0f);
+			ImGui::SliderFloat("Rest Rate", &properties.restRate, 0.0f, 1.0f);
+
+			if (ImGui::Button("Run Loopback", ImVec2(-FLT_MIN, 0.0f)))
+			{
+				netLoopbackStats = physicsSystem->runNetLoopback(properties);
+				hasNetLoopbackStats = true;
+			}
+
+			if (hasNetLoopbackStats)
+			{
+				const auto& stats = netLoopbackStats;
+				auto ratio = stats.fullStateBytes > 0 ? (double)stats.sentBytes / (double)stats.fullStateBytes : 0.0;
+				ImGui::Text("Sent: %llu bytes, %u datagrams (%.1f%% of full state)", 
+					(unsigned long long)stats.sentBytes, stats.sentDatagrams, ratio * 100.0);
+				ImGui::Text("Lost datagrams: %u, Acks: %u, Bad data: %u", 
+					stats.lostDatagrams, stats.ackCount, stats.badDataCount);
+				ImGui::Text("Reordered datagrams: %u, Stale bodies: %u", stats.reorderedCount, stats.staleCount);
+				ImGui::Text("Mismatched bodies: %u / %u visible", stats.mismatchCount, stats.visibleCount);
+				ImGui::Text("Baselines left: %u, Histories left: %u", stats.baselineCount, stats.historyCount);
+			}
+			ImGui::Spacing();
+		}
+
 		// TODO: visualize collision matrix and other physics settings.
 
 		if (debugRenderer)
@@ -167,6 +167,9 @@ void SpriteRenderEditorSystem::renderComponent(SpriteRenderComponent* componentV
 			maxMipCount, Image::Strategy::Default, flags, componentView->taskPriority);
 	}
 
+	ImGui::Checkbox("Occluder", &componentView->isOccluder);
+	ImGui::SameLine();
+
 	ImGui::BeginDisabled();
 	auto isVisible = componentView->isVisible;
 	ImGui::Checkbox("Is Visible", &isVisible);
@@ -187,24 +190,41 @@ void SpriteRenderEditorSystem::renderComponent(SpriteRenderComponent* componentV
 	}
 
 	auto aabbMin = componentView->aabb.getMin(), aabbMax = componentView->aabb.getMax();
+	auto isAabbChanged = false;
 	if (ImGui::DragFloat3("Min AABB", &aabbMin, 0.01f))
+	{
 		componentView->aabb.trySet(aabbMin, aabbMax);
+		isAabbChanged = true;
+	}
 	if (ImGui::BeginPopupContextItem("minAabb"))
 	{
 		if (ImGui::MenuItem("Reset Default"))
+		{
 			componentView->aabb = Aabb::one;
+			isAabbChanged = true;
+		}
 		ImGui::EndPopup();
 	}
 
 	if (ImGui::DragFloat3("Max AABB", &aabbMax, 0.01f))
+	{
 		componentView->aabb.trySet(aabbMin, aabbMax);
+		isAabbChanged = true;
+	}
 	if (ImGui::BeginPopupContextItem("maxAabb"))
 	{
 		if (ImGui::MenuItem("Reset Default"))
+		{
 			componentView->aabb = Aabb::one;
+			isAabbChanged = true;
+		}
 		ImGui::EndPopup();
 	}
 
+	auto meshSystem = MeshRenderSystem::Instance::tryGet();
+	if (isAabbChanged && meshSystem)
+		meshSystem->markStaticMeshesDirty();
+
 	ImGui::DragFloat2("UV Size", &componentView->uvSize, 0.01f);
 	if (ImGui::BeginPopupContextItem("uvSize"))
 	{
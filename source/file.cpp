@@ -18,6 +18,15 @@
 #include <fstream>
 #include <random>
 
+#if GARDEN_OS_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 using namespace garden;
 
 //**********************************************************************************************************************
@@ -115,6 +124,88 @@ fs::path File::createTmpName()
 	return toHex<uint32>(uuid, 4);
 }
 
+//**********************************************************************************************************************
+bool MappedFile::tryMap(const fs::path& filePath)
+{
+	GARDEN_ASSERT(!filePath.empty());
+	unmap();
+
+	#if GARDEN_OS_WINDOWS
+	auto file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, 
+		NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	auto mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	this->fileHandle = file;
+	this->mappingHandle = mapping;
+	this->data = (const uint8*)view;
+	this->size = (psize)fileSize.QuadPart;
+	#else
+	auto file = open(filePath.c_str(), O_RDONLY);
+	if (file == -1)
+		return false;
+
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		close(file);
+		return false;
+	}
+
+	auto view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file); // Note: Mapping keeps its own file reference.
+	if (view == MAP_FAILED)
+		return false;
+
+	#if !GARDEN_OS_APPLE
+	madvise(view, (size_t)fileStat.st_size, MADV_WILLNEED);
+	#endif
+
+	this->data = (const uint8*)view;
+	this->size = (psize)fileStat.st_size;
+	#endif
+	return true;
+}
+void MappedFile::unmap()
+{
+	if (!data)
+		return;
+
+	#if GARDEN_OS_WINDOWS
+	UnmapViewOfFile(data);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+	fileHandle = mappingHandle = nullptr;
+	#else
+	munmap((void*)data, size);
+	#endif
+
+	data = nullptr;
+	size = 0;
+}
+
 #if GARDEN_DEBUG || GARDEN_EDITOR || !GARDEN_PACK_RESOURCES
 bool File::tryGetResourcePath(const fs::path& appResourcesPath, const fs::path& resourcePath, fs::path& filePath)
 {
@@ -257,7 +257,7 @@ void AddressPool::addBufferBarriers(Buffer::BarrierState newState)
 				barriers[barrierCount++] = buffers[i];
 		}
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 
 	BufferBarrierCommand command;
 	command.newState = newState;
@@ -14,6 +14,7 @@
 
 #include "garden/graphics/api.hpp"
 #include "garden/graphics/vulkan/api.hpp"
+#include "garden/graphics/null/api.hpp"
 #include "garden/graphics/glfw.hpp" // Note: Do not move it.
 #include "garden/system/log.hpp" // TODO: we should not include system here
 
@@ -73,6 +74,12 @@ GraphicsAPI::GraphicsAPI(const string& appName, uint2 windowSize,
 	glfwSetWindowSizeLimits(window, GraphicsAPI::minFramebufferSize, 
 		GraphicsAPI::minFramebufferSize, GLFW_DONT_CARE, GLFW_DONT_CARE);
 
+	if (glfwGetPlatform() == GLFW_PLATFORM_NULL)
+	{
+		displayProtocol = DisplayProtocol::None;
+		return;
+	}
+
 	#if GARDEN_OS_LINUX
 	switch(glfwGetPlatform())
 	{
@@ -124,6 +131,12 @@ void GraphicsAPI::initialize(GraphicsBackend backendType, const string& appName,
 	basist::basisu_transcoder_init();
 	#endif
 
+	if (backendType == GraphicsBackend::NullAPI)
+	{
+		// Note: GLFW null platform creates a headless window, so input system still works.
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+	}
+
 	#if GARDEN_OS_LINUX
 		#if GARDEN_MESA_RGP
 		const auto forceX11 = true;
@@ -131,7 +144,7 @@ void GraphicsAPI::initialize(GraphicsBackend backendType, const string& appName,
 		const auto forceX11 = false;
 		#endif
 
-	if (isEnv("GLFW_PLATFORM", "x11") || forceX11)
+	if ((isEnv("GLFW_PLATFORM", "x11") || forceX11) && backendType != GraphicsBackend::NullAPI)
 		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
 	#endif
 
@@ -149,6 +162,11 @@ void GraphicsAPI::initialize(GraphicsBackend backendType, const string& appName,
 		apiInstance = new VulkanAPI(appName, appDataName, appVersion, windowSize, 
 			threadPool, useVsync, useTripleBuffering, isFullscreen, isDecorated);
 	}
+	else if (backendType == GraphicsBackend::NullAPI)
+	{
+		apiInstance = new NullAPI(appName, windowSize, threadPool, 
+			useVsync, useTripleBuffering, isFullscreen, isDecorated);
+	}
 	else abort();
 }
 void GraphicsAPI::terminate()
@@ -14,6 +14,7 @@
 
 #include "garden/graphics/buffer.hpp"
 #include "garden/graphics/vulkan/api.hpp"
+#include "garden/graphics/null/api.hpp"
 
 using namespace std;
 using namespace math;
@@ -150,6 +151,16 @@ static void createVkBuffer(Buffer::Usage usage, Buffer::CpuAccess cpuAccess, Buf
 	}
 }
 
+static void createNullBuffer(Buffer::CpuAccess cpuAccess, uint64 size, void*& instance, void*& allocation, uint8*& map)
+{
+	if (cpuAccess != Buffer::CpuAccess::None)
+	{
+		map = malloc<uint8>(size);
+		allocation = map; // Note: Host memory is released by the null API destroy buffer.
+	}
+	instance = NullAPI::createInstance();
+}
+
 //**********************************************************************************************************************
 Buffer::Buffer(Usage usage, CpuAccess cpuAccess, Location location, Strategy strategy, uint64 size,
 	uint64 version) : Memory(size, cpuAccess, location, strategy, version)
@@ -166,6 +177,8 @@ Buffer::Buffer(Usage usage, CpuAccess cpuAccess, Location location, Strategy str
 	auto graphicsBackend = graphicsAPI->getBackendType();
 	if (graphicsBackend == GraphicsBackend::VulkanAPI)
 		createVkBuffer(usage, cpuAccess, location, strategy, size, instance, allocation, map, deviceAddress);
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		createNullBuffer(cpuAccess, size, instance, allocation, map);
 	else abort();
 
 	this->usage = usage;
@@ -227,6 +240,12 @@ bool Buffer::destroy()
 			vmaDestroyBuffer(vulkanAPI->memoryAllocator, (VkBuffer)instance, (VmaAllocation)allocation);
 		else vulkanAPI->destroyResource(GraphicsAPI::DestroyResourceType::Buffer, instance, allocation);
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+	{
+		if (graphicsAPI->forceResourceDestroy)
+			free(allocation);
+		else graphicsAPI->destroyResource(GraphicsAPI::DestroyResourceType::Buffer, instance, allocation);
+	}
 	else abort();
 
 	return true;
@@ -247,7 +266,7 @@ void Buffer::invalidate(uint64 size, uint64 offset)
 		if (result != VK_SUCCESS)
 			throw GardenError("Failed to invalidate buffer memory.");
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 void Buffer::flush(uint64 size, uint64 offset)
 {
@@ -263,7 +282,7 @@ void Buffer::flush(uint64 size, uint64 offset)
 		if (result != VK_SUCCESS)
 			throw GardenError("Failed to flush buffer memory.");
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 void Buffer::writeData(const void* data, uint64 size, uint64 offset)
 {
@@ -292,7 +311,7 @@ void Buffer::writeData(const void* data, uint64 size, uint64 offset)
 		flush(size, offset);
 		vmaUnmapMemory(vulkanAPI->memoryAllocator, (VmaAllocation)allocation);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 
 //**********************************************************************************************************************
@@ -426,6 +445,6 @@ void Buffer::setDebugName(const string& name)
 		vulkanAPI->device.setDebugUtilsObjectNameEXT(nameInfo);
 		#endif
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 #endif
\ No newline at end of file
@@ -57,6 +57,8 @@ void CommandBuffer::processCommands()
 		{
 		case Command::Type::BufferBarrier:
 			processCommand(*(const BufferBarrierCommand*)command); break;
+		case Command::Type::PipelineBarrier:
+			processCommand(*(const PipelineBarrierCommand*)command); break;
 		case Command::Type::BeginRenderPass:
 			processCommand(*(const BeginRenderPassCommand*)command); break;
 		case Command::Type::Execute:
@@ -14,6 +14,7 @@
 
 #include "garden/graphics/descriptor-set.hpp"
 #include "garden/graphics/vulkan/api.hpp"
+#include "garden/graphics/null/api.hpp"
 
 using namespace math;
 using namespace garden;
@@ -598,6 +599,11 @@ DescriptorSet::DescriptorSet(ID<Pipeline> pipeline, PipelineType pipelineType, U
 	auto graphicsBackend = GraphicsAPI::get()->getBackendType();
 	if (graphicsBackend == GraphicsBackend::VulkanAPI)
 		this->instance = createVkDescriptorSet(pipeline, pipelineType, uniforms, setCount, index);
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+	{
+		this->setCount = (uint8)uniforms.begin()->second.resourceSets.size();
+		this->instance = NullAPI::createInstance();
+	}
 	else abort();
 
 	barriers.resize(uniforms.begin()->second.resourceSets.size());
@@ -612,7 +618,7 @@ bool DescriptorSet::destroy()
 	auto graphicsBackend = GraphicsAPI::get()->getBackendType();
 	if (graphicsBackend == GraphicsBackend::VulkanAPI)
 		destroyVkDescriptorSet(instance, pipeline, pipelineType, uniforms, setCount, index);
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 
 	return true;
 }
@@ -729,7 +735,7 @@ void DescriptorSet::recreate(Uniforms&& uniforms, Samplers&& samplers)
 		recreateVkDescriptorSet(this->uniforms, uniforms, samplers, pipelineUniforms, 
 			descriptorPool, descriptorSetLayout, framebufferView, barriers, instance, index);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 
 	this->uniforms = std::move(uniforms);
 }
@@ -829,7 +835,7 @@ void DescriptorSet::updateResources(string_view name, uint32 elementCount, uint3
 		updateVkDescriptorSetResources(instance, dsUniform->second, pipelineUniform->second, 
 			framebufferView, barriers[setIndex], elementCount, elementOffset, setIndex);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 
 #if GARDEN_DEBUG || GARDEN_EDITOR
@@ -866,6 +872,6 @@ void DescriptorSet::setDebugName(const string& name)
 		}
 		#endif
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 #endif
\ No newline at end of file
@@ -102,6 +102,8 @@ static uint32 getDepthStencilLayout(Framebuffer::Attachment depthStencilAttachme
 				vk::ImageLayout::eDepthStencilAttachmentOptimal : vk::ImageLayout::eDepthStencilReadOnlyOptimal);
 		}
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		return 0;
 	else abort();
 }
 
@@ -118,7 +120,7 @@ Framebuffer::Framebuffer(uint2 size, vector<Attachment>&& colorAttachments, Atta
 		if (!VulkanAPI::get()->features.dynamicRendering)
 			throw GardenError("Dynamic rendering is not supported on this GPU.");
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 
 	this->colorAttachments = std::move(colorAttachments);
 	this->depthStencilAttachment = depthStencilAttachment;
@@ -308,7 +310,7 @@ void Framebuffer::beginRenderPass(const float4* clearColors, uint8 clearColorCou
 			VulkanAPI::get()->vulkanSwapchain->beginSecondaryCommandBuffers(
 				colorAttachments, depthStencilAttachment, name);
 		}
-		else abort();
+		else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 
 		auto threadCount = graphicsAPI->getThreadPool()->getThreadCount();
 		for (uint32 i = 0; i < threadCount; i++)
@@ -352,6 +354,8 @@ void Framebuffer::endRenderPass()
 	auto graphicsBackend = graphicsAPI->getBackendType();
 	if (graphicsBackend == GraphicsBackend::VulkanAPI)
 		VulkanAPI::get()->vulkanSwapchain->endSecondaryCommandBuffers();
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		currentCommandBuffer->addCommand(ExecuteCommand()); // Note: Merges async commands and locks.
 	else abort();
 
 	EndRenderPassCommand command;
@@ -18,8 +18,12 @@
 #include "garden/graphics/gslc.hpp"
 #include "garden/thread-pool.hpp"
 #include "garden/file.hpp"
+#include "garden/hash.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <random>
 #include <exception>
 #include <fstream>
 #include <sstream>
@@ -1383,7 +1387,145 @@ static bool openShaderFileStream(const fs::path& inputFilePath,
 	outputFileStream << "#version 460\n" COMMON_GLSL_EXTENSIONS "#include \"types.gsl\"\n";
 	return true;
 }
-static void compileShaderFile(const fs::path& filePath, const vector<fs::path>& includePaths)
+static void hashShaderIncludes(Hash128::State hashState, string_view source, const fs::path& directory, 
+	const vector<fs::path>& includePaths, vector<fs::path>& visitedPaths)
+{
+	psize lineOffset = 0;
+	while (lineOffset < source.length())
+	{
+		auto lineEnd = source.find('\n', lineOffset);
+		if (lineEnd == string_view::npos)
+			lineEnd = source.length();
+		auto line = source.substr(lineOffset, lineEnd - lineOffset);
+		lineOffset = lineEnd + 1;
+
+		auto position = line.find_first_not_of(" \t");
+		if (position == string_view::npos || line.compare(position, 8, "#include") != 0)
+			continue;
+		auto nameBegin = line.find_first_of("\"<", position + 8);
+		if (nameBegin == string_view::npos)
+			continue;
+		auto nameEnd = line.find_first_of("\">", nameBegin + 1);
+		if (nameEnd == string_view::npos)
+			continue;
+
+		auto name = fs::path(line.substr(nameBegin + 1, nameEnd - nameBegin - 1));
+		fs::path includePath;
+
+		if (line[nameBegin] == '"' && fs::exists(directory / name))
+		{
+			includePath = directory / name;
+		}
+		else
+		{
+			for (const auto& path : includePaths)
+			{
+				if (!fs::exists(path / name))
+					continue;
+				includePath = path / name;
+				break;
+			}
+		}
+
+		if (includePath.empty())
+			continue; // Note: glslc will report missing include file.
+
+		includePath = includePath.lexically_normal();
+		if (find(visitedPaths.begin(), visitedPaths.end(), includePath) != visitedPaths.end())
+			continue;
+		visitedPaths.push_back(includePath);
+
+		vector<uint8> includeData;
+		if (!File::tryLoadBinary(includePath, includeData))
+			continue;
+
+		auto pathString = includePath.generic_string();
+		Hash128::updateState(hashState, pathString.c_str(), pathString.length() + 1);
+		Hash128::updateState(hashState, includeData);
+
+		hashShaderIncludes(hashState, string_view((const char*)includeData.data(), includeData.size()), 
+			includePath.parent_path(), includePaths, visitedPaths);
+	}
+}
+
+static const string& getGlslcVersion()
+{
+	static const string glslcVersion = []()
+	{
+		#if GARDEN_OS_WINDOWS
+		auto pipe = _popen("glslc --version", "r");
+		#else
+		auto pipe = popen("glslc --version", "r");
+		#endif
+		if (!pipe)
+			return string();
+
+		string version; char buffer[256];
+		while (fgets(buffer, sizeof(buffer), pipe))
+			version += buffer;
+
+		#if GARDEN_OS_WINDOWS
+		auto result = _pclose(pipe);
+		#else
+		auto result = pclose(pipe);
+		#endif
+		return result == 0 ? version : string();
+	}();
+	return glslcVersion;
+}
+
+static fs::path getSpvCachePath(const fs::path& filePath, const fs::path& outputPath, 
+	const vector<fs::path>& includePaths, const vector<const char*>& glslcArgs)
+{
+	// Note: Compiler update can change generated code, so its version is a part of the cache key.
+	const auto& glslcVersion = getGlslcVersion();
+	if (glslcVersion.empty())
+		return {}; // Note: Not caching when compiler version is unknown.
+
+	vector<uint8> sourceData;
+	if (!File::tryLoadBinary(filePath, sourceData))
+		throw CompileError("failed to open generated shader file");
+
+	auto hashState = Hash128::createState();
+	Hash128::resetState(hashState);
+	Hash128::updateState(hashState, glslcVersion.c_str(), glslcVersion.length() + 1);
+
+	for (auto arg : glslcArgs)
+		Hash128::updateState(hashState, arg, strlen(arg) + 1);
+	Hash128::updateState(hashState, sourceData);
+
+	vector<fs::path> visitedPaths;
+	hashShaderIncludes(hashState, string_view((const char*)sourceData.data(), sourceData.size()), 
+		filePath.parent_path(), includePaths, visitedPaths);
+
+	auto hash = Hash128::digestState(hashState);
+	Hash128::destroyState(hashState);
+
+	// Note: Cache key includes the whole include dependency set, unchanged shaders are not compiled again.
+	auto cachePath = outputPath / "spv-cache" / hash.toBase64URL();
+	cachePath += ".spv";
+	return cachePath;
+}
+
+static void removeShaderFile(const fs::path& filePath)
+{
+	#if GARDEN_OS_WINDOWS
+	auto attemptCount = 0;
+	while (attemptCount < 10) // File can be still locked.
+	{
+		error_code errorCode;
+		fs::remove(filePath, errorCode);
+		if (errorCode)
+			this_thread::sleep_for(chrono::milliseconds(1));
+		else break;
+	}
+	#else
+	fs::remove(filePath);
+	#endif
+}
+
+static void compileShaderFile(const fs::path& filePath, 
+	const fs::path& outputPath, const vector<fs::path>& includePaths)
 {
 	vector<const char*> glslcArgs = { "glslc", "--target-env=" GARDEN_VULKAN_SHADER_VERSION_STRING };
 	#if GARDEN_DEBUG
@@ -1395,12 +1537,26 @@ static void compileShaderFile(const fs::path& filePath, const vector<fs::path>&
 
 	auto inputFilePath = filePath.generic_string();
 	auto outputFilePath = filePath.generic_string() + ".spv";
+	auto cachePath = getSpvCachePath(filePath, outputPath, includePaths, glslcArgs);
+
+	error_code errorCode;
+	if (!cachePath.empty() && fs::exists(cachePath, errorCode))
+	{
+		fs::copy_file(cachePath, outputFilePath, fs::copy_options::overwrite_existing, errorCode);
+		if (!errorCode)
+		{
+			removeShaderFile(filePath);
+			return;
+		}
+	}
+
 	glslcArgs.push_back("-c");
 	glslcArgs.push_back(inputFilePath.c_str());
 	glslcArgs.push_back("-o");
 	glslcArgs.push_back(outputFilePath.c_str());
 	
 	vector<string> iclPathStrings;
+	iclPathStrings.reserve(includePaths.size());
 	for (const auto& path : includePaths)
 	{
 		iclPathStrings.push_back(path.generic_string());
@@ -1409,24 +1565,29 @@ static void compileShaderFile(const fs::path& filePath, const vector<fs::path>&
 	}
 	glslcArgs.push_back(nullptr);
 
+	// TODO: Compile in-process with the glslang/shaderc library instead of spawning glslc on each cache miss.
+	//       Requires vendoring the compiler, until then only the SPIR-V cache avoids the process overhead.
 	std::cout << std::flush;
 	auto result = mpio::OS::executeFile("glslc", (char**)glslcArgs.data());
 	if (result != 0)
 		throw GardenError("_GLSLC");
+	removeShaderFile(filePath);
 
-	#if GARDEN_OS_WINDOWS
-	auto attemptCount = 0;
-	while (attemptCount < 10) // File can be still locked.
+	if (cachePath.empty())
+		return;
+
+	// Note: Copying through the unique temporary file, other threads and processes can read the same cache entry.
+	random_device randomDevice;
+	auto seed = ((uint64)randomDevice() << 32u) | randomDevice();
+	auto tmpCachePath = cachePath; tmpCachePath += "." + Hash128::generateRandom(seed).toBase64URL() + ".tmp";
+	fs::create_directories(cachePath.parent_path(), errorCode);
+	fs::copy_file(outputFilePath, tmpCachePath, fs::copy_options::overwrite_existing, errorCode);
+	if (!errorCode)
 	{
-		error_code errorCode;
-		fs::remove(filePath, errorCode);
+		fs::rename(tmpCachePath, cachePath, errorCode);
 		if (errorCode)
-			this_thread::sleep_for(chrono::milliseconds(1));
-		else break;
+			fs::remove(tmpCachePath, errorCode);
 	}
-	#else
-	fs::remove(filePath);
-	#endif
 }
 
 //******************************************************************************************************************
@@ -1726,7 +1887,7 @@ static bool compileGraphicsShader(const fs::path& inputPath, const fs::path& out
 	}
 
 	fileData.outputFileStream.close();
-	compileShaderFile(outputFilePath, includePaths);
+	compileShaderFile(outputFilePath, outputPath, includePaths);
 
 	vector<uint8>* shaderCode;
 	if (pipelineStage == PipelineStage::Vertex) shaderCode = &data.vertexCode;
@@ -1952,7 +2113,7 @@ bool GslCompiler::compileComputeShader(const fs::path& inputPath,
 	GARDEN_ASSERT(data.samplerStates.size() <= UINT8_MAX);
 	
 	fileData.outputFileStream.close();
-	compileShaderFile(outputFilePath, includePaths);
+	compileShaderFile(outputFilePath, outputPath, includePaths);
 
 	if (data.pushConstantsSize > 0) data.pushConstantsStages = pipelineStage;
 	if (data.variantCount == 0) data.variantCount = 1;
@@ -2134,7 +2295,7 @@ static bool compileRayTracingShader(const fs::path& inputPath, const fs::path& o
 	}
 	
 	fileData.outputFileStream.close();
-	compileShaderFile(outputFilePath, includePaths);
+	compileShaderFile(outputFilePath, outputPath, includePaths);
 
 	vector<uint8>* shaderCode;
 	if (pipelineStage == PipelineStage::RayGeneration)
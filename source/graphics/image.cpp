@@ -14,6 +14,7 @@
 
 #include "garden/graphics/image.hpp"
 #include "garden/graphics/vulkan/api.hpp"
+#include "garden/graphics/null/api.hpp"
 #include "garden/file.hpp"
 
 #include "png.h"
@@ -100,10 +101,10 @@ static VmaAllocationCreateFlagBits toVmaMemoryStrategy(Image::Strategy memoryUsa
 }
 
 //**********************************************************************************************************************
-static void createVkImage(Image::Type type, Image::Format format, Image::Usage usage, 
-	Image::Strategy strategy, u32x4 size, void*& instance, void*& allocation, uint32& aspectFlags)
+static void fillVkImageInfo(Image::Type type, Image::Format format, Image::Usage usage, 
+	u32x4 size, VkImageCreateInfo& imageInfo, uint32* queueFamilyIndices)
 {
-	VkImageCreateInfo imageInfo = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+	imageInfo = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
 	imageInfo.imageType = (VkImageType)toVkImageType(type);
 	imageInfo.format = (VkFormat)toVkFormat(format);
 	imageInfo.mipLevels = size.getW();
@@ -116,8 +117,6 @@ static void createVkImage(Image::Type type, Image::Format format, Image::Usage u
 	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
 	auto vulkanAPI = VulkanAPI::get();
-
-	uint32 queueFamilyIndices[3];
 	if (hasAnyFlag(usage, Image::Usage::TransferQ | Image::Usage::ComputeQ))
 	{
 		imageInfo.queueFamilyIndexCount = 1;
@@ -156,6 +155,14 @@ static void createVkImage(Image::Type type, Image::Format format, Image::Usage u
 
 	if (type == Image::Type::Cubemap)
 		imageInfo.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+}
+
+static void createVkImage(Image::Type type, Image::Format format, Image::Usage usage, Image::Strategy strategy, 
+	u32x4 size, void* aliasMemory, void*& instance, void*& allocation, uint32& aspectFlags)
+{
+	VkImageCreateInfo imageInfo; uint32 queueFamilyIndices[3];
+	fillVkImageInfo(type, format, usage, size, imageInfo, queueFamilyIndices);
+	auto vulkanAPI = VulkanAPI::get();
 
 	#if GARDEN_DEBUG
 	vk::PhysicalDeviceImageFormatInfo2 imageFormatInfo;
@@ -172,6 +179,20 @@ static void createVkImage(Image::Type type, Image::Format format, Image::Usage u
 	GARDEN_ASSERT(imageInfo.mipLevels <= imageFormatProperties.imageFormatProperties.maxMipLevels);
 	GARDEN_ASSERT(imageInfo.samples <= (VkSampleCountFlags)imageFormatProperties.imageFormatProperties.sampleCounts);
 	#endif
+
+	if (aliasMemory)
+	{
+		VkImage vmaInstance;
+		auto result = vmaCreateAliasingImage(vulkanAPI->memoryAllocator, 
+			(VmaAllocation)aliasMemory, &imageInfo, &vmaInstance);
+		if (result != VK_SUCCESS)
+			throw GardenError("Failed to create aliasing image.");
+
+		// Note: Shared memory is owned by the alias memory creator, not by the image.
+		instance = vmaInstance; allocation = nullptr;
+		aspectFlags = (uint32)toVkImageAspectFlags(format);
+		return;
+	}
  
 	VmaAllocationCreateInfo allocationCreateInfo = {};
 	allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
@@ -193,21 +214,21 @@ static void createVkImage(Image::Type type, Image::Format format, Image::Usage u
 	if (result != VK_SUCCESS)
 		throw GardenError("Failed to allocate image.");
 
-	// TODO: https://gpuopen-librariesandsdks.github.io/VulkanMemoryAllocator/html/resource_aliasing.html
-
 	instance = vmaInstance; allocation = vmaAllocation;
 	aspectFlags = (uint32)toVkImageAspectFlags(format);
 }
 
 //**********************************************************************************************************************
-Image::Image(Type type, Format format, Usage usage, Strategy strategy, u32x4 size, uint64 version) :
+Image::Image(Type type, Format format, Usage usage, Strategy strategy, u32x4 size, uint64 version, void* aliasMemory) :
 	Memory(0, CpuAccess::None, Location::Auto, strategy, version), barrierStates(size.getZ() * size.getW())
 {
 	GARDEN_ASSERT(areAllTrue(size > u32x4::zero));
 
 	auto graphicsBackend = GraphicsAPI::get()->getBackendType();
 	if (graphicsBackend == GraphicsBackend::VulkanAPI)
-		createVkImage(type, format, usage, strategy, size, instance, allocation, aspectFlags);
+		createVkImage(type, format, usage, strategy, size, aliasMemory, instance, allocation, aspectFlags);
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		instance = NullAPI::createInstance();
 	else abort();
 
 	this->binarySize = 0;
@@ -248,7 +269,7 @@ Image::Image(void* instance, Format format, Usage usage, Strategy strategy, uint
 		barrierStates[0].stage = (uint64)vk::PipelineStageFlagBits2::eColorAttachmentOutput;
 		aspectFlags = (uint32)toVkImageAspectFlags(format);
 	}
-	else abort();
+	else if ((GraphicsBackend)backend != GraphicsBackend::NullAPI) abort();
 }
 bool Image::destroy()
 {
@@ -283,7 +304,7 @@ bool Image::destroy()
 			else vulkanAPI->destroyResource(GraphicsAPI::DestroyResourceType::Image, instance, allocation);
 		}
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 
 	return true;
 }
@@ -296,11 +317,87 @@ uint32 Image::calcApiLayerIndex(Type type, uint32 layerIndex) noexcept
 		auto graphicsBackend = GraphicsAPI::get()->getBackendType();
 		if (graphicsBackend == GraphicsBackend::VulkanAPI)
 			return layerIndex ^ 1; // Note: remapping Vulkan API cubemap face indices.
-		else abort();
+		else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 	}
 	return layerIndex;
 }
 
+//**********************************************************************************************************************
+void ImageExt::getMemoryRequirements(Image::Type type, Image::Format format, Image::Usage usage, 
+	u32x4 size, uint64& binarySize, uint64& alignment, uint32& memoryTypes)
+{
+	GARDEN_ASSERT(areAllTrue(size > u32x4::zero));
+
+	auto graphicsBackend = GraphicsAPI::get()->getBackendType();
+	if (graphicsBackend == GraphicsBackend::VulkanAPI)
+	{
+		VkImageCreateInfo imageInfo; uint32 queueFamilyIndices[3];
+		fillVkImageInfo(type, format, usage, size, imageInfo, queueFamilyIndices);
+
+		// Note: Temporary image has no memory bound, it is only used to query requirements.
+		auto vulkanAPI = VulkanAPI::get();
+		auto vkImage = vulkanAPI->device.createImage(vk::ImageCreateInfo(imageInfo));
+		auto memoryRequirements = vulkanAPI->device.getImageMemoryRequirements(vkImage);
+		vulkanAPI->device.destroyImage(vkImage);
+
+		binarySize = memoryRequirements.size;
+		alignment = memoryRequirements.alignment;
+		memoryTypes = memoryRequirements.memoryTypeBits;
+	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+	{
+		binarySize = 0;
+		auto mipSize = size;
+		for (uint32 mip = 0, mipCount = size.getW(); mip < mipCount; mip++)
+		{
+			binarySize += toBinarySize((psize)mipSize.getX() * mipSize.getY() * mipSize.getZ(), format);
+			mipSize = max(mipSize / 2u, u32x4::one);
+		}
+		alignment = 1; memoryTypes = UINT32_MAX;
+	}
+	else abort();
+}
+void* ImageExt::allocateAliasMemory(uint64 binarySize, uint64 alignment, uint32 memoryTypes)
+{
+	GARDEN_ASSERT(binarySize > 0);
+	GARDEN_ASSERT(alignment > 0);
+	GARDEN_ASSERT(memoryTypes != 0);
+
+	auto graphicsBackend = GraphicsAPI::get()->getBackendType();
+	if (graphicsBackend == GraphicsBackend::VulkanAPI)
+	{
+		VkMemoryRequirements memoryRequirements = { binarySize, alignment, memoryTypes };
+		VmaAllocationCreateInfo allocationCreateInfo = {};
+		allocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		allocationCreateInfo.priority = 1.0f;
+
+		VmaAllocation vmaAllocation;
+		auto result = vmaAllocateMemory(VulkanAPI::get()->memoryAllocator, 
+			&memoryRequirements, &allocationCreateInfo, &vmaAllocation, nullptr);
+		if (result != VK_SUCCESS)
+			throw GardenError("Failed to allocate image alias memory.");
+		return vmaAllocation;
+	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		return NullAPI::createInstance();
+	else abort();
+}
+void ImageExt::destroyAliasMemory(void* aliasMemory)
+{
+	if (!aliasMemory)
+		return;
+
+	auto graphicsBackend = GraphicsAPI::get()->getBackendType();
+	if (graphicsBackend == GraphicsBackend::VulkanAPI)
+	{
+		auto vulkanAPI = VulkanAPI::get();
+		if (vulkanAPI->forceResourceDestroy)
+			vmaFreeMemory(vulkanAPI->memoryAllocator, (VmaAllocation)aliasMemory);
+		else vulkanAPI->destroyResource(GraphicsAPI::DestroyResourceType::Image, nullptr, aliasMemory);
+	}
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
+}
+
 //**********************************************************************************************************************
 ID<ImageView> Image::getView()
 {
@@ -397,6 +494,8 @@ bool Image::isSupported(Type type, Format format, Usage usage, uint3 size, uint8
 			mipCount <= imageFormatProperties.imageFormatProperties.maxMipLevels &&
 			layerCount <= imageFormatProperties.imageFormatProperties.maxArrayLayers;
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		return true;
 	else abort();
 }
 
@@ -943,7 +1042,7 @@ void Image::setDebugName(const string& name)
 		vulkanAPI->device.setDebugUtilsObjectNameEXT(nameInfo);
 		#endif
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 #endif
 
@@ -2084,6 +2183,8 @@ ImageView::ImageView(bool isDefault, ID<Image> image, Image::Type type,
 		this->instance = createVkImageView(imageView, type, format, 
 			baseLayer, layerCount, baseMip, mipCount, apiFormat, aspectFlags);
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		this->instance = NullAPI::createInstance();
 	else abort();
 
 	this->image = image;
@@ -2168,7 +2269,7 @@ bool ImageView::destroy()
 			vulkanAPI->device.destroyImageView((VkImageView)instance);
 		else vulkanAPI->destroyResource(GraphicsAPI::DestroyResourceType::ImageView, instance);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 
 	return true;
 }
@@ -2203,6 +2304,6 @@ void ImageView::setDebugName(const string& name)
 		vulkanAPI->device.setDebugUtilsObjectNameEXT(nameInfo);
 		#endif
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 #endif
\ No newline at end of file
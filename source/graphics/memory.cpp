@@ -28,6 +28,11 @@ Memory::BarrierState Memory::toBarrierState(AccessFlags accessFlags, PipelineSta
 		state.access = (uint64)toVkAccessFlags(accessFlags);
 		state.stage = (uint64)toVkPipelineStages(pipelineStages);
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+	{
+		state.access = (uint64)accessFlags;
+		state.stage = (uint64)pipelineStages;
+	}
 	else abort();
 
 	return state;
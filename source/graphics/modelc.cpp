@@ -14,28 +14,1151 @@
 
 #include "garden/graphics/modelc.hpp"
 #include "garden/thread-pool.hpp"
+#include "garden/file.hpp"
 
+#if GARDEN_DEBUG || defined(GARDEN_MODEL_CONVERTER)
 #include "assimp/Importer.hpp"
-#include "assimp/DefaultLogger.hpp"
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
-#include "zstd.h"
+#include "tsl/robin_map.h"
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
 
 using namespace garden;
 using namespace garden::graphics;
 
+//******************************************************************************************************************
+namespace
+{
+	struct ModelHeader final
+	{
+		char magic[4];
+		uint8 version = 0;
+		uint8 isLittleEndian = 0;
+		uint8 channelCount = 0;
+		uint8 lodCount = 0;
+		uint8 indexType = 0;
+		uint8 _alignment0 = 0;
+		uint16 _alignment1 = 0;
+		uint32 vertexCount = 0;
+		uint32 indexCount = 0;
+		uint32 meshletCount = 0;
+		uint32 meshletVertexCount = 0;
+		uint32 meshletTriangleSize = 0;
+		float3 aabbMin = float3::zero;
+		float3 aabbMax = float3::zero;
+	};
+}
+
+constexpr uint8 modelVersion = 2;
+
+static psize toIndexSize(IndexType indexType) noexcept
+{
+	return indexType == IndexType::Uint16 ? sizeof(uint16) : sizeof(uint32);
+}
+
+//******************************************************************************************************************
+// Note: Vertex data is stored quantized in the model file and expanded to the BufferChannel layout on load.
+//       Positions are unorm16 relative to the model AABB, directions are 16-bit snorm octahedral encoded,
+//       texture coordinates are half floats and vertex colors are unorm8.
+
+static psize toQuantizedSize(BufferChannel channel) noexcept
+{
+	switch (channel)
+	{
+	case BufferChannel::Positions: return sizeof(uint16) * 3;
+	case BufferChannel::Normals:
+	case BufferChannel::Tangents:
+	case BufferChannel::Bitangents: return sizeof(int16) * 2;
+	case BufferChannel::TextureCoords: return sizeof(half) * 2;
+	case BufferChannel::VertexColors: return sizeof(uint8) * 4;
+	default: abort();
+	}
+}
+static psize toQuantizedSize(const vector<BufferChannel>& channels) noexcept
+{
+	psize binarySize = 0;
+	for (auto channel : channels)
+		binarySize += toQuantizedSize(channel);
+	return binarySize;
+}
+
+static float3 decodeOctahedral(const int16* encoded) noexcept
+{
+	auto x = std::max((float)encoded[0] / INT16_MAX, -1.0f);
+	auto y = std::max((float)encoded[1] / INT16_MAX, -1.0f);
+	auto z = 1.0f - std::abs(x) - std::abs(y);
+	if (z < 0.0f)
+	{
+		auto foldX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		y = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f); x = foldX;
+	}
+
+	auto length = std::sqrt(x * x + y * y + z * z);
+	return float3(x / length, y / length, z / length);
+}
+static void dequantizeVertexData(const uint8* quantizedData, ModelConverter::ModelData& data)
+{
+	auto extent = data.aabbMax - data.aabbMin;
+	data.vertexData.resize(toBinarySize(data.channels) * data.vertexCount);
+	auto vertices = data.vertexData.data();
+
+	for (uint32 i = 0; i < data.vertexCount; i++)
+	{
+		for (auto channel : data.channels)
+		{
+			switch (channel)
+			{
+			case BufferChannel::Positions:
+			{
+				uint16 position[3]; memcpy(position, quantizedData, sizeof(position));
+				*(float3*)vertices = data.aabbMin + float3((float)position[0], 
+					(float)position[1], (float)position[2]) * (extent / (float)UINT16_MAX);
+				break;
+			}
+			case BufferChannel::Normals:
+			case BufferChannel::Tangents:
+			case BufferChannel::Bitangents:
+			{
+				int16 direction[2]; memcpy(direction, quantizedData, sizeof(direction));
+				*(float3*)vertices = decodeOctahedral(direction);
+				break;
+			}
+			case BufferChannel::TextureCoords:
+			{
+				half texCoords[2]; memcpy(texCoords, quantizedData, sizeof(texCoords));
+				*(float2*)vertices = float2((float)texCoords[0], (float)texCoords[1]);
+				break;
+			}
+			case BufferChannel::VertexColors:
+			{
+				auto color = quantizedData;
+				*(float4*)vertices = float4(color[0], color[1], color[2], color[3]) * (1.0f / UINT8_MAX);
+				break;
+			}
+			default: abort();
+			}
+
+			quantizedData += toQuantizedSize(channel);
+			vertices += toBinarySize(channel);
+		}
+	}
+}
+
+template<typename T>
+static bool readModelArray(const uint8* data, psize dataSize, psize& dataOffset, vector<T>& values, psize count)
+{
+	auto binarySize = count * sizeof(T);
+	if (dataOffset + binarySize > dataSize)
+		return false;
+	values.resize(count);
+	memcpy(values.data(), data + dataOffset, binarySize);
+	dataOffset += binarySize;
+	return true;
+}
+
+//******************************************************************************************************************
+bool ModelConverter::loadModel(const uint8* data, psize dataSize, ModelData& modelData)
+{
+	GARDEN_ASSERT(data);
+
+	if (dataSize < sizeof(ModelHeader))
+		return false;
+
+	ModelHeader header;
+	memcpy(&header, data, sizeof(ModelHeader));
+	if (memcmp(header.magic, modelMagic.data(), modelMagic.length()) != 0 || header.version != modelVersion ||
+		header.isLittleEndian != GARDEN_LITTLE_ENDIAN || header.indexType > (uint8)IndexType::Uint32)
+	{
+		return false;
+	}
+
+	modelData.indexType = (IndexType)header.indexType;
+	modelData.vertexCount = header.vertexCount;
+	modelData.aabbMin = header.aabbMin;
+	modelData.aabbMax = header.aabbMax;
+	psize dataOffset = sizeof(ModelHeader);
+
+	if (!readModelArray(data, dataSize, dataOffset, modelData.channels, header.channelCount))
+		return false;
+	for (auto channel : modelData.channels)
+	{
+		if (channel >= BufferChannel::Count)
+			return false;
+	}
+
+	if (!readModelArray(data, dataSize, dataOffset, modelData.lods, header.lodCount))
+		return false;
+
+	auto vertexSize = (psize)header.vertexCount * toQuantizedSize(modelData.channels);
+	if (dataOffset + vertexSize > dataSize)
+		return false;
+	auto quantizedData = data + dataOffset;
+	dataOffset += vertexSize;
+
+	auto indexSize = (psize)header.indexCount * toIndexSize(modelData.indexType);
+	if (!readModelArray(data, dataSize, dataOffset, modelData.indexData, indexSize) ||
+		!readModelArray(data, dataSize, dataOffset, modelData.meshlets, header.meshletCount) ||
+		!readModelArray(data, dataSize, dataOffset, modelData.meshletVertices, header.meshletVertexCount) ||
+		!readModelArray(data, dataSize, dataOffset, modelData.meshletTriangles, header.meshletTriangleSize))
+	{
+		return false;
+	}
+
+	for (const auto& lod : modelData.lods)
+	{
+		if ((uint64)lod.indexOffset + lod.indexCount > header.indexCount ||
+			(uint64)lod.meshletOffset + lod.meshletCount > header.meshletCount)
+		{
+			return false;
+		}
+	}
+	for (const auto& meshlet : modelData.meshlets)
+	{
+		if (meshlet.vertexCount > maxMeshletVertices || meshlet.triangleCount > maxMeshletTriangles ||
+			(uint64)meshlet.vertexOffset + meshlet.vertexCount > header.meshletVertexCount ||
+			(uint64)meshlet.triangleOffset + meshlet.triangleCount * 3 > header.meshletTriangleSize)
+		{
+			return false;
+		}
+
+		auto triangles = modelData.meshletTriangles.data() + meshlet.triangleOffset;
+		for (uint32 i = 0; i < meshlet.triangleCount * 3; i++)
+		{
+			if (triangles[i] >= meshlet.vertexCount)
+				return false;
+		}
+	}
+	for (auto vertex : modelData.meshletVertices)
+	{
+		if (vertex >= header.vertexCount)
+			return false;
+	}
+
+	if (modelData.indexType == IndexType::Uint16)
+	{
+		auto indices = (const uint16*)modelData.indexData.data();
+		for (uint32 i = 0; i < header.indexCount; i++)
+		{
+			if (indices[i] >= header.vertexCount)
+				return false;
+		}
+	}
+	else
+	{
+		auto indices = (const uint32*)modelData.indexData.data();
+		for (uint32 i = 0; i < header.indexCount; i++)
+		{
+			if (indices[i] >= header.vertexCount)
+				return false;
+		}
+	}
+
+	dequantizeVertexData(quantizedData, modelData);
+	return true;
+}
+bool ModelConverter::loadModel(const fs::path& filePath, ModelData& modelData)
+{
+	vector<uint8> data;
+	if (!File::tryLoadBinary(filePath, data))
+		return false;
+	return loadModel(data.data(), data.size(), modelData);
+}
+
 #if GARDEN_DEBUG || defined(GARDEN_MODEL_CONVERTER)
+//******************************************************************************************************************
+namespace
+{
+	struct VertexStreams final
+	{
+		vector<float3> positions;
+		vector<float3> normals;
+		vector<float3> tangents;
+		vector<float3> bitangents;
+		vector<float2> texCoords;
+		vector<float4> colors;
+	};
+}
+
+constexpr uint32 vertexCacheSize = 32;
+constexpr const char* modelFileExts[] = { ".gltf", ".glb", ".fbx", ".obj", ".dae" };
+
+static float calcVertexScore(int32 cachePosition, uint32 liveCount) noexcept
+{
+	if (liveCount == 0)
+		return -1.0f; // Note: no triangles left using this vertex.
+
+	auto score = 0.0f;
+	if (cachePosition >= 0)
+	{
+		if (cachePosition < 3)
+			score = 0.75f; // Note: last triangle vertices, fixed score to prevent strip-like ordering.
+		else
+			score = std::pow(1.0f - (float)(cachePosition - 3) / (vertexCacheSize - 3), 1.5f);
+	}
+	return score + 2.0f / std::sqrt((float)liveCount);
+}
+
+//******************************************************************************************************************
+// Note: Tom Forsyth's linear-speed vertex cache optimization.
+static void optimizeVertexCache(uint32* indices, uint32 indexCount, uint32 vertexCount)
+{
+	auto triangleCount = indexCount / 3;
+	if (triangleCount < 2)
+		return;
+
+	vector<uint32> adjacencyOffsets(vertexCount + 1, 0);
+	for (uint32 i = 0; i < indexCount; i++)
+		adjacencyOffsets[indices[i] + 1]++;
+	for (uint32 i = 0; i < vertexCount; i++)
+		adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+	vector<uint32> adjacency(indexCount), liveCounts(vertexCount, 0);
+	for (uint32 i = 0; i < indexCount; i++)
+	{
+		auto vertex = indices[i];
+		adjacency[adjacencyOffsets[vertex] + liveCounts[vertex]++] = i / 3;
+	}
+
+	vector<int32> cachePositions(vertexCount, -1);
+	vector<float> vertexScores(vertexCount);
+	for (uint32 i = 0; i < vertexCount; i++)
+		vertexScores[i] = calcVertexScore(-1, liveCounts[i]);
+
+	vector<float> triangleScores(triangleCount);
+	for (uint32 i = 0; i < triangleCount; i++)
+	{
+		auto triangle = indices + i * 3;
+		triangleScores[i] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+	}
+
+	vector<uint8> isEmitted(triangleCount, 0);
+	vector<uint32> outputIndices; outputIndices.reserve(indexCount);
+	uint32 cache[vertexCacheSize + 3], newCache[vertexCacheSize + 3];
+	uint32 cacheCount = 0, inputCursor = 0; int64 bestTriangle = -1;
+
+	for (uint32 emitCount = 0; emitCount < triangleCount; emitCount++)
+	{
+		if (bestTriangle < 0)
+		{
+			while (isEmitted[inputCursor])
+				inputCursor++;
+			bestTriangle = inputCursor;
+		}
+
+		auto triangleIndex = (uint32)bestTriangle;
+		auto triangle = indices + triangleIndex * 3;
+		isEmitted[triangleIndex] = 1;
+
+		uint32 newCount = 0;
+		for (uint8 i = 0; i < 3; i++)
+		{
+			auto vertex = triangle[i];
+			outputIndices.push_back(vertex);
+			if (find(newCache, newCache + newCount, vertex) != newCache + newCount)
+				continue;
+			newCache[newCount++] = vertex;
+
+			auto begin = adjacency.data() + adjacencyOffsets[vertex];
+			auto end = begin + liveCounts[vertex];
+			auto searchResult = find(begin, end, triangleIndex);
+			if (searchResult != end)
+			{
+				*searchResult = *(end - 1);
+				liveCounts[vertex]--;
+			}
+		}
+		for (uint32 i = 0; i < cacheCount; i++)
+		{
+			auto vertex = cache[i];
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+				newCache[newCount++] = vertex;
+		}
+
+		for (uint32 i = 0; i < newCount; i++)
+		{
+			auto vertex = newCache[i];
+			cachePositions[vertex] = i < vertexCacheSize ? (int32)i : -1;
+			vertexScores[vertex] = calcVertexScore(cachePositions[vertex], liveCounts[vertex]);
+		}
+
+		cacheCount = std::min(newCount, vertexCacheSize);
+		memcpy(cache, newCache, cacheCount * sizeof(uint32));
+
+		bestTriangle = -1; auto bestScore = -1.0f;
+		for (uint32 i = 0; i < newCount; i++)
+		{
+			auto vertex = newCache[i];
+			auto adjacencyData = adjacency.data() + adjacencyOffsets[vertex];
+			for (uint32 j = 0; j < liveCounts[vertex]; j++)
+			{
+				auto adjacentIndex = adjacencyData[j];
+				auto adjacent = indices + adjacentIndex * 3;
+				auto score = vertexScores[adjacent[0]] + vertexScores[adjacent[1]] + vertexScores[adjacent[2]];
+				triangleScores[adjacentIndex] = score;
+
+				if (score > bestScore)
+				{
+					bestTriangle = adjacentIndex;
+					bestScore = score;
+				}
+			}
+		}
+	}
+
+	memcpy(indices, outputIndices.data(), indexCount * sizeof(uint32));
+}
+
+//******************************************************************************************************************
+// Note: Splits triangles into clusters on the vertex cache restarts and sorts them front to back from
+//       the mesh center, so the outer facing clusters are drawn first. (Sander et al. simplified)
+static void optimizeOverdraw(uint32* indices, uint32 indexCount, const float3* positions, uint32 vertexCount)
+{
+	auto triangleCount = indexCount / 3;
+	if (triangleCount < 2)
+		return;
+
+	vector<uint32> clusterOffsets, cacheTimestamps(vertexCount, 0);
+	uint32 timestamp = vertexCacheSize + 1;
+
+	for (uint32 i = 0; i < triangleCount; i++)
+	{
+		uint32 missCount = 0;
+		for (uint8 j = 0; j < 3; j++)
+		{
+			auto vertex = indices[i * 3 + j];
+			if (timestamp - cacheTimestamps[vertex] <= vertexCacheSize)
+				continue;
+			cacheTimestamps[vertex] = timestamp++;
+			missCount++;
+		}
+
+		if (i == 0 || missCount == 3)
+			clusterOffsets.push_back(i);
+	}
+
+	auto clusterCount = (uint32)clusterOffsets.size();
+	if (clusterCount < 2)
+		return;
+	clusterOffsets.push_back(triangleCount);
+
+	auto meshCenter = float3::zero;
+	for (uint32 i = 0; i < indexCount; i++)
+		meshCenter += positions[indices[i]];
+	meshCenter /= (float)indexCount;
+
+	vector<pair<float, uint32>> clusterKeys(clusterCount);
+	for (uint32 i = 0; i < clusterCount; i++)
+	{
+		auto center = float3::zero, normal = float3::zero; auto area = 0.0f;
+		for (uint32 j = clusterOffsets[i]; j < clusterOffsets[i + 1]; j++)
+		{
+			auto triangle = indices + j * 3;
+			auto p0 = positions[triangle[0]], p1 = positions[triangle[1]], p2 = positions[triangle[2]];
+			auto triangleNormal = cross(p1 - p0, p2 - p0);
+			auto triangleArea = length(triangleNormal);
+			center += (p0 + p1 + p2) * (triangleArea / 3.0f);
+			normal += triangleNormal; area += triangleArea;
+		}
+
+		auto normalLength = length(normal);
+		if (area > 0.0f && normalLength > 0.0f)
+			clusterKeys[i].first = dot(center / area - meshCenter, normal / normalLength);
+		else clusterKeys[i].first = 0.0f;
+		clusterKeys[i].second = i;
+	}
+
+	std::stable_sort(clusterKeys.begin(), clusterKeys.end(), [](const pair<float, uint32>& a, const pair<float, uint32>& b)
+	{
+		return a.first > b.first;
+	});
+
+	vector<uint32> outputIndices; outputIndices.reserve(indexCount);
+	for (const auto& clusterKey : clusterKeys)
+	{
+		auto cluster = clusterKey.second;
+		outputIndices.insert(outputIndices.end(), indices + clusterOffsets[cluster] * 3,
+			indices + clusterOffsets[cluster + 1] * 3);
+	}
+	memcpy(indices, outputIndices.data(), indexCount * sizeof(uint32));
+}
+
+//******************************************************************************************************************
+template<typename T>
+static void remapVertexStream(vector<T>& stream, const vector<uint32>& remap, uint32 newVertexCount)
+{
+	if (stream.empty())
+		return;
+
+	vector<T> newStream(newVertexCount);
+	for (psize i = 0; i < remap.size(); i++)
+	{
+		if (remap[i] != UINT32_MAX)
+			newStream[remap[i]] = stream[i];
+	}
+	stream = std::move(newStream);
+}
+
+// Note: Orders vertices by the first use in the index buffer, also drops unused vertices.
+static uint32 optimizeVertexFetch(vector<uint32>& indices, VertexStreams& streams, uint32 vertexCount)
+{
+	vector<uint32> remap(vertexCount, UINT32_MAX);
+	uint32 newVertexCount = 0;
+
+	for (auto& index : indices)
+	{
+		auto& newIndex = remap[index];
+		if (newIndex == UINT32_MAX)
+			newIndex = newVertexCount++;
+		index = newIndex;
+	}
+
+	remapVertexStream(streams.positions, remap, newVertexCount);
+	remapVertexStream(streams.normals, remap, newVertexCount);
+	remapVertexStream(streams.tangents, remap, newVertexCount);
+	remapVertexStream(streams.bitangents, remap, newVertexCount);
+	remapVertexStream(streams.texCoords, remap, newVertexCount);
+	remapVertexStream(streams.colors, remap, newVertexCount);
+	return newVertexCount;
+}
+
+//******************************************************************************************************************
+// Note: Vertex clustering simplification, vertices inside the same grid cell are collapsed into the one.
+static void simplifyMesh(const uint32* indices, uint32 indexCount, const float3* positions, uint32 vertexCount,
+	float3 aabbMin, float cellSize, vector<uint32>& lodIndices)
+{
+	tsl::robin_map<uint64, uint32> cells;
+	vector<uint32> vertexClusters(vertexCount, UINT32_MAX);
+	vector<float3> clusterCenters; vector<uint32> clusterCounts;
+	auto invCellSize = 1.0f / cellSize;
+
+	for (uint32 i = 0; i < indexCount; i++)
+	{
+		auto vertex = indices[i];
+		if (vertexClusters[vertex] != UINT32_MAX)
+			continue;
+
+		auto cell = (positions[vertex] - aabbMin) * invCellSize;
+		auto cellKey = (uint64)std::min((uint32)cell.x, 0x1FFFFFu) |
+			((uint64)std::min((uint32)cell.y, 0x1FFFFFu) << 21u) |
+			((uint64)std::min((uint32)cell.z, 0x1FFFFFu) << 42u);
+
+		auto result = cells.emplace(cellKey, (uint32)clusterCenters.size());
+		if (result.second)
+		{
+			clusterCenters.push_back(float3::zero);
+			clusterCounts.push_back(0);
+		}
+
+		auto cluster = result.first->second;
+		clusterCenters[cluster] += positions[vertex];
+		clusterCounts[cluster]++;
+		vertexClusters[vertex] = cluster;
+	}
+
+	auto clusterCount = (uint32)clusterCenters.size();
+	for (uint32 i = 0; i < clusterCount; i++)
+		clusterCenters[i] /= (float)clusterCounts[i];
+
+	vector<uint32> clusterVertices(clusterCount, UINT32_MAX);
+	vector<float> clusterDistances(clusterCount, INFINITY);
+	for (uint32 i = 0; i < vertexCount; i++)
+	{
+		auto cluster = vertexClusters[i];
+		if (cluster == UINT32_MAX)
+			continue;
+
+		auto distance = distanceSq(positions[i], clusterCenters[cluster]);
+		if (distance < clusterDistances[cluster])
+		{
+			clusterDistances[cluster] = distance;
+			clusterVertices[cluster] = i;
+		}
+	}
+
+	lodIndices.clear();
+	for (uint32 i = 0; i < indexCount; i += 3)
+	{
+		auto a = clusterVertices[vertexClusters[indices[i]]];
+		auto b = clusterVertices[vertexClusters[indices[i + 1]]];
+		auto c = clusterVertices[vertexClusters[indices[i + 2]]];
+		if (a == b || b == c || a == c)
+			continue; // Note: triangle collapsed.
+
+		lodIndices.push_back(a);
+		lodIndices.push_back(b);
+		lodIndices.push_back(c);
+	}
+}
+
+//******************************************************************************************************************
+static void finishMeshlet(ModelConverter::Meshlet& meshlet, const ModelConverter::ModelData& data,
+	const float3* positions)
+{
+	auto meshletVertices = data.meshletVertices.data() + meshlet.vertexOffset;
+	auto meshletTriangles = data.meshletTriangles.data() + meshlet.triangleOffset;
+
+	auto center = float3::zero;
+	for (uint32 i = 0; i < meshlet.vertexCount; i++)
+		center += positions[meshletVertices[i]];
+	center /= (float)meshlet.vertexCount;
+
+	auto radiusSq = 0.0f;
+	for (uint32 i = 0; i < meshlet.vertexCount; i++)
+		radiusSq = std::max(radiusSq, distanceSq(positions[meshletVertices[i]], center));
+	meshlet.center = center;
+	meshlet.radius = std::sqrt(radiusSq);
+
+	auto axis = float3::zero;
+	for (uint32 i = 0; i < meshlet.triangleCount; i++)
+	{
+		auto triangle = meshletTriangles + i * 3;
+		auto p0 = positions[meshletVertices[triangle[0]]];
+		auto p1 = positions[meshletVertices[triangle[1]]];
+		auto p2 = positions[meshletVertices[triangle[2]]];
+		auto normal = cross(p1 - p0, p2 - p0); auto normalLength = length(normal);
+		if (normalLength > 0.0f)
+			axis += normal / normalLength;
+	}
+
+	auto axisLength = length(axis);
+	if (axisLength == 0.0f)
+	{
+		meshlet.coneCutoff = 1.0f;
+		return;
+	}
+	axis /= axisLength;
+
+	auto minDot = 1.0f;
+	for (uint32 i = 0; i < meshlet.triangleCount; i++)
+	{
+		auto triangle = meshletTriangles + i * 3;
+		auto p0 = positions[meshletVertices[triangle[0]]];
+		auto p1 = positions[meshletVertices[triangle[1]]];
+		auto p2 = positions[meshletVertices[triangle[2]]];
+		auto normal = cross(p1 - p0, p2 - p0); auto normalLength = length(normal);
+		if (normalLength > 0.0f)
+			minDot = std::min(minDot, dot(axis, normal / normalLength));
+	}
+
+	meshlet.coneAxis = axis;
+	meshlet.coneCutoff = minDot <= 0.0f ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+}
+static void buildMeshlets(const uint32* indices, uint32 indexCount, const float3* positions,
+	vector<uint8>& localIndices, ModelConverter::ModelData& data)
+{
+	ModelConverter::Meshlet meshlet;
+	meshlet.vertexOffset = (uint32)data.meshletVertices.size();
+	meshlet.triangleOffset = (uint32)data.meshletTriangles.size();
+
+	for (uint32 i = 0; i < indexCount; i += 3)
+	{
+		auto triangle = indices + i;
+		uint32 newVertexCount = 0;
+		for (uint8 j = 0; j < 3; j++)
+		{
+			if (localIndices[triangle[j]] == UINT8_MAX && (j == 0 || triangle[j] != triangle[0]) &&
+				(j < 2 || triangle[j] != triangle[1]))
+			{
+				newVertexCount++;
+			}
+		}
+
+		if (meshlet.vertexCount + newVertexCount > ModelConverter::maxMeshletVertices ||
+			meshlet.triangleCount >= ModelConverter::maxMeshletTriangles)
+		{
+			finishMeshlet(meshlet, data, positions);
+			data.meshlets.push_back(meshlet);
+
+			for (uint32 j = 0; j < meshlet.vertexCount; j++)
+				localIndices[data.meshletVertices[meshlet.vertexOffset + j]] = UINT8_MAX;
+
+			meshlet = {};
+			meshlet.vertexOffset = (uint32)data.meshletVertices.size();
+			meshlet.triangleOffset = (uint32)data.meshletTriangles.size();
+		}
+
+		for (uint8 j = 0; j < 3; j++)
+		{
+			auto& localIndex = localIndices[triangle[j]];
+			if (localIndex == UINT8_MAX)
+			{
+				localIndex = (uint8)meshlet.vertexCount++;
+				data.meshletVertices.push_back(triangle[j]);
+			}
+			data.meshletTriangles.push_back(localIndex);
+		}
+		meshlet.triangleCount++;
+	}
+
+	if (meshlet.triangleCount > 0)
+	{
+		finishMeshlet(meshlet, data, positions);
+		data.meshlets.push_back(meshlet);
+		for (uint32 j = 0; j < meshlet.vertexCount; j++)
+			localIndices[data.meshletVertices[meshlet.vertexOffset + j]] = UINT8_MAX;
+	}
+}
+
+//******************************************************************************************************************
+static void importModel(const fs::path& filePath, VertexStreams& streams, vector<uint32>& indices)
+{
+	Assimp::Importer importer;
+	importer.SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_POINT | aiPrimitiveType_LINE);
+
+	auto scene = importer.ReadFile(filePath.generic_string(), aiProcess_Triangulate |
+		aiProcess_JoinIdenticalVertices | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace |
+		aiProcess_PreTransformVertices | aiProcess_SortByPType | aiProcess_FindDegenerates |
+		aiProcess_FindInvalidData | aiProcess_ValidateDataStructure);
+	if (!scene)
+		throw GardenError("Failed to import model. (error: " + string(importer.GetErrorString()) + ")");
+
+	auto hasTangents = true, hasTexCoords = true, hasColors = false;
+	for (uint32 i = 0; i < scene->mNumMeshes; i++)
+	{
+		auto mesh = scene->mMeshes[i];
+		hasTangents &= mesh->HasTangentsAndBitangents();
+		hasTexCoords &= mesh->HasTextureCoords(0);
+		hasColors |= mesh->HasVertexColors(0);
+	}
+
+	for (uint32 i = 0; i < scene->mNumMeshes; i++)
+	{
+		auto mesh = scene->mMeshes[i];
+		if (!(mesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE) || !mesh->HasNormals())
+			continue;
+
+		auto baseVertex = (uint32)streams.positions.size();
+		for (uint32 j = 0; j < mesh->mNumVertices; j++)
+		{
+			auto position = mesh->mVertices[j], normal = mesh->mNormals[j];
+			streams.positions.emplace_back(position.x, position.y, position.z);
+			streams.normals.emplace_back(normal.x, normal.y, normal.z);
+
+			if (hasTangents)
+			{
+				auto tangent = mesh->mTangents[j], bitangent = mesh->mBitangents[j];
+				streams.tangents.emplace_back(tangent.x, tangent.y, tangent.z);
+				streams.bitangents.emplace_back(bitangent.x, bitangent.y, bitangent.z);
+			}
+			if (hasTexCoords)
+			{
+				auto texCoords = mesh->mTextureCoords[0][j];
+				streams.texCoords.emplace_back(texCoords.x, texCoords.y);
+			}
+			if (hasColors)
+			{
+				if (mesh->HasVertexColors(0))
+				{
+					auto color = mesh->mColors[0][j];
+					streams.colors.emplace_back(color.r, color.g, color.b, color.a);
+				}
+				else streams.colors.emplace_back(1.0f, 1.0f, 1.0f, 1.0f);
+			}
+		}
+
+		for (uint32 j = 0; j < mesh->mNumFaces; j++)
+		{
+			const auto& face = mesh->mFaces[j];
+			if (face.mNumIndices != 3)
+				continue;
+			indices.push_back(baseVertex + face.mIndices[0]);
+			indices.push_back(baseVertex + face.mIndices[1]);
+			indices.push_back(baseVertex + face.mIndices[2]);
+		}
+	}
+
+	if (indices.empty())
+		throw GardenError("Model has no triangles.");
+}
+
+//******************************************************************************************************************
+static void writeVertexData(const VertexStreams& streams, ModelConverter::ModelData& data)
+{
+	auto& channels = data.channels;
+	channels.push_back(BufferChannel::Positions);
+	channels.push_back(BufferChannel::Normals);
+	if (!streams.tangents.empty())
+	{
+		channels.push_back(BufferChannel::Tangents);
+		channels.push_back(BufferChannel::Bitangents);
+	}
+	if (!streams.texCoords.empty())
+		channels.push_back(BufferChannel::TextureCoords);
+	if (!streams.colors.empty())
+		channels.push_back(BufferChannel::VertexColors);
+
+	auto vertexSize = toBinarySize(channels);
+	data.vertexData.resize(vertexSize * data.vertexCount);
+	auto vertices = data.vertexData.data();
+
+	for (uint32 i = 0; i < data.vertexCount; i++)
+	{
+		for (auto channel : channels)
+		{
+			switch (channel)
+			{
+			case BufferChannel::Positions: *(float3*)vertices = streams.positions[i]; break;
+			case BufferChannel::Normals: *(float3*)vertices = streams.normals[i]; break;
+			case BufferChannel::Tangents: *(float3*)vertices = streams.tangents[i]; break;
+			case BufferChannel::Bitangents: *(float3*)vertices = streams.bitangents[i]; break;
+			case BufferChannel::TextureCoords: *(float2*)vertices = streams.texCoords[i]; break;
+			case BufferChannel::VertexColors: *(float4*)vertices = streams.colors[i]; break;
+			default: abort();
+			}
+			vertices += toBinarySize(channel);
+		}
+	}
+}
+
+static uint16 quantizeUnorm16(float value) noexcept
+{
+	return (uint16)(std::clamp(value, 0.0f, 1.0f) * UINT16_MAX + 0.5f);
+}
+static void encodeOctahedral(float3 direction, int16* encoded) noexcept
+{
+	auto sum = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+	if (sum == 0.0f)
+	{
+		encoded[0] = encoded[1] = 0;
+		return;
+	}
+
+	auto x = direction.x / sum, y = direction.y / sum;
+	if (direction.z < 0.0f)
+	{
+		auto foldX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		y = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f); x = foldX;
+	}
+
+	encoded[0] = (int16)std::round(std::clamp(x, -1.0f, 1.0f) * INT16_MAX);
+	encoded[1] = (int16)std::round(std::clamp(y, -1.0f, 1.0f) * INT16_MAX);
+}
+static void quantizeVertexData(const ModelConverter::ModelData& data, vector<uint8>& quantizedData)
+{
+	auto extent = data.aabbMax - data.aabbMin;
+	auto invExtent = float3(extent.x > 0.0f ? 1.0f / extent.x : 0.0f, 
+		extent.y > 0.0f ? 1.0f / extent.y : 0.0f, extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+	quantizedData.resize(toQuantizedSize(data.channels) * data.vertexCount);
+	auto quantized = quantizedData.data();
+	auto vertices = data.vertexData.data();
+
+	for (uint32 i = 0; i < data.vertexCount; i++)
+	{
+		for (auto channel : data.channels)
+		{
+			switch (channel)
+			{
+			case BufferChannel::Positions:
+			{
+				auto position = (*(const float3*)vertices - data.aabbMin) * invExtent;
+				uint16 encoded[3] = { quantizeUnorm16(position.x), 
+					quantizeUnorm16(position.y), quantizeUnorm16(position.z) };
+				memcpy(quantized, encoded, sizeof(encoded));
+				break;
+			}
+			case BufferChannel::Normals:
+			case BufferChannel::Tangents:
+			case BufferChannel::Bitangents:
+			{
+				int16 encoded[2]; encodeOctahedral(*(const float3*)vertices, encoded);
+				memcpy(quantized, encoded, sizeof(encoded));
+				break;
+			}
+			case BufferChannel::TextureCoords:
+			{
+				auto texCoords = *(const float2*)vertices;
+				half encoded[2] = { (half)texCoords.x, (half)texCoords.y };
+				memcpy(quantized, encoded, sizeof(encoded));
+				break;
+			}
+			case BufferChannel::VertexColors:
+			{
+				auto color = *(const float4*)vertices;
+				quantized[0] = (uint8)(std::clamp(color.x, 0.0f, 1.0f) * UINT8_MAX + 0.5f);
+				quantized[1] = (uint8)(std::clamp(color.y, 0.0f, 1.0f) * UINT8_MAX + 0.5f);
+				quantized[2] = (uint8)(std::clamp(color.z, 0.0f, 1.0f) * UINT8_MAX + 0.5f);
+				quantized[3] = (uint8)(std::clamp(color.w, 0.0f, 1.0f) * UINT8_MAX + 0.5f);
+				break;
+			}
+			default: abort();
+			}
+
+			quantized += toQuantizedSize(channel);
+			vertices += toBinarySize(channel);
+		}
+	}
+}
+
+static void writeModelFile(const fs::path& filePath, const ModelConverter::ModelData& data, uint32 indexCount)
+{
+	ModelHeader header;
+	memcpy(header.magic, ModelConverter::modelMagic.data(), sizeof(header.magic));
+	header.version = modelVersion;
+	header.isLittleEndian = GARDEN_LITTLE_ENDIAN;
+	header.channelCount = (uint8)data.channels.size();
+	header.lodCount = (uint8)data.lods.size();
+	header.indexType = (uint8)data.indexType;
+	header.vertexCount = data.vertexCount;
+	header.indexCount = indexCount;
+	header.meshletCount = (uint32)data.meshlets.size();
+	header.meshletVertexCount = (uint32)data.meshletVertices.size();
+	header.meshletTriangleSize = (uint32)data.meshletTriangles.size();
+	header.aabbMin = data.aabbMin;
+	header.aabbMax = data.aabbMax;
+
+	auto directory = filePath.parent_path();
+	if (!fs::exists(directory))
+		fs::create_directories(directory);
+
+	ofstream outputStream(filePath, ios::out | ios::binary);
+	if (!outputStream.is_open())
+		throw GardenError("Failed to open output model file.");
+	outputStream.exceptions(ios::failbit | ios::badbit);
+
+	outputStream.write((const char*)&header, sizeof(ModelHeader));
+	outputStream.write((const char*)data.channels.data(), data.channels.size() * sizeof(BufferChannel));
+	outputStream.write((const char*)data.lods.data(), data.lods.size() * sizeof(ModelConverter::Lod));
+	vector<uint8> quantizedData; quantizeVertexData(data, quantizedData);
+	outputStream.write((const char*)quantizedData.data(), quantizedData.size());
+	outputStream.write((const char*)data.indexData.data(), data.indexData.size());
+	outputStream.write((const char*)data.meshlets.data(), data.meshlets.size() * sizeof(ModelConverter::Meshlet));
+	outputStream.write((const char*)data.meshletVertices.data(), data.meshletVertices.size() * sizeof(uint32));
+	outputStream.write((const char*)data.meshletTriangles.data(), data.meshletTriangles.size());
+}
+
 //******************************************************************************************************************
 bool ModelConverter::convertModel(const fs::path& filePath, const fs::path& inputPath, const fs::path& outputPath)
 {
-	return false;
+	GARDEN_ASSERT(!filePath.empty());
+
+	auto inputFilePath = inputPath / filePath;
+	if (!filePath.has_extension() || !fs::exists(inputFilePath))
+	{
+		auto isFound = false;
+		for (auto fileExt : modelFileExts)
+		{
+			inputFilePath = inputPath / filePath; inputFilePath += fileExt;
+			if (!fs::exists(inputFilePath))
+				continue;
+			isFound = true;
+			break;
+		}
+
+		if (!isFound)
+			return false;
+	}
+
+	VertexStreams streams; vector<uint32> indices;
+	importModel(inputFilePath, streams, indices);
+
+	auto vertexCount = (uint32)streams.positions.size();
+	auto lod0IndexCount = (uint32)indices.size();
+	optimizeVertexCache(indices.data(), lod0IndexCount, vertexCount);
+	optimizeOverdraw(indices.data(), lod0IndexCount, streams.positions.data(), vertexCount);
+
+	ModelData data;
+	data.aabbMin = data.aabbMax = streams.positions[indices[0]];
+	for (auto index : indices)
+	{
+		data.aabbMin = min(data.aabbMin, streams.positions[index]);
+		data.aabbMax = max(data.aabbMax, streams.positions[index]);
+	}
+
+	auto extent = data.aabbMax - data.aabbMin;
+	auto maxExtent = std::max(std::max(extent.x, extent.y), extent.z);
+
+	Lod lod;
+	lod.indexCount = lod0IndexCount;
+	data.lods.push_back(lod);
+
+	if (maxExtent > 0.0f)
+	{
+		vector<uint32> lodIndices; uint32 gridSize = 1024;
+		while (data.lods.size() < maxLodCount && gridSize > 1)
+		{
+			const auto& prevLod = data.lods.back();
+			auto targetIndexCount = prevLod.indexCount / 2;
+			if (targetIndexCount < 64 * 3)
+				break;
+
+			while (gridSize > 1)
+			{
+				simplifyMesh(indices.data(), lod0IndexCount, streams.positions.data(),
+					vertexCount, data.aabbMin, maxExtent / gridSize, lodIndices);
+				if (lodIndices.size() <= targetIndexCount)
+					break;
+				gridSize /= 2;
+			}
+
+			if (lodIndices.empty() || lodIndices.size() > prevLod.indexCount * 9 / 10)
+				break;
+
+			optimizeVertexCache(lodIndices.data(), (uint32)lodIndices.size(), vertexCount);
+			lod.indexOffset = (uint32)indices.size();
+			lod.indexCount = (uint32)lodIndices.size();
+			lod.error = 1.0f / gridSize;
+			indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+			data.lods.push_back(lod);
+			gridSize /= 2;
+		}
+	}
+
+	data.vertexCount = optimizeVertexFetch(indices, streams, vertexCount);
+	writeVertexData(streams, data);
+
+	vector<uint8> localIndices(data.vertexCount, UINT8_MAX);
+	for (auto& modelLod : data.lods)
+	{
+		modelLod.meshletOffset = (uint32)data.meshlets.size();
+		buildMeshlets(indices.data() + modelLod.indexOffset, modelLod.indexCount,
+			streams.positions.data(), localIndices, data);
+		modelLod.meshletCount = (uint32)data.meshlets.size() - modelLod.meshletOffset;
+	}
+
+	auto indexCount = (uint32)indices.size();
+	if (data.vertexCount <= UINT16_MAX + 1)
+	{
+		data.indexType = IndexType::Uint16;
+		data.indexData.resize(indexCount * sizeof(uint16));
+		auto indexData = (uint16*)data.indexData.data();
+		for (uint32 i = 0; i < indexCount; i++)
+			indexData[i] = (uint16)indices[i];
+	}
+	else
+	{
+		data.indexType = IndexType::Uint32;
+		data.indexData.resize(indexCount * sizeof(uint32));
+		memcpy(data.indexData.data(), indices.data(), data.indexData.size());
+	}
+
+	auto outputFilePath = outputPath / filePath;
+	outputFilePath.replace_extension(modelExtension);
+	writeModelFile(outputFilePath, data, indexCount);
+	return true;
 }
 #endif
 
-#if true
+#ifdef GARDEN_MODEL_CONVERTER
 //******************************************************************************************************************
 int main(int argc, char* argv[])
 {
-	return 0;
+	if (argc < 2)
+	{
+		cout << "modelc: error: no model file name" << endl;
+		return EXIT_FAILURE;
+	}
+
+	fs::path workingPath = fs::path(argv[0]).parent_path();
+	auto inputPath = workingPath, outputPath = workingPath;
+	ThreadPool* threadPool = nullptr; atomic_int convertResult = true;
+
+	for (int i = 1; i < argc; i++)
+	{
+		auto arg = argv[i];
+		if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0)
+		{
+			cout << "(C) 2022-" GARDEN_CURRENT_YEAR " Nikita Fediuchin. All rights reserved.\n"
+				"modelc - Garden 3D Model Converter\n"
+				"\n"
+				"Usage: modelc [options] name...\n"
+				"\n"
+				"Options:\n"
+				"  -i <dir>      Read input from <dir>.\n"
+				"  -o <dir>      Write output to <dir>.\n"
+				"  -t <value>    Specify thread pool size. (Uses all cores by default)\n"
+				"  -h            Display available options.\n"
+				"  --help        Display available options.\n"
+				"  --version     Display converter version information." << endl;
+			return EXIT_SUCCESS;
+		}
+		else if (strcmp(arg, "--version") == 0)
+		{
+			cout << "modelc " GARDEN_VERSION_STRING << endl;
+			return EXIT_SUCCESS;
+		}
+		else if (strcmp(arg, "-i") == 0)
+		{
+			if (i + 1 >= argc)
+			{
+				cout << "modelc: error: no input directory" << endl;
+				return EXIT_FAILURE;
+			}
+
+			inputPath = argv[i + 1]; i++;
+		}
+		else if (strcmp(arg, "-o") == 0)
+		{
+			if (i + 1 >= argc)
+			{
+				cout << "modelc: error: no output directory" << endl;
+				return EXIT_FAILURE;
+			}
+
+			outputPath = argv[i + 1]; i++;
+		}
+		else if (strcmp(arg, "-t") == 0)
+		{
+			if (i + 1 >= argc)
+			{
+				cout << "modelc: error: no thread count" << endl;
+				return EXIT_FAILURE;
+			}
+
+			auto count = atoi(argv[i + 1]);
+			if (count > 0 && count < thread::hardware_concurrency())
+			{
+				if (threadPool)
+				{
+					threadPool->wait();
+					delete threadPool;
+				}
+				threadPool = new ThreadPool(false, "T", count);
+			}
+			i++;
+		}
+		else if (arg[0] == '-')
+		{
+			cout << string("modelc: error: unsupported option: '") + arg + "'" << endl;
+			return EXIT_FAILURE;
+		}
+		else
+		{
+			if (!threadPool)
+				threadPool = new ThreadPool(false, "T");
+			threadPool->addTask([=, &convertResult](const ThreadPool::Task& task)
+			{
+				if (!convertResult)
+					return;
+
+				// Note: Sending one batched message due to multithreading.
+				cout << string("Converting ") + arg + "\n" << flush;
+				auto result = false;
+
+				try
+				{
+					result = ModelConverter::convertModel(arg, inputPath, outputPath);
+					if (!result)
+						cout << string("modelc: error: no model file found (") + arg + ")\n" << flush;
+				}
+				catch (const exception& e)
+				{
+					cout << string("modelc: error: ") + e.what() + " (" + arg + ")\n" << flush;
+				}
+
+				convertResult &= result;
+			});
+		}
+	}
+
+	if (threadPool)
+	{
+		threadPool->wait();
+		delete threadPool;
+	}
+	return convertResult ? EXIT_SUCCESS : EXIT_FAILURE;
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,100 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "garden/graphics/null/api.hpp"
+#include "garden/graphics/null/swapchain.hpp"
+#include "garden/graphics/null/command-buffer.hpp"
+#include "garden/graphics/glfw.hpp" // Note: Do not move it.
+
+using namespace garden;
+
+//**********************************************************************************************************************
+NullAPI::NullAPI(const string& appName, uint2 windowSize, ThreadPool* threadPool, bool useVsync, 
+	bool useTripleBuffering, bool isFullscreen, bool isDecorated) : 
+	GraphicsAPI(appName, windowSize, threadPool, isFullscreen, isDecorated)
+{
+	this->backendType = GraphicsBackend::NullAPI;
+
+	if (threadPool)
+	{
+		auto threadCount = threadPool->getThreadCount();
+		this->currentPipelines.resize(threadCount);
+		this->currentPipelineTypes.resize(threadCount);
+		this->currentPipelineVariants.resize(threadCount);
+		this->currentVertexBuffers.resize(threadCount);
+		this->currentIndexBuffers.resize(threadCount);
+	}
+
+	int sizeX = 0, sizeY = 0;
+	glfwGetFramebufferSize((GLFWwindow*)window, &sizeX, &sizeY);
+	swapchain = new NullSwapchain(this, uint2(sizeX, sizeY), useVsync, useTripleBuffering);
+
+	frameCommandBuffer = new NullCommandBuffer(this, CommandBufferType::Frame);
+	graphicsCommandBuffer = new NullCommandBuffer(this, CommandBufferType::Graphics);
+	transferCommandBuffer = new NullCommandBuffer(this, CommandBufferType::TransferOnly);
+	computeCommandBuffer = new NullCommandBuffer(this, CommandBufferType::Compute);
+
+	GARDEN_ASSERT_MSG(!nullInstance, "Graphics API is already initialized");
+	nullInstance = this;
+}
+NullAPI::~NullAPI()
+{
+	GARDEN_ASSERT_MSG(nullInstance, "Graphics API is not initialized");
+	// Note: Should be set here, to destroy resources.
+	forceResourceDestroy = false;
+
+	delete computeCommandBuffer;
+	delete transferCommandBuffer;
+	delete graphicsCommandBuffer;
+	delete frameCommandBuffer;
+
+	for (int i = 0; i < inFlightCount + 1; i++)
+		flushDestroyBuffer();
+	delete swapchain;
+
+	tlasPool.clear();
+	blasPool.clear();
+	descriptorSetPool.clear();
+	rayTracingPipelinePool.clear();
+	computePipelinePool.clear();
+	graphicsPipelinePool.clear();
+	samplerPool.clear();
+	framebufferPool.clear();
+	imageViewPool.clear();
+	imagePool.clear();
+	bufferPool.clear();
+
+	nullInstance = nullptr;
+}
+
+//**********************************************************************************************************************
+void NullAPI::flushDestroyBuffer()
+{
+	auto& destroyBuffer = destroyBuffers[flushDestroyIndex];
+	flushDestroyIndex = (flushDestroyIndex + 1) % (inFlightCount + 1);
+	fillDestroyIndex = (fillDestroyIndex + 1) % (inFlightCount + 1);
+
+	if (destroyBuffer.empty())
+		return;
+
+	for (auto& resource : destroyBuffer)
+	{
+		// Note: Only buffers own host memory, other resources are opaque handles.
+		if (resource.type == GraphicsAPI::DestroyResourceType::Buffer)
+			free(resource.data1);
+	}
+
+	destroyBuffer.clear();
+}
@@ -0,0 +1,77 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "garden/graphics/null/command-buffer.hpp"
+#include "garden/profiler.hpp"
+
+using namespace garden;
+using namespace garden::graphics;
+
+//**********************************************************************************************************************
+void NullCommandBuffer::submit()
+{
+	SET_CPU_ZONE_SCOPED("Command Buffer Submit");
+
+	if (type != CommandBufferType::Frame)
+	{
+		// Note: Previous submit is already completed, there is no device.
+		flushLockedResources(lockedResources);
+
+		if (!hasAnyCommand)
+		{
+			size = lastSize = 0;
+			return;
+		}
+	}
+
+	processCommands();
+
+	std::swap(lockingResources, lockedResources);
+	size = lastSize = 0;
+	hasAnyCommand = false;
+}
+
+//**********************************************************************************************************************
+void NullCommandBuffer::processCommand(const FillBufferCommand& command)
+{
+	auto bufferView = GraphicsAPI::get()->bufferPool.get(command.buffer);
+	auto map = bufferView->getMap();
+	if (!map)
+		return;
+
+	auto size = command.size == 0 ? bufferView->getBinarySize() - command.offset : command.size;
+	auto data = (uint32*)(map + command.offset);
+	for (uint64 i = 0; i < size / sizeof(uint32); i++)
+		data[i] = command.data;
+}
+void NullCommandBuffer::processCommand(const CopyBufferCommand& command)
+{
+	auto graphicsAPI = GraphicsAPI::get();
+	auto srcBuffer = graphicsAPI->bufferPool.get(command.source);
+	auto dstBuffer = graphicsAPI->bufferPool.get(command.destination);
+	auto srcMap = srcBuffer->getMap(); auto dstMap = dstBuffer->getMap();
+	if (!srcMap || !dstMap)
+		return;
+
+	auto regionCount = command.regionCount;
+	auto regions = (const Buffer::CopyRegion*)((const uint8*)&command + sizeof(CopyBufferCommandBase));
+
+	for (uint32 i = 0; i < regionCount; i++)
+	{
+		auto region = regions[i];
+		memcpy(dstMap + region.dstOffset, srcMap + region.srcOffset, 
+			region.size == 0 ? srcBuffer->getBinarySize() : region.size);
+	}
+}
@@ -0,0 +1,91 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "garden/graphics/null/swapchain.hpp"
+#include "garden/graphics/null/api.hpp"
+#include "garden/profiler.hpp"
+
+using namespace garden;
+using namespace garden::graphics;
+
+//**********************************************************************************************************************
+static vector<ID<Image>> createNullSwapchainImages(NullAPI* nullAPI, uint2 framebufferSize, bool useTripleBuffering)
+{
+	auto imageCount = useTripleBuffering ? 3u : 2u;
+	vector<ID<Image>> images(imageCount); auto imageData = images.data();
+
+	for (uint32 i = 0; i < imageCount; i++)
+	{
+		auto image = nullAPI->imagePool.create(NullAPI::createInstance(), Image::Format::SrgbB8G8R8A8, 
+			Image::Usage::TransferDst, Image::Strategy::Default, framebufferSize, (uint8)GraphicsBackend::NullAPI);
+		imageData[i] = image;
+
+		#if GARDEN_DEBUG || GARDEN_EDITOR
+		auto imageView = nullAPI->imagePool.get(image);
+		ResourceExt::getDebugName(**imageView) = "image.swapchain" + to_string(i);
+		#endif
+	}
+
+	return images;
+}
+static void destroyNullSwapchainImages(NullAPI* nullAPI, const vector<ID<Image>>& images)
+{
+	for (auto image : images)
+	{
+		auto imageView = nullAPI->imagePool.get(image);
+		imageView->freeAllViews();
+		nullAPI->imagePool.destroy(image);
+	}
+}
+
+//**********************************************************************************************************************
+NullSwapchain::NullSwapchain(NullAPI* nullAPI, uint2 framebufferSize, bool useVsync,
+	bool useTripleBuffering) : Swapchain(useVsync, useTripleBuffering), nullAPI(nullAPI)
+{
+	framebufferSize = max(framebufferSize, uint2(GraphicsAPI::minFramebufferSize));
+	images = createNullSwapchainImages(nullAPI, framebufferSize, useTripleBuffering);
+	this->framebufferSize = framebufferSize;
+}
+NullSwapchain::~NullSwapchain()
+{
+	destroyNullSwapchainImages(nullAPI, images);
+}
+
+void NullSwapchain::recreate(uint2 framebufferSize, bool useVsync, bool useTripleBuffering)
+{
+	destroyNullSwapchainImages(nullAPI, images);
+	framebufferSize = max(framebufferSize, uint2(GraphicsAPI::minFramebufferSize));
+	images = createNullSwapchainImages(nullAPI, framebufferSize, useTripleBuffering);
+
+	// Note: Do not reset inFlightIndex here, temporal systems use it.
+	this->framebufferSize = framebufferSize;
+	this->imageIndex = 0;
+	this->vsync = useVsync;
+	this->tripleBuffering = useTripleBuffering;
+}
+
+//**********************************************************************************************************************
+bool NullSwapchain::acquireNextImage()
+{
+	SET_CPU_ZONE_SCOPED("Next Image Acquire");
+	imageIndex = (imageIndex + 1u) % (uint32)images.size();
+	return true;
+}
+bool NullSwapchain::present()
+{
+	SET_CPU_ZONE_SCOPED("Front Image Present");
+	inFlightIndex = (inFlightIndex + 1u) % inFlightCount;
+	return true;
+}
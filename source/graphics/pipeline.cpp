@@ -14,6 +14,7 @@
 
 #include "garden/graphics/pipeline.hpp"
 #include "garden/graphics/vulkan/api.hpp"
+#include "garden/graphics/null/api.hpp"
 
 using namespace garden;
 using namespace garden::graphics;
@@ -353,6 +354,30 @@ static vector<void*> createVkShaders(const vector<uint8>* codeArray, uint8 shade
 	return shaders;
 }
 
+//**********************************************************************************************************************
+static void createNullDescriptorSetLayouts(vector<void*>& descriptorSetLayouts, 
+	vector<void*>& descriptorPools, const Pipeline::Uniforms& uniforms, uint8 descriptorSetCount)
+{
+	descriptorSetLayouts.resize(descriptorSetCount);
+	descriptorPools.resize(descriptorSetCount);
+
+	for (uint8 dsIndex = 0; dsIndex < descriptorSetCount; dsIndex++)
+	{
+		descriptorSetLayouts[dsIndex] = NullAPI::createInstance();
+
+		for	(const auto& uniformPair : uniforms)
+		{
+			auto pipelineUniform = uniformPair.second;
+			if (pipelineUniform.descriptorSetIndex != dsIndex || pipelineUniform.arraySize > 0)
+				continue;
+
+			// Note: Descriptor pool is only created for bindless descriptor sets.
+			descriptorPools[dsIndex] = NullAPI::createInstance();
+			break;
+		}
+	}
+}
+
 //**********************************************************************************************************************
 Pipeline::Pipeline(CreateData& createData, bool asyncRecording)
 {
@@ -381,6 +406,13 @@ Pipeline::Pipeline(CreateData& createData, bool asyncRecording)
 		this->pipelineLayout = createVkPipelineLayout(pushConstantsSize,
 			createData.pushConstantsStages, descriptorSetLayouts, createData.shaderPath);
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+	{
+		this->pushConstantsMask = (uint32)createData.pushConstantsStages;
+		createNullDescriptorSetLayouts(descriptorSetLayouts, 
+			descriptorPools, uniforms, createData.descriptorSetCount);
+		this->pipelineLayout = NullAPI::createInstance();
+	}
 	else abort();
 }
 
@@ -411,7 +443,7 @@ bool Pipeline::destroy()
 		destroyVkPipeline(instance, pipelineLayout, 
 			samplers, descriptorSetLayouts, descriptorPools, variantCount);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 
 	return true;
 }
@@ -421,6 +453,8 @@ vector<void*> Pipeline::createShaders(const vector<uint8>* codeArray, uint8 shad
 	auto graphicsBackend = GraphicsAPI::get()->getBackendType();
 	if (graphicsBackend == GraphicsBackend::VulkanAPI)
 		return createVkShaders(codeArray, shaderCount, pipelinePath);
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		return vector<void*>(shaderCount, NullAPI::createInstance());
 	else abort();
 }
 void Pipeline::destroyShaders(const vector<void*>& shaders)
@@ -432,7 +466,7 @@ void Pipeline::destroyShaders(const vector<void*>& shaders)
 		for (auto shader : shaders)
 			vulkanAPI->device.destroyShaderModule((VkShaderModule)shader);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 
 //**********************************************************************************************************************
@@ -729,6 +763,19 @@ void Pipeline::bindAsync(uint8 variant, int32 threadIndex)
 			threadIndex++;
 		}
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+	{
+		while (threadIndex < autoThreadCount)
+		{
+			graphicsAPI->currentPipelines[threadIndex] = pipeline;
+			graphicsAPI->currentPipelineTypes[threadIndex] = type;
+			graphicsAPI->currentPipelineVariants[threadIndex] = variant;
+
+			if (resourceType != ResourceType::Count)
+				currentCommandBuffer->addLockedResource(resourceType, ID<Resource>(pipeline), threadIndex);
+			threadIndex++;
+		}
+	}
 	else abort();
 }
 
@@ -841,6 +888,15 @@ void Pipeline::bindDescriptorSetsAsync(const DescriptorSet::Range* descriptorSet
 		}
 		vkDescriptorSets.clear();
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+	{
+		while (threadIndex < autoThreadCount)
+		{
+			currentCommandBuffer->addCommand(AsyncRenderCommand(command), threadIndex);
+			updateDescriptorsLock(descriptorSetRanges, rangeCount, threadIndex);
+			threadIndex++;
+		}
+	}
 	else abort();
 }
 
@@ -882,5 +938,5 @@ void Pipeline::pushConstantsAsync(const void* data, int32 threadIndex)
 			vk::PipelineLayout((VkPipelineLayout)pipelineLayout), 
 			(vk::ShaderStageFlags)pushConstantsMask, 0, pushConstantsSize, data);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 #include "garden/graphics/pipeline/compute.hpp"
 #include "garden/graphics/vulkan/api.hpp"
+#include "garden/graphics/null/api.hpp"
 
 using namespace garden::graphics;
 
@@ -62,6 +63,8 @@ ComputePipeline::ComputePipeline(ComputeCreateData& createData, bool asyncRecord
 	auto graphicsBackend = GraphicsAPI::get()->getBackendType();
 	if (graphicsBackend == GraphicsBackend::VulkanAPI)
 		createVkInstance(createData);
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		this->instance = NullAPI::createInstance();
 	else abort();
 }
 
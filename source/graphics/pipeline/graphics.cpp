@@ -14,6 +14,7 @@
 
 #include "garden/graphics/pipeline/graphics.hpp"
 #include "garden/graphics/vulkan/api.hpp"
+#include "garden/graphics/null/api.hpp"
 
 using namespace garden;
 using namespace garden::graphics;
@@ -382,6 +383,8 @@ GraphicsPipeline::GraphicsPipeline(GraphicsCreateData& createData,
 	auto graphicsBackend = GraphicsAPI::get()->getBackendType();
 	if (graphicsBackend == GraphicsBackend::VulkanAPI)
 		createVkInstance(createData);
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		this->instance = NullAPI::createInstance();
 	else abort();
 }
 
@@ -449,7 +452,7 @@ void GraphicsPipeline::setViewportAsync(float4 viewport, int32 threadIndex)
 		while (threadIndex < autoThreadCount)
 			secondaryCommandBuffers[threadIndex++].setViewport(0, 1, &vkViewport);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 
 //**********************************************************************************************************************
@@ -506,7 +509,7 @@ void GraphicsPipeline::setScissorAsync(int4 scissor, int32 threadIndex)
 		while (threadIndex < autoThreadCount)
 			secondaryCommandBuffers[threadIndex++].setScissor(0, 1, &vkScissor);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 
 //**********************************************************************************************************************
@@ -575,7 +578,7 @@ void GraphicsPipeline::setViewportScissorAsync(float4 viewportScissor, int32 thr
 			secondaryCommandBuffer.setScissor(0, 1, &vkScissor);
 		}
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 
 //**********************************************************************************************************************
@@ -656,6 +659,16 @@ void GraphicsPipeline::drawAsync(int32 threadIndex, ID<Buffer> vertexBuffer,
 		secondaryCommandBuffer.draw(vertexCount, instanceCount, vertexOffset, instanceOffset);
 		vulkanAPI->secondaryCommandStates[threadIndex]->store(true);
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+	{
+		if (vertexBuffer)
+		{
+			vertexBufferView = OptView<Buffer>(graphicsAPI->bufferPool.get(vertexBuffer));
+			GARDEN_ASSERT_MSG(ResourceExt::getInstance(**vertexBufferView), "Vertex buffer [" + 
+				vertexBufferView->getDebugName() + "] is not ready");
+			graphicsAPI->currentVertexBuffers[threadIndex] = vertexBuffer;
+		}
+	}
 	else abort();
 
 	DrawCommand command;
@@ -772,6 +785,11 @@ void GraphicsPipeline::drawIndexedAsync(int32 threadIndex, ID<Buffer> vertexBuff
 		secondaryCommandBuffer.drawIndexed(indexCount, instanceCount, indexOffset, vertexOffset, instanceOffset);
 		vulkanAPI->secondaryCommandStates[threadIndex]->store(true);
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+	{
+		graphicsAPI->currentVertexBuffers[threadIndex] = vertexBuffer;
+		graphicsAPI->currentIndexBuffers[threadIndex] = indexBuffer;
+	}
 	else abort();
 
 	DrawIndexedCommand command;
@@ -783,8 +801,8 @@ void GraphicsPipeline::drawIndexedAsync(int32 threadIndex, ID<Buffer> vertexBuff
 	{
 		atomicFetchAdd32(&ResourceExt::getBusyLock(**vertexBufferView), 1);
 		atomicFetchAdd32(&ResourceExt::getBusyLock(**indexBufferView), 1);
-		currentCommandBuffer->addLockedResource(vertexBuffer);
-		currentCommandBuffer->addLockedResource(indexBuffer);
+		currentCommandBuffer->addLockedResource(vertexBuffer, threadIndex);
+		currentCommandBuffer->addLockedResource(indexBuffer, threadIndex);
 	}
 }
 
@@ -829,7 +847,7 @@ void GraphicsPipeline::drawFullscreenAsync(int32 threadIndex)
 		secondaryCommandBuffer.draw(3, 1, 0, 0);
 		vulkanAPI->secondaryCommandStates[threadIndex]->store(true);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 
 void GraphicsPipeline::setDepthBias(float constantFactor, float slopeFactor, float clamp)
@@ -863,5 +881,5 @@ void GraphicsPipeline::setDepthBiasAsync(float constantFactor, float slopeFactor
 		while (threadIndex < autoThreadCount)
 			secondaryCommandBuffers[threadIndex++].setDepthBias(constantFactor, clamp, slopeFactor);
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
\ No newline at end of file
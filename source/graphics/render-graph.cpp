@@ -0,0 +1,685 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "garden/graphics/render-graph.hpp"
+#include "garden/graphics/vulkan/api.hpp"
+#include "garden/profiler.hpp"
+#include <algorithm>
+
+using namespace garden;
+using namespace garden::graphics;
+
+namespace
+{
+	struct SyncState final
+	{
+		uint64 writeStage = 0;
+		uint64 writeAccess = 0;
+		uint64 readStage = 0;
+		uint64 readAccess = 0;
+		uint32 layout = 0;
+		bool hasState = false;
+	};
+	struct AliasGroup final
+	{
+		vector<uint2> lifetimes;
+		uint64 binarySize = 0;
+		uint64 alignment = 1;
+		uint32 memoryTypes = UINT32_MAX;
+	};
+}
+
+//**********************************************************************************************************************
+static Image::LayoutState toVkLayoutState(RenderGraph::Access access,
+	PipelineStage stages, Image::Format format, bool isWrite) noexcept
+{
+	Image::LayoutState state;
+	switch (access)
+	{
+	case RenderGraph::Access::ColorAttachment:
+		state.stage = (uint64)vk::PipelineStageFlagBits2::eColorAttachmentOutput;
+		state.access = (uint64)(vk::AccessFlagBits2::eColorAttachmentRead | vk::AccessFlagBits2::eColorAttachmentWrite);
+		state.layout = (uint32)vk::ImageLayout::eColorAttachmentOptimal;
+		break;
+	case RenderGraph::Access::DepthStencilAttachment:
+		state.stage = (uint64)(vk::PipelineStageFlagBits2::eEarlyFragmentTests |
+			vk::PipelineStageFlagBits2::eLateFragmentTests);
+		state.access = (uint64)vk::AccessFlagBits2::eDepthStencilAttachmentRead;
+		if (isWrite)
+			state.access |= (uint64)vk::AccessFlagBits2::eDepthStencilAttachmentWrite;
+
+		// Note: Matches framebuffer depth/stencil attachment layouts.
+		if (isFormatDepthOnly(format))
+		{
+			state.layout = (uint32)(isWrite ? vk::ImageLayout::eDepthAttachmentOptimal :
+				vk::ImageLayout::eDepthReadOnlyOptimal);
+		}
+		else if (isFormatStencilOnly(format))
+		{
+			state.layout = (uint32)(isWrite ? vk::ImageLayout::eStencilAttachmentOptimal :
+				vk::ImageLayout::eStencilReadOnlyOptimal);
+		}
+		else
+		{
+			state.layout = (uint32)(isWrite ? vk::ImageLayout::eDepthStencilAttachmentOptimal :
+				vk::ImageLayout::eDepthStencilReadOnlyOptimal);
+		}
+		break;
+	case RenderGraph::Access::Sampled:
+		state.stage = (uint64)toVkPipelineStages(stages);
+		state.access = (uint64)vk::AccessFlagBits2::eShaderSampledRead;
+		state.layout = (uint32)vk::ImageLayout::eShaderReadOnlyOptimal;
+		break;
+	case RenderGraph::Access::Storage:
+		state.stage = (uint64)toVkPipelineStages(stages);
+		state.access = (uint64)(isWrite ? vk::AccessFlagBits2::eShaderStorageWrite :
+			vk::AccessFlagBits2::eShaderStorageRead);
+		state.layout = (uint32)vk::ImageLayout::eGeneral;
+		break;
+	case RenderGraph::Access::Uniform:
+		state.stage = (uint64)toVkPipelineStages(stages);
+		state.access = (uint64)vk::AccessFlagBits2::eUniformRead;
+		break;
+	case RenderGraph::Access::Vertex:
+		state.stage = (uint64)vk::PipelineStageFlagBits2::eVertexAttributeInput;
+		state.access = (uint64)vk::AccessFlagBits2::eVertexAttributeRead;
+		break;
+	case RenderGraph::Access::Index:
+		state.stage = (uint64)vk::PipelineStageFlagBits2::eIndexInput;
+		state.access = (uint64)vk::AccessFlagBits2::eIndexRead;
+		break;
+	case RenderGraph::Access::Indirect:
+		state.stage = (uint64)vk::PipelineStageFlagBits2::eDrawIndirect;
+		state.access = (uint64)vk::AccessFlagBits2::eIndirectCommandRead;
+		break;
+	case RenderGraph::Access::Transfer:
+		state.stage = (uint64)vk::PipelineStageFlagBits2::eTransfer;
+		if (isWrite)
+		{
+			state.access = (uint64)vk::AccessFlagBits2::eTransferWrite;
+			state.layout = (uint32)vk::ImageLayout::eTransferDstOptimal;
+		}
+		else
+		{
+			state.access = (uint64)vk::AccessFlagBits2::eTransferRead;
+			state.layout = (uint32)vk::ImageLayout::eTransferSrcOptimal;
+		}
+		break;
+	default: abort();
+	}
+	return state;
+}
+static Image::LayoutState toLayoutState(RenderGraph::Access access,
+	PipelineStage stages, Image::Format format, bool isWrite, GraphicsBackend graphicsBackend) noexcept
+{
+	if (graphicsBackend == GraphicsBackend::VulkanAPI)
+		return toVkLayoutState(access, stages, format, isWrite);
+
+	if (graphicsBackend == GraphicsBackend::NullAPI)
+	{
+		Image::LayoutState state;
+		state.stage = (uint64)stages;
+		state.access = (uint64)1 << ((uint8)access * 2 + (isWrite ? 1 : 0));
+		state.layout = (uint32)access + 1;
+		return state;
+	}
+	abort();
+}
+
+static Image::Usage toImageUsage(RenderGraph::Access access, bool isWrite) noexcept
+{
+	switch (access)
+	{
+		case RenderGraph::Access::ColorAttachment: return Image::Usage::ColorAttachment;
+		case RenderGraph::Access::DepthStencilAttachment: return Image::Usage::DepthStencilAttachment;
+		case RenderGraph::Access::Sampled: return Image::Usage::Sampled;
+		case RenderGraph::Access::Storage: return Image::Usage::Storage;
+		case RenderGraph::Access::Transfer: return isWrite ? Image::Usage::TransferDst : Image::Usage::TransferSrc;
+		default: abort(); // Note: Other access types are only supported by the buffers.
+	}
+}
+static Image::Usage toImageQ(CommandBufferType commandBufferType) noexcept
+{
+	if (commandBufferType == CommandBufferType::TransferOnly)
+		return Image::Usage::TransferQ;
+	if (commandBufferType == CommandBufferType::Compute)
+		return Image::Usage::ComputeQ;
+	return Image::Usage::None;
+}
+static Buffer::Usage toBufferQ(CommandBufferType commandBufferType) noexcept
+{
+	if (commandBufferType == CommandBufferType::TransferOnly)
+		return Buffer::Usage::TransferQ;
+	if (commandBufferType == CommandBufferType::Compute)
+		return Buffer::Usage::ComputeQ;
+	return Buffer::Usage::None;
+}
+
+//**********************************************************************************************************************
+RenderGraph::RenderGraph()
+{
+	hashState = Hash128::createState();
+}
+RenderGraph::~RenderGraph()
+{
+	destroyTransients();
+	Hash128::destroyState(hashState);
+}
+
+void RenderGraph::destroyTransients()
+{
+	if (transientImages.empty() && aliasMemories.empty())
+		return;
+
+	auto graphicsAPI = GraphicsAPI::get();
+	for (auto image : transientImages)
+	{
+		if (!image)
+			continue;
+		graphicsAPI->imagePool.get(image)->freeAllViews();
+		graphicsAPI->imagePool.destroy(image);
+	}
+	for (auto aliasMemory : aliasMemories)
+		ImageExt::destroyAliasMemory(aliasMemory);
+
+	transientImages.clear();
+	aliasMemories.clear();
+	transientMemorySize = aliasedMemorySize = 0;
+}
+
+//**********************************************************************************************************************
+uint32 RenderGraph::importImage(ID<Image> image)
+{
+	GARDEN_ASSERT(image);
+	ResourceData resource;
+	resource.image = image;
+	resources.push_back(std::move(resource));
+	return (uint32)(resources.size() - 1);
+}
+uint32 RenderGraph::importBuffer(ID<Buffer> buffer)
+{
+	GARDEN_ASSERT(buffer);
+	ResourceData resource;
+	resource.buffer = buffer;
+	resources.push_back(std::move(resource));
+	return (uint32)(resources.size() - 1);
+}
+uint32 RenderGraph::createImage(const ImageDesc& desc, string_view debugName)
+{
+	GARDEN_ASSERT(desc.format != Image::Format::Undefined);
+	GARDEN_ASSERT(areAllTrue(desc.size > u32x4::zero));
+	ResourceData resource;
+	resource.desc = desc;
+	resource.isTransient = true;
+	#if GARDEN_DEBUG || GARDEN_EDITOR
+	resource.debugName = debugName;
+	#endif
+	resources.push_back(std::move(resource));
+	return (uint32)(resources.size() - 1);
+}
+
+//**********************************************************************************************************************
+uint32 RenderGraph::addPass(const string& name, OnExecute&& onExecute)
+{
+	GARDEN_ASSERT(!name.empty());
+	GARDEN_ASSERT(onExecute);
+	PassData pass;
+	pass.name = name;
+	pass.onExecute = std::move(onExecute);
+	passes.push_back(std::move(pass));
+	return (uint32)(passes.size() - 1);
+}
+void RenderGraph::read(uint32 pass, uint32 resource, Access access, PipelineStage stages)
+{
+	GARDEN_ASSERT(pass < passes.size());
+	GARDEN_ASSERT(resource < resources.size());
+	GARDEN_ASSERT_MSG(access != Access::ColorAttachment, "Color attachment can only be written");
+	AccessData accessData;
+	accessData.pass = pass;
+	accessData.resource = resource;
+	accessData.stages = stages;
+	accessData.access = access;
+	accessData.isWrite = false;
+	accesses.push_back(accessData);
+}
+void RenderGraph::write(uint32 pass, uint32 resource, Access access, PipelineStage stages)
+{
+	GARDEN_ASSERT(pass < passes.size());
+	GARDEN_ASSERT(resource < resources.size());
+	GARDEN_ASSERT_MSG(access == Access::ColorAttachment || access == Access::DepthStencilAttachment ||
+		access == Access::Storage || access == Access::Transfer, "Access type can only be read");
+	AccessData accessData;
+	accessData.pass = pass;
+	accessData.resource = resource;
+	accessData.stages = stages;
+	accessData.access = access;
+	accessData.isWrite = true;
+	accesses.push_back(accessData);
+}
+void RenderGraph::keepPass(uint32 pass)
+{
+	GARDEN_ASSERT(pass < passes.size());
+	passes[pass].isKept = true;
+}
+
+void RenderGraph::clear() noexcept
+{
+	resources.clear();
+	passes.clear();
+	accesses.clear();
+}
+
+//**********************************************************************************************************************
+Hash128 RenderGraph::calcTopologyHash(CommandBufferType commandBufferType)
+{
+	auto graphicsAPI = GraphicsAPI::get();
+	Hash128::resetState(hashState);
+	Hash128::updateState(hashState, &commandBufferType, sizeof(CommandBufferType));
+
+	for (const auto& resource : resources)
+	{
+		Hash128::updateState(hashState, &resource.isTransient, sizeof(bool));
+		if (resource.isTransient)
+		{
+			const auto& desc = resource.desc;
+			uint32 size[4] = { desc.size.getX(), desc.size.getY(), desc.size.getZ(), desc.size.getW() };
+			Hash128::updateState(hashState, size, sizeof(uint32) * 4);
+			Hash128::updateState(hashState, &desc.type, sizeof(Image::Type));
+			Hash128::updateState(hashState, &desc.format, sizeof(Image::Format));
+			Hash128::updateState(hashState, &desc.usage, sizeof(Image::Usage));
+		}
+		else if (resource.image)
+		{
+			// Note: Imported image format selects depth/stencil barrier layouts.
+			auto format = graphicsAPI->imagePool.get(resource.image)->getFormat();
+			Hash128::updateState(hashState, &format, sizeof(Image::Format));
+		}
+	}
+	for (const auto& pass : passes)
+		Hash128::updateState(hashState, &pass.isKept, sizeof(bool));
+
+	Hash128::updateState(hashState, accesses.data(), accesses.size() * sizeof(AccessData));
+	return Hash128::digestState(hashState);
+}
+
+//**********************************************************************************************************************
+void RenderGraph::compile()
+{
+	SET_CPU_ZONE_SCOPED("Render Graph Compile");
+
+	auto graphicsAPI = GraphicsAPI::get();
+	GARDEN_ASSERT_MSG(graphicsAPI->currentCommandBuffer, "Not recording");
+	auto commandBufferType = graphicsAPI->currentCommandBuffer->getType();
+	auto topologyHash = calcTopologyHash(commandBufferType);
+	if (topologyHash == this->topologyHash)
+		return;
+	this->topologyHash = topologyHash;
+
+	destroyTransients();
+	planPasses.clear(); planBarriers.clear(); barrierResources.clear();
+
+	auto passCount = (uint32)passes.size(), resourceCount = (uint32)resources.size();
+	auto graphicsBackend = graphicsAPI->getBackendType();
+	auto queueUsage = toImageQ(commandBufferType);
+
+	// Note: Grouping accesses by pass, keeping declaration order inside each pass.
+	vector<AccessData> passAccesses(accesses);
+	std::stable_sort(passAccesses.begin(), passAccesses.end(), [](const AccessData& a, const AccessData& b)
+	{
+		return a.pass < b.pass;
+	});
+	vector<uint32> accessOffsets(passCount + 1, 0);
+	for (const auto& access : passAccesses)
+		accessOffsets[access.pass + 1]++;
+	for (uint32 i = 0; i < passCount; i++)
+		accessOffsets[i + 1] += accessOffsets[i];
+
+	// Note: Passes are declared in the execution order, so readers are always visited before their writers.
+	vector<bool> neededResources(resourceCount, false);
+	culledPasses.assign(passCount, true);
+
+	for (int64 i = (int64)passCount - 1; i >= 0; i--)
+	{
+		auto isAlive = passes[i].isKept;
+		for (uint32 j = accessOffsets[i], end = accessOffsets[i + 1]; j < end; j++)
+		{
+			const auto& access = passAccesses[j];
+			if (access.isWrite && (!resources[access.resource].isTransient || neededResources[access.resource]))
+				isAlive = true;
+		}
+		if (!isAlive)
+			continue;
+
+		culledPasses[i] = false;
+		for (uint32 j = accessOffsets[i], end = accessOffsets[i + 1]; j < end; j++)
+		{
+			const auto& access = passAccesses[j];
+			if (!access.isWrite)
+				neededResources[access.resource] = true;
+		}
+	}
+
+	// Note: Transient image lifetime is an inclusive range of the executed pass indices.
+	vector<uint2> lifetimes(resourceCount, uint2(UINT32_MAX, 0));
+	vector<Image::Usage> usages(resourceCount, Image::Usage::None);
+	for (uint32 i = 0; i < passCount; i++)
+	{
+		if (culledPasses[i])
+			continue;
+
+		auto planIndex = (uint32)planPasses.size();
+		for (uint32 j = accessOffsets[i], end = accessOffsets[i + 1]; j < end; j++)
+		{
+			const auto& access = passAccesses[j];
+			const auto& resource = resources[access.resource];
+
+			if (resource.isTransient)
+			{
+				auto& lifetime = lifetimes[access.resource];
+				lifetime.x = std::min(lifetime.x, planIndex);
+				lifetime.y = std::max(lifetime.y, planIndex);
+				usages[access.resource] |= toImageUsage(access.access, access.isWrite);
+			}
+			#if GARDEN_DEBUG
+			else if (resource.image && queueUsage != Image::Usage::None)
+			{
+				auto imageView = graphicsAPI->imagePool.get(resource.image);
+				GARDEN_ASSERT_MSG(hasAnyFlag(imageView->getUsage(), queueUsage),
+					"Image [" + imageView->getDebugName() + "] does not have current queue flag");
+			}
+			else if (resource.buffer && queueUsage != Image::Usage::None)
+			{
+				auto bufferView = graphicsAPI->bufferPool.get(resource.buffer);
+				GARDEN_ASSERT_MSG(hasAnyFlag(bufferView->getUsage(), toBufferQ(commandBufferType)),
+					"Buffer [" + bufferView->getDebugName() + "] does not have current queue flag");
+			}
+			#endif
+		}
+
+		PlanPass planPass;
+		planPass.pass = i;
+		planPasses.push_back(planPass);
+	}
+
+	//******************************************************************************************************************
+	// Note: Placing bigger images first, then each image goes to the first group without lifetime overlaps.
+	vector<uint32> transientOrder; vector<uint64> binarySizes(resourceCount, 0);
+	vector<uint32> memoryTypes(resourceCount, 0), resourceGroups(resourceCount, 0);
+	vector<uint64> alignments(resourceCount, 0);
+	vector<AliasGroup> aliasGroups;
+
+	for (uint32 i = 0; i < resourceCount; i++)
+	{
+		const auto& resource = resources[i];
+		if (!resource.isTransient || lifetimes[i].x == UINT32_MAX)
+			continue;
+
+		const auto& desc = resource.desc;
+		usages[i] |= desc.usage | queueUsage;
+		ImageExt::getMemoryRequirements(desc.type, desc.format,
+			usages[i], desc.size, binarySizes[i], alignments[i], memoryTypes[i]);
+		transientMemorySize += binarySizes[i];
+		transientOrder.push_back(i);
+	}
+	std::stable_sort(transientOrder.begin(), transientOrder.end(), [&](uint32 a, uint32 b)
+	{
+		return binarySizes[a] > binarySizes[b];
+	});
+
+	for (auto resource : transientOrder)
+	{
+		auto lifetime = lifetimes[resource];
+		auto groupIndex = (uint32)aliasGroups.size();
+
+		for (uint32 i = 0; i < (uint32)aliasGroups.size(); i++)
+		{
+			const auto& aliasGroup = aliasGroups[i];
+			if ((aliasGroup.memoryTypes & memoryTypes[resource]) == 0)
+				continue;
+
+			auto isOverlapping = false;
+			for (auto groupLifetime : aliasGroup.lifetimes)
+			{
+				if (lifetime.x <= groupLifetime.y && groupLifetime.x <= lifetime.y)
+				{
+					isOverlapping = true;
+					break;
+				}
+			}
+			if (isOverlapping)
+				continue;
+
+			groupIndex = i;
+			break;
+		}
+
+		if (groupIndex == aliasGroups.size())
+			aliasGroups.emplace_back();
+
+		auto& aliasGroup = aliasGroups[groupIndex];
+		aliasGroup.lifetimes.push_back(lifetime);
+		aliasGroup.binarySize = std::max(aliasGroup.binarySize, binarySizes[resource]);
+		aliasGroup.alignment = std::max(aliasGroup.alignment, alignments[resource]);
+		aliasGroup.memoryTypes &= memoryTypes[resource];
+		resourceGroups[resource] = groupIndex;
+	}
+
+	aliasMemories.resize(aliasGroups.size());
+	for (uint32 i = 0; i < (uint32)aliasGroups.size(); i++)
+	{
+		const auto& aliasGroup = aliasGroups[i];
+		aliasMemories[i] = ImageExt::allocateAliasMemory(
+			aliasGroup.binarySize, aliasGroup.alignment, aliasGroup.memoryTypes);
+		aliasedMemorySize += aliasGroup.binarySize;
+	}
+
+	transientImages.assign(resourceCount, {});
+	for (auto resource : transientOrder)
+	{
+		const auto& desc = resources[resource].desc;
+		auto image = graphicsAPI->imagePool.create(desc.type, desc.format, usages[resource],
+			Image::Strategy::Default, desc.size, 0, aliasMemories[resourceGroups[resource]]);
+		transientImages[resource] = image;
+
+		#if GARDEN_DEBUG || GARDEN_EDITOR
+		auto imageView = graphicsAPI->imagePool.get(image);
+		imageView->setDebugName("image.graph." + resources[resource].debugName);
+		#endif
+	}
+
+	//******************************************************************************************************************
+	vector<SyncState> syncStates(resourceCount);
+	vector<Memory::BarrierState> groupStates(aliasGroups.size());
+	vector<uint32> groupFirstBarriers(aliasGroups.size(), UINT32_MAX);
+
+	for (auto& planPass : planPasses)
+	{
+		planPass.barrierOffset = (uint32)planBarriers.size();
+		auto passAccessOffset = accessOffsets[planPass.pass], passAccessEnd = accessOffsets[planPass.pass + 1];
+
+		for (uint32 i = passAccessOffset; i < passAccessEnd; i++)
+		{
+			auto resource = passAccesses[i].resource;
+			const auto& resourceData = resources[resource];
+
+			auto isFirstAccess = true;
+			for (uint32 j = passAccessOffset; j < i; j++)
+			{
+				if (passAccesses[j].resource == resource)
+				{
+					isFirstAccess = false;
+					break;
+				}
+			}
+			if (!isFirstAccess)
+				continue;
+
+			// Note: Merging all pass accesses to the same resource into one barrier.
+			auto format = resourceData.isTransient ? resourceData.desc.format : resourceData.image ?
+				graphicsAPI->imagePool.get(resourceData.image)->getFormat() : Image::Format::Undefined;
+			auto isWrite = false;
+			for (uint32 j = i; j < passAccessEnd; j++)
+				isWrite |= passAccesses[j].resource == resource && passAccesses[j].isWrite;
+
+			Image::LayoutState newState;
+			for (uint32 j = i; j < passAccessEnd; j++)
+			{
+				const auto& access = passAccesses[j];
+				if (access.resource != resource)
+					continue;
+
+				auto state = toLayoutState(access.access, access.stages, format, isWrite, graphicsBackend);
+				if (resourceData.buffer)
+					state.layout = 0;
+				GARDEN_ASSERT_MSG(j == i || state.layout == newState.layout, "Render pass [" +
+					passes[planPass.pass].name + "] uses different resource layouts at the same time");
+				newState.stage |= state.stage; newState.access |= state.access;
+				newState.layout = state.layout;
+			}
+
+			ResourceBarrier barrier;
+			barrier.newState = newState;
+			barrier.type = resourceData.buffer ? ResourceType::Buffer : ResourceType::Image;
+			auto& syncState = syncStates[resource];
+			auto needBarrier = true;
+
+			if (!syncState.hasState)
+			{
+				if (resourceData.isTransient)
+				{
+					// Note: Previous content is discarded, but previous alias memory accesses should be finished.
+					const auto& groupState = groupStates[resourceGroups[resource]];
+					barrier.oldState.stage = groupState.stage;
+					barrier.oldState.access = groupState.access;
+					barrier.oldState.layout = 0;
+				}
+				else barrier.isTracked = true;
+				syncState.layout = newState.layout;
+			}
+			else if (isWrite || newState.layout != syncState.layout)
+			{
+				barrier.oldState.stage = syncState.writeStage | syncState.readStage;
+				barrier.oldState.access = syncState.writeAccess | syncState.readAccess;
+				barrier.oldState.layout = syncState.layout;
+				syncState.readStage = syncState.readAccess = 0;
+				syncState.layout = newState.layout;
+			}
+			else if ((newState.stage & ~syncState.readStage) || (newState.access & ~syncState.readAccess))
+			{
+				if (syncState.writeStage == 0 && !resourceData.isTransient)
+					barrier.isTracked = true; // Note: Last write happened outside of the graph.
+				else
+				{
+					barrier.oldState.stage = syncState.writeStage | syncState.readStage;
+					barrier.oldState.access = syncState.writeAccess;
+					barrier.oldState.layout = syncState.layout;
+				}
+			}
+			else needBarrier = false;
+
+			if (isWrite)
+			{
+				syncState.writeStage = newState.stage; syncState.writeAccess = newState.access;
+				syncState.readStage = syncState.readAccess = 0;
+			}
+			else
+			{
+				syncState.readStage |= newState.stage;
+				syncState.readAccess |= newState.access;
+			}
+			syncState.hasState = true;
+
+			if (resourceData.isTransient)
+			{
+				auto& groupState = groupStates[resourceGroups[resource]];
+				groupState.stage = syncState.writeStage | syncState.readStage;
+				groupState.access = syncState.writeAccess | syncState.readAccess;
+			}
+
+			if (needBarrier)
+			{
+				if (resourceData.isTransient && groupFirstBarriers[resourceGroups[resource]] == UINT32_MAX)
+					groupFirstBarriers[resourceGroups[resource]] = (uint32)planBarriers.size();
+				planBarriers.push_back(barrier);
+				barrierResources.push_back(resource);
+			}
+		}
+		planPass.barrierCount = (uint32)planBarriers.size() - planPass.barrierOffset;
+	}
+
+	// Note: Alias memory first occupant waits for the last occupant accesses of the previous frame. (WAR, WAW)
+	for (uint32 i = 0; i < (uint32)aliasGroups.size(); i++)
+	{
+		auto barrierIndex = groupFirstBarriers[i];
+		if (barrierIndex == UINT32_MAX)
+			continue;
+		auto& oldState = planBarriers[barrierIndex].oldState;
+		oldState.stage = groupStates[i].stage;
+		oldState.access = groupStates[i].access;
+	}
+
+	version++;
+}
+
+//**********************************************************************************************************************
+void RenderGraph::execute()
+{
+	SET_CPU_ZONE_SCOPED("Render Graph Execute");
+
+	compile();
+
+	auto currentCommandBuffer = GraphicsAPI::get()->currentCommandBuffer;
+	for (const auto& planPass : planPasses)
+	{
+		const auto& pass = passes[planPass.pass];
+		SET_GPU_DEBUG_LABEL(pass.name);
+
+		// Note: Barrier command is recorded even without barriers, it marks the pass start.
+		PipelineBarrierCommand command;
+		if (planPass.barrierCount > 0)
+		{
+			// Note: Imported resources can change between frames without changing the topology.
+			barrierBuffer.resize(planPass.barrierCount);
+			for (uint32 i = 0; i < planPass.barrierCount; i++)
+			{
+				auto barrierIndex = planPass.barrierOffset + i;
+				auto resource = barrierResources[barrierIndex];
+				auto& barrier = barrierBuffer[i];
+				barrier = planBarriers[barrierIndex];
+
+				if (barrier.type == ResourceType::Image)
+				{
+					auto image = getImage(resource);
+					barrier.resource = ID<Resource>(image);
+					currentCommandBuffer->addLockedResource(image);
+				}
+				else
+				{
+					auto buffer = getBuffer(resource);
+					barrier.resource = ID<Resource>(buffer);
+					currentCommandBuffer->addLockedResource(buffer);
+				}
+			}
+
+			command.barrierCount = planPass.barrierCount;
+			command.barriers = barrierBuffer.data();
+		}
+
+		currentCommandBuffer->addCommand(command);
+		pass.onExecute();
+	}
+
+	if (!planPasses.empty()) // Note: Releasing last pass resources, following commands are tracked again.
+		currentCommandBuffer->addCommand(PipelineBarrierCommand());
+}
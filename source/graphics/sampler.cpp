@@ -14,6 +14,7 @@
 
 #include "garden/graphics/sampler.hpp"
 #include "garden/graphics/vulkan/api.hpp"
+#include "garden/graphics/null/api.hpp"
 
 using namespace math;
 using namespace garden;
@@ -36,6 +37,8 @@ Sampler::Sampler(const State& state) : state(state)
 		auto samplerInfo = getVkSamplerCreateInfo(state);
 		this->instance = VulkanAPI::get()->device.createSampler(samplerInfo);
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		this->instance = NullAPI::createInstance();
 	else abort();
 }
 
@@ -47,7 +50,7 @@ bool Sampler::destroy()
 	auto graphicsBackend = GraphicsAPI::get()->getBackendType();
 	if (graphicsBackend == GraphicsBackend::VulkanAPI)
 		destroyVkSampler(instance);
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 
 	return true;
 }
@@ -70,6 +73,6 @@ void Sampler::setDebugName(const string& name)
 		vulkanAPI->device.setDebugUtilsObjectNameEXT(nameInfo);
 		#endif
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 }
 #endif
\ No newline at end of file
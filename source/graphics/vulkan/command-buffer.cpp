@@ -176,10 +176,13 @@ void VulkanCommandBuffer::addBufferBarrier(VulkanAPI* vulkanAPI,
 	Buffer::BarrierState& newBufferState, ID<Buffer> buffer, uint64 size, uint64 offset)
 {
 	// TODO: we can specify only required buffer range, not full range.
-	auto& oldBufferState = vulkanAPI->getBufferState(buffer);
+	auto bufferView = vulkanAPI->bufferPool.get(buffer);
+	if (MemoryExt::isGraphOwned(**bufferView))
+		return; // Note: Already synchronized by the render graph pass barrier.
+
+	auto& oldBufferState = BufferExt::getBarrierState(**bufferView);
 	if (isDifferentState(oldBufferState, newBufferState))
 	{
-		auto bufferView = vulkanAPI->bufferPool.get(buffer);
 		::addBufferBarrier(vulkanAPI, oldBufferState, newBufferState, 
 			(VkBuffer)ResourceExt::getInstance(**bufferView), size, offset);
 	}
@@ -216,6 +219,9 @@ void VulkanCommandBuffer::addImageBarrier(VulkanAPI* vulkanAPI,
 {
 	auto view = vulkanAPI->imageViewPool.get(imageView);
 	auto image = vulkanAPI->imagePool.get(view->getImage());
+	if (MemoryExt::isGraphOwned(**image))
+		return; // Note: Already synchronized by the render graph pass barrier.
+
 	auto& oldImageState = vulkanAPI->getImageState(view->getImage(), view->getBaseLayer(), view->getBaseMip());
 
 	if (VulkanCommandBuffer::isDifferentState(oldImageState, newImageState))
@@ -235,6 +241,9 @@ static void addImageBarriers(VulkanAPI* vulkanAPI, Image::LayoutState& newImageS
 	ID<Image> image, uint8 baseMip, uint8 mipCount, uint32 baseLayer, uint32 layerCount)
 {
 	auto imageView = vulkanAPI->imagePool.get(image);
+	if (MemoryExt::isGraphOwned(**imageView))
+		return; // Note: Already synchronized by the render graph pass barrier.
+
 	auto vkImage = (VkImage)ResourceExt::getInstance(**imageView);
 	auto aspectFlags = (vk::ImageAspectFlags)ImageExt::getAspectFlags(**imageView);
 
@@ -431,6 +440,7 @@ void VulkanCommandBuffer::submit()
 	#endif
 
 	processCommands();
+	releaseGraphResources();
 
 	if (type == CommandBufferType::Frame)
 	{
@@ -642,7 +652,7 @@ void VulkanCommandBuffer::addRenderPassBarriersAsync(uint32 thisSize)
 static constexpr bool isMajorCommand(Command::Type commandType) noexcept
 {
 	return commandType == Command::Type::Dispatch | commandType == Command::Type::TraceRays |
-		commandType == Command::Type::EndRenderPass;
+		commandType == Command::Type::EndRenderPass | commandType == Command::Type::PipelineBarrier;
 }
 
 void VulkanCommandBuffer::processCommand(const BufferBarrierCommand& command)
@@ -657,6 +667,78 @@ void VulkanCommandBuffer::processCommand(const BufferBarrierCommand& command)
 		addBufferBarrier(vulkanAPI, newState, buffers[i]);
 }
 
+//**********************************************************************************************************************
+void VulkanCommandBuffer::releaseGraphResources()
+{
+	for (auto image : graphImages)
+		MemoryExt::isGraphOwned(**vulkanAPI->imagePool.get(image)) = false;
+	for (auto buffer : graphBuffers)
+		MemoryExt::isGraphOwned(**vulkanAPI->bufferPool.get(buffer)) = false;
+	graphImages.clear(); graphBuffers.clear();
+}
+
+void VulkanCommandBuffer::processCommand(const PipelineBarrierCommand& command)
+{
+	SET_CPU_ZONE_SCOPED("PipelineBarrier Command Process");
+
+	auto commandBufferData = (const uint8*)&command;
+	auto barrierCount = command.barrierCount;
+	auto barriers = (const ResourceBarrier*)(commandBufferData + sizeof(PipelineBarrierCommandBase));
+	releaseGraphResources(); // Note: Previous render graph pass has ended.
+
+	// Note: Tracked states keep the write access, so that following not graph commands wait for it.
+	//       Pass commands do not add the same barriers again, because declared resources are graph owned.
+	for (uint32 i = 0; i < barrierCount; i++)
+	{
+		auto barrier = barriers[i];
+		if (barrier.type == ResourceType::Image)
+		{
+			auto image = ID<Image>(barrier.resource);
+			auto imageView = vulkanAPI->imagePool.get(image);
+			auto mipCount = imageView->getMipCount(); auto layerCount = imageView->getLayerCount();
+
+			if (barrier.isTracked)
+				addImageBarriers(vulkanAPI, barrier.newState, image, 0, mipCount, 0, layerCount);
+			else
+			{
+				::addImageBarrier(vulkanAPI, barrier.oldState, barrier.newState, 
+					(VkImage)ResourceExt::getInstance(**imageView), 0, mipCount, 0, layerCount,
+					(vk::ImageAspectFlags)ImageExt::getAspectFlags(**imageView));
+
+				for (auto& barrierState : ImageExt::getBarrierStates(**imageView))
+				{
+					auto view = barrierState.view;
+					barrierState = barrier.newState;
+					barrierState.view = view;
+				}
+				ImageExt::isFullBarrier(**imageView) = true;
+			}
+
+			MemoryExt::isGraphOwned(**imageView) = true;
+			graphImages.push_back(image);
+		}
+		else if (barrier.type == ResourceType::Buffer)
+		{
+			auto buffer = ID<Buffer>(barrier.resource);
+			auto bufferView = vulkanAPI->bufferPool.get(buffer);
+
+			if (barrier.isTracked)
+				addBufferBarrier(vulkanAPI, barrier.newState, buffer);
+			else
+			{
+				::addBufferBarrier(vulkanAPI, barrier.oldState, barrier.newState, 
+					(VkBuffer)ResourceExt::getInstance(**bufferView), VK_WHOLE_SIZE, 0);
+				BufferExt::getBarrierState(**bufferView) = barrier.newState;
+			}
+
+			MemoryExt::isGraphOwned(**bufferView) = true;
+			graphBuffers.push_back(buffer);
+		}
+		else abort();
+	}
+	processPipelineBarriers();
+}
+
 //**********************************************************************************************************************
 void VulkanCommandBuffer::processCommand(const BeginRenderPassCommand& command)
 {
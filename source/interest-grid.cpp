@@ -0,0 +1,120 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "garden/interest-grid.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace garden;
+
+static uint64 toCellKey(int32 x, int32 z) noexcept
+{
+	return ((uint64)(uint32)x << 32u) | (uint64)(uint32)z;
+}
+
+static float calcDistanceSq(float3 a, float3 b) noexcept
+{
+	auto x = a.x - b.x, y = a.y - b.y, z = a.z - b.z;
+	return x * x + y * y + z * z;
+}
+
+//**********************************************************************************************************************
+void InterestGrid::build()
+{
+	auto itemCount = (uint32)items.size();
+	keys.resize(itemCount);
+	cells.clear();
+
+	for (uint32 i = 0; i < itemCount; i++)
+	{
+		const auto& position = items[i].position;
+		keys[i] = std::make_pair(toCellKey((int32)std::floor(position.x * invCellSize),
+			(int32)std::floor(position.z * invCellSize)), i);
+	}
+	std::sort(keys.begin(), keys.end());
+
+	sortedItems.resize(itemCount);
+	for (uint32 i = 0; i < itemCount; i++)
+	{
+		const auto& key = keys[i];
+		sortedItems[i] = items[key.second];
+
+		if (i == 0 || keys[i - 1].first != key.first)
+		{
+			Cell cell; cell.offset = i; cell.count = 1;
+			cells.emplace(key.first, cell);
+		}
+		else cells.find(key.first).value().count++;
+	}
+	items.clear();
+}
+void InterestGrid::clear() noexcept
+{
+	items.clear();
+	keys.clear();
+	sortedItems.clear();
+	cells.clear();
+}
+
+//**********************************************************************************************************************
+void InterestGrid::query(float3 center, float radius, std::vector<Item>& result) const
+{
+	GARDEN_ASSERT(radius >= 0.0f);
+	if (cells.empty())
+		return;
+
+	auto minX = (int32)std::floor((center.x - radius) * invCellSize);
+	auto maxX = (int32)std::floor((center.x + radius) * invCellSize);
+	auto minZ = (int32)std::floor((center.z - radius) * invCellSize);
+	auto maxZ = (int32)std::floor((center.z + radius) * invCellSize);
+	auto radiusSq = radius * radius;
+	auto items = sortedItems.data();
+
+	// Note: Iterating over the filled cells when the query covers more cells than there are.
+	if ((uint64)(maxX - minX + 1) * (uint64)(maxZ - minZ + 1) > cells.size())
+	{
+		for (const auto& pair : cells)
+		{
+			auto x = (int32)(uint32)(pair.first >> 32u), z = (int32)(uint32)pair.first;
+			if (x < minX || x > maxX || z < minZ || z > maxZ)
+				continue;
+
+			auto cellItems = items + pair.second.offset;
+			for (uint32 i = 0; i < pair.second.count; i++)
+			{
+				if (calcDistanceSq(cellItems[i].position, center) <= radiusSq)
+					result.push_back(cellItems[i]);
+			}
+		}
+		return;
+	}
+
+	for (auto z = minZ; z <= maxZ; z++)
+	{
+		for (auto x = minX; x <= maxX; x++)
+		{
+			auto searchResult = cells.find(toCellKey(x, z));
+			if (searchResult == cells.end())
+				continue;
+
+			auto cellItems = items + searchResult->second.offset;
+			for (uint32 i = 0; i < searchResult->second.count; i++)
+			{
+				if (calcDistanceSq(cellItems[i].position, center) <= radiusSq)
+					result.push_back(cellItems[i]);
+			}
+		}
+	}
+}
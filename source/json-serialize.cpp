@@ -15,6 +15,7 @@
 #include "garden/json-serialize.hpp"
 #include "garden/utf.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
@@ -322,347 +323,918 @@ string JsonSerializer::toString() const
 	return stringStream.str();
 }
 
+//**********************************************************************************************************************
+static bool isJsonSpace(char c) noexcept { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+static void skipJsonSpace(const char*& iter, const char* end) noexcept
+{
+	while (iter < end && isJsonSpace(*iter))
+		iter++;
+}
+
+static void encodeUtf8(uint32 codepoint, char*& output) noexcept
+{
+	if (codepoint < 0x80)
+	{
+		*output++ = (char)codepoint;
+	}
+	else if (codepoint < 0x800)
+	{
+		*output++ = (char)(0xC0 | (codepoint >> 6));
+		*output++ = (char)(0x80 | (codepoint & 0x3F));
+	}
+	else if (codepoint < 0x10000)
+	{
+		*output++ = (char)(0xE0 | (codepoint >> 12));
+		*output++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+		*output++ = (char)(0x80 | (codepoint & 0x3F));
+	}
+	else
+	{
+		*output++ = (char)(0xF0 | (codepoint >> 18));
+		*output++ = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+		*output++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+		*output++ = (char)(0x80 | (codepoint & 0x3F));
+	}
+}
+static bool readHex4(const char* iter, const char* end, uint32& value) noexcept
+{
+	if (end - iter < 4)
+		return false;
+
+	value = 0;
+	for (uint8 i = 0; i < 4; i++)
+	{
+		auto c = iter[i]; value <<= 4;
+		if (c >= '0' && c <= '9') value |= (uint32)(c - '0');
+		else if (c >= 'a' && c <= 'f') value |= (uint32)(c - 'a' + 10);
+		else if (c >= 'A' && c <= 'F') value |= (uint32)(c - 'A' + 10);
+		else return false;
+	}
+	return true;
+}
+
+//**********************************************************************************************************************
+static void parseJsonString(char* data, const char*& iter, const char* end, uint32& offset, uint32& length)
+{
+	GARDEN_ASSERT(*iter == '"');
+	auto begin = ++iter;
+	while (iter < end && *iter != '"' && *iter != '\\')
+	{
+		if ((uint8)*iter < 0x20)
+			throw GardenError("Invalid control character in JSON string.");
+		iter++;
+	}
+
+	if (iter < end && *iter == '"')
+	{
+		offset = (uint32)(begin - data); length = (uint32)(iter - begin);
+		iter++;
+		return;
+	}
+
+	// Note: Decoded string is never longer than the escaped one, so we can decode it in place.
+	auto output = data + (iter - data);
+	while (true)
+	{
+		if (iter >= end)
+			throw GardenError("Unterminated JSON string.");
+
+		auto c = *iter;
+		if (c == '"')
+			break;
+		if ((uint8)c < 0x20)
+			throw GardenError("Invalid control character in JSON string.");
+
+		if (c != '\\')
+		{
+			*output++ = c; iter++;
+			continue;
+		}
+
+		if (++iter >= end)
+			throw GardenError("Unterminated JSON string escape.");
+
+		switch (*iter++)
+		{
+		case '"': *output++ = '"'; break;
+		case '\\': *output++ = '\\'; break;
+		case '/': *output++ = '/'; break;
+		case 'b': *output++ = '\b'; break;
+		case 'f': *output++ = '\f'; break;
+		case 'n': *output++ = '\n'; break;
+		case 'r': *output++ = '\r'; break;
+		case 't': *output++ = '\t'; break;
+		case 'u':
+		{
+			uint32 codepoint;
+			if (!readHex4(iter, end, codepoint))
+				throw GardenError("Invalid JSON string unicode escape.");
+			iter += 4;
+
+			if (codepoint >= 0xD800 && codepoint <= 0xDBFF)
+			{
+				uint32 lowSurrogate;
+				if (end - iter < 6 || iter[0] != '\\' || iter[1] != 'u' || 
+					!readHex4(iter + 2, end, lowSurrogate) || lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+				{
+					throw GardenError("Invalid JSON string surrogate pair.");
+				}
+				codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+				iter += 6;
+			}
+			else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF)
+			{
+				throw GardenError("Invalid JSON string surrogate pair.");
+			}
+			encodeUtf8(codepoint, output);
+			break;
+		}
+		default: throw GardenError("Invalid JSON string escape.");
+		}
+	}
+
+	offset = (uint32)(begin - data); length = (uint32)(output - begin);
+	iter++;
+}
+
+//**********************************************************************************************************************
+static bool parseJsonNumber(const char*& iter, const char* end, int64& intValue, uint64& uintValue, double& floatValue)
+{
+	auto begin = iter; auto isNegative = false, isFloat = false;
+	if (*iter == '-')
+	{
+		isNegative = true;
+		iter++;
+	}
+
+	auto digits = iter; uint64 value = 0; auto isOverflow = false;
+	while (iter < end && *iter >= '0' && *iter <= '9')
+	{
+		auto digit = (uint64)(*iter - '0');
+		if (value > (UINT64_MAX - digit) / 10)
+			isOverflow = true;
+		value = value * 10 + digit;
+		iter++;
+	}
+	if (iter == digits || (*digits == '0' && iter - digits > 1))
+		throw GardenError("Invalid JSON number.");
+
+	if (iter < end && *iter == '.')
+	{
+		isFloat = true; digits = ++iter;
+		while (iter < end && *iter >= '0' && *iter <= '9')
+			iter++;
+		if (iter == digits)
+			throw GardenError("Invalid JSON number fraction.");
+	}
+	if (iter < end && (*iter == 'e' || *iter == 'E'))
+	{
+		isFloat = true; iter++;
+		if (iter < end && (*iter == '+' || *iter == '-'))
+			iter++;
+		digits = iter;
+		while (iter < end && *iter >= '0' && *iter <= '9')
+			iter++;
+		if (iter == digits)
+			throw GardenError("Invalid JSON number exponent.");
+	}
+
+	if (!isFloat && !isOverflow)
+	{
+		if (!isNegative)
+		{
+			uintValue = value;
+			return false;
+		}
+		if (value <= (uint64)INT64_MAX + 1)
+		{
+			intValue = (int64)(0 - value);
+			return false;
+		}
+	}
+
+	// Note: Source buffer is null terminated and number is validated, so strtod stops at the number end.
+	floatValue = std::strtod(begin, nullptr);
+	return true;
+}
+
 //**********************************************************************************************************************
 JsonDeserializer::JsonDeserializer()
 {
-	hierarchy.emplace(&data);
+	reset();
+}
+
+void JsonDeserializer::reset()
+{
+	hierarchy.clear();
+	if (nodes.empty())
+		nodes.emplace_back();
+	Level level; level.node = 0;
+	hierarchy.push_back(level);
+}
+
+void JsonDeserializer::parseText()
+{
+	auto data = source.data();
+	const char* iter = data; auto end = data + (source.size() - 1); // Note: Excluding null terminator.
+	uint32 nameOffset = 0, nameLength = 0;
+	nodes.clear(); parseStack.clear();
+
+	while (true)
+	{
+		skipJsonSpace(iter, end);
+		if (!parseStack.empty() && nodes[parseStack.back()].type == NodeType::Object)
+		{
+			if (iter >= end || *iter != '"')
+				throw GardenError("Expected JSON object key.");
+			parseJsonString(data, iter, end, nameOffset, nameLength);
+			skipJsonSpace(iter, end);
+			if (iter >= end || *iter != ':')
+				throw GardenError("Expected ':' after JSON object key.");
+			iter++;
+			skipJsonSpace(iter, end);
+		}
+		else
+		{
+			nameOffset = nameLength = 0;
+		}
+
+		if (iter >= end)
+			throw GardenError("Unexpected end of JSON data.");
+
+		if (!parseStack.empty())
+			nodes[parseStack.back()].length++;
+
+		Node node;
+		node.nameOffset = nameOffset;
+		node.nameLength = nameLength;
+		node.next = (uint32)nodes.size() + 1;
+
+		auto c = *iter;
+		if (c == '{' || c == '[')
+		{
+			node.type = c == '{' ? NodeType::Object : NodeType::Array;
+			parseStack.push_back((uint32)nodes.size());
+			nodes.push_back(node);
+			iter++;
+
+			skipJsonSpace(iter, end);
+			if (iter >= end || *iter != (c == '{' ? '}' : ']'))
+				continue;
+
+			iter++;
+			nodes[parseStack.back()].next = (uint32)nodes.size();
+			parseStack.pop_back();
+		}
+		else
+		{
+			if (c == '"')
+			{
+				uint32 offset, length;
+				parseJsonString(data, iter, end, offset, length);
+				node.type = NodeType::String;
+				node.uintValue = offset;
+				node.length = length;
+			}
+			else if (c == '-' || (c >= '0' && c <= '9'))
+			{
+				int64 intValue = 0; uint64 uintValue = 0; double floatValue = 0.0;
+				if (parseJsonNumber(iter, end, intValue, uintValue, floatValue))
+				{
+					node.type = NodeType::Float;
+					node.floatValue = floatValue;
+				}
+				else if (c == '-')
+				{
+					node.type = NodeType::Integer;
+					node.intValue = intValue;
+				}
+				else
+				{
+					node.type = NodeType::Unsigned;
+					node.uintValue = uintValue;
+				}
+			}
+			else if (end - iter >= 4 && memcmp(iter, "true", 4) == 0)
+			{
+				node.type = NodeType::Boolean; node.uintValue = 1; iter += 4;
+			}
+			else if (end - iter >= 5 && memcmp(iter, "false", 5) == 0)
+			{
+				node.type = NodeType::Boolean; node.uintValue = 0; iter += 5;
+			}
+			else if (end - iter >= 4 && memcmp(iter, "null", 4) == 0)
+			{
+				node.type = NodeType::Null; iter += 4;
+			}
+			else
+			{
+				throw GardenError("Unexpected JSON value character.");
+			}
+			nodes.push_back(node);
+		}
+
+		while (true)
+		{
+			skipJsonSpace(iter, end);
+			if (parseStack.empty())
+			{
+				if (iter != end)
+					throw GardenError("Unexpected data after JSON root value.");
+				return;
+			}
+
+			if (iter >= end)
+				throw GardenError("Unexpected end of JSON data.");
+			if (*iter == ',')
+			{
+				iter++;
+				break;
+			}
+
+			auto& container = nodes[parseStack.back()];
+			if (*iter != (container.type == NodeType::Object ? '}' : ']'))
+				throw GardenError("Expected ',' or closing bracket in JSON data.");
+
+			iter++;
+			container.next = (uint32)nodes.size();
+			parseStack.pop_back();
+		}
+	}
+}
+
+//**********************************************************************************************************************
+template<typename T>
+static T readBsonValue(const char* data, uint32 offset, uint32 size)
+{
+	if (offset + sizeof(T) > size)
+		throw GardenError("Unexpected end of BSON data.");
+	T value; memcpy(&value, data + offset, sizeof(T));
+	#if !GARDEN_LITTLE_ENDIAN
+	auto bytes = (uint8*)&value;
+	std::reverse(bytes, bytes + sizeof(T));
+	#endif
+	return value;
+}
+
+void JsonDeserializer::parseBson(uint32 offset, uint32 size, NodeType type, uint32 nameOffset, uint32 nameLength)
+{
+	auto data = source.data();
+	auto documentSize = readBsonValue<int32>(data, offset, size);
+	if (documentSize < 5 || (uint64)offset + documentSize > size || data[offset + documentSize - 1] != 0)
+		throw GardenError("Invalid BSON document size.");
+	auto documentEnd = offset + (uint32)documentSize - 1;
+
+	auto documentIndex = (uint32)nodes.size();
+	Node document;
+	document.type = type;
+	document.nameOffset = nameOffset;
+	document.nameLength = nameLength;
+	nodes.push_back(document);
+
+	auto iter = offset + (uint32)sizeof(int32);
+	while (iter < documentEnd)
+	{
+		auto elementType = (uint8)data[iter++];
+		auto keyOffset = iter;
+		while (iter < documentEnd && data[iter] != 0)
+			iter++;
+		if (iter >= documentEnd)
+			throw GardenError("Invalid BSON element key.");
+		auto keyLength = iter - keyOffset;
+		iter++;
+
+		nodes[documentIndex].length++;
+		if (type == NodeType::Array)
+			keyOffset = keyLength = 0;
+
+		if (elementType == 0x03 || elementType == 0x04)
+		{
+			auto childSize = readBsonValue<int32>(data, iter, documentEnd);
+			parseBson(iter, documentEnd, elementType == 0x03 ? NodeType::Object : 
+				NodeType::Array, keyOffset, keyLength);
+			iter += (uint32)childSize;
+			continue;
+		}
+
+		Node node;
+		node.nameOffset = keyOffset;
+		node.nameLength = keyLength;
+		node.next = (uint32)nodes.size() + 1;
+
+		switch (elementType)
+		{
+		case 0x01:
+			node.type = NodeType::Float;
+			node.floatValue = readBsonValue<double>(data, iter, documentEnd);
+			iter += sizeof(double);
+			break;
+		case 0x02:
+		{
+			auto stringSize = readBsonValue<int32>(data, iter, documentEnd);
+			iter += sizeof(int32);
+			if (stringSize < 1 || (uint64)iter + stringSize > documentEnd || data[iter + stringSize - 1] != 0)
+				throw GardenError("Invalid BSON string size.");
+			node.type = NodeType::String;
+			node.uintValue = iter;
+			node.length = (uint32)stringSize - 1;
+			iter += (uint32)stringSize;
+			break;
+		}
+		case 0x05:
+		{
+			// Note: Binary data is not supported by the deserializer interface, skipping it.
+			auto binarySize = readBsonValue<int32>(data, iter, documentEnd);
+			if (binarySize < 0 || (uint64)iter + sizeof(int32) + 1 + binarySize > documentEnd)
+				throw GardenError("Invalid BSON binary size.");
+			iter += sizeof(int32) + 1 + (uint32)binarySize;
+			break;
+		}
+		case 0x08:
+			node.type = NodeType::Boolean;
+			node.uintValue = readBsonValue<uint8>(data, iter, documentEnd) != 0;
+			iter += sizeof(uint8);
+			break;
+		case 0x0A: break;
+		case 0x10:
+			node.type = NodeType::Integer;
+			node.intValue = readBsonValue<int32>(data, iter, documentEnd);
+			iter += sizeof(int32);
+			break;
+		case 0x11:
+			node.type = NodeType::Unsigned;
+			node.uintValue = readBsonValue<uint64>(data, iter, documentEnd);
+			iter += sizeof(uint64);
+			break;
+		case 0x12:
+			node.type = NodeType::Integer;
+			node.intValue = readBsonValue<int64>(data, iter, documentEnd);
+			iter += sizeof(int64);
+			break;
+		default: throw GardenError("Unsupported BSON element type.");
+		}
+		nodes.push_back(node);
+	}
+
+	nodes[documentIndex].next = (uint32)nodes.size();
 }
 
+//**********************************************************************************************************************
 void JsonDeserializer::load(string_view json)
 {
 	GARDEN_ASSERT(!json.empty());
-	data = json::parse(json);
-	hierarchy = {};
-	hierarchy.emplace(&data);
+	if (json.size() >= UINT32_MAX)
+		throw GardenError("JSON data is too big.");
+	source.resize(json.size() + 1);
+	memcpy(source.data(), json.data(), json.size());
+	source[json.size()] = 0;
+	parseText();
+	reset();
 }
 void JsonDeserializer::load(const vector<uint8>& bson)
 {
 	GARDEN_ASSERT(!bson.empty());
-	data = json::from_bson(bson);
-	hierarchy = {};
-	hierarchy.emplace(&data);
+	load(bson.data(), bson.size());
+}
+void JsonDeserializer::load(const uint8* bson, psize size)
+{
+	GARDEN_ASSERT(bson);
+	GARDEN_ASSERT(size > 0);
+	if (size >= UINT32_MAX)
+		throw GardenError("BSON data is too big.");
+	source.resize(size);
+	memcpy(source.data(), bson, size);
+	nodes.clear();
+	parseBson(0, (uint32)size, NodeType::Object, 0, 0);
+	reset();
 }
 void JsonDeserializer::load(const fs::path& filePath)
 {
 	GARDEN_ASSERT(!filePath.empty());
-	std::ifstream fileStream(filePath);
-	fileStream >> data;
-	hierarchy = {};
-	hierarchy.emplace(&data);
+	std::ifstream fileStream(filePath, std::ios::in | std::ios::binary | std::ios::ate);
+	if (!fileStream.is_open())
+		throw GardenError("Failed to open JSON file. (path: " + filePath.generic_string() + ")");
+
+	auto fileSize = (psize)fileStream.tellg();
+	if (fileSize >= UINT32_MAX)
+		throw GardenError("JSON file is too big. (path: " + filePath.generic_string() + ")");
+	fileStream.seekg(0, std::ios::beg);
+
+	source.resize(fileSize + 1);
+	if (!fileStream.read(source.data(), fileSize))
+		throw GardenError("Failed to read JSON file. (path: " + filePath.generic_string() + ")");
+	source[fileSize] = 0;
+	parseText();
+	reset();
 }
 
-bool JsonDeserializer::beginChild(string_view name)
+//**********************************************************************************************************************
+template<typename T>
+static void writeBsonValue(vector<uint8>& bson, T value)
 {
-	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_structured())
-		return false;
-	hierarchy.emplace(&object);
-	return true;
+	#if !GARDEN_LITTLE_ENDIAN
+	auto bytes = (uint8*)&value;
+	std::reverse(bytes, bytes + sizeof(T));
+	#endif
+	auto offset = bson.size();
+	bson.resize(offset + sizeof(T));
+	memcpy(bson.data() + offset, &value, sizeof(T));
 }
-void JsonDeserializer::endChild()
+
+void JsonDeserializer::writeBson(uint32 nodeIndex, vector<uint8>& bson, string_view skipName) const
 {
-	GARDEN_ASSERT_MSG(hierarchy.size() > 1, "No child to end");
-	hierarchy.pop();
+	const auto& document = nodes[nodeIndex];
+	auto documentOffset = bson.size();
+	writeBsonValue(bson, (int32)0);
+
+	auto child = nodeIndex + 1; string indexString;
+	for (uint32 i = 0; i < document.length; i++, child = nodes[child].next)
+	{
+		const auto& node = nodes[child];
+		if (document.type == NodeType::Object && !skipName.empty() && getName(node) == skipName)
+			continue;
+		auto typeOffset = bson.size();
+		bson.push_back(0);
+
+		string_view key;
+		if (document.type == NodeType::Array)
+		{
+			indexString = to_string(i);
+			key = indexString;
+		}
+		else key = getName(node);
+
+		bson.insert(bson.end(), key.begin(), key.end());
+		bson.push_back(0);
+
+		uint8 elementType;
+		switch (node.type)
+		{
+		case NodeType::Null: elementType = 0x0A; break;
+		case NodeType::Boolean: elementType = 0x08; bson.push_back(node.uintValue ? 1 : 0); break;
+		case NodeType::Float: elementType = 0x01; writeBsonValue(bson, node.floatValue); break;
+		case NodeType::Integer:
+			if (node.intValue >= INT32_MIN && node.intValue <= INT32_MAX)
+			{
+				elementType = 0x10; writeBsonValue(bson, (int32)node.intValue);
+			}
+			else
+			{
+				elementType = 0x12; writeBsonValue(bson, node.intValue);
+			}
+			break;
+		case NodeType::Unsigned:
+			if (node.uintValue <= (uint64)INT32_MAX)
+			{
+				elementType = 0x10; writeBsonValue(bson, (int32)node.uintValue);
+			}
+			else if (node.uintValue <= (uint64)INT64_MAX)
+			{
+				elementType = 0x12; writeBsonValue(bson, (int64)node.uintValue);
+			}
+			else
+			{
+				elementType = 0x11; writeBsonValue(bson, node.uintValue);
+			}
+			break;
+		case NodeType::String:
+		{
+			elementType = 0x02;
+			auto value = getString(node);
+			writeBsonValue(bson, (int32)(value.size() + 1));
+			bson.insert(bson.end(), value.begin(), value.end());
+			bson.push_back(0);
+			break;
+		}
+		case NodeType::Array: elementType = 0x04; writeBson(child, bson, skipName); break;
+		case NodeType::Object: elementType = 0x03; writeBson(child, bson, skipName); break;
+		default: abort();
+		}
+		bson[typeOffset] = elementType;
+	}
+
+	bson.push_back(0);
+	auto documentSize = (int32)(bson.size() - documentOffset);
+	#if !GARDEN_LITTLE_ENDIAN
+	auto bytes = (uint8*)&documentSize;
+	std::reverse(bytes, bytes + sizeof(int32));
+	#endif
+	memcpy(bson.data() + documentOffset, &documentSize, sizeof(int32));
+}
+void JsonDeserializer::toBson(vector<uint8>& bson, string_view skipName) const
+{
+	auto nodeIndex = hierarchy.back().node;
+	if (nodes[nodeIndex].type != NodeType::Object)
+		throw GardenError("Only JSON object can be serialized to BSON.");
+	bson.clear();
+	writeBson(nodeIndex, bson, skipName);
 }
 
 //**********************************************************************************************************************
-psize JsonDeserializer::getArraySize()
+const JsonDeserializer::Node* JsonDeserializer::findChild(uint32 nodeIndex, string_view name) const noexcept
 {
-	return hierarchy.top()->size();
+	const auto& node = nodes[nodeIndex];
+	if (node.type != NodeType::Object)
+		return nullptr;
+
+	auto child = nodeIndex + 1;
+	for (uint32 i = 0; i < node.length; i++, child = nodes[child].next)
+	{
+		if (getName(nodes[child]) == name)
+			return &nodes[child];
+	}
+	return nullptr;
 }
-bool JsonDeserializer::beginArrayElement(psize index)
+const JsonDeserializer::Node* JsonDeserializer::findMember(string_view name) noexcept
 {
-	auto& object = *hierarchy.top();
-	if (!object.is_array())
-		return false;
-	hierarchy.emplace(&object.at(index));
-	return true;
+	auto& level = hierarchy.back();
+	const auto& node = nodes[level.node];
+	if (node.type != NodeType::Object || node.length == 0)
+		return nullptr;
+
+	// Note: Continuing search from the last accessed member, members are usually read in the stored order.
+	auto child = level.lastChild, index = level.lastIndex;
+	if (child == 0)
+	{
+		child = level.node + 1;
+		index = 0;
+	}
+
+	for (uint32 i = 0; i < node.length; i++)
+	{
+		if (getName(nodes[child]) == name)
+		{
+			level.lastChild = child;
+			level.lastIndex = index;
+			return &nodes[child];
+		}
+
+		if (++index == node.length)
+		{
+			child = level.node + 1;
+			index = 0;
+		}
+		else child = nodes[child].next;
+	}
+	return nullptr;
 }
 
-bool JsonDeserializer::read(int64& value)
+bool JsonDeserializer::beginChild(string_view name)
 {
-	auto& object = *hierarchy.top();
-	if (!object.is_number_integer())
+	GARDEN_ASSERT(!name.empty());
+	auto member = findMember(name);
+	if (!member || (member->type != NodeType::Object && member->type != NodeType::Array))
 		return false;
-	value = (int64)object;
+
+	Level level; level.node = (uint32)(member - nodes.data());
+	hierarchy.push_back(level);
 	return true;
 }
-bool JsonDeserializer::read(uint64& value)
+void JsonDeserializer::endChild()
 {
-	auto& object = *hierarchy.top();
-	if (!object.is_number_integer())
-		return false;
-	value = (uint64)object;
-	return true;
+	GARDEN_ASSERT_MSG(hierarchy.size() > 1, "No child to end");
+	hierarchy.pop_back();
 }
-bool JsonDeserializer::read(int32& value)
+
+//**********************************************************************************************************************
+psize JsonDeserializer::getArraySize()
 {
-	auto& object = *hierarchy.top();
-	if (!object.is_number_integer())
-		return false;
-	value = (int32)object;
-	return true;
+	const auto& node = nodes[hierarchy.back().node];
+	if (node.type == NodeType::Array || node.type == NodeType::Object)
+		return node.length;
+	return node.type == NodeType::Null ? 0 : 1;
 }
-bool JsonDeserializer::read(uint32& value)
+bool JsonDeserializer::beginArrayElement(psize index)
 {
-	auto& object = *hierarchy.top();
-	if (!object.is_number_integer())
+	auto& level = hierarchy.back();
+	const auto& node = nodes[level.node];
+	if (node.type != NodeType::Array || index >= node.length)
 		return false;
-	value = (uint32)object;
+
+	// Note: Arrays are usually iterated sequentially, so we step forward from the last accessed element.
+	auto child = level.lastChild, childIndex = level.lastIndex;
+	if (child == 0 || index < childIndex)
+	{
+		child = level.node + 1;
+		childIndex = 0;
+	}
+	while (childIndex < index)
+	{
+		child = nodes[child].next;
+		childIndex++;
+	}
+
+	level.lastChild = child;
+	level.lastIndex = childIndex;
+
+	Level element; element.node = child;
+	hierarchy.push_back(element);
 	return true;
 }
-bool JsonDeserializer::read(int16& value)
+
+//**********************************************************************************************************************
+template<typename T>
+static bool getJsonInteger(const JsonDeserializer::Node* node, T& value) noexcept
 {
-	auto& object = *hierarchy.top();
-	if (!object.is_number_integer())
+	if (!node)
 		return false;
-	value = (int16)object;
+	if (node->type == JsonDeserializer::NodeType::Integer)
+		value = (T)node->intValue;
+	else if (node->type == JsonDeserializer::NodeType::Unsigned)
+		value = (T)node->uintValue;
+	else return false;
 	return true;
 }
-bool JsonDeserializer::read(uint16& value)
+template<typename T>
+static bool getJsonUnsigned(const JsonDeserializer::Node* node, T& value) noexcept
 {
-	auto& object = *hierarchy.top();
-	if (!object.is_number_integer())
+	if (!node || node->type != JsonDeserializer::NodeType::Unsigned)
 		return false;
-	value = (uint16)object;
+	value = (T)node->uintValue;
 	return true;
 }
-bool JsonDeserializer::read(int8& value)
+template<typename T>
+static bool getJsonFloat(const JsonDeserializer::Node* node, T& value) noexcept
 {
-	auto& object = *hierarchy.top();
-	if (!object.is_number_integer())
+	if (!node || node->type != JsonDeserializer::NodeType::Float)
 		return false;
-	value = (int8)object;
+	value = (T)node->floatValue;
 	return true;
 }
-bool JsonDeserializer::read(uint8& value)
+static bool getJsonBool(const JsonDeserializer::Node* node, bool& value) noexcept
 {
-	auto& object = *hierarchy.top();
-	if (!object.is_number_integer())
+	if (!node || node->type != JsonDeserializer::NodeType::Boolean)
 		return false;
-	value = (uint8)object;
+	value = node->uintValue != 0;
 	return true;
 }
 
 //**********************************************************************************************************************
-bool JsonDeserializer::read(bool& value)
-{
-	auto& object = *hierarchy.top();
-	if (!object.is_boolean())
-		return false;
-	value = (bool)object;
-	return true;
-}
-bool JsonDeserializer::read(float& value)
-{
-	auto& object = *hierarchy.top();
-	if (!object.is_number_float())
-		return false;
-	value = (float)object;
-	return true;
-}
-bool JsonDeserializer::read(double& value)
-{
-	auto& object = *hierarchy.top();
-	if (!object.is_number_float())
-		return false;
-	value = (double)object;
-	return true;
-}
+bool JsonDeserializer::read(int64& value) { return getJsonInteger(&nodes[hierarchy.back().node], value); }
+bool JsonDeserializer::read(uint64& value) { return getJsonInteger(&nodes[hierarchy.back().node], value); }
+bool JsonDeserializer::read(int32& value) { return getJsonInteger(&nodes[hierarchy.back().node], value); }
+bool JsonDeserializer::read(uint32& value) { return getJsonInteger(&nodes[hierarchy.back().node], value); }
+bool JsonDeserializer::read(int16& value) { return getJsonInteger(&nodes[hierarchy.back().node], value); }
+bool JsonDeserializer::read(uint16& value) { return getJsonInteger(&nodes[hierarchy.back().node], value); }
+bool JsonDeserializer::read(int8& value) { return getJsonInteger(&nodes[hierarchy.back().node], value); }
+bool JsonDeserializer::read(uint8& value) { return getJsonInteger(&nodes[hierarchy.back().node], value); }
+bool JsonDeserializer::read(bool& value) { return getJsonBool(&nodes[hierarchy.back().node], value); }
+bool JsonDeserializer::read(float& value) { return getJsonFloat(&nodes[hierarchy.back().node], value); }
+bool JsonDeserializer::read(double& value) { return getJsonFloat(&nodes[hierarchy.back().node], value); }
+
 bool JsonDeserializer::read(string& value)
 {
-	auto& object = *hierarchy.top();
-	if (!object.is_string())
+	const auto& node = nodes[hierarchy.back().node];
+	if (node.type != NodeType::String)
 		return false;
-	value = (string)object;
+	value.assign(getString(node));
 	return true;
 }
 
 void JsonDeserializer::endArrayElement()
 {
 	GARDEN_ASSERT_MSG(hierarchy.size() > 1, "No array element to end");
-	hierarchy.pop();
+	hierarchy.pop_back();
 }
 
 //**********************************************************************************************************************
 bool JsonDeserializer::read(string_view name, int64& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_number_integer())
-		return false;
-	value = (int64)object;
-	return true;
+	return getJsonInteger(findMember(name), value);
 }
 bool JsonDeserializer::read(string_view name, uint64& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_number_integer())
-		return false;
-	value = (uint64)object;
-	return true;
+	return getJsonInteger(findMember(name), value);
 }
 bool JsonDeserializer::read(string_view name, int32& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_number_integer())
-		return false;
-	value = (int32)object;
-	return true;
+	return getJsonInteger(findMember(name), value);
 }
 bool JsonDeserializer::read(string_view name, uint32& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_number_integer())
-		return false;
-	value = (uint32)object;
-	return true;
+	return getJsonInteger(findMember(name), value);
 }
 bool JsonDeserializer::read(string_view name, int16& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_number_integer())
-		return false;
-	value = (int16)object;
-	return true;
+	return getJsonInteger(findMember(name), value);
 }
 bool JsonDeserializer::read(string_view name, uint16& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_number_integer())
-		return false;
-	value = (uint16)object;
-	return true;
+	return getJsonInteger(findMember(name), value);
 }
 bool JsonDeserializer::read(string_view name, int8& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_number_integer())
-		return false;
-	value = (int8)object;
-	return true;
+	return getJsonInteger(findMember(name), value);
 }
 bool JsonDeserializer::read(string_view name, uint8& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_number_integer())
-		return false;
-	value = (uint8)object;
-	return true;
+	return getJsonInteger(findMember(name), value);
 }
 
 //**********************************************************************************************************************
 bool JsonDeserializer::read(string_view name, bool& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_boolean())
-		return false;
-	value = (bool)object;
-	return true;
+	return getJsonBool(findMember(name), value);
 }
 bool JsonDeserializer::read(string_view name, volatile bool& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_boolean())
+	bool boolValue;
+	if (!getJsonBool(findMember(name), boolValue))
 		return false;
-	value = (bool)object;
+	value = boolValue;
 	return true;
 }
 bool JsonDeserializer::read(string_view name, float& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_number_float())
-		return false;
-	value = (float)object;
-	return true;
+	return getJsonFloat(findMember(name), value);
 }
 bool JsonDeserializer::read(string_view name, double& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_number_float())
-		return false;
-	value = (double)object;
-	return true;
+	return getJsonFloat(findMember(name), value);
 }
 bool JsonDeserializer::read(string_view name, string& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_string())
+	auto member = findMember(name);
+	if (!member || member->type != NodeType::String)
 		return false;
-	value.assign((const string&)object);
+	value.assign(getString(*member));
 	return true;
 }
 bool JsonDeserializer::read(string_view name, u32string& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_string())
+	auto member = findMember(name);
+	if (!member || member->type != NodeType::String)
 		return false;
-	return UTF::convert((const string&)object, value) == 0;
+	return UTF::convert(getString(*member), value) == 0;
 }
 
 //**********************************************************************************************************************
 bool JsonDeserializer::read(string_view name, int2& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (object.is_number_integer())
+	auto member = findMember(name);
+	if (getJsonInteger(member, value.x))
 	{
-		value = int2((int32)object);
+		value = int2(value.x);
 		return true;
 	}
-	
-	if (!object.is_object())
+	if (!member || member->type != NodeType::Object)
 		return false;
-	auto result = true;
-	auto i = &object["x"]; if (i->is_number_integer()) value.x = (int32)*i; else result = false;
-	i = &object["y"]; if (i->is_number_integer()) value.y = (int32)*i; else result = false;
+
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonInteger(findChild(index, "x"), value.x)) result = false;
+	if (!getJsonInteger(findChild(index, "y"), value.y)) result = false;
 	return result;
 }
 bool JsonDeserializer::read(string_view name, int3& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (object.is_number_integer())
+	auto member = findMember(name);
+	if (getJsonInteger(member, value.x))
 	{
-		value = int3((int32)object);
+		value = int3(value.x);
 		return true;
 	}
+	if (!member || member->type != NodeType::Object)
+		return false;
 
-	auto result = true;
-	auto i = &object["x"]; if (i->is_number_integer()) value.x = (int32)*i; else result = false;
-	i = &object["y"]; if (i->is_number_integer()) value.y = (int32)*i; else result = false;
-	i = &object["z"]; if (i->is_number_integer()) value.z = (int32)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonInteger(findChild(index, "x"), value.x)) result = false;
+	if (!getJsonInteger(findChild(index, "y"), value.y)) result = false;
+	if (!getJsonInteger(findChild(index, "z"), value.z)) result = false;
 	return result;
 }
 bool JsonDeserializer::read(string_view name, int4& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (object.is_number_integer())
+	auto member = findMember(name);
+	if (getJsonInteger(member, value.x))
 	{
-		value = int4((int32)object);
+		value = int4(value.x);
 		return true;
 	}
+	if (!member || member->type != NodeType::Object)
+		return false;
 
-	auto result = true;
-	auto i = &object["x"]; if (i->is_number_integer()) value.x = (int32)*i; else result = false;
-	i = &object["y"]; if (i->is_number_integer()) value.y = (int32)*i; else result = false;
-	i = &object["z"]; if (i->is_number_integer()) value.z = (int32)*i; else result = false;
-	i = &object["w"]; if (i->is_number_integer()) value.w = (int32)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonInteger(findChild(index, "x"), value.x)) result = false;
+	if (!getJsonInteger(findChild(index, "y"), value.y)) result = false;
+	if (!getJsonInteger(findChild(index, "z"), value.z)) result = false;
+	if (!getJsonInteger(findChild(index, "w"), value.w)) result = false;
 	return result;
 }
 
@@ -670,49 +1242,55 @@ bool JsonDeserializer::read(string_view name, int4& value)
 bool JsonDeserializer::read(string_view name, uint2& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (object.is_number_unsigned())
+	auto member = findMember(name);
+	if (getJsonUnsigned(member, value.x))
 	{
-		value = uint2((uint32)object);
+		value = uint2(value.x);
 		return true;
 	}
+	if (!member || member->type != NodeType::Object)
+		return false;
 
-	auto result = true;
-	auto i = &object["x"]; if (i->is_number_unsigned()) value.x = (uint32)*i; else result = false;
-	i = &object["y"]; if (i->is_number_unsigned()) value.y = (uint32)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonUnsigned(findChild(index, "x"), value.x)) result = false;
+	if (!getJsonUnsigned(findChild(index, "y"), value.y)) result = false;
 	return result;
 }
 bool JsonDeserializer::read(string_view name, uint3& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (object.is_number_unsigned())
+	auto member = findMember(name);
+	if (getJsonUnsigned(member, value.x))
 	{
-		value = uint3((uint32)object);
+		value = uint3(value.x);
 		return true;
 	}
+	if (!member || member->type != NodeType::Object)
+		return false;
 
-	auto result = true;
-	auto i = &object["x"]; if (i->is_number_unsigned()) value.x = (uint32)*i; else result = false;
-	i = &object["y"]; if (i->is_number_unsigned()) value.y = (uint32)*i; else result = false;
-	i = &object["z"]; if (i->is_number_unsigned()) value.z = (uint32)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonUnsigned(findChild(index, "x"), value.x)) result = false;
+	if (!getJsonUnsigned(findChild(index, "y"), value.y)) result = false;
+	if (!getJsonUnsigned(findChild(index, "z"), value.z)) result = false;
 	return result;
 }
 bool JsonDeserializer::read(string_view name, uint4& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (object.is_number_unsigned())
+	auto member = findMember(name);
+	if (getJsonUnsigned(member, value.x))
 	{
-		value = uint4((uint32)object);
+		value = uint4(value.x);
 		return true;
 	}
+	if (!member || member->type != NodeType::Object)
+		return false;
 
-	auto result = true;
-	auto i = &object["x"]; if (i->is_number_unsigned()) value.x = (uint32)*i; else result = false;
-	i = &object["y"]; if (i->is_number_unsigned()) value.y = (uint32)*i; else result = false;
-	i = &object["z"]; if (i->is_number_unsigned()) value.z = (uint32)*i; else result = false;
-	i = &object["w"]; if (i->is_number_unsigned()) value.w = (uint32)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonUnsigned(findChild(index, "x"), value.x)) result = false;
+	if (!getJsonUnsigned(findChild(index, "y"), value.y)) result = false;
+	if (!getJsonUnsigned(findChild(index, "z"), value.z)) result = false;
+	if (!getJsonUnsigned(findChild(index, "w"), value.w)) result = false;
 	return result;
 }
 
@@ -720,63 +1298,69 @@ bool JsonDeserializer::read(string_view name, uint4& value)
 bool JsonDeserializer::read(string_view name, float2& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (object.is_number_float())
+	auto member = findMember(name);
+	if (getJsonFloat(member, value.x))
 	{
-		value = float2((float)object);
+		value = float2(value.x);
 		return true;
 	}
+	if (!member || member->type != NodeType::Object)
+		return false;
 
-	auto result = true;
-	auto i = &object["x"]; if (i->is_number_float()) value.x = (float)*i; else result = false;
-	i = &object["y"]; if (i->is_number_float()) value.y = (float)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonFloat(findChild(index, "x"), value.x)) result = false;
+	if (!getJsonFloat(findChild(index, "y"), value.y)) result = false;
 	return result;
 }
 bool JsonDeserializer::read(string_view name, float3& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (object.is_number_float())
+	auto member = findMember(name);
+	if (getJsonFloat(member, value.x))
 	{
-		value = float3((float)object);
+		value = float3(value.x);
 		return true;
 	}
+	if (!member || member->type != NodeType::Object)
+		return false;
 
-	auto result = true;
-	auto i = &object["x"]; if (i->is_number_float()) value.x = (float)*i; else result = false;
-	i = &object["y"]; if (i->is_number_float()) value.y = (float)*i; else result = false;
-	i = &object["z"]; if (i->is_number_float()) value.z = (float)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonFloat(findChild(index, "x"), value.x)) result = false;
+	if (!getJsonFloat(findChild(index, "y"), value.y)) result = false;
+	if (!getJsonFloat(findChild(index, "z"), value.z)) result = false;
 	return result;
 }
 bool JsonDeserializer::read(string_view name, float4& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (object.is_number_float())
+	auto member = findMember(name);
+	if (getJsonFloat(member, value.x))
 	{
-		value = float4((float)object);
+		value = float4(value.x);
 		return true;
 	}
+	if (!member || member->type != NodeType::Object)
+		return false;
 
-	auto result = true;
-	auto i = &object["x"]; if (i->is_number_float()) value.x = (float)*i; else result = false;
-	i = &object["y"]; if (i->is_number_float()) value.y = (float)*i; else result = false;
-	i = &object["z"]; if (i->is_number_float()) value.z = (float)*i; else result = false;
-	i = &object["w"]; if (i->is_number_float()) value.w = (float)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonFloat(findChild(index, "x"), value.x)) result = false;
+	if (!getJsonFloat(findChild(index, "y"), value.y)) result = false;
+	if (!getJsonFloat(findChild(index, "z"), value.z)) result = false;
+	if (!getJsonFloat(findChild(index, "w"), value.w)) result = false;
 	return result;
 }
 bool JsonDeserializer::read(string_view name, quat& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_object())
+	auto member = findMember(name);
+	if (!member || member->type != NodeType::Object)
 		return false;
 
-	auto result = true;
-	auto i = &object["x"]; if (i->is_number_float()) value.setX((float)*i); else result = false;
-	i = &object["y"]; if (i->is_number_float()) value.setY((float)*i); else result = false;
-	i = &object["z"]; if (i->is_number_float()) value.setZ((float)*i); else result = false;
-	i = &object["w"]; if (i->is_number_float()) value.setW((float)*i); else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true; float component;
+	if (getJsonFloat(findChild(index, "x"), component)) value.setX(component); else result = false;
+	if (getJsonFloat(findChild(index, "y"), component)) value.setY(component); else result = false;
+	if (getJsonFloat(findChild(index, "z"), component)) value.setZ(component); else result = false;
+	if (getJsonFloat(findChild(index, "w"), component)) value.setW(component); else result = false;
 	return result;
 }
 
@@ -784,66 +1368,66 @@ bool JsonDeserializer::read(string_view name, quat& value)
 bool JsonDeserializer::read(string_view name, float2x2& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_object())
+	auto member = findMember(name);
+	if (!member || member->type != NodeType::Object)
 		return false;
 
-	auto result = true;
-	auto i = &object["00"]; if (i->is_number_float()) value.c0.x = (float)*i; else result = false;
-	i = &object["01"]; if (i->is_number_float()) value.c0.y = (float)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonFloat(findChild(index, "00"), value.c0.x)) result = false;
+	if (!getJsonFloat(findChild(index, "01"), value.c0.y)) result = false;
 
-	i = &object["10"]; if (i->is_number_float()) value.c1.x = (float)*i; else result = false;
-	i = &object["11"]; if (i->is_number_float()) value.c1.y = (float)*i; else result = false;
+	if (!getJsonFloat(findChild(index, "10"), value.c1.x)) result = false;
+	if (!getJsonFloat(findChild(index, "11"), value.c1.y)) result = false;
 	return result;
 }
 bool JsonDeserializer::read(string_view name, float3x3& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_object())
+	auto member = findMember(name);
+	if (!member || member->type != NodeType::Object)
 		return false;
 
-	auto result = true;
-	auto i = &object["00"]; if (i->is_number_float()) value.c0.x = (float)*i; else result = false;
-	i = &object["01"]; if (i->is_number_float()) value.c0.y = (float)*i; else result = false;
-	i = &object["02"]; if (i->is_number_float()) value.c0.z = (float)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonFloat(findChild(index, "00"), value.c0.x)) result = false;
+	if (!getJsonFloat(findChild(index, "01"), value.c0.y)) result = false;
+	if (!getJsonFloat(findChild(index, "02"), value.c0.z)) result = false;
 
-	i = &object["10"]; if (i->is_number_float()) value.c1.x = (float)*i; else result = false;
-	i = &object["11"]; if (i->is_number_float()) value.c1.y = (float)*i; else result = false;
-	i = &object["12"]; if (i->is_number_float()) value.c1.z = (float)*i; else result = false;
+	if (!getJsonFloat(findChild(index, "10"), value.c1.x)) result = false;
+	if (!getJsonFloat(findChild(index, "11"), value.c1.y)) result = false;
+	if (!getJsonFloat(findChild(index, "12"), value.c1.z)) result = false;
 
-	i = &object["20"]; if (i->is_number_float()) value.c2.x = (float)*i; else result = false;
-	i = &object["21"]; if (i->is_number_float()) value.c2.y = (float)*i; else result = false;
-	i = &object["22"]; if (i->is_number_float()) value.c2.z = (float)*i; else result = false;
+	if (!getJsonFloat(findChild(index, "20"), value.c2.x)) result = false;
+	if (!getJsonFloat(findChild(index, "21"), value.c2.y)) result = false;
+	if (!getJsonFloat(findChild(index, "22"), value.c2.z)) result = false;
 	return result;
 }
 bool JsonDeserializer::read(string_view name, float4x4& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_object())
+	auto member = findMember(name);
+	if (!member || member->type != NodeType::Object)
 		return false;
 
-	auto result = true;
-	auto i = &object["00"]; if (i->is_number_float()) value.c0.x = (float)*i; else result = false;
-	i = &object["01"]; if (i->is_number_float()) value.c0.y = (float)*i; else result = false;
-	i = &object["02"]; if (i->is_number_float()) value.c0.z = (float)*i; else result = false;
-	i = &object["03"]; if (i->is_number_float()) value.c0.w = (float)*i; else result = false;
-
-	i = &object["10"]; if (i->is_number_float()) value.c1.x = (float)*i; else result = false;
-	i = &object["11"]; if (i->is_number_float()) value.c1.y = (float)*i; else result = false;
-	i = &object["12"]; if (i->is_number_float()) value.c1.z = (float)*i; else result = false;
-	i = &object["13"]; if (i->is_number_float()) value.c1.w = (float)*i; else result = false;
-
-	i = &object["20"]; if (i->is_number_float()) value.c2.x = (float)*i; else result = false;
-	i = &object["21"]; if (i->is_number_float()) value.c2.y = (float)*i; else result = false;
-	i = &object["22"]; if (i->is_number_float()) value.c2.z = (float)*i; else result = false;
-	i = &object["23"]; if (i->is_number_float()) value.c2.w = (float)*i; else result = false;
-
-	i = &object["30"]; if (i->is_number_float()) value.c3.x = (float)*i; else result = false;
-	i = &object["31"]; if (i->is_number_float()) value.c3.y = (float)*i; else result = false;
-	i = &object["32"]; if (i->is_number_float()) value.c3.z = (float)*i; else result = false;
-	i = &object["33"]; if (i->is_number_float()) value.c3.w = (float)*i; else result = false;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
+	if (!getJsonFloat(findChild(index, "00"), value.c0.x)) result = false;
+	if (!getJsonFloat(findChild(index, "01"), value.c0.y)) result = false;
+	if (!getJsonFloat(findChild(index, "02"), value.c0.z)) result = false;
+	if (!getJsonFloat(findChild(index, "03"), value.c0.w)) result = false;
+
+	if (!getJsonFloat(findChild(index, "10"), value.c1.x)) result = false;
+	if (!getJsonFloat(findChild(index, "11"), value.c1.y)) result = false;
+	if (!getJsonFloat(findChild(index, "12"), value.c1.z)) result = false;
+	if (!getJsonFloat(findChild(index, "13"), value.c1.w)) result = false;
+
+	if (!getJsonFloat(findChild(index, "20"), value.c2.x)) result = false;
+	if (!getJsonFloat(findChild(index, "21"), value.c2.y)) result = false;
+	if (!getJsonFloat(findChild(index, "22"), value.c2.z)) result = false;
+	if (!getJsonFloat(findChild(index, "23"), value.c2.w)) result = false;
+
+	if (!getJsonFloat(findChild(index, "30"), value.c3.x)) result = false;
+	if (!getJsonFloat(findChild(index, "31"), value.c3.y)) result = false;
+	if (!getJsonFloat(findChild(index, "32"), value.c3.z)) result = false;
+	if (!getJsonFloat(findChild(index, "33"), value.c3.w)) result = false;
 	return result;
 }
 
@@ -864,10 +1448,10 @@ bool JsonDeserializer::read(string_view name, Aabb& value)
 bool JsonDeserializer::read(string_view name, Color& value)
 {
 	GARDEN_ASSERT(!name.empty());
-	auto& object = hierarchy.top()->operator[](name);
-	if (!object.is_string())
+	auto member = findMember(name);
+	if (!member || member->type != NodeType::String)
 		return false;
-	value = Color((const string&)object);
+	value = Color(string(getString(*member)));
 	return true;
 }
 bool JsonDeserializer::read(string_view name, f32x4& value, uint8 components)
@@ -875,24 +1459,22 @@ bool JsonDeserializer::read(string_view name, f32x4& value, uint8 components)
 	GARDEN_ASSERT(!name.empty());
 	GARDEN_ASSERT(components <= 4);
 
-	auto& object = hierarchy.top()->operator[](name);
-	if (object.is_number_float())
+	auto member = findMember(name); float floatValue;
+	if (getJsonFloat(member, floatValue))
 	{
-		auto floatValue = (float)object;
 		for (uint8 c = 0; c < components; c++)
 			value[c] = floatValue;
 		return true;
 	}
 
-	if (!object.is_object())
+	if (!member || member->type != NodeType::Object)
 		return false;
 
-	auto result = true;
+	auto index = (uint32)(member - nodes.data()); auto result = true;
 	constexpr const char* componentNames[4] = { "x", "y", "z", "w" };
 	for (uint8 c = 0; c < components; c++)
 	{
-		auto i = &object[componentNames[c]]; 
-		if (i->is_number_float()) value[c] = ((float)*i); else result = false;
+		if (getJsonFloat(findChild(index, componentNames[c]), floatValue)) value[c] = floatValue; else result = false;
 	}
 	return result;
-}
\ No newline at end of file
+}
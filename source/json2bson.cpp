@@ -13,12 +13,13 @@
 // limitations under the License.
 
 #include "garden/json2bson.hpp"
+#include "garden/json-serialize.hpp"
+#include "garden/binary-scene.hpp"
 #include "garden/thread-pool.hpp"
 #include "garden/file.hpp"
 
 #include "nlohmann/json.hpp"
 
-#include <stack>
 #include <atomic>
 #include <fstream>
 #include <iostream>
@@ -28,10 +29,30 @@ using json = nlohmann::json;
 
 #if GARDEN_DEBUG || defined(JSON2BSON)
 //**********************************************************************************************************************
-bool Json2Bson::convertFile(const fs::path& filePath, const fs::path& inputPath, const fs::path& outputPath)
+bool Json2Bson::convertFile(const fs::path& filePath, const fs::path& inputPath, 
+	const fs::path& outputPath, bool keepDebugNames)
 {	
 	GARDEN_ASSERT(!filePath.empty());
 
+	if (filePath.extension() == ".scene")
+	{
+		auto inputFilePath = inputPath / filePath;
+		if (!fs::exists(inputFilePath))
+			return false;
+
+		// Note: Scenes are compiled to the memory mappable binary scene format.
+		JsonDeserializer deserializer(inputFilePath);
+		vector<uint8> binaryData;
+		BinaryScene::convert(deserializer, binaryData, keepDebugNames);
+
+		auto outputFilePath = outputPath / filePath;
+		auto outputDirectory = outputFilePath.parent_path();
+		if (!fs::exists(outputDirectory))
+			fs::create_directories(outputDirectory);
+		File::storeBinary(outputFilePath, binaryData);
+		return true;
+	}
+
 	std::ifstream inputStream(inputPath / filePath);
 	if (!inputStream.is_open())
 		return false;
@@ -40,30 +61,6 @@ bool Json2Bson::convertFile(const fs::path& filePath, const fs::path& inputPath,
 	inputStream >> textData;
 	inputStream.close();
 
-	if (filePath.extension() == ".scene")
-	{
-		std::stack<json*> jsonStack;
-		jsonStack.push(&textData);
-
-		while (!jsonStack.empty())
-		{
-			auto& json = *jsonStack.top();
-			jsonStack.pop();
-
-			if (json.is_object())
-			{
-				json.erase("debugName");
-				for (auto& pair : json.items()) 
-					jsonStack.push(&pair.value());
-			}
-			else if (json.is_array())
-			{
-				for (auto& item : json) 
-					jsonStack.push(&item);
-			}
-		}
-	}
-
 	auto binaryData = json::to_bson(textData);
 	textData = {}; // Cleaning up memory.
 
@@ -88,7 +85,7 @@ int main(int argc, char *argv[])
 
 	fs::path workingPath = fs::path(argv[0]).parent_path();
 	auto inputPath = workingPath, outputPath = workingPath;
-	ThreadPool* threadPool = nullptr; atomic_int convertResult = true;
+	ThreadPool* threadPool = nullptr; atomic_int convertResult = true; auto keepDebugNames = false;
 	
 	for (int i = 1; i < argc; i++)
 	{
@@ -104,6 +101,7 @@ int main(int argc, char *argv[])
 				"  -i <dir>      Read input from <dir>.\n"
 				"  -o <dir>      Write output to <dir>.\n"
 				"  -t <value>    Specify thread pool size. (Uses all cores by default)\n"
+				"  -d            Keep scene entity debug names.\n"
 				"  -h            Display available options.\n"
 				"  --help        Display available options.\n"
 				"  --version     Display converter version information." << endl;
@@ -154,6 +152,10 @@ int main(int argc, char *argv[])
 			}
 			i++;
 		}
+		else if (strcmp(arg, "-d") == 0)
+		{
+			keepDebugNames = true;
+		}
 		else if (arg[0] == '-')
 		{
 			cout << string("json2bson: error: unsupported option: '") + arg + "'" << endl;
@@ -173,7 +175,7 @@ int main(int argc, char *argv[])
 
 				try
 				{
-					auto result = Json2Bson::convertFile(arg, inputPath, outputPath);
+					auto result = Json2Bson::convertFile(arg, inputPath, outputPath, keepDebugNames);
 					if (!result)
 						cout << string("json2bson: error: no file found (") + arg + ")\n" << flush;
 					convertResult &= result;
@@ -183,6 +185,11 @@ int main(int argc, char *argv[])
 					cout << string("json2bson: ") + e.what() + " (" + arg + ")\n" << flush;
 					convertResult &= false;
 				}
+				catch (const GardenError& e)
+				{
+					cout << string("json2bson: error: ") + e.what() + " (" + arg + ")\n" << flush;
+					convertResult &= false;
+				}
 			});
 		}
 	}
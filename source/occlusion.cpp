@@ -0,0 +1,235 @@
+// Copyright 2022-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "garden/occlusion.hpp"
+#include "garden/simd.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if GARDEN_SIMD_SSE2
+#include <immintrin.h>
+#endif
+
+using namespace garden;
+
+static constexpr float minClipW = 1.0e-5f;
+static constexpr uint8 boxFaces[6][4] =
+{
+	{ 0, 2, 6, 4 }, { 1, 3, 7, 5 }, // -X, +X
+	{ 0, 1, 5, 4 }, { 2, 6, 7, 3 }, // -Y, +Y
+	{ 0, 1, 3, 2 }, { 4, 5, 7, 6 }, // -Z, +Z
+};
+
+//**********************************************************************************************************************
+void OcclusionBuffer::setSize(uint2 size)
+{
+	GARDEN_ASSERT(size.x > 0 && size.y > 0);
+	this->size = size;
+	depthData.assign((psize)size.x * size.y, 0.0f);
+}
+void OcclusionBuffer::clear(uint32 bandIndex) noexcept
+{
+	GARDEN_ASSERT(bandIndex < getBandCount());
+	auto rowOffset = bandIndex * bandHeight;
+	auto rowCount = std::min(bandHeight, size.y - rowOffset);
+	memset(depthData.data() + (psize)rowOffset * size.x, 0, (psize)rowCount * size.x * sizeof(float));
+}
+
+//**********************************************************************************************************************
+bool OcclusionBuffer::projectBox(const f32x4x4& mvp, const Aabb& aabb, Box& box) const noexcept
+{
+	auto min = aabb.getMin(), max = aabb.getMax();
+	auto halfWidth = size.x * 0.5f, halfHeight = size.y * 0.5f;
+	box.minY = FLT_MAX; box.maxY = -FLT_MAX;
+
+	for (uint8 i = 0; i < 8; i++)
+	{
+		auto corner = f32x4((i & 1) ? max.getX() : min.getX(),
+			(i & 2) ? max.getY() : min.getY(), (i & 4) ? max.getZ() : min.getZ(), 1.0f);
+		auto clip = mvp * corner;
+		if (clip.getW() <= minClipW)
+			return false; // Note: Near plane clipping is not supported, occluder is skipped.
+
+		auto invW = 1.0f / clip.getW();
+		auto& vertex = box.vertices[i];
+		vertex.x = (clip.getX() * invW + 1.0f) * halfWidth;
+		vertex.y = (clip.getY() * invW + 1.0f) * halfHeight;
+		vertex.z = clip.getZ() * invW;
+		box.minY = std::min(box.minY, vertex.y);
+		box.maxY = std::max(box.maxY, vertex.y);
+	}
+	return true;
+}
+
+//**********************************************************************************************************************
+static void fillSpan(float* depths, uint32 x0, uint32 x1, float depth, float depthDX, float minDepth) noexcept
+{
+	auto x = x0;
+
+	#if GARDEN_SIMD_SSE2
+	auto step = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), dx = _mm_set1_ps(depthDX);
+	auto minD = _mm_set1_ps(minDepth), baseD = _mm_set1_ps(depth);
+	for (; x + 4 <= x1; x += 4)
+	{
+		auto offset = _mm_add_ps(_mm_set1_ps((float)x), step);
+		auto d = _mm_max_ps(_mm_add_ps(baseD, _mm_mul_ps(offset, dx)), minD);
+		_mm_storeu_ps(depths + x, _mm_max_ps(_mm_loadu_ps(depths + x), d));
+	}
+	#endif
+
+	for (; x < x1; x++)
+		depths[x] = std::max(depths[x], std::max(depth + x * depthDX, minDepth));
+}
+
+static float calcArea(const float3& v0, const float3& v1, const float3& v2) noexcept
+{
+	return (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+}
+
+/**
+ * @brief Rasterizes projected convex box face.
+ * @details Whole quad is rasterized at once, triangles would leave holes along the shared edge.
+ */
+static void rasterizeFace(float* depthData, uint2 size, const float3* vertices, uint32 rowOffset, uint32 rowEnd) noexcept
+{
+	auto area012 = calcArea(vertices[0], vertices[1], vertices[2]);
+	auto area023 = calcArea(vertices[0], vertices[2], vertices[3]);
+	auto area = area012 + area023;
+	if (std::abs(area) < 1.0e-6f)
+		return;
+
+	// Note: Edge functions are positive inside, offset by half pixel to test the worst pixel corner.
+	auto sign = area < 0.0f ? -1.0f : 1.0f;
+	float edgeA[4], edgeB[4], edgeC[4];
+	auto minY = FLT_MAX, maxY = -FLT_MAX, minDepth = FLT_MAX;
+	for (uint8 i = 0; i < 4; i++)
+	{
+		const auto& a = vertices[i]; const auto& b = vertices[(i + 1) & 3];
+		edgeA[i] = (a.y - b.y) * sign; edgeB[i] = (b.x - a.x) * sign;
+		edgeC[i] = -(edgeA[i] * a.x + edgeB[i] * a.y) - 0.5f * (std::abs(edgeA[i]) + std::abs(edgeB[i]));
+		minY = std::min(minY, a.y); maxY = std::max(maxY, a.y); minDepth = std::min(minDepth, a.z);
+	}
+
+	auto y0 = (uint32)std::max((float)rowOffset, std::ceil(minY - 0.5f));
+	auto y1 = (uint32)std::max((float)y0, std::min((float)rowEnd, std::floor(maxY - 0.5f) + 1.0f));
+	if (y0 >= y1)
+		return;
+
+	// Note: Reverse Z depth is linear in screen space, using the farthest value inside each pixel.
+	const auto& v0 = vertices[0];
+	const auto& v1 = vertices[std::abs(area012) >= std::abs(area023) ? 1 : 2];
+	const auto& v2 = vertices[std::abs(area012) >= std::abs(area023) ? 2 : 3];
+	auto invArea = 1.0f / calcArea(v0, v1, v2);
+	auto depthDX = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) * invArea;
+	auto depthDY = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) * invArea;
+	auto depthOffset = 0.5f * (std::abs(depthDX) + std::abs(depthDY));
+	auto width = (float)size.x;
+
+	for (auto y = y0; y < y1; y++)
+	{
+		auto centerY = y + 0.5f;
+		auto left = 0.0f, right = width;
+		for (uint8 i = 0; i < 4; i++)
+		{
+			auto value = edgeB[i] * centerY + edgeC[i];
+			if (edgeA[i] > 0.0f)
+				left = std::max(left, -value / edgeA[i]);
+			else if (edgeA[i] < 0.0f)
+				right = std::min(right, -value / edgeA[i]);
+			else if (value < 0.0f)
+				right = -1.0f;
+		}
+
+		auto x0 = std::max(0.0f, std::ceil(left - 0.5f));
+		auto x1 = std::min(width, std::floor(right - 0.5f) + 1.0f);
+		if (x0 >= x1)
+			continue;
+
+		// Note: Depth at the pixel center X = 0.5 of this row, minus worst corner offset.
+		auto depth = v0.z + (0.5f - v0.x) * depthDX + (centerY - v0.y) * depthDY - depthOffset;
+		fillSpan(depthData + (psize)y * size.x, (uint32)x0, (uint32)x1, depth, depthDX, minDepth);
+	}
+}
+
+void OcclusionBuffer::rasterizeBox(const Box& box, uint32 bandIndex) noexcept
+{
+	GARDEN_ASSERT(bandIndex < getBandCount());
+	auto rowOffset = bandIndex * bandHeight;
+	auto rowEnd = std::min(rowOffset + bandHeight, size.y);
+	if (box.maxY < (float)rowOffset || box.minY > (float)rowEnd)
+		return;
+
+	for (uint8 i = 0; i < 6; i++)
+	{
+		const auto face = boxFaces[i];
+		float3 vertices[4] =
+		{
+			box.vertices[face[0]], box.vertices[face[1]], box.vertices[face[2]], box.vertices[face[3]]
+		};
+		rasterizeFace(depthData.data(), size, vertices, rowOffset, rowEnd);
+	}
+}
+
+//**********************************************************************************************************************
+bool OcclusionBuffer::isVisible(const f32x4x4& viewProj, f32x4 center, f32x4 extent) const noexcept
+{
+	auto halfWidth = size.x * 0.5f, halfHeight = size.y * 0.5f;
+	auto minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX, maxDepth = 0.0f;
+
+	for (uint8 i = 0; i < 8; i++)
+	{
+		auto corner = center + f32x4((i & 1) ? extent.getX() : -extent.getX(),
+			(i & 2) ? extent.getY() : -extent.getY(), (i & 4) ? extent.getZ() : -extent.getZ(), 0.0f);
+		corner.setW(1.0f);
+		auto clip = viewProj * corner;
+		if (clip.getW() <= minClipW)
+			return true;
+
+		auto invW = 1.0f / clip.getW();
+		auto x = (clip.getX() * invW + 1.0f) * halfWidth, y = (clip.getY() * invW + 1.0f) * halfHeight;
+		minX = std::min(minX, x); maxX = std::max(maxX, x);
+		minY = std::min(minY, y); maxY = std::max(maxY, y);
+		maxDepth = std::max(maxDepth, clip.getZ() * invW); // Note: Nearest box point is one of the corners.
+	}
+
+	// Note: Testing every pixel touched by the box screen rectangle.
+	minX = std::max(0.0f, std::floor(minX)); maxX = std::min((float)size.x, std::ceil(maxX));
+	minY = std::max(0.0f, std::floor(minY)); maxY = std::min((float)size.y, std::ceil(maxY));
+	if (minX >= maxX || minY >= maxY)
+		return true;
+
+	auto x0 = (uint32)minX, x1 = (uint32)maxX, y1 = (uint32)maxY;
+	for (auto y = (uint32)minY; y < y1; y++)
+	{
+		const auto depths = depthData.data() + (psize)y * size.x;
+		auto x = x0;
+
+		#if GARDEN_SIMD_SSE2
+		auto boxDepth = _mm_set1_ps(maxDepth);
+		for (; x + 4 <= x1; x += 4)
+		{
+			if (_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(depths + x), boxDepth)) != 0)
+				return true;
+		}
+		#endif
+
+		for (; x < x1; x++)
+		{
+			if (depths[x] <= maxDepth)
+				return true;
+		}
+	}
+	return false;
+}
@@ -19,21 +19,37 @@
 #include "garden/system/input.hpp"
 #include "garden/profiler.hpp"
 
+#include <algorithm>
+
 using namespace garden;
 
 //**********************************************************************************************************************
-bool AnimationComponent::getActiveLooped(bool& isLooped) const
+bool AnimationComponent::getActiveLooped(bool& isLooped)
 {
-	if (active.empty())
+	auto animation = getActiveAnimation();
+	if (!animation)
 		return false;
 
+	auto animationView = AnimationSystem::Instance::get()->get(animation);
+	isLooped = animationView->isLooped;
+	return true;
+}
+ID<Animation> AnimationComponent::getActiveAnimation()
+{
+	if (!isActiveDirty)
+		return activeAnimation;
+
+	isActiveDirty = false;
+	activeAnimation = {};
+	if (active.empty())
+		return {};
+
 	auto searchResult = animations.find(active);
 	if (searchResult == animations.end())
-		return false;
+		return {};
 
-	auto animation = AnimationSystem::Instance::get()->get(searchResult->second);
-	isLooped = animation->isLooped;
-	return true;
+	activeAnimation = ID<Animation>(searchResult->second);
+	return activeAnimation;
 }
 
 AnimationSystem::AnimationSystem(bool animateAsync, bool setSingleton) : 
@@ -48,100 +64,201 @@ AnimationSystem::AnimationSystem(bool animateAsync, bool setSingleton) :
 }
 
 //**********************************************************************************************************************
+static uint8 findComponentIndex(const Entity::ComponentData* components, uint32 componentCount, const System* system)
+{
+	for (uint32 i = 0; i < componentCount; i++)
+	{
+		if (components[i].system == system)
+			return (uint8)i;
+	}
+	return UINT8_MAX;
+}
+static View<Component> getTrackComponent(const Entity::ComponentData* components, 
+	uint32 componentCount, const System* system, uint8& componentIndex)
+{
+	// Note: Resolved entity component index is revalidated with a single pointer compare.
+	if (componentIndex >= componentCount || components[componentIndex].system != system)
+	{
+		componentIndex = findComponentIndex(components, componentCount, system);
+		if (componentIndex == UINT8_MAX)
+			return {};
+	}
+
+	const auto& component = components[componentIndex];
+	return component.system->getComponent(component.instance);
+}
+
+static thread_local vector<f32x4> trackResults;
+
+static void animateKeyframe(View<Animation> animationView, psize keyframe, 
+	const Entity::ComponentData* components, uint32 componentCount, uint8* trackIndices)
+{
+	const auto& tracks = animationView->getTracks();
+	auto trackFrames = animationView->getTrackFrames().data();
+	auto trackValues = animationView->getTrackValues().data();
+	auto trackMasks = animationView->getTrackMasks().data();
+	auto frameCount = animationView->getFrames().size();
+
+	for (psize i = 0; i < tracks.size(); i++)
+	{
+		const auto& track = tracks[i];
+		auto componentView = getTrackComponent(components, componentCount, track.system, trackIndices[i]);
+		if (!componentView)
+			continue;
+
+		auto trackIndex = i * frameCount + keyframe;
+		if (track.propCount == 0)
+		{
+			auto frameView = track.animatable->getAnimation(trackFrames[trackIndex]);
+			track.animatable->animateAsync(componentView, frameView, frameView, 1.0f);
+			continue;
+		}
+
+		f32x4 values[IAnimatable::maxBakedProps];
+		for (uint8 j = 0; j < track.propCount; j++)
+			values[j] = trackValues[(track.valueOffset + j) * frameCount + keyframe];
+		track.animatable->animateBaked(componentView, values, trackMasks[trackIndex]);
+	}
+}
+
+static float calcTrackT(float t, AnimationFunc funcType, float funcCoeff) noexcept
+{
+	if (funcType == AnimationFunc::Pow)
+		return std::pow(t, funcCoeff);
+	if (funcType == AnimationFunc::Gain)
+		return gain(t, funcCoeff);
+	return t;
+}
+static void animateKeyframes(View<Animation> animationView, psize indexA, psize indexB, float baseT,
+	const Entity::ComponentData* components, uint32 componentCount, uint8* trackIndices)
+{
+	const auto& tracks = animationView->getTracks();
+	auto trackFrames = animationView->getTrackFrames().data();
+	auto trackValues = animationView->getTrackValues().data();
+	auto trackMasks = animationView->getTrackMasks().data();
+	auto trackCoeffs = animationView->getTrackCoeffs().data();
+	auto trackFuncs = animationView->getTrackFuncs().data();
+	auto frameCount = animationView->getFrames().size();
+
+	if (trackResults.size() < animationView->getBakedPropCount())
+		trackResults.resize(animationView->getBakedPropCount());
+	auto results = trackResults.data();
+
+	// Note: Interpolating all baked clip properties in one pass over the SoA arrays, components are written after.
+	for (psize i = 0; i < tracks.size(); i++)
+	{
+		const auto& track = tracks[i];
+		if (track.propCount == 0)
+			continue;
+
+		auto trackIndex = i * frameCount + indexA;
+		auto t = calcTrackT(baseT, trackFuncs[trackIndex], trackCoeffs[trackIndex]);
+
+		for (uint8 j = 0; j < track.propCount; j++)
+		{
+			auto values = trackValues + (track.valueOffset + j) * frameCount;
+			auto a = values[indexA], b = values[indexB];
+
+			f32x4 result;
+			switch (track.interps[j])
+			{
+				case AnimationInterp::Lerp: result = lerp(a, b, t); break;
+				case AnimationInterp::Slerp: result = (f32x4)slerp(quat(a), quat(b), t); break;
+				case AnimationInterp::Step: result = (bool)round(t) ? b : a; break;
+				default: abort();
+			}
+			results[track.valueOffset + j] = result;
+		}
+	}
+
+	for (psize i = 0; i < tracks.size(); i++)
+	{
+		const auto& track = tracks[i];
+		auto componentView = getTrackComponent(components, componentCount, track.system, trackIndices[i]);
+		if (!componentView)
+			continue;
+
+		auto trackIndex = i * frameCount + indexA;
+		if (track.propCount == 0)
+		{
+			auto t = calcTrackT(baseT, trackFuncs[trackIndex], trackCoeffs[trackIndex]);
+			auto frameViewA = track.animatable->getAnimation(trackFrames[trackIndex]);
+			auto frameViewB = track.animatable->getAnimation(trackFrames[i * frameCount + indexB]);
+			track.animatable->animateAsync(componentView, frameViewA, frameViewB, t);
+			continue;
+		}
+
+		track.animatable->animateBaked(componentView, results + track.valueOffset, trackMasks[trackIndex]);
+	}
+}
+
 static void animateComponent(Manager* manager, const AnimationSystem::AnimationPool* animations, 
-	AnimationComponent& animationComp)
+	const System* transformSystem, AnimationComponent& animationComp)
 {
 	auto entity = animationComp.getEntity();
-	if (!entity || !animationComp.isPlaying || animationComp.active.empty())
+	if (!entity || !animationComp.isPlaying)
 		return;
 
-	auto transformView = manager->tryGet<TransformComponent>(entity);
-	if (transformView)
+	auto entityView = manager->getEntities().get(entity);
+	auto components = entityView->getComponents();
+	auto componentCount = entityView->getComponentCount();
+
+	if (transformSystem)
 	{
-		if (!transformView->isActive())
+		auto transformView = View<TransformComponent>(getTrackComponent(
+			components, componentCount, transformSystem, animationComp.transformIndex));
+		if (transformView && !transformView->isActive())
 			return;
 	}
 
-	const auto& componentAnimations = animationComp.getAnimations();
-	auto searchResult = componentAnimations.find(animationComp.active);
-	if (searchResult == componentAnimations.end())
+	auto animation = animationComp.getActiveAnimation();
+	if (!animation)
 		return;
 
-	auto animationView = animations->get(searchResult->second);
-	const auto& keyframes = animationView->getKeyframes();
-	if (keyframes.empty())
+	auto animationView = animations->get(animation);
+	const auto& frames = animationView->getFrames();
+	if (frames.empty())
 		return;
 
-	auto keyframeB = keyframes.lower_bound((int32)ceil(animationComp.frame));
-	if (keyframeB == keyframes.end())
+	auto trackCount = animationView->getTracks().size();
+	if (animationComp.trackIndices.size() != trackCount)
+		animationComp.trackIndices.assign(trackCount, UINT8_MAX);
+	auto trackIndices = animationComp.trackIndices.data();
+	auto frameCount = frames.size(); auto frameData = frames.data();
+	auto searchResult = std::lower_bound(frameData, frameData + frameCount, (int32)ceil(animationComp.frame));
+
+	if (searchResult == frameData + frameCount)
 	{
-		if (!animationView->isLooped && keyframes.size() > 1)
+		if (!animationView->isLooped && frameCount > 1)
 		{
-			keyframeB--; const auto& animatables = keyframeB->second;
-			for (const auto& pair : animatables)
-			{
-				auto animatableSystem = dynamic_cast<IAnimatable*>(pair.first);
-				auto frameView = animatableSystem->getAnimation(pair.second);
-				auto componentView = manager->tryGet(entity, pair.first->getComponentType());
-				if (componentView)
-					animatableSystem->animateAsync(View<Component>(componentView), frameView, frameView, 1.0f);
-			}
-
+			animateKeyframe(animationView, frameCount - 1, components, componentCount, trackIndices);
 			animationComp.frame = 0.0f;
 			animationComp.isPlaying = false;
 			return;
 		}
 
-		keyframeB--;
-		animationComp.frame = keyframeB->first == 0 ? 0.0f : fmod(animationComp.frame, (float)keyframeB->first);
-		keyframeB = keyframes.lower_bound((int32)ceil(animationComp.frame));
-		GARDEN_ASSERT_MSG(keyframeB != keyframes.end(), "Something went wrong :(");
+		auto lastFrame = frameData[frameCount - 1];
+		animationComp.frame = lastFrame == 0 ? 0.0f : fmod(animationComp.frame, (float)lastFrame);
+		searchResult = std::lower_bound(frameData, frameData + frameCount, (int32)ceil(animationComp.frame));
+		GARDEN_ASSERT_MSG(searchResult != frameData + frameCount, "Something went wrong :(");
 	}
 
-	auto keyframeA = keyframeB;
-	if (keyframeA != keyframes.begin())
-		keyframeA--;
+	auto indexB = (psize)(searchResult - frameData);
+	auto indexA = indexB > 0 ? indexB - 1 : indexB;
 
-	const auto& animatablesA = keyframeA->second;
-	const auto& animatablesB = keyframeB->second;
-
-	if (keyframeA == keyframeB)
+	if (indexA == indexB)
 	{
-		for (const auto& pair : animatablesA)
-		{
-			auto animatableSystem = dynamic_cast<IAnimatable*>(pair.first);
-			auto frameView = animatableSystem->getAnimation(pair.second);
-			auto componentView = manager->tryGet(entity, pair.first->getComponentType());
-			if (componentView)
-				animatableSystem->animateAsync(View<Component>(componentView), frameView, frameView, 1.0f);
-		}
+		animateKeyframe(animationView, indexA, components, componentCount, trackIndices);
 	}
 	else
 	{
-		auto currentFrame = animationComp.frame;
-		auto frameA = keyframeA->first, frameB = keyframeB->first;
+		auto frameA = frameData[indexA], frameB = frameData[indexB];
 		auto frameDiff = frameB - frameA;
-		auto t = frameDiff == 0 ? 1.0f : (currentFrame - frameA) / (float)frameDiff;
-
-		for (const auto& pairA : animatablesA)
-		{
-			auto animationFrameB = animatablesB.at(pairA.first);
-			auto animatableSystem = dynamic_cast<IAnimatable*>(pairA.first);
-			auto frameViewA = animatableSystem->getAnimation(pairA.second);
-			auto frameViewB = animatableSystem->getAnimation(animationFrameB);
-
-			if (frameViewA->funcType == AnimationFunc::Pow)
-				t = std::pow(t, frameViewA->funcCoeff);
-			else if (frameViewA->funcType == AnimationFunc::Gain)
-				t = gain(t, frameViewA->funcCoeff);
-
-			auto componentView = manager->tryGet(entity, pairA.first->getComponentType());
-			if (componentView)
-				animatableSystem->animateAsync(View<Component>(componentView), frameViewA, frameViewB, t);
-		}
+		auto baseT = frameDiff == 0 ? 1.0f : (animationComp.frame - frameA) / (float)frameDiff;
+		animateKeyframes(animationView, indexA, indexB, baseT, components, componentCount, trackIndices);
 	}
 
-	if (!animationView->isLooped && keyframes.size() == 1)
+	if (!animationView->isLooped && frameCount == 1)
 	{
 		animationComp.frame = 0.0f;
 		animationComp.isPlaying = false;
@@ -159,22 +276,32 @@ void AnimationSystem::update()
 	if (components.getCount() == 0)
 		return;
 
+	auto animationData = animations.getData();
+	auto animationOccupancy = animations.getOccupancy();
+	for (uint32 i = 0; i < animationOccupancy; i++)
+	{
+		auto& animation = animationData[i];
+		if (animation.isBakeDirty())
+			animation.bake(); // Note: baking before the async animation, tracks are read only there.
+	}
+
 	auto animations = &this->animations;
 	auto componentData = components.getData();
 	auto threadSystem = ThreadSystem::Instance::tryGet();
+	const System* transformSystem = TransformSystem::Instance::tryGet();
 
 	if (animateAsync && threadSystem)
 	{
 		auto& threadPool = threadSystem->getForegroundPool();
-		threadPool.addItems([animations, componentData](const ThreadPool::Task& task)
+		threadPool.addItems([animations, componentData, transformSystem](const ThreadPool::Task& task)
 		{
 			auto itemCount = task.getItemCount();
 			auto manager = Manager::Instance::get();
 
 			for (uint32 i = task.getItemOffset(); i < itemCount; i++)
-				animateComponent(manager, animations, componentData[i]);
+				animateComponent(manager, animations, transformSystem, componentData[i]);
 		},
-		components.getOccupancy());
+		components.getOccupancy(), ThreadPool::priorityNormal, {}, ThreadPool::defaultGrainSize);
 		threadPool.wait();
 	}
 	else
@@ -183,21 +310,20 @@ void AnimationSystem::update()
 		auto manager = Manager::Instance::get();
 
 		for (uint32 i = 0; i < componentOccupancy; i++)
-			animateComponent(manager, animations, componentData[i]);
+			animateComponent(manager, animations, transformSystem, componentData[i]);
 	}
 }
 
 static void randomizeStartFrame(mt19937& randomGenerator, View<AnimationComponent> componentView)
 {
-	if (!componentView->randomizeStart || componentView->active.empty())
+	if (!componentView->randomizeStart)
 		return;
 
-	const auto& animations = componentView->getAnimations();
-	auto searchResult = animations.find(componentView->active);
-	if (searchResult == animations.end())
+	auto animation = componentView->getActiveAnimation();
+	if (!animation)
 		return;
 
-	auto animationView = AnimationSystem::Instance::get()->get(searchResult->second);
+	auto animationView = AnimationSystem::Instance::get()->get(animation);
 	if (animationView->getKeyframes().empty())
 		return;
 
@@ -231,6 +357,7 @@ void AnimationSystem::copyComponent(View<Component> source, View<Component> dest
 	auto destinationView = View<AnimationComponent>(destination);
 	destinationView->animations = sourceView->animations;
 	destinationView->active = sourceView->active;
+	destinationView->isActiveDirty = true;
 	destinationView->frame = sourceView->frame;
 	destinationView->isPlaying = sourceView->isPlaying;
 	destinationView->randomizeStart = sourceView->randomizeStart;
@@ -299,9 +426,11 @@ void AnimationSystem::deserialize(IDeserializer& deserializer, View<Component> c
 			deserializer.endArrayElement();
 		}
 		deserializer.endChild();
+		componentView->isActiveDirty = true;
 	}
 
-	deserializer.read("active", componentView->active);
+	if (deserializer.read("active", componentView->active))
+		componentView->isActiveDirty = true;
 	deserializer.read("frame", componentView->frame);
 	deserializer.read("isPlaying", componentView->isPlaying);
 	deserializer.read("randomizeStart", componentView->randomizeStart);
@@ -69,8 +69,8 @@ static void calcJitterOffsets(vector<float2>& jitterOffsets,
 }
 
 //**********************************************************************************************************************
-GraphicsSystem::GraphicsSystem(uint2 windowSize, bool isFullscreen, bool isDecorated,
-	bool useAsyncRecording, bool setSingleton) : Singleton(setSingleton), asyncRecording(useAsyncRecording)
+GraphicsSystem::GraphicsSystem(uint2 windowSize, bool isFullscreen, bool isDecorated, bool useAsyncRecording, 
+	GraphicsBackend backendType, bool setSingleton) : Singleton(setSingleton), asyncRecording(useAsyncRecording)
 {
 	auto manager = Manager::Instance::get();
 	manager->registerEvent("Render");
@@ -85,7 +85,7 @@ GraphicsSystem::GraphicsSystem(uint2 windowSize, bool isFullscreen, bool isDecor
 	auto threadSystem = ThreadSystem::Instance::tryGet();
 	auto threadPool = threadSystem ? &threadSystem->getForegroundPool() : nullptr;
 
-	GraphicsAPI::initialize(GraphicsBackend::VulkanAPI, appInfoSystem->getName(), appInfoSystem->getAppDataName(),
+	GraphicsAPI::initialize(backendType, appInfoSystem->getName(), appInfoSystem->getAppDataName(),
 		appInfoSystem->getVersion(), windowSize, threadPool, useVsync, useTripleBuffering, isFullscreen, isDecorated);
 
 	auto graphicsAPI = GraphicsAPI::get();
@@ -139,6 +139,8 @@ void GraphicsSystem::preInit()
 
 	if (graphicsBackend == GraphicsBackend::VulkanAPI)
 		logVkGpuInfo();
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		GARDEN_LOG_INFO("GPU: Null (headless)");
 	else abort();
 
 	auto inputSystem = InputSystem::Instance::get();
@@ -353,7 +355,7 @@ void GraphicsSystem::update()
 			nvLowLatency = useLowLatency; nvMaxFrameRate = maxFrameRate; 
 		}
 	}
-	else abort();
+	else if (graphicsBackend != GraphicsBackend::NullAPI) abort();
 
 	if (isFramebufferSizeValid)
 	{
@@ -1221,6 +1223,8 @@ void GraphicsSystem::addBarriers(Buffer::BarrierState newState, const ID<Buffer>
 				barrierBuffers.push_back(buffers[i]);
 		}
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		barrierBuffers.assign(buffers, buffers + bufferCount);
 	else abort();
 
 	BufferBarrierCommand command;
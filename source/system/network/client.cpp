@@ -23,7 +23,7 @@ using namespace garden;
 static NetsResult sendEncMessage(nets::IStreamClient* streamClient, uint8* encKey, uint8 messageLengthSize)
 {
 	constexpr uint8 bufferSize = ClientSession::keySize + 16;
-	StreamOutputBuffer<bufferSize> message("enc", ClientSession::keySize, messageLengthSize);
+	StreamOutputBuffer<bufferSize> message(NetMessageID::enc, ClientSession::keySize, messageLengthSize);
 	message.write(encKey, ClientSession::keySize);
 	auto result = streamClient->send(message);
 	OPENSSL_cleanse(message.buffer, bufferSize * sizeof(uint8));
@@ -148,33 +148,26 @@ int ClientNetworkSystem::onMessageReceive(::StreamMessage message, void* argumen
 {
 	SET_CPU_ZONE_SCOPED("On Message Receive");
 
-	if (getStreamMessageLeft(message) < sizeof(uint8) * 3)
+	StreamInput input(message); uint16 messageID;
+	if (input.readMessageID(messageID))
 		return BAD_DATA_NETS_RESULT;
 
-	bool isSystem;
-	if (readStreamMessageBool(&message, &isSystem))
-		return BAD_DATA_NETS_RESULT;
-
-	const void* typeString; psize typeLength;
-	if (readStreamMessageData(&message, &typeString, &typeLength, sizeof(uint8)))
-		return BAD_DATA_NETS_RESULT;
-
-	string_view messageType((const char*)typeString, typeLength);
 	auto clientSystem = (ClientNetworkSystem*)argument;
+	if (messageID == NetMessageID::types)
+		return clientSystem->onTypesResponse(input, clientSystem->isDatagram);
 
-	if (isSystem)
-	{
-		auto searchResult = clientSystem->networkables.find(messageType);
-		if (searchResult != clientSystem->networkables.end())
-			return searchResult->second->onMsgFromServer(message, clientSystem->isDatagram);
-	}
-	else
+	const auto& receivers = clientSystem->receivers;
+	if (messageID < receivers.size())
 	{
-		auto searchResult = clientSystem->listeners.find(messageType);
-		if (searchResult != clientSystem->listeners.end())
-			return searchResult->second(message, clientSystem->isDatagram);
+		const auto& receiver = receivers[messageID];
+		if (receiver.networkable)
+			return receiver.networkable->onMsgFromServer(input, clientSystem->isDatagram);
+		if (receiver.onReceive)
+			return receiver.onReceive(input, clientSystem->isDatagram);
 	}
-	return BAD_DATA_NETS_RESULT;
+
+	// Note: Datagram can arrive before the message types table sent over the stream.
+	return clientSystem->isDatagram ? SUCCESS_NETS_RESULT : BAD_DATA_NETS_RESULT;
 }
 
 int ClientNetworkSystem::onEncResponse(StreamInput response, bool isDatagram)
@@ -231,6 +224,57 @@ int ClientNetworkSystem::onEncResponse(StreamInput response, bool isDatagram)
 	return response.isComplete() ? SUCCESS_NETS_RESULT : BAD_DATA_NETS_RESULT;
 }
 
+int ClientNetworkSystem::onTypesResponse(StreamInput response, bool isDatagram)
+{
+	uint16 firstID; uint8 typeCount;
+	if (isDatagram || response.read(firstID) || response.read(typeCount) || 
+		firstID < NetMessageID::reservedCount || (uint32)firstID + typeCount > NetMessageID::max + 1u)
+	{
+		return BAD_DATA_NETS_RESULT;
+	}
+
+	messageLocker.lock();
+	if (firstID == NetMessageID::reservedCount)
+	{
+		resetMessageTypes();
+	}
+	else if (firstID != receivers.size())
+	{
+		messageLocker.unlock();
+		return BAD_DATA_NETS_RESULT;
+	}
+
+	for (uint8 i = 0; i < typeCount; i++)
+	{
+		uint8 typeLength; const void* typeString;
+		if (response.read(typeLength) || typeLength == 0 || response.read(typeString, typeLength))
+		{
+			messageLocker.unlock();
+			return BAD_DATA_NETS_RESULT;
+		}
+
+		string_view messageType((const char*)typeString, typeLength);
+		auto messageID = (uint16)receivers.size();
+		messageIDs.emplace(messageType, messageID);
+
+		auto searchResult = localReceivers.find(messageType);
+		if (searchResult != localReceivers.end())
+		{
+			const auto& receiver = searchResult->second;
+			if (receiver.networkable)
+				receiver.networkable->messageID = messageID;
+			receivers.push_back(receiver);
+		}
+		else
+		{
+			receivers.emplace_back();
+		}
+	}
+
+	messageLocker.unlock();
+	return response.isComplete() ? SUCCESS_NETS_RESULT : BAD_DATA_NETS_RESULT;
+}
+
 //**********************************************************************************************************************
 ClientNetworkSystem::ClientNetworkSystem(psize receiveBufferSize, psize messageBufferSize, 
 	uint8 clientLengthSize, double timeoutTime, bool setSingleton)
@@ -251,6 +295,7 @@ ClientNetworkSystem::ClientNetworkSystem(psize receiveBufferSize, psize messageB
 	this->messageBufferSize = messageBufferSize + serverLengthSize;
 	GARDEN_ASSERT(this->messageBufferSize <= receiveBufferSize);
 	this->messageBuffer = new uint8[this->messageBufferSize];
+	resetMessageTypes();
 }
 void ClientNetworkSystem::preInit()
 {
@@ -262,12 +307,8 @@ void ClientNetworkSystem::preInit()
 	{
 		for (auto system : *systemGroup)
 		{
-			auto networkableSystem = dynamic_cast<INetworkable*>(system);
-			auto messageType = networkableSystem->getMessageType();
-			GARDEN_ASSERT(messageType.length() <= UINT8_MAX);
-			GARDEN_ASSERT(listeners.find(messageType) == listeners.end());
-			auto result = networkables.emplace(messageType, networkableSystem);
-			GARDEN_ASSERT_MSG(result.second, "Already registered network message type");
+			Receiver receiver; receiver.networkable = dynamic_cast<INetworkable*>(system);
+			addMessageType(receiver.networkable->getMessageType(), receiver);
 		}
 	}
 
@@ -275,7 +316,7 @@ void ClientNetworkSystem::preInit()
 	{
 		if (!isDatagram || !request.isComplete())
 			return (NetsResult)BAD_DATA_NETS_RESULT;
-		StreamOutputBuffer<16> message("pong", 0, clientLengthSize);
+		StreamOutputBuffer<16> message(NetMessageID::pong, 0, clientLengthSize);
 		return sendDatagram(message);
 	});
 	addListener("pong", [this](StreamInput response, bool isDatagram)
@@ -302,6 +343,59 @@ void ClientNetworkSystem::preDeinit()
 	destroy();
 }
 
+//**********************************************************************************************************************
+void ClientNetworkSystem::resetMessageTypes()
+{
+	for (const auto& pair : localReceivers)
+	{
+		if (pair.second.networkable)
+			pair.second.networkable->messageID = NetMessageID::invalid;
+	}
+
+	messageIDs.clear();
+	receivers.resize(NetMessageID::reservedCount);
+
+	for (uint16 i = 0; i < NetMessageID::reservedCount; i++)
+	{
+		auto messageType = netReservedMessageTypes[i];
+		messageIDs.emplace(messageType, i);
+
+		auto searchResult = localReceivers.find(messageType);
+		if (searchResult != localReceivers.end())
+			receivers[i] = searchResult->second;
+	}
+}
+void ClientNetworkSystem::addMessageType(string_view messageType, const Receiver& receiver)
+{
+	GARDEN_ASSERT(!messageType.empty());
+	GARDEN_ASSERT(messageType.length() <= UINT8_MAX);
+
+	messageLocker.lock();
+	if (messageType == netReservedMessageTypes[NetMessageID::types] || 
+		!localReceivers.emplace(messageType, receiver).second)
+	{
+		messageLocker.unlock();
+		throw GardenError("Client message type already registered. (type: " + string(messageType) + ")");
+	}
+
+	for (uint16 i = 0; i < NetMessageID::reservedCount; i++)
+	{
+		if (netReservedMessageTypes[i] != messageType)
+			continue;
+		receivers[i] = receiver;
+		break;
+	}
+	messageLocker.unlock();
+}
+uint16 ClientNetworkSystem::getMessageID(string_view messageType) const
+{
+	messageLocker.lock();
+	auto searchResult = messageIDs.find(messageType);
+	auto messageID = searchResult != messageIDs.end() ? searchResult->second : NetMessageID::invalid;
+	messageLocker.unlock();
+	return messageID;
+}
+
 //**********************************************************************************************************************
 void ClientNetworkSystem::update()
 {
@@ -313,7 +407,7 @@ void ClientNetworkSystem::update()
 		auto currentTime = mpio::OS::getCurrentClock();
 		if (currentTime > pingMessageDelay)
 		{
-			StreamOutputBuffer<16> message("ping", 0, clientLengthSize);
+			StreamOutputBuffer<16> message(NetMessageID::ping, 0, clientLengthSize);
 			auto result = sendDatagram(message);
 			if (result != SUCCESS_NETS_RESULT)
 				disconnect(result);
@@ -42,7 +42,7 @@ StreamServerHandle::StreamServerHandle(ServerNetworkSystem* serverSystem, Socket
 static NetsResult sendEncMessage(ClientSession* clientSession, uint8 messageLengthSize)
 {
 	constexpr uint8 messageSize = sizeof(uint32) + ClientSession::keySize, bufferSize = messageSize + 16;
-	StreamOutputBuffer<bufferSize> message("enc", messageSize, messageLengthSize);
+	StreamOutputBuffer<bufferSize> message(NetMessageID::enc, messageSize, messageLengthSize);
 	message.write((const void*)&clientSession->datagramUID, sizeof(uint32)); // Note: No endianness swap for random data.
 	message.write(clientSession->encKey, ClientSession::keySize);
 	auto result = clientSession->send(message);
@@ -145,7 +145,7 @@ void* StreamServerHandle::onSessionCreate(nets::StreamSessionView streamSession)
 	}
 	else
 	{
-		StreamOutputBuffer<16 + sizeof(uint32)> message("enc", sizeof(uint32), serverLengthSize);
+		StreamOutputBuffer<16 + sizeof(uint32)> message(NetMessageID::enc, sizeof(uint32), serverLengthSize);
 		message.write((const void*)&clientSession->datagramUID, sizeof(uint32)); // Note: No endianness swap for random data.
 		if (clientSession->send(message) != SUCCESS_NETS_RESULT)
 		{
@@ -154,6 +154,12 @@ void* StreamServerHandle::onSessionCreate(nets::StreamSessionView streamSession)
 		}
 	}
 
+	if (sendTypesMessage(clientSession) != SUCCESS_NETS_RESULT)
+	{
+		streamSession.shutdown();
+		GARDEN_LOG_INFO("Failed to send session types. (address: " + streamSession.getAddress() + ")");
+	}
+
 	GARDEN_LOG_INFO("Created a new client session. (address: " + streamSession.getAddress() + ")");
 	return clientSession;
 }
@@ -271,32 +277,20 @@ int StreamServerHandle::onMessageReceive(::StreamMessage message, void* argument
 {
 	SET_CPU_ZONE_SCOPED("On Message Receive");
 
-	if (getStreamMessageLeft(message) < sizeof(uint8) * 3)
-		return BAD_DATA_NETS_RESULT;
-
-	bool isSystem;
-	if (readStreamMessageBool(&message, &isSystem))
+	StreamInput input(message); uint16 messageID;
+	if (input.readMessageID(messageID))
 		return BAD_DATA_NETS_RESULT;
 
-	const void* typeString; psize typeLength;
-	if (readStreamMessageData(&message, &typeString, &typeLength, sizeof(uint8)))
-		return BAD_DATA_NETS_RESULT;
-
-	string_view messageType((const char*)typeString, typeLength);
 	auto pair = *((std::pair<ServerNetworkSystem*, ClientSession*>*)argument);
+	const auto& receivers = pair.first->receivers;
+	if (messageID >= receivers.size())
+		return BAD_DATA_NETS_RESULT;
 
-	if (isSystem)
-	{
-		auto searchResult = pair.first->networkables.find(messageType);
-		if (searchResult != pair.first->networkables.end())
-			return searchResult->second->onMsgFromClient(pair.second, message);
-	}
-	else
-	{
-		auto searchResult = pair.first->listeners.find(messageType);
-		if (searchResult != pair.first->listeners.end())
-			return searchResult->second(pair.second, message);
-	}
+	const auto& receiver = receivers[messageID];
+	if (receiver.networkable)
+		return receiver.networkable->onMsgFromClient(pair.second, input);
+	if (receiver.onReceive)
+		return receiver.onReceive(pair.second, input);
 	return BAD_DATA_NETS_RESULT;
 }
 
@@ -341,10 +335,49 @@ int StreamServerHandle::onPingRequest(ClientSession* session, StreamInput reques
 {
 	if (!session->isAuthorized || !session->datagramAddress || !request.isComplete())
 		return BAD_DATA_NETS_RESULT;
-	StreamOutputBuffer<16> response("pong", 0, serverLengthSize);
+	StreamOutputBuffer<16> response(NetMessageID::pong, 0, serverLengthSize);
 	return sendDatagram(session, response);
 }
 
+//**********************************************************************************************************************
+NetsResult StreamServerHandle::sendTypesMessage(ClientSession* clientSession)
+{
+	// Note: Table is split into several messages if it does not fit into the server message length size.
+	constexpr psize headerSize = sizeof(uint16) + sizeof(uint8) + 1; // 1 = types message ID size
+	auto maxMessageSize = serverLengthSize < sizeof(uint32) ? 
+		((psize)1 << (serverLengthSize * 8)) - 1 : (psize)UINT32_MAX;
+	const auto& messageTypes = serverSystem->messageTypes;
+	auto typeCount = (uint16)messageTypes.size();
+	vector<uint8> buffer;
+
+	auto firstID = NetMessageID::reservedCount;
+	do
+	{
+		psize messageSize = headerSize; auto lastID = firstID;
+		while (lastID < typeCount && (lastID - firstID) < UINT8_MAX)
+		{
+			auto typeSize = sizeof(uint8) + messageTypes[lastID].size();
+			if (messageSize + typeSize > maxMessageSize)
+				break;
+			messageSize += typeSize; lastID++;
+		}
+		if (lastID == firstID && firstID < typeCount)
+			return BAD_DATA_NETS_RESULT;
+
+		StreamOutput message(NetMessageID::types, buffer, messageSize - 1, serverLengthSize);
+		message.write(firstID); message.write((uint8)(lastID - firstID));
+		for (uint16 i = firstID; i < lastID; i++)
+			message.write(string_view(messageTypes[i]), sizeof(uint8));
+
+		auto result = clientSession->send(message);
+		if (result != SUCCESS_NETS_RESULT)
+			return result;
+		firstID = lastID;
+	} while (firstID < typeCount);
+
+	return SUCCESS_NETS_RESULT;
+}
+
 //**********************************************************************************************************************
 ServerNetworkSystem::ServerNetworkSystem(bool setSingleton) : Singleton(setSingleton)
 {
@@ -352,6 +385,13 @@ ServerNetworkSystem::ServerNetworkSystem(bool setSingleton) : Singleton(setSingl
 	ECSM_SUBSCRIBE_TO_EVENT("PreInit", ServerNetworkSystem::preInit);
 	ECSM_SUBSCRIBE_TO_EVENT("PreDeinit", ServerNetworkSystem::preDeinit);
 	ECSM_SUBSCRIBE_TO_EVENT("Update", ServerNetworkSystem::update);
+
+	for (auto messageType : netReservedMessageTypes)
+	{
+		messageIDs.emplace(messageType, (uint16)receivers.size());
+		messageTypes.emplace_back(messageType);
+		receivers.emplace_back();
+	}
 }
 void ServerNetworkSystem::preInit()
 {
@@ -363,12 +403,8 @@ void ServerNetworkSystem::preInit()
 	{
 		for (auto system : *systemGroup)
 		{
-			auto networkableSystem = dynamic_cast<INetworkable*>(system);
-			auto messageType = networkableSystem->getMessageType();
-			GARDEN_ASSERT(messageType.length() <= UINT8_MAX);
-			GARDEN_ASSERT(listeners.find(messageType) == listeners.end());
-			auto result = networkables.emplace(messageType, networkableSystem);
-			GARDEN_ASSERT_MSG(result.second, "Already registered network message type");
+			Receiver receiver; receiver.networkable = dynamic_cast<INetworkable*>(system);
+			addMessageType(receiver.networkable->getMessageType(), receiver);
 		}
 	}
 
@@ -386,6 +422,35 @@ void ServerNetworkSystem::preDeinit()
 	stop();
 }
 
+uint16 ServerNetworkSystem::addMessageType(string_view messageType, const Receiver& receiver)
+{
+	GARDEN_ASSERT(!messageType.empty());
+	GARDEN_ASSERT(messageType.length() <= UINT8_MAX);
+
+	auto searchResult = messageIDs.find(messageType);
+	if (searchResult != messageIDs.end())
+	{
+		auto messageID = searchResult->second;
+		auto& reservedReceiver = receivers[messageID];
+		if (messageID >= NetMessageID::reservedCount || reservedReceiver.networkable || reservedReceiver.onReceive)
+			throw GardenError("Server message type already registered. (type: " + string(messageType) + ")");
+		reservedReceiver = receiver;
+		return messageID;
+	}
+
+	if (receivers.size() > NetMessageID::max)
+		throw GardenError("Too many server message types registered.");
+
+	auto messageID = (uint16)receivers.size();
+	messageIDs.emplace(messageType, messageID);
+	messageTypes.emplace_back(messageType);
+	receivers.push_back(receiver);
+
+	if (receiver.networkable)
+		receiver.networkable->messageID = messageID;
+	return messageID;
+}
+
 //**********************************************************************************************************************
 static void updateSessions(StreamServerHandle* streamServer, std::function<int(ClientSession*)> onSessionUpdate)
 {
@@ -14,6 +14,7 @@
 
 #include "garden/system/physics.hpp"
 #include "garden/system/network/server.hpp"
+#include "garden/system/network/client.hpp"
 #include "garden/system/physics-impl.hpp"
 #include "garden/system/character.hpp"
 #include "garden/system/transform.hpp"
@@ -22,6 +23,8 @@
 #include "garden/system/input.hpp"
 #include "garden/system/loop.hpp"
 #include "garden/system/log.hpp"
+#include "garden/interest-grid.hpp"
+#include "garden/binary-scene.hpp"
 #include "garden/profiler.hpp"
 #include "garden/base64.hpp"
 #include "mpmt/thread.hpp"
@@ -1035,7 +1038,7 @@ void PhysicsSystem::prepareSimulate()
 			}
 		}
 	},
-	components.getOccupancy());
+	components.getOccupancy(), ThreadPool::priorityNormal, {}, ThreadPool::defaultGrainSize);
 	threadPool.wait();
 }
 
@@ -1221,6 +1224,73 @@ void PhysicsSystem::simulate()
 	}
 }
 
+//**********************************************************************************************************************
+enum class NetBodyField : uint8
+{
+	None = 0x00, Cell = 0x01, Offset = 0x02, Rotation = 0x04, LinearVelocity = 0x08, AngularVelocity = 0x10, All = 0x1F
+};
+DECLARE_ENUM_CLASS_FLAG_OPERATORS(NetBodyField)
+
+struct NetBodyRecord final
+{
+	PhysicsSystem::NetBodyState state = {};
+	const PhysicsSystem::NetBaseline* baseline = nullptr;
+	uint32 entityUID = 0;
+	float priority = 0.0f;
+};
+
+static constexpr uint32 netRecordHeaderSize = sizeof(uint32) + sizeof(uint8) * 2;
+static constexpr uint32 netMaxMessageSize = MAX_DATAGRAM_MESSAGE_SIZE - StreamOutput::baseTotalSize;
+static constexpr uint32 maxAcksPerMessage = netMaxMessageSize / sizeof(uint32);
+static thread_local vector<InterestGrid::Item> interestItems;
+static thread_local vector<NetBodyRecord> netBodyRecords;
+
+static PhysicsSystem::NetBodyState quantizeNetBody(f32x4 position, 
+	quat rotation, f32x4 linearVelocity, f32x4 angularVelocity)
+{
+	PhysicsSystem::NetBodyState state;
+	state.rotationData = compressUnit(rotation);
+	compress3(linearVelocity, state.linearData, state.linearMagnitude);
+	compress3(angularVelocity, state.angularData, state.angularMagnitude);
+
+	auto worldPosition = (float3)position; auto cellPosition = &worldPosition.x; auto cell = &state.cell.x;
+	for (uint8 i = 0; i < 3; i++)
+	{
+		auto cellIndex = std::floor(cellPosition[i] * (1.0f / PhysicsSystem::netCellSize));
+		auto offset = cellPosition[i] * (1.0f / PhysicsSystem::netCellSize) - cellIndex;
+		cell[i] = (int32)cellIndex;
+		state.offset[i] = (uint16)std::clamp(std::round(offset * (float)UINT16_MAX), 0.0f, (float)UINT16_MAX);
+	}
+	return state;
+}
+static PhysicsSystem::NetBodyState quantizeNetBody(const RigidbodyComponent* rigidbodyView)
+{
+	f32x4 position; quat rotation; rigidbodyView->getPosAndRot(position, rotation);
+	return quantizeNetBody(position, rotation, rigidbodyView->getLinearVelocity(), rigidbodyView->getAngularVelocity());
+}
+static bool dequantizeNetBody(const PhysicsSystem::NetBodyState& state, PhysicsSystem::NetRigidbody& netRigidbody)
+{
+	auto rotation = normalize(decompressUnit(state.rotationData));
+	auto linearVelocity = decompress3(state.linearData, state.linearMagnitude);
+	auto angularVelocity = decompress3(state.angularData, state.angularMagnitude);
+
+	float3 position; auto cellPosition = &position.x; auto cell = &state.cell.x;
+	for (uint8 i = 0; i < 3; i++)
+	{
+		cellPosition[i] = ((float)cell[i] + state.offset[i] * (1.0f / (float)UINT16_MAX)) * 
+			PhysicsSystem::netCellSize;
+	}
+
+	if (isNan4((f32x4)position) || isNan4(rotation) || isNan3(linearVelocity) || isNan3(angularVelocity))
+		return false;
+
+	netRigidbody.rotation = rotation; netRigidbody.position = position;
+	netRigidbody.linearVelocity = (float3)linearVelocity;
+	netRigidbody.angularVelocity = (float3)angularVelocity;
+	return true;
+}
+
+//**********************************************************************************************************************
 void PhysicsSystem::flushNetRigidbodies()
 {
 	SET_CPU_ZONE_SCOPED("Net Rigidbodies Flush");
@@ -1231,7 +1301,7 @@ void PhysicsSystem::flushNetRigidbodies()
 
 	auto manager = Manager::Instance::get();
 	netRigidbodyLocker.lock();
-	for (auto pair : netRigidbodies)
+	for (auto pair : netReceiver.rigidbodies)
 	{
 		auto entity = networkSystem->findEntity(pair.first);
 		if (!entity)
@@ -1245,53 +1315,380 @@ void PhysicsSystem::flushNetRigidbodies()
 		rigidbodyView->setLinearVelocity((f32x4)pair.second.linearVelocity);
 		rigidbodyView->setAngularVelocity((f32x4)pair.second.angularVelocity);
 	}
-	netRigidbodies.clear();
+	netReceiver.rigidbodies.clear();
+
+	auto clientNetworkSystem = ClientNetworkSystem::Instance::tryGet();
+	if (!netReceiver.acks.empty() && clientNetworkSystem && clientNetworkSystem->isAuthorized && 
+		getMessageID() != NetMessageID::invalid)
+	{
+		auto ackCount = (uint32)netReceiver.acks.size();
+		auto acks = netReceiver.acks.data();
+		auto lengthSize = clientNetworkSystem->getClientLengthSize();
+
+		for (uint32 i = 0; i < ackCount; i += maxAcksPerMessage)
+		{
+			auto msgAckCount = min(ackCount - i, maxAcksPerMessage);
+			StreamOutputBuffer<MAX_DATAGRAM_MESSAGE_SIZE> message(
+				getMessageID(), msgAckCount * sizeof(uint32), lengthSize);
+			for (uint32 j = 0; j < msgAckCount; j++)
+				message.write(acks[i + j]);
+			clientNetworkSystem->sendDatagram(message);
+		}
+	}
+	netReceiver.acks.clear();
 	netRigidbodyLocker.unlock();
 }
 
 //**********************************************************************************************************************
-static constexpr uint32 rbTransformSize = sizeof(uint32) * 2 + sizeof(uint64) * 2 + sizeof(float3);
-static constexpr uint32 maxRbPerMessage = (MAX_DATAGRAM_MESSAGE_SIZE - StreamOutput::baseTotalSize) / rbTransformSize;
-static thread_local vector<ShapeHit> shapeHits;
-static thread_local vector<RigidbodyComponent*> rigidbodyViews;
+static NetBodyField getNetBodyDelta(const PhysicsSystem::NetBodyState& state, const PhysicsSystem::NetBodyState& base)
+{
+	auto fields = NetBodyField::None;
+	if (state.cell != base.cell)
+		fields |= NetBodyField::Cell;
+	if (memcmp(state.offset, base.offset, sizeof(uint16) * 3) != 0)
+		fields |= NetBodyField::Offset;
+	if (state.rotationData != base.rotationData)
+		fields |= NetBodyField::Rotation;
+	if (state.linearData != base.linearData || state.linearMagnitude != base.linearMagnitude)
+		fields |= NetBodyField::LinearVelocity;
+	if (state.angularData != base.angularData || state.angularMagnitude != base.angularMagnitude)
+		fields |= NetBodyField::AngularVelocity;
+	return fields;
+}
+static uint32 getNetBodySize(NetBodyField fields) noexcept
+{
+	uint32 size = netRecordHeaderSize;
+	if (hasAnyFlag(fields, NetBodyField::Cell))
+		size += sizeof(int3);
+	if (hasAnyFlag(fields, NetBodyField::Offset))
+		size += sizeof(uint16) * 3;
+	if (hasAnyFlag(fields, NetBodyField::Rotation))
+		size += sizeof(uint32);
+	if (hasAnyFlag(fields, NetBodyField::LinearVelocity))
+		size += sizeof(uint32) + sizeof(float);
+	if (hasAnyFlag(fields, NetBodyField::AngularVelocity))
+		size += sizeof(uint32) + sizeof(float);
+	return size;
+}
 
-static void encodeNetRigidbody(Manager* manager, const RigidbodyComponent* rigidbodyView, StreamOutput& message)
+static void encodeNetBody(const NetBodyRecord& record, uint32 snapshotID, StreamOutput& message)
 {
-	auto networkView = manager->get<NetworkComponent>(rigidbodyView->getEntity());
-	f32x4 position; quat rotation; rigidbodyView->getPosAndRot(position, rotation);
-	uint32 linearData, angularData; float linearMagnitude, angularMagnitude;
-	auto rotationData = compressUnit(rotation);
-	compress3(rigidbodyView->getLinearVelocity(), linearData, linearMagnitude);
-	compress3(rigidbodyView->getAngularVelocity(), angularData, angularMagnitude);
+	const auto& state = record.state;
+	auto fields = NetBodyField::All; uint8 baselineAge = 0;
+	if (record.baseline)
+	{
+		fields = getNetBodyDelta(state, record.baseline->state);
+		baselineAge = (uint8)(snapshotID - record.baseline->snapshotID);
+	}
 
-	message.write(networkView->getEntityUID());
-	message.write((float3)position); message.write(rotationData);
-	message.write(linearData); message.write(angularData);
-	message.write(linearMagnitude); message.write(angularMagnitude);
+	message.write(record.entityUID); message.write((uint8)fields); message.write(baselineAge);
+	if (hasAnyFlag(fields, NetBodyField::Cell))
+		message.write(state.cell);
+	if (hasAnyFlag(fields, NetBodyField::Offset))
+	{
+		message.write(state.offset[0]); message.write(state.offset[1]); message.write(state.offset[2]);
+	}
+	if (hasAnyFlag(fields, NetBodyField::Rotation))
+		message.write(state.rotationData);
+	if (hasAnyFlag(fields, NetBodyField::LinearVelocity))
+	{
+		message.write(state.linearData); message.write(state.linearMagnitude);
+	}
+	if (hasAnyFlag(fields, NetBodyField::AngularVelocity))
+	{
+		message.write(state.angularData); message.write(state.angularMagnitude);
+	}
 }
-static bool decodeNetRigidbody(StreamInput& message, uint32& entityUID, PhysicsSystem::NetRigidbody& netRigidbody)
+static bool decodeNetBody(StreamInput& message, NetBodyField fields, PhysicsSystem::NetBodyState& state)
 {
-	uint32 rotationData, linearData, angularData; float3 position; float linearMagnitude, angularMagnitude;
-	if (message.read(entityUID) || message.read(position) || message.read(rotationData) || message.read(linearData) || 
-		message.read(angularData) || message.read(linearMagnitude) || message.read(angularMagnitude))
+	if (hasAnyFlag(fields, NetBodyField::Cell) && message.read(state.cell))
+		return false;
+	if (hasAnyFlag(fields, NetBodyField::Offset) && (message.read(state.offset[0]) || 
+		message.read(state.offset[1]) || message.read(state.offset[2])))
 	{
 		return false;
 	}
+	if (hasAnyFlag(fields, NetBodyField::Rotation) && message.read(state.rotationData))
+		return false;
+	if (hasAnyFlag(fields, NetBodyField::LinearVelocity) && 
+		(message.read(state.linearData) || message.read(state.linearMagnitude)))
+	{
+		return false;
+	}
+	if (hasAnyFlag(fields, NetBodyField::AngularVelocity) && 
+		(message.read(state.angularData) || message.read(state.angularMagnitude)))
+	{
+		return false;
+	}
+	return true;
+}
 
-	auto rotation = normalize(decompressUnit(rotationData));
-	auto linearVelocity = decompress3(linearData, linearMagnitude);
-	auto angularVelocity = decompress3(angularData, angularMagnitude);
+//**********************************************************************************************************************
+struct NetServerSender final
+{
+	StreamServerHandle* streamServer = nullptr;
+	ClientSession* clientSession = nullptr;
+	uint16 messageID = 0;
+	uint8 lengthSize = 0;
 
-	if (isNan4((f32x4)position) || isNan4(rotation) || isNan3(linearVelocity) || isNan3(angularVelocity))
-		return false;
+	void send(const StreamOutput& message) const { streamServer->sendDatagram(clientSession, message); }
+};
 
-	netRigidbody.rotation = rotation; netRigidbody.position = position;
-	netRigidbody.linearVelocity = (float3)linearVelocity;
-	netRigidbody.angularVelocity = (float3)angularVelocity;
-	return true;
+template<typename S>
+static void sendNetSnapshot(const S& sender, PhysicsSystem::NetClientState* clientState, 
+	const NetBodyRecord* records, uint32 recordCount, uint32 messageSize)
+{
+	auto snapshotID = clientState->nextSnapshotID++;
+	StreamOutputBuffer<MAX_DATAGRAM_MESSAGE_SIZE> message(sender.messageID, messageSize, sender.lengthSize);
+	message.write(snapshotID);
+
+	auto& snapshot = clientState->snapshots[snapshotID % PhysicsSystem::netSnapshotHistory];
+	snapshot.snapshotID = snapshotID;
+	snapshot.bodies.resize(recordCount);
+
+	for (uint32 i = 0; i < recordCount; i++)
+	{
+		const auto& record = records[i];
+		encodeNetBody(record, snapshotID, message);
+		snapshot.bodies[i] = make_pair(record.entityUID, record.state);
+	}
+	sender.send(message);
+}
+
+template<typename S>
+static void sendNetBodies(const S& sender, PhysicsSystem::NetClientState* clientState, 
+	const PhysicsSystem::NetInterestBody* bodies, float3 center, float viewRadius, uint32 bandwidth)
+{
+	auto& baselines = clientState->baselines;
+
+	// Note: Forgetting baselines of bodies that left the interest area or were destroyed since the last tick.
+	for (auto i = baselines.begin(); i != baselines.end();)
+	{
+		if (i->second.interestTick != clientState->interestTick)
+			i = baselines.erase(i);
+		else i++;
+	}
+
+	auto interestTick = ++clientState->interestTick;
+	auto snapshotID = clientState->nextSnapshotID;
+	uint32 totalSize = 0;
+
+	for (const auto& item : interestItems)
+	{
+		const auto& body = bodies[item.index];
+		auto searchResult = baselines.find(body.entityUID);
+		PhysicsSystem::NetBaseline* baseline = nullptr;
+		if (searchResult != baselines.end())
+		{
+			baseline = &searchResult.value();
+			baseline->interestTick = interestTick;
+		}
+
+		auto distance = length3((f32x4)body.position - (f32x4)center);
+
+		// Note: Already replicated bodies are kept inside the hysteresis band to prevent view edge flickering.
+		if (distance > viewRadius && !baseline)
+			continue;
+
+		uint32 baselineAge = PhysicsSystem::netMaxBaselineAge;
+		if (baseline)
+		{
+			// Note: Bodies at rest and bodies that have not changed since the last acknowledged state are skipped.
+			if (getNetBodyDelta(body.state, baseline->state) == NetBodyField::None)
+				continue;
+			baselineAge = min(snapshotID - baseline->snapshotID, PhysicsSystem::netMaxBaselineAge);
+		}
+
+		NetBodyRecord record;
+		record.state = body.state;
+		record.baseline = baseline;
+		record.entityUID = body.entityUID;
+		record.priority = (1.0f + body.speed) * (float)(baselineAge + 1) / (1.0f + distance);
+		totalSize += getNetBodySize(baseline ? getNetBodyDelta(body.state, baseline->state) : NetBodyField::All);
+		netBodyRecords.push_back(record);
+	}
+	interestItems.clear();
+
+	if (netBodyRecords.empty())
+		return;
+
+	if (totalSize > bandwidth)
+	{
+		std::sort(netBodyRecords.begin(), netBodyRecords.end(), [](const NetBodyRecord& a, const NetBodyRecord& b)
+		{
+			return a.priority > b.priority;
+		});
+	}
+
+	auto records = netBodyRecords.data();
+	auto recordCount = (uint32)netBodyRecords.size();
+	uint32 messageOffset = 0, messageSize = sizeof(uint32), sentSize = 0;
+
+	for (uint32 i = 0; i < recordCount; i++)
+	{
+		auto& record = records[i];
+		auto snapshotID = clientState->nextSnapshotID;
+
+		// Note: Client keeps only the last netBodyHistory body states, so older baselines can not be decoded.
+		if (record.baseline && snapshotID - record.baseline->snapshotID > PhysicsSystem::netMaxBaselineAge)
+			record.baseline = nullptr;
+
+		auto fields = record.baseline ? getNetBodyDelta(record.state, record.baseline->state) : NetBodyField::All;
+		auto recordSize = getNetBodySize(fields);
+
+		if (sentSize + messageSize + recordSize > bandwidth)
+		{
+			recordCount = i; // Note: Lower priority bodies are postponed to the next ticks.
+			break;
+		}
+		if (messageSize + recordSize > netMaxMessageSize)
+		{
+			sendNetSnapshot(sender, clientState, records + messageOffset, i - messageOffset, messageSize);
+			sentSize += messageSize; messageOffset = i; messageSize = sizeof(uint32);
+			i--; // Note: Re-evaluating baseline age.
+			continue;
+		}
+		messageSize += recordSize;
+	}
+
+	if (recordCount > messageOffset)
+		sendNetSnapshot(sender, clientState, records + messageOffset, recordCount - messageOffset, messageSize);
+	netBodyRecords.clear();
+}
+
+static void applyNetAck(PhysicsSystem::NetClientState& clientState, uint32 snapshotID)
+{
+	auto& snapshot = clientState.snapshots[snapshotID % PhysicsSystem::netSnapshotHistory];
+	if (snapshot.snapshotID != snapshotID)
+		return;
+
+	auto& baselines = clientState.baselines;
+	for (const auto& body : snapshot.bodies)
+	{
+		auto baselineResult = baselines.find(body.first);
+		if (baselineResult == baselines.end())
+		{
+			PhysicsSystem::NetBaseline baseline;
+			baseline.state = body.second;
+			baseline.snapshotID = snapshotID;
+			baseline.interestTick = clientState.interestTick;
+			baselines.emplace(body.first, baseline);
+		}
+		else if (baselineResult->second.snapshotID < snapshotID)
+		{
+			auto& baseline = baselineResult.value();
+			baseline.state = body.second;
+			baseline.snapshotID = snapshotID;
+		}
+	}
+
+	snapshot.bodies.clear();
+	snapshot.snapshotID = 0;
 }
 
 //**********************************************************************************************************************
+static int receiveNetSnapshot(StreamInput message, PhysicsSystem::NetReceiver& receiver)
+{
+	uint32 snapshotID;
+	if (message.read(snapshotID) || snapshotID == 0)
+		return BAD_DATA_NETS_RESULT;
+
+	auto& histories = receiver.histories;
+
+	// Note: Server restarts snapshot numbering for a new session, old body histories are no longer valid.
+	if (snapshotID < receiver.lastSnapshotID && 
+		receiver.lastSnapshotID - snapshotID > PhysicsSystem::netSnapshotHistory)
+	{
+		histories.clear();
+		receiver.lastSnapshotID = receiver.prunedSnapshotID = 0;
+	}
+	if (snapshotID > receiver.lastSnapshotID)
+		receiver.lastSnapshotID = snapshotID;
+
+	uint32 entityUID; uint8 fields, baselineAge;
+	PhysicsSystem::NetRigidbody netRigidbody; auto isComplete = true;
+
+	while (message.getLeft() > 0)
+	{
+		if (message.read(entityUID) || message.read(fields) || message.read(baselineAge) ||
+			(fields & ~(uint8)NetBodyField::All) != 0 || baselineAge > PhysicsSystem::netMaxBaselineAge)
+		{
+			return BAD_DATA_NETS_RESULT;
+		}
+
+		auto& history = histories[entityUID];
+		PhysicsSystem::NetBodyState state = {}; auto hasBaseline = true;
+
+		if (baselineAge != 0)
+		{
+			auto baselineID = snapshotID - baselineAge;
+			auto baselineIndex = baselineID % PhysicsSystem::netBodyHistory;
+			if (history.snapshotIDs[baselineIndex] == baselineID)
+				state = history.states[baselineIndex];
+			else hasBaseline = false;
+		}
+
+		if (!decodeNetBody(message, (NetBodyField)fields, state))
+			return BAD_DATA_NETS_RESULT;
+
+		// Note: Not acknowledging snapshot if its baseline is lost, server will resend full state later.
+		if (!hasBaseline || !dequantizeNetBody(state, netRigidbody))
+		{
+			isComplete = false;
+			continue;
+		}
+
+		// Note: Reordered older datagram is still a valid baseline, but it should not override newer state.
+		auto historyIndex = snapshotID % PhysicsSystem::netBodyHistory;
+		if (snapshotID >= history.snapshotIDs[historyIndex])
+		{
+			history.states[historyIndex] = state;
+			history.snapshotIDs[historyIndex] = snapshotID;
+		}
+		if (snapshotID < history.lastSnapshotID)
+			continue;
+		history.lastSnapshotID = snapshotID;
+
+		auto result = receiver.rigidbodies.find(entityUID);
+		if (result == receiver.rigidbodies.end())
+			receiver.rigidbodies.emplace(entityUID, netRigidbody);
+		else result.value() = netRigidbody;
+	}
+
+	if (isComplete)
+		receiver.acks.push_back(snapshotID);
+
+	// Note: Bodies not received for a whole baseline window left the view or were destroyed on the server.
+	if (receiver.lastSnapshotID - receiver.prunedSnapshotID > PhysicsSystem::netMaxBaselineAge)
+	{
+		for (auto i = histories.begin(); i != histories.end();)
+		{
+			if (receiver.lastSnapshotID - i->second.lastSnapshotID > PhysicsSystem::netMaxBaselineAge)
+				i = histories.erase(i);
+			else i++;
+		}
+		receiver.prunedSnapshotID = receiver.lastSnapshotID;
+	}
+	return SUCCESS_NETS_RESULT;
+}
+
+//**********************************************************************************************************************
+void PhysicsSystem::processServerAcks()
+{
+	netRigidbodyLocker.lock();
+	std::swap(netServerAcks, netServerAckCache);
+	netRigidbodyLocker.unlock();
+
+	for (auto ack : netServerAckCache)
+	{
+		auto clientResult = netClients.find(ack.first);
+		if (clientResult == netClients.end())
+			continue;
+		applyNetAck(clientResult.value(), ack.second);
+	}
+	netServerAckCache.clear();
+}
+
 void PhysicsSystem::sendServerMessages()
 {
 	SET_CPU_ZONE_SCOPED("Server Rigidbody Send");
@@ -1301,68 +1698,135 @@ void PhysicsSystem::sendServerMessages()
 		return;
 
 	ServerSessionLocker sessions;
-	if (sessions.count() == 0)
+	processServerAcks();
+
+	auto sessionCount = (uint32)sessions.count();
+	netClientStates.resize(sessionCount);
+
+	for (uint32 i = 0; i < sessionCount; i++)
+	{
+		auto clientSession = sessions.get(i);
+		if (!clientSession)
+		{
+			netClientStates[i] = nullptr;
+			continue;
+		}
+
+		auto searchResult = netClients.find(clientSession->datagramUID);
+		if (searchResult == netClients.end())
+		{
+			NetClientState clientState;
+			clientState.snapshots.resize(netSnapshotHistory);
+			searchResult = netClients.emplace(clientSession->datagramUID, std::move(clientState)).first;
+		}
+
+		auto& clientState = searchResult.value();
+		clientState.isVisited = true;
+		netClientStates[i] = &clientState;
+	}
+
+	for (auto i = netClients.begin(); i != netClients.end();)
+	{
+		if (i->second.isVisited)
+		{
+			i.value().isVisited = false;
+			i++;
+		}
+		else i = netClients.erase(i);
+	}
+
+	if (sessionCount == 0 || components.getCount() == 0)
 		return;
 
 	auto& threadPool = ThreadSystem::Instance::get()->getForegroundPool();
+	netInterestBodies.resize(components.getOccupancy());
+
+	threadPool.addItems([this](const ThreadPool::Task& task)
+	{
+		auto manager = Manager::Instance::get();
+		auto componentData = components.getData();
+		auto interestBodies = netInterestBodies.data();
+		auto itemCount = task.getItemCount();
+
+		for (uint32 i = task.getItemOffset(); i < itemCount; i++)
+		{
+			auto rigidbodyView = &componentData[i];
+			auto& interestBody = interestBodies[i];
+			interestBody.entityUID = 0;
+
+			auto entity = rigidbodyView->entity;
+			if (!entity || !rigidbodyView->instance || !rigidbodyView->inSimulation ||
+				rigidbodyView->getMotionType() == MotionType::Static)
+			{
+				continue;
+			}
+
+			auto networkView = manager->tryGet<NetworkComponent>(entity);
+			if (!networkView || !networkView->getEntityUID())
+				continue;
+
+			interestBody.state = quantizeNetBody(rigidbodyView);
+			interestBody.position = (float3)rigidbodyView->getPosition();
+			interestBody.speed = length3(rigidbodyView->getLinearVelocity());
+			interestBody.entityUID = networkView->getEntityUID();
+		}
+	},
+	components.getOccupancy(), ThreadPool::priorityNormal, {}, ThreadPool::defaultGrainSize);
+	threadPool.wait();
+
+	auto interestBodyCount = (uint32)netInterestBodies.size();
+	for (uint32 i = 0; i < interestBodyCount; i++)
+	{
+		const auto& interestBody = netInterestBodies[i];
+		if (interestBody.entityUID)
+			interestGrid.add(interestBody.position, i);
+	}
+	interestGrid.setCellSize(networkCellSize);
+	interestGrid.build();
+
 	threadPool.addItems([this, &sessions](const ThreadPool::Task& task)
 	{
 		auto manager = Manager::Instance::get();
 		auto networkSystem = NetworkSystem::Instance::get();
 		auto streamServer = ServerNetworkSystem::Instance::get()->getStreamHandle();
 		auto lengthSize = streamServer->getServerLengthSize();
-		auto deltaTime = getPhysicsDeltaTime();
+		auto messageID = getMessageID();
+		auto clientStates = netClientStates.data();
+		auto interestBodies = netInterestBodies.data();
 		auto itemCount = task.getItemCount();
 
 		for (uint32 i = task.getItemOffset(); i < itemCount; i++)
 		{
 			auto clientSession = sessions.get(i);
-			if (!clientSession || !clientSession->entityUID)
+			if (!clientSession || !clientSession->entityUID || !clientStates[i])
 				continue;
 
+			// Note: Client without a controlled body has no view, so all its baselines are forgotten.
 			auto entity = networkSystem->findEntity(clientSession->entityUID);
 			if (!entity)
+			{
+				clientStates[i]->baselines.clear();
 				continue;
-
+			}
 			auto rigidbodyView = manager->tryGet<RigidbodyComponent>(entity);
 			if (!rigidbodyView)
-				continue;
-
-			auto sphere = Sphere(networkViewRadius, rigidbodyView->getPosition());
-			collideSphere(sphere, shapeHits, (int8)BroadPhaseLayer::Moving);
-			if (shapeHits.empty())
-				continue;
-
-			for (auto hit : shapeHits)
 			{
-				if (!manager->has<NetworkComponent>(hit.entity))
-					continue;
-				auto rigidbodyView = manager->get<RigidbodyComponent>(hit.entity);
-				if (!rigidbodyView->isActive())
-					continue;
-				rigidbodyViews.push_back(*rigidbodyView);
+				clientStates[i]->baselines.clear();
+				continue;
 			}
-			shapeHits.clear();
 
-			auto rigidbodyCount = (uint32)rigidbodyViews.size();
-			auto messageCount = (uint32)ceil((float)rigidbodyCount / maxRbPerMessage);
-			const auto rigidbodies = rigidbodyViews.data();
+			auto center = (float3)rigidbodyView->getPosition();
+			interestGrid.query(center, networkViewRadius + networkViewMargin, interestItems);
 
-			uint32 index = 0;
-			for (uint32 i = 0; i < messageCount; i++)
-			{
-				auto msgRigidbodyCount = min(rigidbodyCount - i * maxRbPerMessage, maxRbPerMessage);
-				auto messageSize = msgRigidbodyCount * rbTransformSize; // TODO: this goes out of rigidbodyCount range!
-				StreamOutputBuffer<MAX_DATAGRAM_MESSAGE_SIZE> message(messageType, messageSize, lengthSize, true);
-
-				for (uint32 j = 0; j < msgRigidbodyCount; j++)
-					encodeNetRigidbody(manager, rigidbodies[index++], message);
-				streamServer->sendDatagram(clientSession, message);
-			}
-			rigidbodyViews.clear();
+			NetServerSender sender;
+			sender.streamServer = streamServer;
+			sender.clientSession = clientSession;
+			sender.messageID = messageID;
+			sender.lengthSize = lengthSize;
+			sendNetBodies(sender, clientStates[i], interestBodies, center, networkViewRadius, networkBandwidth);
 		}
 	},
-	(uint32)sessions.count());
+	sessionCount);
 	threadPool.wait();
 }
 
@@ -1380,7 +1844,8 @@ void PhysicsSystem::copyComponent(View<Component> source, View<Component> destin
 {
 	const auto sourceView = View<RigidbodyComponent>(source);
 	auto destinationView = View<RigidbodyComponent>(destination);
-	destinationView->inSimulation = sourceView->inSimulation;
+	auto isBatched = isBatchingBodies && sourceView->inSimulation && sourceView->shape;
+	destinationView->inSimulation = isBatched ? false : sourceView->inSimulation;
 
 	auto isActive = sourceView->isActive();
 	auto motionType = sourceView->getMotionType();
@@ -1403,6 +1868,14 @@ void PhysicsSystem::copyComponent(View<Component> source, View<Component> destin
 	destinationView->lastRotation = sourceView->lastRotation;
 	destinationView->eventListener = sourceView->eventListener;
 	destinationView->uid = 0;
+
+	if (isBatched)
+	{
+		// Note: Adding body to the simulation later in endSimulationBatch().
+		if (isActive)
+			batchedActiveBodies.push_back(destinationView->entity);
+		else batchedBodies.push_back(destinationView->entity);
+	}
 }
 string_view PhysicsSystem::getComponentName() const
 {
@@ -1712,6 +2185,73 @@ void PhysicsSystem::deserialize(IDeserializer& deserializer, View<Component> com
 		}
 	}
 }
+void PhysicsSystem::deserializeRecord(const BinarySceneRecord& record, View<Component> component)
+{
+	const auto& rigidbodyRecord = (const BinaryRigidbodyRecord&)record;
+	auto componentView = View<RigidbodyComponent>(component);
+
+	if (rigidbodyRecord.uid)
+	{
+		componentView->uid = rigidbodyRecord.uid;
+		auto result = deserializedEntities.emplace(componentView->uid, componentView->entity);
+		if (!result.second)
+		{
+			GARDEN_LOG_ERROR("Deserialized entity with already existing UID. ("
+				"uid: " + to_string(componentView->uid) + ")");
+		}
+	}
+
+	auto eventListener = rigidbodyRecord.getEventListener();
+	if (!eventListener.empty())
+		componentView->eventListener = eventListener;
+
+	if (rigidbodyRecord.shapeType != BinaryShapeType::None)
+	{
+		auto shape = createSharedBoxShape((f32x4)rigidbodyRecord.halfExtent, rigidbodyRecord.convexRadius);
+		if (rigidbodyRecord.shapeType == BinaryShapeType::RotatedTranslatedBox)
+		{
+			shape = createSharedRotTransShape(shape, (f32x4)rigidbodyRecord.shapePosition, 
+				BinaryScene::toQuat(rigidbodyRecord.shapeRotation));
+		}
+
+		auto flags = rigidbodyRecord.flags;
+		auto isActive = hasAnyFlag(flags, BinaryRigidbodyFlags::IsActive);
+		auto allowDynamicOrKinematic = hasAnyFlag(flags, BinaryRigidbodyFlags::AllowDynamicOrKinematic);
+		componentView->setShape(shape, (MotionType)rigidbodyRecord.motionType, rigidbodyRecord.collisionLayer,
+			isActive, allowDynamicOrKinematic, (AllowedDOF)rigidbodyRecord.allowedDOF);
+
+		if (hasAnyFlag(flags, BinaryRigidbodyFlags::IsSensor))
+			componentView->setSensor(true);
+		if (hasAnyFlag(flags, BinaryRigidbodyFlags::IsKinematicVsStatic))
+			componentView->setKinematicVsStatic(true);
+
+		auto position = (f32x4)rigidbodyRecord.position;
+		auto rotation = BinaryScene::toQuat(rigidbodyRecord.rotation);
+		if (position != f32x4::zero || rotation != quat::identity)
+			componentView->setPosAndRot(position, rotation, isActive);
+
+		auto velocity = (f32x4)rigidbodyRecord.linearVelocity;
+		if (velocity != f32x4::zero)
+			componentView->setLinearVelocity(velocity);
+		velocity = (f32x4)rigidbodyRecord.angularVelocity;
+		if (velocity != f32x4::zero)
+			componentView->setAngularVelocity(velocity);
+	}
+
+	auto constraints = rigidbodyRecord.getConstraints();
+	for (uint32 i = 0; i < rigidbodyRecord.constraintCount; i++)
+	{
+		const auto& constraint = constraints[i];
+		if (constraint.type >= (uint32)ConstraintType::Count)
+			continue;
+
+		EntityConstraint entityConstraint = {};
+		entityConstraint.entity = componentView->entity;
+		entityConstraint.otherUID = constraint.otherUID;
+		entityConstraint.type = (ConstraintType)constraint.type;
+		deserializedConstraints.push_back(entityConstraint);
+	}
+}
 void PhysicsSystem::postDeserialize(IDeserializer& deserializer)
 {
 	auto manager = Manager::Instance::get();
@@ -1737,36 +2277,268 @@ void PhysicsSystem::postDeserialize(IDeserializer& deserializer)
 
 //**********************************************************************************************************************
 string_view PhysicsSystem::getMessageType() { return messageType; }
-int PhysicsSystem::onMsgFromClient(ClientSession* session, StreamInput message) { return BAD_DATA_NETS_RESULT; }
-
-int PhysicsSystem::onMsgFromServer(StreamInput message, bool isDatagram)
+int PhysicsSystem::onMsgFromClient(ClientSession* session, StreamInput message)
 {
 	auto messageSize = message.getLeft();
-	if (!isDatagram || messageSize % rbTransformSize)
+	if (messageSize == 0 || messageSize % sizeof(uint32) || messageSize / sizeof(uint32) > maxAcksPerMessage)
 		return BAD_DATA_NETS_RESULT;
 
-	auto rigidbodyCount = messageSize / rbTransformSize;
-	uint32 entityUID; NetRigidbody netRigidbody;
+	auto ackCount = (uint32)(messageSize / sizeof(uint32));
+	uint32 snapshotID;
 
 	netRigidbodyLocker.lock();
-	for (uint32 i = 0; i < rigidbodyCount; i++)
+	for (uint32 i = 0; i < ackCount; i++)
 	{
-		if (!decodeNetRigidbody(message, entityUID, netRigidbody))
+		if (message.read(snapshotID) || snapshotID == 0)
 		{
 			netRigidbodyLocker.unlock();
 			return BAD_DATA_NETS_RESULT;
 		}
-
-		auto result = netRigidbodies.find(entityUID);
-		if (result == netRigidbodies.end())
-			netRigidbodies.emplace(entityUID, netRigidbody);
-		else result.value() = netRigidbody;
+		netServerAcks.emplace_back(session->datagramUID, snapshotID);
 	}
 	netRigidbodyLocker.unlock();
 
 	return SUCCESS_NETS_RESULT;
 }
 
+int PhysicsSystem::onMsgFromServer(StreamInput message, bool isDatagram)
+{
+	if (!isDatagram)
+		return BAD_DATA_NETS_RESULT;
+
+	netRigidbodyLocker.lock();
+	auto result = receiveNetSnapshot(message, netReceiver);
+	netRigidbodyLocker.unlock();
+	return result;
+}
+
+#if GARDEN_DEBUG || GARDEN_EDITOR
+//**********************************************************************************************************************
+template<typename T>
+struct NetLoopbackChannel final
+{
+	vector<pair<uint32, T>> items;
+	mt19937 randomGenerator;
+	float lossRate = 0.0f;
+	uint32 latencyTicks = 0;
+	uint32 jitterTicks = 0;
+	uint32 lostCount = 0;
+	uint32 tick = 0;
+
+	void push(T&& item)
+	{
+		if (uniform_real_distribution<float>(0.0f, 1.0f)(randomGenerator) < lossRate)
+		{
+			lostCount++;
+			return;
+		}
+
+		auto deliveryTick = tick + latencyTicks;
+		if (jitterTicks > 0)
+			deliveryTick += randomGenerator() % (jitterTicks + 1);
+		items.emplace_back(deliveryTick, std::move(item));
+	}
+	template<typename F>
+	void deliver(F&& onReceive)
+	{
+		for (auto i = items.begin(); i != items.end();)
+		{
+			if (i->first <= tick)
+			{
+				onReceive(i->second);
+				i = items.erase(i);
+			}
+			else i++;
+		}
+	}
+};
+
+struct NetLoopbackSender final
+{
+	NetLoopbackChannel<vector<uint8>>* channel = nullptr;
+	PhysicsSystem::NetLoopbackStats* stats = nullptr;
+	uint16 messageID = 0;
+	uint8 lengthSize = 0;
+
+	void send(const StreamOutput& message) const
+	{
+		auto data = (const uint8*)message.getBuffer() + lengthSize;
+		auto size = message.getSize() - lengthSize;
+		stats->sentBytes += size; stats->sentDatagrams++;
+		channel->push(vector<uint8>(data, data + size));
+	}
+};
+
+PhysicsSystem::NetLoopbackStats PhysicsSystem::runNetLoopback(const NetLoopbackProperties& properties)
+{
+	GARDEN_ASSERT(properties.bodyCount > 0);
+	SET_CPU_ZONE_SCOPED("Net Loopback Run");
+
+	NetLoopbackStats stats;
+	mt19937 randomGenerator(properties.seed);
+	uniform_real_distribution<float> unitDistribution(-1.0f, 1.0f), rateDistribution(0.0f, 1.0f);
+
+	NetLoopbackChannel<vector<uint8>> serverChannel; NetLoopbackChannel<uint32> clientChannel;
+	serverChannel.randomGenerator = mt19937(properties.seed + 1);
+	clientChannel.randomGenerator = mt19937(properties.seed + 2);
+	serverChannel.lossRate = clientChannel.lossRate = properties.lossRate;
+	serverChannel.latencyTicks = clientChannel.latencyTicks = properties.latencyTicks;
+	serverChannel.jitterTicks = clientChannel.jitterTicks = properties.jitterTicks;
+
+	NetLoopbackSender sender;
+	sender.channel = &serverChannel;
+	sender.stats = &stats;
+	sender.messageID = NetMessageID::reservedCount;
+	sender.lengthSize = sizeof(uint32);
+
+	NetClientState clientState;
+	clientState.snapshots.resize(netSnapshotHistory);
+	NetReceiver receiver;
+
+	vector<NetInterestBody> bodies(properties.bodyCount);
+	vector<f32x4> velocities(properties.bodyCount, f32x4::zero);
+	for (uint32 i = 0; i < properties.bodyCount; i++)
+	{
+		auto& body = bodies[i];
+		body.entityUID = i + 1;
+		body.position = (float3)(f32x4(unitDistribution(randomGenerator), unitDistribution(randomGenerator),
+			unitDistribution(randomGenerator)) * (networkViewRadius * 0.5f));
+		if (rateDistribution(randomGenerator) >= properties.restRate)
+		{
+			velocities[i] = f32x4(unitDistribution(randomGenerator), unitDistribution(randomGenerator),
+				unitDistribution(randomGenerator)) * 10.0f;
+		}
+	}
+
+	auto deltaTime = 1.0f / (float)simulationRate;
+	auto queryRadius = networkViewRadius + networkViewMargin;
+	auto leaveTick = properties.tickCount / 2;
+	auto maxTickCount = properties.tickCount + netSnapshotHistory * 16;
+	uint32 tick = 0;
+
+	while (tick < maxTickCount)
+	{
+		auto isDraining = tick >= properties.tickCount;
+		if (isDraining)
+			serverChannel.lossRate = clientChannel.lossRate = 0.0f;
+
+		uint32 visibleCount = 0;
+		for (uint32 i = 0; i < properties.bodyCount; i++)
+		{
+			auto& body = bodies[i];
+			auto velocity = isDraining ? f32x4::zero : velocities[i];
+			auto speed = length3(velocity);
+
+			// Note: Moving half of the bodies out of the view to check baseline and history pruning.
+			if (tick == leaveTick && i % 2 == 1)
+				body.position.x += queryRadius * 4.0f;
+			auto position = (f32x4)body.position + velocity * deltaTime;
+			auto rotation = fromEulerAngles(f32x4(0.0f, (float)tick * deltaTime * speed * 0.1f, 0.0f));
+
+			body.state = quantizeNetBody(position, rotation, velocity, f32x4::zero);
+			body.position = (float3)position;
+			body.speed = speed;
+
+			auto distance = length3(position);
+			if (distance <= queryRadius)
+			{
+				InterestGrid::Item item;
+				item.position = body.position;
+				item.index = i;
+				interestItems.push_back(item);
+			}
+			if (distance <= networkViewRadius)
+				visibleCount++;
+		}
+		stats.fullStateBytes += (uint64)visibleCount * getNetBodySize(NetBodyField::All);
+
+		serverChannel.tick = clientChannel.tick = tick;
+		clientChannel.deliver([&](uint32 snapshotID)
+		{
+			applyNetAck(clientState, snapshotID);
+			stats.ackCount++;
+		});
+
+		auto sentDatagrams = stats.sentDatagrams;
+		sendNetBodies(sender, &clientState, bodies.data(), float3::zero, networkViewRadius, networkBandwidth);
+
+		serverChannel.deliver([&](const vector<uint8>& data)
+		{
+			::StreamMessage streamMessage;
+			streamMessage.iter = (uint8*)data.data();
+			streamMessage.end = streamMessage.iter + data.size();
+			StreamInput message(streamMessage); uint16 messageID;
+			if (message.readMessageID(messageID) || messageID != sender.messageID)
+			{
+				stats.badDataCount++;
+				return;
+			}
+
+			auto snapshotMessage = message; uint32 snapshotID;
+			if (!snapshotMessage.read(snapshotID) && snapshotID < receiver.lastSnapshotID)
+				stats.reorderedCount++;
+			if (receiveNetSnapshot(message, receiver) != SUCCESS_NETS_RESULT)
+				stats.badDataCount++;
+		});
+
+		// Note: Pending body state should be the newest received one, even if datagrams were reordered.
+		for (const auto& pair : receiver.rigidbodies)
+		{
+			auto searchResult = receiver.histories.find(pair.first);
+			if (searchResult == receiver.histories.end())
+			{
+				stats.staleCount++;
+				continue;
+			}
+
+			const auto& history = searchResult->second;
+			NetRigidbody newestRigidbody;
+			if (!dequantizeNetBody(history.states[history.lastSnapshotID % netBodyHistory], newestRigidbody) ||
+				memcmp(&pair.second.rotation, &newestRigidbody.rotation, sizeof(quat)) != 0 ||
+				memcmp(&pair.second.position, &newestRigidbody.position, sizeof(float3) * 3) != 0)
+			{
+				stats.staleCount++;
+			}
+		}
+		for (auto ack : receiver.acks)
+			clientChannel.push(std::move(ack));
+		receiver.acks.clear();
+		receiver.rigidbodies.clear();
+		tick++;
+
+		if (isDraining && serverChannel.items.empty() && 
+			clientChannel.items.empty() && stats.sentDatagrams == sentDatagrams)
+		{
+			break;
+		}
+	}
+
+	for (const auto& body : bodies)
+	{
+		if (length3((f32x4)body.position) > networkViewRadius)
+			continue;
+		stats.visibleCount++;
+
+		auto searchResult = receiver.histories.find(body.entityUID);
+		if (searchResult == receiver.histories.end())
+		{
+			stats.mismatchCount++;
+			continue;
+		}
+
+		const auto& history = searchResult->second;
+		auto historyIndex = history.lastSnapshotID % netBodyHistory;
+		if (getNetBodyDelta(body.state, history.states[historyIndex]) != NetBodyField::None)
+			stats.mismatchCount++;
+	}
+
+	stats.lostDatagrams = serverChannel.lostCount + clientChannel.lostCount;
+	stats.baselineCount = (uint32)clientState.baselines.size();
+	stats.historyCount = (uint32)receiver.histories.size();
+	return stats;
+}
+#endif
+
 //**********************************************************************************************************************
 f32x4 PhysicsSystem::getGravity() const noexcept
 {
@@ -2316,6 +3088,55 @@ void PhysicsSystem::setWorldTransformRecursive(ID<Entity> entity, bool activate)
 	}
 }
 
+//**********************************************************************************************************************
+void PhysicsSystem::beginSimulationBatch()
+{
+	GARDEN_ASSERT_MSG(!isBatchingBodies, "Simulation batch is already started");
+	isBatchingBodies = true;
+}
+void PhysicsSystem::endSimulationBatch()
+{
+	GARDEN_ASSERT_MSG(isBatchingBodies, "Simulation batch is not started");
+	isBatchingBodies = false;
+
+	if (batchedBodies.empty() && batchedActiveBodies.empty())
+		return;
+
+	auto manager = Manager::Instance::get();
+	auto bodyInterface = (JPH::BodyInterface*)this->bodyInterface;
+	vector<JPH::BodyID> bodyIDs;
+
+	for (uint8 i = 0; i < 2; i++)
+	{
+		auto& entities = i == 0 ? batchedBodies : batchedActiveBodies;
+		if (entities.empty())
+			continue;
+
+		bodyIDs.clear();
+		bodyIDs.reserve(entities.size());
+
+		for (auto entity : entities)
+		{
+			// Note: Rigidbody can be destroyed or changed before the batch end.
+			auto rigidbodyView = manager->tryGet<RigidbodyComponent>(entity);
+			if (!rigidbodyView || !rigidbodyView->instance || rigidbodyView->inSimulation)
+				continue;
+
+			bodyIDs.push_back(((JPH::Body*)rigidbodyView->instance)->GetID());
+			rigidbodyView->inSimulation = true;
+		}
+		entities.clear();
+
+		if (bodyIDs.empty())
+			continue;
+
+		auto bodyCount = (int)bodyIDs.size();
+		auto addState = bodyInterface->AddBodiesPrepare(bodyIDs.data(), bodyCount);
+		bodyInterface->AddBodiesFinalize(bodyIDs.data(), bodyCount, addState, 
+			i == 0 ? JPH::EActivation::DontActivate : JPH::EActivation::Activate);
+	}
+}
+
 //**********************************************************************************************************************
 void PhysicsSystem::enableCollision(uint16 collisionLayer1, uint16 collisionLayer2)
 {
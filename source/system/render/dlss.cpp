@@ -314,6 +314,8 @@ void DlssRenderSystem::preInit()
 		ngxResult = NVSDK_NGX_VULKAN_GetFeatureRequirements(vulkanAPI->instance, 
 			vulkanAPI->physicalDevice, &discoveryInfo, &featureRequirement);
 	}
+	else if (graphicsBackend == GraphicsBackend::NullAPI)
+		return; // Note: DLSS requires a GPU device.
 	else abort();
 
 	if (ngxResult != NVSDK_NGX_Result_Success)
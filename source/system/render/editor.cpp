@@ -1245,8 +1245,8 @@ void EditorRenderSystem::drawModelSelector(const char* name, fs::path& path, Ref
 				path = selectedFile;
 				path.replace_extension();
 
-				abort();
-				// TODO: resourceSystem->loadModel(path, );
+				resourceSystem->loadModel(path, vertexBuffer, indexBuffer, 
+					Buffer::Strategy::Default, BufferLoadFlags::LoadShared);
 			},
 			AppInfoSystem::Instance::get()->getResourcesPath() / "models", ResourceSystem::modelFileExts);
 		}
@@ -19,7 +19,13 @@
 #include "garden/system/transform.hpp"
 #include "garden/system/thread.hpp"
 #include "garden/profiler.hpp"
+#include "garden/simd.hpp"
 #include "math/matrix/projection.hpp"
+#include <algorithm>
+
+#if GARDEN_SIMD_AVX2 || GARDEN_SIMD_SSE2
+#include <immintrin.h>
+#endif
 
 #if GARDEN_EDITOR
 #include "garden/editor/system/graphics.hpp"
@@ -108,233 +114,1341 @@ void MeshRenderSystem::prepareSystems()
 }
 
 //**********************************************************************************************************************
-static void prepareUnsortedMeshes(f32x4 cameraOffset, f32x4 cameraPosition, const Frustum& frustum, 
-	MeshRenderSystem::UnsortedBuffer* unsortedBuffer, uint32 itemOffset, uint32 itemCount, uint32 threadIndex, 
-	int8 shadowPass, bool useThreading)
+static constexpr uint8 depthKeyBits = 24;
+static constexpr uint8 radixBits = 8;
+static constexpr uint32 radixSize = 1u << radixBits;
+static constexpr uint32 radixMask = radixSize - 1;
+static constexpr uint8 unsortedPassCount = (depthKeyBits + 32) / radixBits;
+static constexpr uint8 sortedPassCount = depthKeyBits / radixBits;
+static constexpr uint8 maxRadixPassCount = unsortedPassCount;
+static constexpr uint32 parallelSortThreshold = 16384;
+static constexpr uint32 minSortBlockSize = 4096;
+
+static uint32 calcDepthKey(float distance) noexcept
 {
-	SET_CPU_ZONE_SCOPED("Unsorted Meshes Prepare");
+	uint32 bits; memcpy(&bits, &distance, sizeof(uint32));
+	bits ^= (uint32)((int32)bits >> 31) | 0x80000000u; // Note: Makes float bits sortable as unsigned integer.
+	return bits >> (32 - depthKeyBits);
+}
+
+//**********************************************************************************************************************
+static f32x4x4 calcUiProjView() noexcept
+{
+	auto halfSize = float2(0.5f);
+	auto uiTransformSystem = UiTransformSystem::Instance::tryGet();
+	if (uiTransformSystem)
+		halfSize *= uiTransformSystem->getUiSize();
+	return (f32x4x4)calcOrthoProjRevZ(float2(-halfSize.x, halfSize.x), 
+		float2(-halfSize.y, halfSize.y), float2(-1.0f, 1.0f));
+}
+
+static void calcFrustumPlanes(const f32x4x4& viewProj, f32x4* planes) noexcept
+{
+	auto r0 = f32x4(viewProj.c0.getX(), viewProj.c1.getX(), viewProj.c2.getX(), viewProj.c3.getX());
+	auto r1 = f32x4(viewProj.c0.getY(), viewProj.c1.getY(), viewProj.c2.getY(), viewProj.c3.getY());
+	auto r2 = f32x4(viewProj.c0.getZ(), viewProj.c1.getZ(), viewProj.c2.getZ(), viewProj.c3.getZ());
+	auto r3 = f32x4(viewProj.c0.getW(), viewProj.c1.getW(), viewProj.c2.getW(), viewProj.c3.getW());
+	planes[0] = r3 + r0; planes[1] = r3 - r0;
+	planes[2] = r3 + r1; planes[3] = r3 - r1;
+	planes[4] = r2; planes[5] = r3 - r2; // Note: Clip space depth range is [0, w].
+}
+
+//**********************************************************************************************************************
+static void calcWorldBounds(const Aabb& aabb, const f32x4x4& model, f32x4& center, f32x4& extent) noexcept
+{
+	auto aabbSize = aabb.getSize(); aabbSize.fixW();
+	auto localCenter = aabb.getMin() + aabbSize * 0.5f; localCenter.setW(1.0f);
+	auto localExtent = aabbSize * 0.5f;
+	center = model * localCenter;
+	extent = abs(model.c0) * localExtent.getX() + abs(model.c1) * 
+		localExtent.getY() + abs(model.c2) * localExtent.getZ();
+}
+static bool isValidAabb(const Aabb& aabb) noexcept
+{
+	auto aabbSize = aabb.getSize(); aabbSize.fixW();
+	return !areAllTrue(aabbSize <= f32x4::zero);
+}
+
+/**
+ * @brief Returns mesh entity transform, cached component pool item is validated by the entity.
+ */
+static TransformComponent* getMeshTransform(Manager* manager, const MeshRenderComponent* meshRenderView, 
+	MeshRenderSystem::CullingData& culling, uint32 item, TransformComponent* transformData, 
+	uint32 transformOccupancy, bool& isCached)
+{
+	auto entity = meshRenderView->getEntity();
+	auto transformItem = culling.transformItems[item];
+	if (culling.entities[item] == entity && transformItem < transformOccupancy && 
+		transformData[transformItem].getEntity() == entity)
+	{
+		isCached = true;
+		return &transformData[transformItem];
+	}
+
+	auto transformView = manager->tryGet<TransformComponent>(entity);
+	if (!transformView)
+	{
+		culling.entities[item] = {};
+		return nullptr;
+	}
+
+	TransformComponent* transformComponent = *transformView;
+	culling.entities[item] = entity;
+	culling.transformItems[item] = (uint32)(transformComponent - transformData);
+	isCached = false;
+	return transformComponent;
+}
+static void resizeCullingData(MeshRenderSystem::CullingData& culling, uint32 count)
+{
+	if (culling.viewMasks.size() >= count)
+		return;
+	culling.centerX.resize(count); culling.centerY.resize(count); culling.centerZ.resize(count);
+	culling.extentX.resize(count); culling.extentY.resize(count); culling.extentZ.resize(count);
+	culling.aabbs.resize(count); culling.entities.resize(count); culling.modelStamps.resize(count);
+	culling.transformItems.resize(count, UINT32_MAX);
+	culling.viewMasks.resize(count); culling.models.resize(count);
+	culling.drawMasks.resize(count, UINT32_MAX); // Note: Forces new items component update.
+}
+
+//**********************************************************************************************************************
+/**
+ * @brief Tests world space bounds against the view frustum planes and clears culled item view bits.
+ * @details Items array maps culled slots to the component pool items. (Null = identity)
+ */
+static void cullAabbs(const f32x4* planes, MeshRenderSystem::CullingData& culling, 
+	uint32 viewBit, const uint32* items, uint32 itemOffset, uint32 itemCount) noexcept
+{
+	// Note: Planes are not normalized, it doesn't affect the test sign.
+	float nx[6], ny[6], nz[6], nw[6], ax[6], ay[6], az[6];
+	for (uint8 p = 0; p < 6; p++)
+	{
+		auto plane = planes[p];
+		nx[p] = plane.getX(); ny[p] = plane.getY(); nz[p] = plane.getZ(); nw[p] = plane.getW();
+		ax[p] = std::abs(nx[p]); ay[p] = std::abs(ny[p]); az[p] = std::abs(nz[p]);
+	}
+
+	const auto centerX = culling.centerX.data(), centerY = culling.centerY.data(), centerZ = culling.centerZ.data();
+	const auto extentX = culling.extentX.data(), extentY = culling.extentY.data(), extentZ = culling.extentZ.data();
+	auto viewMasks = culling.viewMasks.data();
+	auto k = itemOffset;
+
+	#if GARDEN_SIMD_AVX2
+	__m256 pnx[6], pny[6], pnz[6], pnw[6], pax[6], pay[6], paz[6];
+	for (uint8 p = 0; p < 6; p++)
+	{
+		pnx[p] = _mm256_set1_ps(nx[p]); pny[p] = _mm256_set1_ps(ny[p]); 
+		pnz[p] = _mm256_set1_ps(nz[p]); pnw[p] = _mm256_set1_ps(nw[p]);
+		pax[p] = _mm256_set1_ps(ax[p]); pay[p] = _mm256_set1_ps(ay[p]); paz[p] = _mm256_set1_ps(az[p]);
+	}
+
+	auto zero = _mm256_setzero_ps();
+	for (; k + 8 <= itemCount; k += 8)
+	{
+		__m256 cx, cy, cz, ex, ey, ez;
+		if (items)
+		{
+			auto indices = _mm256_loadu_si256((const __m256i*)(items + k));
+			cx = _mm256_i32gather_ps(centerX, indices, 4); cy = _mm256_i32gather_ps(centerY, indices, 4);
+			cz = _mm256_i32gather_ps(centerZ, indices, 4); ex = _mm256_i32gather_ps(extentX, indices, 4);
+			ey = _mm256_i32gather_ps(extentY, indices, 4); ez = _mm256_i32gather_ps(extentZ, indices, 4);
+		}
+		else
+		{
+			cx = _mm256_loadu_ps(centerX + k); cy = _mm256_loadu_ps(centerY + k); cz = _mm256_loadu_ps(centerZ + k);
+			ex = _mm256_loadu_ps(extentX + k); ey = _mm256_loadu_ps(extentY + k); ez = _mm256_loadu_ps(extentZ + k);
+		}
+		auto outside = zero;
+
+		for (uint8 p = 0; p < 6; p++)
+		{
+			auto distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pnx[p], cx), _mm256_mul_ps(pny[p], cy)), 
+				_mm256_add_ps(_mm256_mul_ps(pnz[p], cz), pnw[p]));
+			auto radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pax[p], ex), 
+				_mm256_mul_ps(pay[p], ey)), _mm256_mul_ps(paz[p], ez));
+			outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_LT_OQ));
+		}
+
+		auto outsideBits = (uint32)_mm256_movemask_ps(outside);
+		if (outsideBits == 0)
+			continue;
+
+		for (uint32 j = 0; j < 8; j++)
+		{
+			if (outsideBits & (1u << j))
+				viewMasks[items ? items[k + j] : k + j] &= ~viewBit;
+		}
+	}
+	#elif GARDEN_SIMD_SSE2
+	__m128 pnx[6], pny[6], pnz[6], pnw[6], pax[6], pay[6], paz[6];
+	for (uint8 p = 0; p < 6; p++)
+	{
+		pnx[p] = _mm_set1_ps(nx[p]); pny[p] = _mm_set1_ps(ny[p]); 
+		pnz[p] = _mm_set1_ps(nz[p]); pnw[p] = _mm_set1_ps(nw[p]);
+		pax[p] = _mm_set1_ps(ax[p]); pay[p] = _mm_set1_ps(ay[p]); paz[p] = _mm_set1_ps(az[p]);
+	}
+
+	auto zero = _mm_setzero_ps();
+	for (; k + 4 <= itemCount; k += 4)
+	{
+		__m128 cx, cy, cz, ex, ey, ez;
+		if (items) // Note: SSE2 has no gather instruction.
+		{
+			auto i0 = items[k], i1 = items[k + 1], i2 = items[k + 2], i3 = items[k + 3];
+			cx = _mm_setr_ps(centerX[i0], centerX[i1], centerX[i2], centerX[i3]);
+			cy = _mm_setr_ps(centerY[i0], centerY[i1], centerY[i2], centerY[i3]);
+			cz = _mm_setr_ps(centerZ[i0], centerZ[i1], centerZ[i2], centerZ[i3]);
+			ex = _mm_setr_ps(extentX[i0], extentX[i1], extentX[i2], extentX[i3]);
+			ey = _mm_setr_ps(extentY[i0], extentY[i1], extentY[i2], extentY[i3]);
+			ez = _mm_setr_ps(extentZ[i0], extentZ[i1], extentZ[i2], extentZ[i3]);
+		}
+		else
+		{
+			cx = _mm_loadu_ps(centerX + k); cy = _mm_loadu_ps(centerY + k); cz = _mm_loadu_ps(centerZ + k);
+			ex = _mm_loadu_ps(extentX + k); ey = _mm_loadu_ps(extentY + k); ez = _mm_loadu_ps(extentZ + k);
+		}
+		auto outside = zero;
+
+		for (uint8 p = 0; p < 6; p++)
+		{
+			auto distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pnx[p], cx), _mm_mul_ps(pny[p], cy)), 
+				_mm_add_ps(_mm_mul_ps(pnz[p], cz), pnw[p]));
+			auto radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pax[p], ex), 
+				_mm_mul_ps(pay[p], ey)), _mm_mul_ps(paz[p], ez));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+		}
+
+		auto outsideBits = (uint32)_mm_movemask_ps(outside);
+		if (outsideBits == 0)
+			continue;
+
+		for (uint32 j = 0; j < 4; j++)
+		{
+			if (outsideBits & (1u << j))
+				viewMasks[items ? items[k + j] : k + j] &= ~viewBit;
+		}
+	}
+	#endif
+
+	for (; k < itemCount; k++)
+	{
+		auto i = items ? items[k] : k;
+		if (!(viewMasks[i] & viewBit))
+			continue;
+
+		for (uint8 p = 0; p < 6; p++)
+		{
+			auto distance = nx[p] * centerX[i] + ny[p] * centerY[i] + nz[p] * centerZ[i] + nw[p];
+			auto radius = ax[p] * extentX[i] + ay[p] * extentY[i] + az[p] * extentZ[i];
+			if (distance + radius < 0.0f)
+			{
+				viewMasks[i] &= ~viewBit;
+				break;
+			}
+		}
+	}
+}
+
+//**********************************************************************************************************************
+/**
+ * @brief Culls meshes linearly. Items array maps culled slots to the component pool items. (Null = identity)
+ * 
+ * @details
+ * World space bounds are persistent and updated only for the changed meshes, so that still scenes skip the 
+ * per-item matrix multiplication. Camera relative model matrices are calculated only for the visible meshes.
+ */
+static void cullMeshes(MeshRenderSystem::MeshView* const* views, uint32 viewCount, const f32x4* uiPlanes, 
+	f32x4 cameraPosition, MeshRenderSystem::MeshBuffer* meshBuffer, const uint32* items, 
+	uint32 itemOffset, uint32 itemCount)
+{
+	SET_CPU_ZONE_SCOPED("Meshes Cull");
+
+	auto manager = Manager::Instance::get();
+	auto meshSystem = meshBuffer->meshSystem;
+	auto componentSize = meshSystem->getMeshComponentSize();
+	auto componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
+	const auto& transformComponents = TransformSystem::Instance::get()->getComponents();
+	auto transformData = (TransformComponent*)transformComponents.getData();
+	auto transformOccupancy = transformComponents.getOccupancy();
+	auto bufferViewMask = meshBuffer->viewMask;
+	auto& culling = meshBuffer->culling;
+
+	for (uint32 k = itemOffset; k < itemCount; k++)
+	{
+		auto i = items ? items[k] : k;
+		auto meshRenderView = (MeshRenderComponent*)(componentData + i * componentSize);
+		if (!meshRenderView->getEntity() || !meshRenderView->isEnabled || !isValidAabb(meshRenderView->aabb))
+		{
+			culling.viewMasks[i] = 0;
+			continue;
+		}
+
+		bool isCached;
+		auto transformView = getMeshTransform(manager, meshRenderView, 
+			culling, i, transformData, transformOccupancy, isCached);
+		if (!transformView || !transformView->isActive())
+		{
+			culling.viewMasks[i] = 0;
+			continue;
+		}
+
+		const auto& aabb = meshRenderView->aabb;
+		if (!isCached || transformView->isModelDirty() || culling.modelStamps[i] != 
+			transformView->getModelStamp() || memcmp(&culling.aabbs[i], &aabb, sizeof(Aabb)) != 0)
+		{
+			f32x4 center, extent;
+			calcWorldBounds(aabb, transformView->calcModel(), center, extent);
+			culling.centerX[i] = center.getX(); culling.centerY[i] = center.getY(); culling.centerZ[i] = center.getZ();
+			culling.extentX[i] = extent.getX(); culling.extentY[i] = extent.getY(); culling.extentZ[i] = extent.getZ();
+			culling.modelStamps[i] = transformView->getModelStamp();
+			culling.aabbs[i] = aabb;
+		}
+		culling.viewMasks[i] = bufferViewMask;
+
+		if (meshBuffer->collectOccluders && meshRenderView->isOccluder)
+			meshBuffer->occluders[meshBuffer->occluderCount.fetch_add(1)] = i;
+	}
+
+	if (uiPlanes)
+	{
+		cullAabbs(uiPlanes, culling, 1u, items, itemOffset, itemCount);
+	}
+	else
+	{
+		for (uint32 i = 0; i < viewCount; i++)
+		{
+			auto viewBit = 1u << i;
+			if (bufferViewMask & viewBit)
+				cullAabbs(views[i]->worldPlanes, culling, viewBit, items, itemOffset, itemCount);
+		}
+	}
+
+	for (uint32 k = itemOffset; k < itemCount; k++)
+	{
+		auto i = items ? items[k] : k;
+		if (culling.viewMasks[i] == 0)
+			continue;
+		auto transformView = &transformData[culling.transformItems[i]];
+		culling.models[i] = (float4x3)transformView->calcModel(cameraPosition);
+	}
+}
+
+//**********************************************************************************************************************
+static constexpr uint8 staticTaskDepth = 5;
+static constexpr uint8 staticStackSize = 64;
+
+struct StaticBuildItem final
+{
+	f32x4 min = f32x4::zero;
+	f32x4 max = f32x4::zero;
+	f32x4 center = f32x4::zero;
+	uint32 item = 0;
+	ID<Entity> entity = {};
+};
+
+static float getAxis(f32x4 value, uint8 axis) noexcept
+{
+	return axis == 0 ? value.getX() : (axis == 1 ? value.getY() : value.getZ());
+}
+static bool isStaticMesh(Manager* manager, MeshRenderComponent* meshRenderView)
+{
+	auto entity = meshRenderView->getEntity();
+	return manager->has<StaticTransformComponent>(entity) && 
+		manager->has<TransformComponent>(entity) && isValidAabb(meshRenderView->aabb);
+}
+
+static void buildStaticTree(MeshRenderSystem::StaticTree& staticTree, vector<StaticBuildItem>& buildItems)
+{
+	struct BuildRange final { uint32 nodeIndex, begin, end, depth; };
+
+	auto& nodes = staticTree.nodes;
+	auto itemCount = (uint32)buildItems.size();
+	nodes.clear(); staticTree.taskNodes.clear();
+	staticTree.items.resize(itemCount); staticTree.entities.resize(itemCount);
+	if (itemCount == 0)
+		return;
+
+	nodes.reserve(itemCount * 2 - 1);
+	nodes.emplace_back();
+	vector<BuildRange> ranges = { { 0, 0, itemCount, 0 } };
+
+	while (!ranges.empty())
+	{
+		auto range = ranges.back(); ranges.pop_back();
+		auto boundsMin = buildItems[range.begin].min, boundsMax = buildItems[range.begin].max;
+		auto centerMin = buildItems[range.begin].center, centerMax = centerMin;
+		for (uint32 i = range.begin + 1; i < range.end; i++)
+		{
+			const auto& buildItem = buildItems[i];
+			boundsMin = min(boundsMin, buildItem.min); boundsMax = max(boundsMax, buildItem.max);
+			centerMin = min(centerMin, buildItem.center); centerMax = max(centerMax, buildItem.center);
+		}
+
+		auto& node = nodes[range.nodeIndex];
+		node.min = (float3)boundsMin; node.max = (float3)boundsMax;
+
+		if (range.end - range.begin == 1)
+		{
+			node.offset = range.begin; node.count = 1;
+			if (range.depth <= staticTaskDepth)
+				staticTree.taskNodes.push_back(range.nodeIndex);
+			continue;
+		}
+		if (range.depth == staticTaskDepth)
+			staticTree.taskNodes.push_back(range.nodeIndex);
+
+		// Note: Median split along the longest centroid axis, keeps tree balanced.
+		auto centerSize = centerMax - centerMin; uint8 axis = 0;
+		if (centerSize.getY() > centerSize.getX())
+			axis = 1;
+		if (centerSize.getZ() > (axis == 0 ? centerSize.getX() : centerSize.getY()))
+			axis = 2;
+
+		auto middle = range.begin + (range.end - range.begin) / 2;
+		std::nth_element(buildItems.begin() + range.begin, buildItems.begin() + middle, 
+			buildItems.begin() + range.end, [axis](const StaticBuildItem& a, const StaticBuildItem& b)
+		{
+			return getAxis(a.center, axis) < getAxis(b.center, axis);
+		});
+
+		auto childIndex = (uint32)nodes.size();
+		node.offset = childIndex; node.count = 0;
+		nodes.emplace_back(); nodes.emplace_back(); // Note: Invalidates node reference.
+		ranges.push_back({ childIndex, range.begin, middle, range.depth + 1 });
+		ranges.push_back({ childIndex + 1, middle, range.end, range.depth + 1 });
+	}
+
+	for (uint32 i = 0; i < itemCount; i++)
+	{
+		staticTree.items[i] = buildItems[i].item;
+		staticTree.entities[i] = buildItems[i].entity;
+	}
+}
+
+//**********************************************************************************************************************
+static void updateStaticTree(Manager* manager, MeshRenderSystem::MeshBuffer* meshBuffer, uint64 staticVersion)
+{
+	auto meshSystem = meshBuffer->meshSystem;
+	const auto& componentPool = meshSystem->getMeshComponentPool();
+	auto componentCount = componentPool.getCount(), occupancy = componentPool.getOccupancy();
+	auto& staticTree = meshBuffer->staticTree;
+
+	auto isRebuild = staticTree.isDirty.load() || staticTree.meshSystem != meshSystem || 
+		staticTree.staticVersion != staticVersion;
+	if (!isRebuild && staticTree.componentCount == componentCount && staticTree.occupancy == occupancy)
+		return;
+
+	SET_CPU_ZONE_SCOPED("Static Meshes Update");
+
+	staticTree.meshSystem = meshSystem;
+	staticTree.staticVersion = staticVersion;
+	staticTree.componentCount = componentCount;
+	staticTree.occupancy = occupancy;
+	staticTree.isDirty.store(false);
+	staticTree.dynamicItems.clear();
+
+	auto componentSize = meshSystem->getMeshComponentSize();
+	auto componentData = (uint8*)componentPool.getData();
+	uint32 staticCount = 0;
+
+	for (uint32 i = 0; i < occupancy; i++)
+	{
+		auto meshRenderView = (MeshRenderComponent*)(componentData + i * componentSize);
+		if (!meshRenderView->getEntity())
+			continue; // Note: Skipping free pool items.
+
+		if (isStaticMesh(manager, meshRenderView))
+			staticCount++;
+		else staticTree.dynamicItems.push_back(i);
+	}
+
+	// Note: Changed static items are also detected during traversal using entity IDs.
+	if (!isRebuild && staticCount == staticTree.items.size())
+		return;
+
+	SET_CPU_ZONE_SCOPED("Static Meshes Build");
+
+	vector<StaticBuildItem> buildItems(staticCount); uint32 buildIndex = 0;
+	for (uint32 i = 0; i < occupancy; i++)
+	{
+		auto meshRenderView = (MeshRenderComponent*)(componentData + i * componentSize);
+		if (!meshRenderView->getEntity() || !isStaticMesh(manager, meshRenderView))
+			continue;
+
+		auto transformView = manager->get<TransformComponent>(meshRenderView->getEntity());
+		f32x4 center, extent;
+		calcWorldBounds(meshRenderView->aabb, transformView->calcModel(), center, extent);
+
+		auto& buildItem = buildItems[buildIndex++];
+		buildItem.min = center - extent; buildItem.max = center + extent; buildItem.center = center;
+		buildItem.item = i; buildItem.entity = meshRenderView->getEntity();
+	}
+
+	buildStaticTree(staticTree, buildItems);
+}
+
+//**********************************************************************************************************************
+static bool cullStaticNode(const f32x4* planes, const float3& center, const float3& extent, bool& isInside) noexcept
+{
+	isInside = true;
+	for (uint8 p = 0; p < 6; p++)
+	{
+		auto plane = planes[p];
+		auto distance = plane.getX() * center.x + plane.getY() * center.y + plane.getZ() * center.z + plane.getW();
+		auto radius = std::abs(plane.getX()) * extent.x + 
+			std::abs(plane.getY()) * extent.y + std::abs(plane.getZ()) * extent.z;
+		if (distance + radius < 0.0f)
+			return false;
+		if (distance - radius < 0.0f)
+			isInside = false;
+	}
+	return true;
+}
+
+static void cullStaticMeshes(MeshRenderSystem::MeshView* const* views, uint32 viewCount, 
+	f32x4 cameraPosition, MeshRenderSystem::MeshBuffer* meshBuffer, uint32 taskOffset, uint32 taskCount)
+{
+	SET_CPU_ZONE_SCOPED("Static Meshes Cull");
+
+	struct StackItem final { uint32 nodeIndex, visibleMask, insideMask; };
 
 	auto manager = Manager::Instance::get();
+	auto meshSystem = meshBuffer->meshSystem;
+	auto componentSize = meshSystem->getMeshComponentSize();
+	auto componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
+	auto& staticTree = meshBuffer->staticTree;
+	auto& culling = meshBuffer->culling;
+	const auto nodes = staticTree.nodes.data();
+	StackItem stack[staticStackSize];
+
+	for (uint32 t = taskOffset; t < taskCount; t++)
+	{
+		stack[0] = { staticTree.taskNodes[t], meshBuffer->viewMask, 0 };
+		uint32 stackSize = 1;
+
+		while (stackSize > 0)
+		{
+			auto stackItem = stack[--stackSize];
+			const auto& node = nodes[stackItem.nodeIndex];
+			auto visibleMask = stackItem.visibleMask, insideMask = stackItem.insideMask;
+			auto center = (node.max + node.min) * 0.5f, extent = (node.max - node.min) * 0.5f;
+
+			// Note: Views which fully contain parent node are not tested again.
+			for (uint32 i = 0; i < viewCount; i++)
+			{
+				auto viewBit = 1u << i;
+				if (!(visibleMask & viewBit) || (insideMask & viewBit))
+					continue;
+
+				bool isInside;
+				if (!cullStaticNode(views[i]->worldPlanes, center, extent, isInside))
+					visibleMask &= ~viewBit;
+				else if (isInside)
+					insideMask |= viewBit;
+			}
+
+			if (visibleMask == 0)
+				continue;
+
+			if (node.count == 0)
+			{
+				GARDEN_ASSERT(stackSize + 2 <= staticStackSize);
+				stack[stackSize++] = { node.offset, visibleMask, insideMask };
+				stack[stackSize++] = { node.offset + 1, visibleMask, insideMask };
+				continue;
+			}
+
+			for (uint32 j = node.offset; j < node.offset + node.count; j++)
+			{
+				auto i = staticTree.items[j];
+				auto meshRenderView = (MeshRenderComponent*)(componentData + i * componentSize);
+				if (meshRenderView->getEntity() != staticTree.entities[j])
+				{
+					staticTree.isDirty.store(true); // Note: Pool item has been reused, rebuilding next frame.
+					continue;
+				}
+				if (!meshRenderView->isEnabled)
+					continue;
+
+				auto transformView = manager->tryGet<TransformComponent>(meshRenderView->getEntity());
+				if (!transformView || !transformView->isActive())
+					continue;
+
+				culling.models[i] = (float4x3)transformView->calcModel(cameraPosition);
+				culling.viewMasks[i] = visibleMask;
+
+				if (meshBuffer->collectOccluders && meshRenderView->isOccluder && (visibleMask & 1u))
+					meshBuffer->occluders[meshBuffer->occluderCount.fetch_add(1)] = i;
+			}
+		}
+	}
+}
+
+//**********************************************************************************************************************
+static uint32 getReadyMeshes(IMeshRenderSystem* meshSystem, MeshRenderComponent* meshRenderView, 
+	MeshRenderSystem::CullingData& culling, uint32 index, f32x4 cameraPosition, 
+	const MeshRenderSystem::MeshView* mainView, const OcclusionBuffer* occlusionBuffer, f32x4x4& bakedModel)
+{
+	auto visibleMask = culling.viewMasks[index]; uint32 readyCount = 0;
+	if ((visibleMask & 1u) && occlusionBuffer)
+	{
+		f32x4 center, extent;
+		calcWorldBounds(meshRenderView->aabb, f32x4x4(culling.models[index], 
+			f32x4(0.0f, 0.0f, 0.0f, 1.0f)), center, extent);
+		if (!occlusionBuffer->isVisible(mainView->viewProj, center, extent))
+			visibleMask &= ~1u; // Note: Occluders are rasterized only for the main camera view.
+	}
+
+	if (visibleMask != 0) // Note: Only culling survivors reach the mesh system.
+	{
+		bakedModel = f32x4x4(culling.models[index], f32x4(0.0f, 0.0f, 0.0f, 1.0f));
+		readyCount = meshSystem->getReadyMeshesAsync(meshRenderView, cameraPosition, bakedModel);
+		if (readyCount == 0)
+			visibleMask = 0;
+	}
+
+	culling.drawMasks[index] = visibleMask;
+	meshRenderView->viewMask = visibleMask;
+	return readyCount;
+}
+
+//**********************************************************************************************************************
+static void prepareUnsortedMeshes(MeshRenderSystem::MeshView* const* views, uint32 viewCount, 
+	f32x4 cameraPosition, MeshRenderSystem::UnsortedBuffer* unsortedBuffer, const OcclusionBuffer* occlusionBuffer, 
+	uint32 itemOffset, uint32 itemCount, uint32 threadIndex, bool useThreading)
+{
+	SET_CPU_ZONE_SCOPED("Unsorted Meshes Prepare");
+
 	auto meshSystem = unsortedBuffer->meshSystem;
 	auto componentSize = meshSystem->getMeshComponentSize();
 	auto componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
-	auto isNotShadowPass = shadowPass < 0;
+	auto& culling = unsortedBuffer->culling;
+	auto hasMainView = (unsortedBuffer->viewMask & 1u) != 0;
+	auto rangeSize = itemCount - itemOffset;
+
+	MeshRenderSystem::UnsortedMesh* meshes[MeshRenderSystem::maxViewCount];
+	uint32 drawCounts[MeshRenderSystem::maxViewCount], instanceCounts[MeshRenderSystem::maxViewCount];
+	memset(drawCounts, 0, viewCount * sizeof(uint32));
+	memset(instanceCounts, 0, viewCount * sizeof(uint32));
 
-	MeshRenderSystem::UnsortedMesh* meshes = nullptr;
 	if (useThreading)
 	{
 		auto& threadMeshes = unsortedBuffer->threadMeshes[threadIndex];
-		if (threadMeshes.size() < itemCount - itemOffset)
-			threadMeshes.resize(itemCount - itemOffset);
-		meshes = threadMeshes.data();
+		if (threadMeshes.size() < rangeSize * viewCount)
+			threadMeshes.resize(rangeSize * viewCount);
+		for (uint32 i = 0; i < viewCount; i++)
+			meshes[i] = threadMeshes.data() + i * rangeSize;
 	}
 	else
 	{
-		meshes = unsortedBuffer->combinedMeshes.data();
+		for (uint32 i = 0; i < viewCount; i++)
+			meshes[i] = unsortedBuffer->combinedMeshes[i].data();
+	}
+
+	for (uint32 i = itemOffset; i < itemCount; i++)
+	{
+		if (culling.viewMasks[i] == 0 && culling.drawMasks[i] == 0)
+			continue; // Note: Still culled, component is already up to date.
+
+		auto meshRenderView = (MeshRenderComponent*)(componentData + i * componentSize);
+		f32x4x4 bakedModel;
+		auto readyCount = getReadyMeshes(meshSystem, meshRenderView, 
+			culling, i, cameraPosition, views[0], occlusionBuffer, bakedModel);
+		if (hasMainView)
+			meshRenderView->isVisible = readyCount > 0 && (culling.viewMasks[i] & 1u);
+		if (readyCount == 0)
+			continue;
+
+		MeshRenderSystem::UnsortedMesh unsortedMesh;
+		unsortedMesh.componentOffset = i * componentSize;
+		unsortedMesh.bakedModel = (float4x3)bakedModel;
+		auto stateKey = (uint64)meshSystem->getMeshStateAsync(meshRenderView) << depthKeyBits;
+		auto translation = getTranslation(f32x4x4(culling.models[i], f32x4(0.0f, 0.0f, 0.0f, 1.0f)));
+		auto visibleMask = culling.viewMasks[i];
+
+		for (uint32 j = 0; j < viewCount; j++)
+		{
+			if (!(visibleMask & (1u << j)))
+				continue;
+			unsortedMesh.sortKey = stateKey | calcDepthKey(lengthSq3(translation + views[j]->cameraOffset));
+			meshes[j][drawCounts[j]++] = unsortedMesh;
+			instanceCounts[j] += readyCount;
+		}
+	}
+
+	for (uint32 i = 0; i < viewCount; i++)
+	{
+		auto drawCount = drawCounts[i];
+		if (drawCount == 0)
+			continue;
+
+		auto& counter = unsortedBuffer->counters[i];
+		auto drawOffset = counter.drawCount.fetch_add(drawCount);
+		counter.instanceCount.fetch_add(instanceCounts[i]);
+		if (useThreading)
+		{
+			memcpy(unsortedBuffer->combinedMeshes[i].data() + drawOffset,
+				meshes[i], drawCount * sizeof(MeshRenderSystem::UnsortedMesh));
+		}
+	}
+}
+
+//**********************************************************************************************************************
+static void prepareSortedMeshes(MeshRenderSystem::MeshView* const* views, uint32 viewCount, 
+	f32x4 cameraPosition, const f32x4* uiPlanes, MeshRenderSystem::SortedBuffer* sortedBuffer, 
+	const OcclusionBuffer* occlusionBuffer, MeshRenderSystem::SortedMesh* uiMeshes, atomic<uint32>* uiDrawIndex, 
+	vector<vector<MeshRenderSystem::SortedMesh>>& threadMeshes, uint32 bufferIndex, 
+	uint32 itemOffset, uint32 itemCount, uint32 threadIndex, bool useThreading)
+{
+	SET_CPU_ZONE_SCOPED("Sorted Meshes Prepare");
+
+	auto meshSystem = sortedBuffer->meshSystem;
+	auto componentSize = meshSystem->getMeshComponentSize();
+	auto componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
+	auto& culling = sortedBuffer->culling;
+	auto hasMainView = (sortedBuffer->viewMask & 1u) != 0;
+	auto distance2D = uiPlanes != nullptr;
+	auto rangeSize = itemCount - itemOffset;
+	if (distance2D)
+		viewCount = 1; // Note: UI meshes are rendered only by the main camera.
+
+	MeshRenderSystem::SortedMesh* combinedMeshes[MeshRenderSystem::maxViewCount];
+	atomic<uint32>* drawIndices[MeshRenderSystem::maxViewCount];
+	MeshRenderSystem::SortedMesh* meshes[MeshRenderSystem::maxViewCount];
+	uint32 drawCounts[MeshRenderSystem::maxViewCount], instanceCounts[MeshRenderSystem::maxViewCount];
+	memset(drawCounts, 0, viewCount * sizeof(uint32));
+	memset(instanceCounts, 0, viewCount * sizeof(uint32));
+
+	if (distance2D)
+	{
+		combinedMeshes[0] = uiMeshes;
+		drawIndices[0] = uiDrawIndex;
+	}
+	else
+	{
+		for (uint32 i = 0; i < viewCount; i++)
+		{
+			combinedMeshes[i] = views[i]->transMeshes.data();
+			drawIndices[i] = &views[i]->transDrawIndex;
+		}
+	}
+
+	if (useThreading)
+	{
+		auto& _threadMeshes = threadMeshes[threadIndex];
+		if (_threadMeshes.size() < rangeSize * viewCount)
+			_threadMeshes.resize(rangeSize * viewCount);
+		for (uint32 i = 0; i < viewCount; i++)
+			meshes[i] = _threadMeshes.data() + i * rangeSize;
+	}
+	else
+	{
+		for (uint32 i = 0; i < viewCount; i++)
+			meshes[i] = combinedMeshes[i] + drawIndices[i]->load();
+	}
+
+	for (uint32 i = itemOffset; i < itemCount; i++)
+	{
+		if (culling.viewMasks[i] == 0 && culling.drawMasks[i] == 0)
+			continue; // Note: Still culled, component is already up to date.
+
+		auto meshRenderView = (MeshRenderComponent*)(componentData + i * componentSize);
+		f32x4x4 bakedModel;
+		auto readyCount = getReadyMeshes(meshSystem, meshRenderView, 
+			culling, i, cameraPosition, views[0], occlusionBuffer, bakedModel);
+		if (hasMainView)
+			meshRenderView->isVisible = readyCount > 0 && (culling.viewMasks[i] & 1u);
+		if (readyCount == 0)
+			continue;
+
+		MeshRenderSystem::SortedMesh sortedMesh;
+		sortedMesh.componentOffset = i * componentSize;
+		sortedMesh.bakedModel = (float4x3)bakedModel;
+		sortedMesh.bufferIndex = bufferIndex;
+		auto translation = getTranslation(f32x4x4(culling.models[i], f32x4(0.0f, 0.0f, 0.0f, 1.0f)));
+		auto visibleMask = culling.viewMasks[i];
+
+		for (uint32 j = 0; j < viewCount; j++)
+		{
+			if (!(visibleMask & (1u << j)))
+				continue;
+			auto distance = distance2D ? translation.getZ() + 1.0f : 
+				lengthSq3(translation + views[j]->cameraOffset);
+			sortedMesh.sortKey = ~calcDepthKey(distance) & ((1u << depthKeyBits) - 1); // Note: Back-to-front order.
+			meshes[j][drawCounts[j]++] = sortedMesh;
+			instanceCounts[j] += readyCount;
+		}
+	}
+
+	for (uint32 i = 0; i < viewCount; i++)
+	{
+		auto drawCount = drawCounts[i];
+		if (drawCount == 0)
+			continue;
+
+		auto drawOffset = drawIndices[i]->fetch_add(drawCount);
+		if (useThreading)
+			memcpy(combinedMeshes[i] + drawOffset, meshes[i], drawCount * sizeof(MeshRenderSystem::SortedMesh));
+		auto& counter = sortedBuffer->counters[i];
+		counter.drawCount.fetch_add(drawCount);
+		counter.instanceCount.fetch_add(instanceCounts[i]);
+	}
+}
+
+//**********************************************************************************************************************
+template<class T>
+static void radixSortMeshes(vector<T>& meshes, vector<T>& tempMeshes, uint32 count, uint8 passCount)
+{
+	if (count < 2)
+		return;
+	if (tempMeshes.size() < count)
+		tempMeshes.resize(count);
+
+	uint32 histograms[maxRadixPassCount][radixSize];
+	memset(histograms, 0, passCount * radixSize * sizeof(uint32));
+	auto src = meshes.data(), dst = tempMeshes.data();
+	auto isSwapped = false;
+
+	for (uint32 i = 0; i < count; i++)
+	{
+		auto sortKey = src[i].sortKey;
+		for (uint8 pass = 0; pass < passCount; pass++)
+			histograms[pass][(sortKey >> (pass * radixBits)) & radixMask]++;
+	}
+
+	for (uint8 pass = 0; pass < passCount; pass++)
+	{
+		auto histogram = histograms[pass]; auto shift = pass * radixBits;
+		if (histogram[(src[0].sortKey >> shift) & radixMask] == count)
+			continue; // Note: All keys have the same digit, nothing to reorder.
+
+		uint32 offset = 0;
+		for (uint32 i = 0; i < radixSize; i++)
+		{
+			auto digitCount = histogram[i];
+			histogram[i] = offset; offset += digitCount;
+		}
+		for (uint32 i = 0; i < count; i++)
+			dst[histogram[(src[i].sortKey >> shift) & radixMask]++] = src[i];
+
+		std::swap(src, dst); isSwapped = !isSwapped;
+	}
+
+	if (isSwapped)
+		meshes.swap(tempMeshes);
+}
+
+//**********************************************************************************************************************
+template<class T>
+static void radixSortMeshes(ThreadPool& threadPool, vector<uint32>& sortHistograms, 
+	vector<T>& meshes, vector<T>& tempMeshes, uint32 count, uint8 passCount)
+{
+	if (tempMeshes.size() < count)
+		tempMeshes.resize(count);
+
+	auto blockCount = std::min(threadPool.getThreadCount(), (count + minSortBlockSize - 1) / minSortBlockSize);
+	auto blockSize = (count + blockCount - 1) / blockCount;
+	if (sortHistograms.size() < blockCount * maxRadixPassCount * radixSize)
+		sortHistograms.resize(blockCount * maxRadixPassCount * radixSize);
+
+	// Note: Histograms are stored as [block][pass][digit].
+	auto histograms = sortHistograms.data();
+	auto src = meshes.data(), dst = tempMeshes.data();
+	auto isSwapped = false, isFirstPass = true;
+
+	threadPool.addTasks([histograms, src, count, blockSize, passCount](const ThreadPool::Task& task)
+	{
+		SET_CPU_ZONE_SCOPED("Meshes Radix Histogram");
+
+		auto blockHistograms = histograms + task.getTaskIndex() * (maxRadixPassCount * radixSize);
+		memset(blockHistograms, 0, passCount * radixSize * sizeof(uint32));
+		auto itemOffset = task.getTaskIndex() * blockSize, itemCount = std::min(itemOffset + blockSize, count);
+
+		for (uint32 i = itemOffset; i < itemCount; i++)
+		{
+			auto sortKey = src[i].sortKey;
+			for (uint8 pass = 0; pass < passCount; pass++)
+				blockHistograms[pass * radixSize + ((sortKey >> (pass * radixBits)) & radixMask)]++;
+		}
+	},
+	blockCount);
+	threadPool.wait();
+
+	for (uint8 pass = 0; pass < passCount; pass++)
+	{
+		auto shift = pass * radixBits; auto passOffset = pass * radixSize;
+		auto digit = (src[0].sortKey >> shift) & radixMask; uint32 digitCount = 0;
+		for (uint32 i = 0; i < blockCount; i++)
+			digitCount += histograms[i * (maxRadixPassCount * radixSize) + passOffset + digit];
+		if (digitCount == count)
+			continue; // Note: All keys have the same digit, nothing to reorder.
+
+		if (!isFirstPass) // Note: First pass histograms are computed for the source order.
+		{
+			threadPool.addTasks([histograms, src, count, blockSize, shift, passOffset](const ThreadPool::Task& task)
+			{
+				SET_CPU_ZONE_SCOPED("Meshes Radix Histogram");
+
+				auto histogram = histograms + task.getTaskIndex() * (maxRadixPassCount * radixSize) + passOffset;
+				memset(histogram, 0, radixSize * sizeof(uint32));
+				auto itemOffset = task.getTaskIndex() * blockSize, itemCount = std::min(itemOffset + blockSize, count);
+
+				for (uint32 i = itemOffset; i < itemCount; i++)
+					histogram[(src[i].sortKey >> shift) & radixMask]++;
+			},
+			blockCount);
+			threadPool.wait();
+		}
+		isFirstPass = false;
+
+		uint32 offset = 0;
+		for (uint32 i = 0; i < radixSize; i++)
+		{
+			for (uint32 j = 0; j < blockCount; j++)
+			{
+				auto& histogram = histograms[j * (maxRadixPassCount * radixSize) + passOffset + i];
+				auto blockDigitCount = histogram; histogram = offset; offset += blockDigitCount;
+			}
+		}
+
+		threadPool.addTasks([histograms, src, dst, count, blockSize, shift, passOffset](const ThreadPool::Task& task)
+		{
+			SET_CPU_ZONE_SCOPED("Meshes Radix Scatter");
+
+			auto histogram = histograms + task.getTaskIndex() * (maxRadixPassCount * radixSize) + passOffset;
+			auto itemOffset = task.getTaskIndex() * blockSize, itemCount = std::min(itemOffset + blockSize, count);
+
+			for (uint32 i = itemOffset; i < itemCount; i++)
+				dst[histogram[(src[i].sortKey >> shift) & radixMask]++] = src[i];
+		},
+		blockCount);
+		threadPool.wait();
+
+		std::swap(src, dst); isSwapped = !isSwapped;
+	}
+
+	if (isSwapped)
+		meshes.swap(tempMeshes);
+}
+
+//**********************************************************************************************************************
+void MeshRenderSystem::sortMeshes()
+{
+	SET_CPU_ZONE_SCOPED("Meshes Sort");
+
+	auto threadSystem = asyncPreparing ? ThreadSystem::Instance::tryGet() : nullptr;
+	if (!threadSystem)
+	{
+		for (uint32 i = 0; i < unsortedBufferCount; i++)
+		{
+			auto unsortedBuffer = unsortedBuffers[i];
+			if (unsortedBuffer->meshSystem->getMeshRenderType() == MeshRenderType::OIT)
+				continue; // Note: No need to sort OIT meshes at all.
+
+			SET_CPU_ZONE_SCOPED("Unsorted Meshes Sort");
+			for (uint32 j = 0; j < viewCount; j++)
+			{
+				radixSortMeshes(unsortedBuffer->combinedMeshes[j], unsortedBuffer->tempMeshes[j], 
+					unsortedBuffer->counters[j].drawCount.load(), unsortedPassCount);
+			}
+		}
+
+		{
+			SET_CPU_ZONE_SCOPED("Trans Meshes Sort");
+			for (uint32 i = 0; i < viewCount; i++)
+			{
+				auto view = views[i];
+				radixSortMeshes(view->transMeshes, view->transTempMeshes, 
+					view->transDrawIndex.load(), sortedPassCount);
+			}
+		}
+		{
+			SET_CPU_ZONE_SCOPED("UI Meshes Sort");
+			radixSortMeshes(uiSortedMeshes, uiTempMeshes, uiDrawIndex.load(), sortedPassCount);
+		}
+		return;
+	}
+
+	auto& threadPool = threadSystem->getForegroundPool();
+	for (uint32 i = 0; i < unsortedBufferCount; i++)
+	{
+		auto unsortedBuffer = unsortedBuffers[i];
+		if (!unsortedBuffer->prepareJob.isValid() || 
+			unsortedBuffer->meshSystem->getMeshRenderType() == MeshRenderType::OIT)
+		{
+			continue;
+		}
+
+		// Note: Sorting starts as soon as this buffer meshes are prepared.
+		threadPool.addTask([this, unsortedBuffer](const ThreadPool::Task& task)
+		{
+			SET_CPU_ZONE_SCOPED("Unsorted Meshes Sort");
+
+			for (uint32 j = 0; j < viewCount; j++)
+			{
+				auto drawCount = unsortedBuffer->counters[j].drawCount.load();
+				if (drawCount > parallelSortThreshold)
+					continue; // Note: Large buffers are sorted below using all threads.
+
+				radixSortMeshes(unsortedBuffer->combinedMeshes[j], 
+					unsortedBuffer->tempMeshes[j], drawCount, unsortedPassCount);
+			}
+		},
+		ThreadPool::priorityNormal, unsortedBuffer->prepareJob);
+	}
+
+	if (!transPrepareJobs.empty())
+	{
+		auto transPrepareJob = threadPool.whenAll(transPrepareJobs);
+		for (uint32 i = 0; i < viewCount; i++)
+		{
+			auto view = views[i];
+			threadPool.addTask([view](const ThreadPool::Task& task)
+			{
+				auto drawCount = view->transDrawIndex.load();
+				if (drawCount > parallelSortThreshold)
+					return;
+
+				SET_CPU_ZONE_SCOPED("Trans Meshes Sort");
+				radixSortMeshes(view->transMeshes, view->transTempMeshes, drawCount, sortedPassCount);
+			},
+			ThreadPool::priorityNormal, transPrepareJob);
+		}
+	}
+	if (!uiPrepareJobs.empty())
+	{
+		threadPool.addTask([this](const ThreadPool::Task& task)
+		{
+			auto drawCount = uiDrawIndex.load();
+			if (drawCount > parallelSortThreshold)
+				return;
+
+			SET_CPU_ZONE_SCOPED("UI Meshes Sort");
+			radixSortMeshes(uiSortedMeshes, uiTempMeshes, drawCount, sortedPassCount);
+		},
+		ThreadPool::priorityNormal, threadPool.whenAll(uiPrepareJobs));
 	}
 
-	uint32 drawCount = 0, instanceCount = 0;
-	for (uint32 i = itemOffset; i < itemCount; i++)
-	{
-		auto meshRenderView = (MeshRenderComponent*)(componentData + i * componentSize);
-		auto aabbSize = meshRenderView->aabb.getSize(); aabbSize.fixW();
+	threadPool.wait();
 
-		if (!meshRenderView->getEntity() || !meshRenderView->isEnabled || areAllTrue(aabbSize <= f32x4::zero))
-		{
-			if (isNotShadowPass)
-				meshRenderView->isVisible = false;
+	for (uint32 i = 0; i < unsortedBufferCount; i++)
+	{
+		auto unsortedBuffer = unsortedBuffers[i];
+		if (unsortedBuffer->meshSystem->getMeshRenderType() == MeshRenderType::OIT)
 			continue;
-		}
 
-		auto transformView = manager->tryGet<TransformComponent>(meshRenderView->getEntity());
-		if (!transformView || !transformView->isActive())
+		for (uint32 j = 0; j < viewCount; j++)
 		{
-			if (isNotShadowPass)
-				meshRenderView->isVisible = false;
-			continue;
-		}
+			auto drawCount = unsortedBuffer->counters[j].drawCount.load();
+			if (drawCount <= parallelSortThreshold)
+				continue;
 
-		auto model = transformView->calcModel(cameraPosition); auto bakedModel = model;
-		auto readyCount = meshSystem->getReadyMeshesAsync(meshRenderView, cameraPosition, frustum, bakedModel);
-		if (readyCount == 0)
-		{
-			if (isNotShadowPass)
-				meshRenderView->isVisible = false;
-			continue;
+			SET_CPU_ZONE_SCOPED("Unsorted Meshes Sort");
+			radixSortMeshes(threadPool, sortHistograms, unsortedBuffer->combinedMeshes[j], 
+				unsortedBuffer->tempMeshes[j], drawCount, unsortedPassCount);
 		}
-
-		if (isNotShadowPass)
-			meshRenderView->isVisible = true;
-
-		MeshRenderSystem::UnsortedMesh unsortedMesh;
-		unsortedMesh.componentOffset = i * componentSize;
-		unsortedMesh.bakedModel = (float4x3)bakedModel;
-		unsortedMesh.distanceSq = lengthSq3(getTranslation(model) + cameraOffset);
-		meshes[drawCount++] = unsortedMesh;
-		instanceCount += readyCount;
 	}
+	for (uint32 i = 0; i < viewCount; i++)
+	{
+		auto view = views[i];
+		auto drawCount = view->transDrawIndex.load();
+		if (drawCount <= parallelSortThreshold)
+			continue;
 
-	auto drawOffset = unsortedBuffer->drawCount.fetch_add(drawCount);
-	unsortedBuffer->instanceCount.fetch_add(instanceCount);
-	if (useThreading)
+		SET_CPU_ZONE_SCOPED("Trans Meshes Sort");
+		radixSortMeshes(threadPool, sortHistograms, view->transMeshes, 
+			view->transTempMeshes, drawCount, sortedPassCount);
+	}
+	if (uiDrawIndex.load() > parallelSortThreshold)
 	{
-		memcpy(unsortedBuffer->combinedMeshes.data() + drawOffset,
-			meshes, drawCount * sizeof(MeshRenderSystem::UnsortedMesh));
+		SET_CPU_ZONE_SCOPED("UI Meshes Sort");
+		radixSortMeshes(threadPool, sortHistograms, uiSortedMeshes, 
+			uiTempMeshes, uiDrawIndex.load(), sortedPassCount);
 	}
 }
 
 //**********************************************************************************************************************
-static void prepareSortedMeshes(f32x4 cameraOffset, f32x4 cameraPosition, const Frustum& frustum, 
-	MeshRenderSystem::SortedBuffer* sortedBuffer, MeshRenderSystem::SortedMesh* combinedMeshes, 
-	vector<vector<MeshRenderSystem::SortedMesh>>& threadMeshes, atomic<uint32>* sortedDrawIndex, 
-	uint32 bufferIndex, uint32 itemOffset, uint32 itemCount, uint32 threadIndex, int8 shadowPass, 
-	bool useThreading, bool distance2D)
+void MeshRenderSystem::addView(const f32x4x4& viewProj, 
+	f32x4 cameraOffset, IShadowMeshRenderSystem* shadowSystem, int8 shadowPass)
 {
-	SET_CPU_ZONE_SCOPED("Sorted Meshes Prepare");
+	if (views.size() <= viewCount)
+		views.push_back(new MeshView());
+
+	auto view = views[viewCount++];
+	view->viewProj = viewProj;
+	view->cameraOffset = cameraOffset;
+	view->shadowSystem = shadowSystem;
+	view->shadowPass = shadowPass;
+	calcFrustumPlanes(viewProj, view->planes);
+
+	// Note: Static mesh tree bounds are stored in world space, not camera relative.
+	auto cameraPosition = (f32x4)GraphicsSystem::Instance::get()->getCommonConstants().cameraPos;
+	for (uint8 i = 0; i < 6; i++)
+	{
+		auto plane = view->planes[i];
+		plane.setW(plane.getW() - dot3(plane, cameraPosition));
+		view->worldPlanes[i] = plane;
+	}
+}
+void MeshRenderSystem::prepareViews()
+{
+	SET_CPU_ZONE_SCOPED("Views Prepare");
 
-	auto manager = Manager::Instance::get();
-	auto meshSystem = sortedBuffer->meshSystem;
-	auto componentSize = meshSystem->getMeshComponentSize();
-	auto componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
-	auto isNotShadowPass = shadowPass < 0;
+	const auto& cc = GraphicsSystem::Instance::get()->getCommonConstants();
+	viewCount = 0;
+	addView(cc.viewProj, f32x4::zero, nullptr, -1);
+	calcFrustumPlanes(calcUiProjView(), uiPlanes);
 
-	MeshRenderSystem::SortedMesh* meshes = nullptr;
-	if (useThreading)
+	auto systemGroup = Manager::Instance::get()->tryGetSystemGroup<IShadowMeshRenderSystem>();
+	if (!systemGroup)
+		return;
+
+	for (auto system : *systemGroup)
 	{
-		auto& _threadMeshes = threadMeshes[threadIndex];
-		if (_threadMeshes.size() < itemCount - itemOffset)
-			_threadMeshes.resize(itemCount - itemOffset);
-		meshes = _threadMeshes.data();
+		auto shadowSystem = dynamic_cast<IShadowMeshRenderSystem*>(system);
+		auto passCount = shadowSystem->getShadowPassCount();
+
+		for (uint8 passIndex = 0; passIndex < passCount; passIndex++)
+		{
+			GARDEN_ASSERT_MSG(viewCount < maxViewCount, "Out of mesh culling views");
+			if (viewCount == maxViewCount)
+				return;
+
+			f32x4x4 viewProj; f32x4 cameraOffset;
+			if (!shadowSystem->prepareShadowRender(passIndex, viewProj, cameraOffset))
+				continue;
+			addView(viewProj, cameraOffset, shadowSystem, passIndex);
+		}
 	}
-	else
+}
+
+//**********************************************************************************************************************
+static uint32 calcSystemViewMask(IMeshRenderSystem* meshSystem, 
+	MeshRenderSystem::MeshView* const* views, uint32 viewCount, bool isMainOnly)
+{
+	if (isMainOnly)
+		return meshSystem->isDrawReady(-1) ? 1u : 0u;
+
+	uint32 viewMask = 0;
+	for (uint32 i = 0; i < viewCount; i++)
 	{
-		meshes = combinedMeshes;
+		if (meshSystem->isDrawReady(views[i]->shadowPass))
+			viewMask |= 1u << i;
 	}
+	return viewMask;
+}
 
-	uint32 drawCount = 0, instanceCount = 0;
-	for (uint32 i = itemOffset; i < itemCount; i++)
-	{
-		auto meshRenderView = (MeshRenderComponent*)(componentData + i * componentSize);
-		auto aabbSize = meshRenderView->aabb.getSize(); aabbSize.fixW();
+static void prepareCulling(Manager* manager, MeshRenderSystem::MeshBuffer* meshBuffer, 
+	uint32 occupancy, bool isChanged, bool useStatic, bool collectOccluders)
+{
+	auto& culling = meshBuffer->culling;
+	resizeCullingData(culling, occupancy);
+	if (isChanged) // Note: Component masks can be outdated after mesh system or view change.
+		std::fill(culling.drawMasks.begin(), culling.drawMasks.end(), UINT32_MAX);
+
+	meshBuffer->collectOccluders = collectOccluders;
+	meshBuffer->occluderCount.store(0);
+	if (collectOccluders && meshBuffer->occluders.size() < occupancy)
+		meshBuffer->occluders.resize(occupancy);
+
+	auto staticSystem = useStatic ? StaticTransformSystem::Instance::tryGet() : nullptr;
+	meshBuffer->useStatic = staticSystem != nullptr;
+	if (staticSystem)
+		updateStaticTree(manager, meshBuffer, staticSystem->getVersion());
+}
 
-		if (!meshRenderView->getEntity() || !meshRenderView->isEnabled || areAllTrue(aabbSize <= f32x4::zero))
+static ThreadPool::Job cullMeshBuffer(ThreadPool* threadPool, vector<ThreadPool::Job>& cullJobs, 
+	MeshRenderSystem::MeshView* const* views, uint32 viewCount, const f32x4* uiPlanes, 
+	f32x4 cameraPosition, MeshRenderSystem::MeshBuffer* meshBuffer, uint32 occupancy)
+{
+	if (!meshBuffer->useStatic)
+	{
+		if (!threadPool)
 		{
-			if (isNotShadowPass)
-				meshRenderView->isVisible = false;
-			continue;
+			cullMeshes(views, viewCount, uiPlanes, cameraPosition, meshBuffer, nullptr, 0, occupancy);
+			return {};
 		}
 
-		auto transformView = manager->tryGet<TransformComponent>(meshRenderView->getEntity());
-		if (!transformView || !transformView->isActive())
+		return threadPool->addItems([views, viewCount, uiPlanes, 
+			cameraPosition, meshBuffer](const ThreadPool::Task& task)
 		{
-			if (isNotShadowPass)
-				meshRenderView->isVisible = false;
-			continue;
-		}
+			cullMeshes(views, viewCount, uiPlanes, cameraPosition, meshBuffer, 
+				nullptr, task.getItemOffset(), task.getItemCount());
+		},
+		occupancy, ThreadPool::priorityNormal, {}, ThreadPool::defaultGrainSize);
+	}
 
-		auto model = transformView->calcModel(cameraPosition); auto bakedModel = model;
-		auto readyCount = meshSystem->getReadyMeshesAsync(meshRenderView, cameraPosition, frustum, bakedModel);
-		if (readyCount == 0)
-		{
-			if (isNotShadowPass)
-				meshRenderView->isVisible = false;
-			continue;
-		}
+	const auto& staticTree = meshBuffer->staticTree;
+	auto dynamicCount = (uint32)staticTree.dynamicItems.size();
+	auto taskCount = (uint32)staticTree.taskNodes.size();
+	// Note: Static tree traversal writes only visible item masks.
+	memset(meshBuffer->culling.viewMasks.data(), 0, occupancy * sizeof(uint32));
 
-		if (isNotShadowPass)
-			meshRenderView->isVisible = true;
+	if (!threadPool)
+	{
+		cullMeshes(views, viewCount, nullptr, cameraPosition, meshBuffer, 
+			staticTree.dynamicItems.data(), 0, dynamicCount);
+		cullStaticMeshes(views, viewCount, cameraPosition, meshBuffer, 0, taskCount);
+		return {};
+	}
 
-		MeshRenderSystem::SortedMesh sortedMesh;
-		sortedMesh.componentOffset = i * componentSize;
-		sortedMesh.bakedModel = (float4x3)bakedModel;
-		sortedMesh.distanceSq = distance2D ? getTranslation(model).getZ() + 1.0f : 
-			lengthSq3(getTranslation(model) + cameraOffset);
-		sortedMesh.bufferIndex = bufferIndex;
-		meshes[drawCount++] = sortedMesh;
-		instanceCount += readyCount;
+	cullJobs.clear();
+	if (dynamicCount > 0)
+	{
+		cullJobs.push_back(threadPool->addItems([views, viewCount, 
+			cameraPosition, meshBuffer](const ThreadPool::Task& task)
+		{
+			cullMeshes(views, viewCount, nullptr, cameraPosition, meshBuffer, 
+				meshBuffer->staticTree.dynamicItems.data(), task.getItemOffset(), task.getItemCount());
+		},
+		dynamicCount, ThreadPool::priorityNormal, {}, ThreadPool::defaultGrainSize));
+	}
+	if (taskCount > 0)
+	{
+		cullJobs.push_back(threadPool->addItems([views, viewCount, 
+			cameraPosition, meshBuffer](const ThreadPool::Task& task)
+		{
+			cullStaticMeshes(views, viewCount, cameraPosition, meshBuffer, task.getItemOffset(), task.getItemCount());
+		},
+		taskCount, ThreadPool::priorityNormal, {}, 1));
 	}
 
-	auto drawOffset = sortedDrawIndex->fetch_add(drawCount);
-	if (useThreading)
-		memcpy(combinedMeshes + drawOffset, meshes, drawCount * sizeof(MeshRenderSystem::SortedMesh));
-	sortedBuffer->drawCount.fetch_add(drawCount);
-	sortedBuffer->instanceCount.fetch_add(instanceCount);
+	if (cullJobs.empty())
+		return {};
+	return cullJobs.size() == 1 ? cullJobs[0] : threadPool->whenAll(cullJobs);
+}
+
+static ThreadPool::Job combineJobs(ThreadPool* threadPool, vector<ThreadPool::Job>& jobs, 
+	const ThreadPool::Job& job0, const ThreadPool::Job& job1)
+{
+	if (!job0.isValid())
+		return job1;
+	if (!job1.isValid())
+		return job0;
+
+	jobs.clear(); jobs.push_back(job0); jobs.push_back(job1);
+	return threadPool->whenAll(jobs);
 }
 
 //**********************************************************************************************************************
-void MeshRenderSystem::sortMeshes() // TODO: We can use here async bitonic sorting algorithm
+static bool selectOccluders(MeshRenderSystem::UnsortedBuffer* const* unsortedBuffers, uint32 unsortedBufferCount, 
+	const f32x4x4& viewProj, uint32 occluderBudget, vector<MeshRenderSystem::Occluder>& occluders, 
+	vector<OcclusionBuffer::Box>& occluderBoxes, const OcclusionBuffer& occlusionBuffer)
 {
-	SET_CPU_ZONE_SCOPED("Meshes Sort");
+	SET_CPU_ZONE_SCOPED("Occluders Select");
 
-	auto threadSystem = asyncPreparing ? ThreadSystem::Instance::tryGet() : nullptr;
+	occluders.clear(); occluderBoxes.clear();
 	for (uint32 i = 0; i < unsortedBufferCount; i++)
 	{
 		auto unsortedBuffer = unsortedBuffers[i];
-		if (unsortedBuffer->meshSystem->getMeshRenderType() == MeshRenderType::OIT ||
-			unsortedBuffer->drawCount.load() == 0) // Note: No need to sort OIT meshes at all.
-		{
+		if (!unsortedBuffer->collectOccluders)
 			continue;
-		}
 
-		if (threadSystem)
-		{
-			threadSystem->getForegroundPool().addTask([unsortedBuffer](const ThreadPool::Task& task)
-			{
-				SET_CPU_ZONE_SCOPED("Unsorted Meshes Sort");
-				auto& meshes = unsortedBuffer->combinedMeshes;
-				std::sort(meshes.begin(), meshes.begin() + unsortedBuffer->drawCount.load());
-			});
-		}
-		else
+		auto meshSystem = unsortedBuffer->meshSystem;
+		auto componentSize = meshSystem->getMeshComponentSize();
+		auto componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
+		const auto& culling = unsortedBuffer->culling;
+		auto occluderCount = unsortedBuffer->occluderCount.load();
+
+		for (uint32 j = 0; j < occluderCount; j++)
 		{
-			SET_CPU_ZONE_SCOPED("Unsorted Meshes Sort");
-			auto& meshes = unsortedBuffer->combinedMeshes;
-			std::sort(meshes.begin(), meshes.begin() + unsortedBuffer->drawCount.load());
+			auto item = unsortedBuffer->occluders[j];
+			if (!(culling.viewMasks[item] & 1u))
+				continue; // Note: Occluder is outside of the camera frustum.
+
+			auto meshRenderView = (MeshRenderComponent*)(componentData + item * componentSize);
+			f32x4 center, extent;
+			calcWorldBounds(meshRenderView->aabb, f32x4x4(culling.models[item], 
+				f32x4(0.0f, 0.0f, 0.0f, 1.0f)), center, extent);
+
+			MeshRenderSystem::Occluder occluder;
+			occluder.meshBuffer = unsortedBuffer;
+			occluder.item = item;
+			occluder.weight = lengthSq3(extent) / std::max(lengthSq3(center), 1.0e-6f);
+			occluders.push_back(occluder);
 		}
 	}
 
-	if (transDrawIndex.load() > 0)
+	if (occluders.size() > occluderBudget) // Note: Keeping only the largest occluders on the screen.
 	{
-		if (threadSystem)
+		std::nth_element(occluders.begin(), occluders.begin() + occluderBudget, occluders.end(), 
+			[](const MeshRenderSystem::Occluder& a, const MeshRenderSystem::Occluder& b)
 		{
-			threadSystem->getForegroundPool().addTask([this](const ThreadPool::Task& task)
-			{
-				SET_CPU_ZONE_SCOPED("Trans Meshes Sort");
-				std::sort(transSortedMeshes.begin(), transSortedMeshes.begin() + transDrawIndex.load());
-			});
-		}
-		else
-		{
-			SET_CPU_ZONE_SCOPED("Trans Meshes Sort");
-			std::sort(transSortedMeshes.begin(), transSortedMeshes.begin() + transDrawIndex.load());
-		}
+			return a.weight > b.weight;
+		});
+		occluders.resize(occluderBudget);
 	}
-	if (uiDrawIndex.load() > 0)
+
+	for (const auto& occluder : occluders)
 	{
-		if (threadSystem)
-		{
-			threadSystem->getForegroundPool().addTask([this](const ThreadPool::Task& task)
-			{
-				SET_CPU_ZONE_SCOPED("UI Meshes Sort");
-				std::sort(uiSortedMeshes.begin(), uiSortedMeshes.begin() + uiDrawIndex.load());
-			});
-		}
-		else
+		auto meshSystem = occluder.meshBuffer->meshSystem;
+		auto meshRenderView = (MeshRenderComponent*)((uint8*)meshSystem->getMeshComponentPool().getData() + 
+			occluder.item * meshSystem->getMeshComponentSize());
+		auto model = f32x4x4(occluder.meshBuffer->culling.models[occluder.item], f32x4(0.0f, 0.0f, 0.0f, 1.0f));
+
+		OcclusionBuffer::Box box;
+		if (occlusionBuffer.projectBox(viewProj * model, meshRenderView->aabb, box))
+			occluderBoxes.push_back(box);
+	}
+	return !occluderBoxes.empty();
+}
+static void rasterizeOccluders(OcclusionBuffer& occlusionBuffer, 
+	const vector<OcclusionBuffer::Box>& occluderBoxes, uint32 bandIndex)
+{
+	SET_CPU_ZONE_SCOPED("Occluders Rasterize");
+
+	occlusionBuffer.clear(bandIndex);
+	for (const auto& box : occluderBoxes)
+		occlusionBuffer.rasterizeBox(box, bandIndex);
+}
+
+ThreadPool::Job MeshRenderSystem::prepareOcclusion(ThreadPool* threadPool)
+{
+	hasOccluders = false;
+	if (!threadPool)
+	{
+		hasOccluders = selectOccluders(unsortedBuffers.data(), unsortedBufferCount, views[0]->viewProj, 
+			occluderBudget, occluders, occluderBoxes, occlusionBuffer);
+		if (hasOccluders)
 		{
-			SET_CPU_ZONE_SCOPED("UI Meshes Sort");
-			std::sort(uiSortedMeshes.begin(), uiSortedMeshes.begin() + uiDrawIndex.load());
+			auto bandCount = occlusionBuffer.getBandCount();
+			for (uint32 i = 0; i < bandCount; i++)
+				rasterizeOccluders(occlusionBuffer, occluderBoxes, i);
 		}
+		return {};
+	}
+
+	// Note: Occluders are known only after all mesh buffers are culled.
+	cullJobs.clear();
+	for (uint32 i = 0; i < unsortedBufferCount; i++)
+	{
+		auto unsortedBuffer = unsortedBuffers[i];
+		if (unsortedBuffer->collectOccluders && unsortedBuffer->cullJob.isValid())
+			cullJobs.push_back(unsortedBuffer->cullJob);
 	}
+
+	auto selectJob = threadPool->addTask([this](const ThreadPool::Task& task)
+	{
+		hasOccluders = selectOccluders(unsortedBuffers.data(), unsortedBufferCount, views[0]->viewProj, 
+			occluderBudget, occluders, occluderBoxes, occlusionBuffer);
+	},
+	ThreadPool::priorityNormal, cullJobs.empty() ? ThreadPool::Job() : threadPool->whenAll(cullJobs));
+
+	return threadPool->addTasks([this](const ThreadPool::Task& task)
+	{
+		if (hasOccluders)
+			rasterizeOccluders(occlusionBuffer, occluderBoxes, task.getTaskIndex());
+	},
+	occlusionBuffer.getBandCount(), ThreadPool::priorityNormal, selectJob);
 }
 
 //**********************************************************************************************************************
-void MeshRenderSystem::prepareMeshes(const Frustum& viewFrustum, 
-	const Frustum* uiFrustum, f32x4 cameraOffset, int8 shadowPass)
+void MeshRenderSystem::prepareMeshes()
 {
 	SET_CPU_ZONE_SCOPED("Meshes Prepare");
 
 	uint32 transMeshMaxCount = 0, uiMeshMaxCount = 0;
-	transDrawIndex.store(0); uiDrawIndex.store(0);
+	uiDrawIndex.store(0);
+	transPrepareJobs.clear(); uiPrepareJobs.clear();
 	unsortedBufferCount = sortedBufferCount = 0;
 	hasAnyRefr = hasAnyOIT = hasAnyTD = false;
 
@@ -362,11 +1476,8 @@ void MeshRenderSystem::prepareMeshes(const Frustum& viewFrustum,
 		}
 		else if (renderType == MeshRenderType::UI)
 		{
-			if (shadowPass < 0)
-			{
-				uiMeshMaxCount += meshSystem->getMeshComponentPool().getCount();
-				sortedBufferCount++;
-			}
+			uiMeshMaxCount += meshSystem->getMeshComponentPool().getCount();
+			sortedBufferCount++;
 		}
 		else
 		{
@@ -389,22 +1500,30 @@ void MeshRenderSystem::prepareMeshes(const Frustum& viewFrustum,
 			sortedBuffers[i] = new SortedBuffer();
 	}
 
-	if (transSortedMeshes.size() < transMeshMaxCount)
-		transSortedMeshes.resize(transMeshMaxCount);
+	for (uint32 i = 0; i < viewCount; i++)
+	{
+		auto view = views[i];
+		view->transDrawIndex.store(0);
+		if (view->transMeshes.size() < transMeshMaxCount)
+			view->transMeshes.resize(transMeshMaxCount);
+	}
 	if (uiSortedMeshes.size() < uiMeshMaxCount)
 		uiSortedMeshes.resize(uiMeshMaxCount);
 
 	auto manager = Manager::Instance::get();
 	auto graphicsSystem = GraphicsSystem::Instance::get();
 	auto threadSystem = asyncPreparing ? ThreadSystem::Instance::tryGet() : nullptr;
+	auto threadPool = threadSystem ? &threadSystem->getForegroundPool() : nullptr;
 	const auto& cc = graphicsSystem->getCommonConstants();
 	auto cameraPosition = (f32x4)cc.cameraPos;
+	auto viewCount = this->viewCount;
 	uint32 unsortedBufferIndex = 0, sortedBufferIndex = 0;
 
 	#if GARDEN_EDITOR
 	auto graphicsEditorSystem = manager->tryGet<GraphicsEditorSystem>();
 	#endif
 
+	// Note: Each mesh is visited once, its bounds are culled against the camera and all shadow pass views.
 	for (auto meshSystem : meshSystems)
 	{
 		const auto& componentPool = meshSystem->getMeshComponentPool();
@@ -413,103 +1532,82 @@ void MeshRenderSystem::prepareMeshes(const Frustum& viewFrustum,
 		
 		if (renderType == MeshRenderType::Translucent || renderType == MeshRenderType::UI)
 		{
-			if (renderType == MeshRenderType::UI && shadowPass >= 0)
-				continue;
-
-			auto bufferIndex = sortedBufferIndex++;
-			auto sortedBuffer = sortedBuffers[bufferIndex];
+			auto isUI = renderType == MeshRenderType::UI;
+			auto sortedBuffer = sortedBuffers[sortedBufferIndex++];
+			auto isChanged = sortedBuffer->meshSystem != meshSystem;
+			auto lastViewMask = sortedBuffer->viewMask;
 			sortedBuffer->meshSystem = meshSystem;
-			sortedBuffer->drawCount.store(0);
-			sortedBuffer->instanceCount.store(0);
+			sortedBuffer->prepareJob.release();
+			sortedBuffer->cullJob.release();
+			for (uint32 i = 0; i < viewCount; i++)
+			{
+				sortedBuffer->counters[i].drawCount.store(0);
+				sortedBuffer->counters[i].instanceCount.store(0);
+			}
 			// Note: Still setting buffer system to reuse last mem allocation sizes.
 
-			if (componentCount == 0 || !meshSystem->isDrawReady(shadowPass))
+			sortedBuffer->viewMask = componentCount > 0 ? 
+				calcSystemViewMask(meshSystem, views.data(), viewCount, isUI) : 0;
+			if (sortedBuffer->viewMask == 0)
 				continue;
+			prepareCulling(manager, sortedBuffer, componentPool.getOccupancy(), 
+				isChanged || lastViewMask != sortedBuffer->viewMask, !isUI, false);
 
-			SortedMesh* combinedSortedMeshes; atomic<uint32>* sortedDrawIndex;
-			const Frustum* frustum; f32x4 sortedCameraPos; bool distance2D;
-			if (renderType == MeshRenderType::Translucent)
-			{
-				combinedSortedMeshes = transSortedMeshes.data();
-				sortedDrawIndex = &transDrawIndex; frustum = &viewFrustum;
-				sortedCameraPos = cameraPosition; distance2D = false;
-			}
-			else
-			{
-				combinedSortedMeshes = uiSortedMeshes.data();
-				sortedDrawIndex = &uiDrawIndex; frustum = uiFrustum;
-				sortedCameraPos = f32x4::zero; distance2D = true;
-			}
-
-			if (threadSystem)
-			{
-				auto& threadPool = threadSystem->getForegroundPool();
-				if (sortedThreadMeshes.size() < threadPool.getThreadCount())
-					sortedThreadMeshes.resize(threadPool.getThreadCount());
-
-				// Note: do not optimize args with [&], it captures stack address!!!
-				threadPool.addItems([this, cameraOffset, sortedCameraPos, frustum, 
-					sortedBuffer, combinedSortedMeshes, sortedDrawIndex, bufferIndex, 
-					shadowPass, distance2D](const ThreadPool::Task& task)
-				{
-					prepareSortedMeshes(cameraOffset, sortedCameraPos, *frustum, sortedBuffer, 
-						combinedSortedMeshes, sortedThreadMeshes, sortedDrawIndex, bufferIndex, 
-						task.getItemOffset(), task.getItemCount(), task.getThreadIndex(), shadowPass, 
-						true, distance2D);
-				},
-				componentPool.getOccupancy());
-			}
-			else
-			{
-				prepareSortedMeshes(cameraOffset, sortedCameraPos, *frustum, sortedBuffer, 
-					combinedSortedMeshes, sortedThreadMeshes, sortedDrawIndex, bufferIndex, 
-					0, componentPool.getOccupancy(), 0, shadowPass, false, distance2D);
-			}
+			auto sortedCameraPos = isUI ? f32x4::zero : cameraPosition;
+			auto sortedPlanes = isUI ? (const f32x4*)uiPlanes : nullptr;
+			sortedBuffer->cullJob = cullMeshBuffer(threadPool, cullJobs, views.data(), viewCount, 
+				sortedPlanes, sortedCameraPos, sortedBuffer, componentPool.getOccupancy());
 
 			#if GARDEN_EDITOR
-			if (graphicsEditorSystem)
+			if (graphicsEditorSystem && (sortedBuffer->viewMask & 1u))
 				graphicsEditorSystem->translucentTotalCount += componentCount;
 			#endif
 		}
 		else
 		{
 			auto unsortedBuffer = unsortedBuffers[unsortedBufferIndex++];
+			auto isChanged = unsortedBuffer->meshSystem != meshSystem;
+			auto lastViewMask = unsortedBuffer->viewMask;
 			unsortedBuffer->meshSystem = meshSystem;
-			unsortedBuffer->drawCount.store(0);
-			unsortedBuffer->instanceCount.store(0);
+			unsortedBuffer->prepareJob.release();
+			unsortedBuffer->cullJob.release();
+			for (uint32 i = 0; i < viewCount; i++)
+			{
+				unsortedBuffer->counters[i].drawCount.store(0);
+				unsortedBuffer->counters[i].instanceCount.store(0);
+			}
 			// Note: Still setting buffer system to reuse last mem allocation sizes.
 
-			if (componentCount == 0 || !meshSystem->isDrawReady(shadowPass))
+			auto viewMask = componentCount > 0 ? 
+				calcSystemViewMask(meshSystem, views.data(), viewCount, false) : 0;
+			unsortedBuffer->viewMask = viewMask;
+			if (viewMask == 0)
 				continue;
 
-			if (unsortedBuffer->combinedMeshes.size() < componentCount)
-				unsortedBuffer->combinedMeshes.resize(componentCount);
+			auto collectOccluders = useOcclusionCulling && (viewMask & 1u) && 
+				(renderType == MeshRenderType::Color || renderType == MeshRenderType::Opaque);
+			prepareCulling(manager, unsortedBuffer, componentPool.getOccupancy(), 
+				isChanged || lastViewMask != viewMask, true, collectOccluders);
 
-			hasAnyRefr |= renderType == MeshRenderType::Refracted;
-			hasAnyOIT |= renderType == MeshRenderType::OIT;
-			hasAnyTD |= renderType == MeshRenderType::TransDepth;
-			
-			if (threadSystem)
+			for (uint32 i = 0; i < viewCount; i++)
 			{
-				auto& threadPool = threadSystem->getForegroundPool();
-				if (unsortedBuffer->threadMeshes.size() < threadPool.getThreadCount())
-					unsortedBuffer->threadMeshes.resize(threadPool.getThreadCount());
-
-				threadPool.addItems([=](const ThreadPool::Task& task)
-				{
-					prepareUnsortedMeshes(cameraOffset, cameraPosition, viewFrustum, unsortedBuffer, 
-						task.getItemOffset(), task.getItemCount(), task.getThreadIndex(), shadowPass, true);
-				},
-				componentPool.getOccupancy());
+				auto& combinedMeshes = unsortedBuffer->combinedMeshes[i];
+				if ((viewMask & (1u << i)) && combinedMeshes.size() < componentCount)
+					combinedMeshes.resize(componentCount);
 			}
-			else
+
+			if (viewMask & 1u)
 			{
-				prepareUnsortedMeshes(cameraOffset, cameraPosition, viewFrustum,
-					unsortedBuffer, 0, componentPool.getOccupancy(), 0, shadowPass, false);
+				hasAnyRefr |= renderType == MeshRenderType::Refracted;
+				hasAnyOIT |= renderType == MeshRenderType::OIT;
+				hasAnyTD |= renderType == MeshRenderType::TransDepth;
 			}
 
+			unsortedBuffer->cullJob = cullMeshBuffer(threadPool, cullJobs, views.data(), viewCount, 
+				nullptr, cameraPosition, unsortedBuffer, componentPool.getOccupancy());
+
 			#if GARDEN_EDITOR
-			if (graphicsEditorSystem)
+			if (graphicsEditorSystem && (viewMask & 1u))
 			{
 				if (renderType == MeshRenderType::OIT || renderType == 
 					MeshRenderType::Refracted || renderType == MeshRenderType::TransDepth)
@@ -520,12 +1618,84 @@ void MeshRenderSystem::prepareMeshes(const Frustum& viewFrustum,
 			}
 			#endif	
 		}
-	}		
+	}
+
+	auto occlusionJob = useOcclusionCulling ? prepareOcclusion(threadPool) : ThreadPool::Job();
+	auto occlusion = useOcclusionCulling ? &occlusionBuffer : nullptr;
+
+	for (uint32 bufferIndex = 0; bufferIndex < sortedBufferCount; bufferIndex++)
+	{
+		auto sortedBuffer = sortedBuffers[bufferIndex];
+		if (sortedBuffer->viewMask == 0)
+			continue;
+
+		auto componentOccupancy = sortedBuffer->meshSystem->getMeshComponentPool().getOccupancy();
+		auto isUI = sortedBuffer->meshSystem->getMeshRenderType() == MeshRenderType::UI;
+		auto sortedCameraPos = isUI ? f32x4::zero : cameraPosition;
+		auto sortedPlanes = isUI ? (const f32x4*)uiPlanes : nullptr;
+		auto sortedOcclusion = isUI ? nullptr : occlusion;
+
+		if (threadPool)
+		{
+			if (sortedThreadMeshes.size() < threadPool->getThreadCount())
+				sortedThreadMeshes.resize(threadPool->getThreadCount());
+
+			// Note: do not optimize args with [&], it captures stack address!!!
+			// Note: UI buffers do not wait for the occluder select job, so they must never read hasOccluders.
+			sortedBuffer->prepareJob = threadPool->addItems([this, viewCount, sortedCameraPos, 
+				sortedPlanes, sortedBuffer, sortedOcclusion, bufferIndex](const ThreadPool::Task& task)
+			{
+				prepareSortedMeshes(views.data(), viewCount, sortedCameraPos, sortedPlanes, sortedBuffer, 
+					sortedOcclusion && hasOccluders ? sortedOcclusion : nullptr, uiSortedMeshes.data(), &uiDrawIndex, 
+					sortedThreadMeshes, bufferIndex, task.getItemOffset(), task.getItemCount(), 
+					task.getThreadIndex(), true);
+			},
+			componentOccupancy, ThreadPool::priorityNormal, combineJobs(threadPool, cullJobs, sortedBuffer->cullJob, 
+				sortedOcclusion ? occlusionJob : ThreadPool::Job()), ThreadPool::defaultGrainSize);
+
+			if (isUI)
+				uiPrepareJobs.push_back(sortedBuffer->prepareJob);
+			else transPrepareJobs.push_back(sortedBuffer->prepareJob);
+		}
+		else
+		{
+			prepareSortedMeshes(views.data(), viewCount, sortedCameraPos, sortedPlanes, sortedBuffer, 
+				sortedOcclusion && hasOccluders ? sortedOcclusion : nullptr, uiSortedMeshes.data(), &uiDrawIndex, 
+				sortedThreadMeshes, bufferIndex, 0, componentOccupancy, 0, false);
+		}
+	}
+	for (uint32 bufferIndex = 0; bufferIndex < unsortedBufferCount; bufferIndex++)
+	{
+		auto unsortedBuffer = unsortedBuffers[bufferIndex];
+		if (unsortedBuffer->viewMask == 0)
+			continue;
+
+		auto componentOccupancy = unsortedBuffer->meshSystem->getMeshComponentPool().getOccupancy();
+		if (threadPool)
+		{
+			if (unsortedBuffer->threadMeshes.size() < threadPool->getThreadCount())
+				unsortedBuffer->threadMeshes.resize(threadPool->getThreadCount());
+
+			unsortedBuffer->prepareJob = threadPool->addItems([this, viewCount, 
+				cameraPosition, unsortedBuffer, occlusion](const ThreadPool::Task& task)
+			{
+				prepareUnsortedMeshes(views.data(), viewCount, cameraPosition, unsortedBuffer, 
+					hasOccluders ? occlusion : nullptr, task.getItemOffset(), task.getItemCount(), 
+					task.getThreadIndex(), true);
+			},
+			componentOccupancy, ThreadPool::priorityNormal, combineJobs(threadPool, cullJobs, 
+				unsortedBuffer->cullJob, occlusionJob), ThreadPool::defaultGrainSize);
+		}
+		else
+		{
+			prepareUnsortedMeshes(views.data(), viewCount, cameraPosition, unsortedBuffer, 
+				hasOccluders ? occlusion : nullptr, 0, componentOccupancy, 0, false);
+		}
+	}
 
 	if (!meshSystems.empty())
 	{
-		if (threadSystem)
-			threadSystem->getForegroundPool().wait();
+		sortMeshes(); // Note: Also waits for the async preparing jobs.
 
 		#if GARDEN_EDITOR
 		if (graphicsEditorSystem)
@@ -534,51 +1704,49 @@ void MeshRenderSystem::prepareMeshes(const Frustum& viewFrustum,
 			{
 				auto unsortedBuffer = unsortedBuffers[i];
 				auto renderType = unsortedBuffer->meshSystem->getMeshRenderType();
+				auto drawCount = unsortedBuffer->counters[0].drawCount.load();
 				if (renderType == MeshRenderType::OIT || renderType == 
 					MeshRenderType::Refracted || renderType == MeshRenderType::TransDepth)
 				{
-					graphicsEditorSystem->translucentDrawCount += unsortedBuffer->drawCount.load();
+					graphicsEditorSystem->translucentDrawCount += drawCount;
 				}
-				else graphicsEditorSystem->opaqueDrawCount += unsortedBuffer->drawCount.load();
+				else graphicsEditorSystem->opaqueDrawCount += drawCount;
 			}
-			graphicsEditorSystem->translucentDrawCount += transDrawIndex.load() + uiDrawIndex.load();
+			graphicsEditorSystem->translucentDrawCount += views[0]->transDrawIndex.load() + uiDrawIndex.load();
 		}
-		#endif	
-
-		sortMeshes();
-
-		if (threadSystem)
-			threadSystem->getForegroundPool().wait();
+		#endif
 	}
 }
 
 //**********************************************************************************************************************
-void MeshRenderSystem::renderUnsorted(const f32x4x4& viewProj, MeshRenderType renderType, int8 shadowPass)
+void MeshRenderSystem::renderUnsorted(const f32x4x4& viewProj, MeshRenderType renderType, uint8 viewIndex)
 {
 	SET_CPU_ZONE_SCOPED("Unsorted Mesh Render");
 
 	auto threadSystem = asyncRecording ? ThreadSystem::Instance::tryGet() : nullptr;
+	auto shadowPass = views[viewIndex]->shadowPass;
+
 	for (uint32 bufferIndex = 0; bufferIndex < unsortedBufferCount; bufferIndex++)
 	{
 		auto unsortedBuffer = unsortedBuffers[bufferIndex];
 		auto meshSystem = unsortedBuffer->meshSystem;
-		auto drawCount = unsortedBuffer->drawCount.load();
+		auto drawCount = unsortedBuffer->counters[viewIndex].drawCount.load();
 		if (drawCount == 0 || meshSystem->getMeshRenderType() != renderType)
 			continue;
 
-		auto& instanceCount = unsortedBuffer->instanceCount;
+		auto& instanceCount = unsortedBuffer->counters[viewIndex].instanceCount;
 		meshSystem->prepareDraw(viewProj, drawCount, instanceCount.load(), shadowPass);
 		auto totalInstanceCount = instanceCount.load(); instanceCount.store(0);
+		const auto meshes = unsortedBuffer->combinedMeshes[viewIndex].data();
 
 		if (threadSystem)
 		{
 			auto& threadPool = threadSystem->getForegroundPool();
-			threadPool.addItems([unsortedBuffer, &viewProj, &instanceCount](const ThreadPool::Task& task)
+			threadPool.addItems([unsortedBuffer, meshes, &viewProj, &instanceCount](const ThreadPool::Task& task)
 			{
 				SET_CPU_ZONE_SCOPED("Unsorted Mesh Draw");
 
 				auto meshSystem = unsortedBuffer->meshSystem;
-				const auto meshes = unsortedBuffer->combinedMeshes.data();
 				auto componentSize = meshSystem->getMeshComponentSize();
 				auto componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
 				// Note: Using task index instead of thread to preserve items order.
@@ -608,7 +1776,6 @@ void MeshRenderSystem::renderUnsorted(const f32x4x4& viewProj, MeshRenderType re
 		{
 			SET_CPU_ZONE_SCOPED("Unsorted Mesh Draw");
 
-			const auto meshes = unsortedBuffer->combinedMeshes.data();
 			auto componentSize = meshSystem->getMeshComponentSize();
 			auto componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
 			uint32 drawInstanceCount = 0;
@@ -636,15 +1803,16 @@ void MeshRenderSystem::renderUnsorted(const f32x4x4& viewProj, MeshRenderType re
 }
 
 //**********************************************************************************************************************
-void MeshRenderSystem::renderSorted(const f32x4x4& viewProj, MeshRenderType renderType, int8 shadowPass)
+void MeshRenderSystem::renderSorted(const f32x4x4& viewProj, MeshRenderType renderType, uint8 viewIndex)
 {
 	SET_CPU_ZONE_SCOPED("Sorted Mesh Render");
 
+	auto view = views[viewIndex];
 	const SortedMesh* combinedSortedMeshes; uint32 totalDrawCount;
 	if (renderType == MeshRenderType::Translucent)
 	{
-		combinedSortedMeshes = transSortedMeshes.data();
-		totalDrawCount = transDrawIndex.load();
+		combinedSortedMeshes = view->transMeshes.data();
+		totalDrawCount = view->transDrawIndex.load();
 	}
 	else if (renderType == MeshRenderType::UI)
 	{
@@ -660,26 +1828,27 @@ void MeshRenderSystem::renderSorted(const f32x4x4& viewProj, MeshRenderType rend
 	{
 		auto sortedBuffer = sortedBuffers[bufferIndex];
 		auto meshSystem = sortedBuffer->meshSystem;
-		auto drawCount = sortedBuffer->drawCount.load();
+		auto& counter = sortedBuffer->counters[viewIndex];
+		auto drawCount = counter.drawCount.load();
 		if (drawCount == 0 || meshSystem->getMeshRenderType() != renderType)
 			continue;
 
-		auto instanceCount = sortedBuffer->instanceCount.load();
-		meshSystem->prepareDraw(viewProj, drawCount, instanceCount, shadowPass);
-		sortedBuffer->instanceCount.store(0); // Note: Reusing instanceCount for rendering.
+		auto instanceCount = counter.instanceCount.load();
+		meshSystem->prepareDraw(viewProj, drawCount, instanceCount, view->shadowPass);
+		counter.instanceCount.store(0); // Note: Reusing instanceCount for rendering.
 	}
 
 	auto threadSystem = asyncRecording ? ThreadSystem::Instance::tryGet() : nullptr;
 	if (threadSystem)
 	{
 		auto& threadPool = threadSystem->getForegroundPool();
-		threadPool.addItems([this, &viewProj, combinedSortedMeshes](const ThreadPool::Task& task)
+		threadPool.addItems([this, &viewProj, combinedSortedMeshes, viewIndex](const ThreadPool::Task& task)
 		{
 			SET_CPU_ZONE_SCOPED("Sorted Mesh Draw");
 
 			auto bufferIndex = combinedSortedMeshes[task.getItemOffset()].bufferIndex;
 			auto meshSystem = sortedBuffers[bufferIndex]->meshSystem;
-			auto instanceCount = &sortedBuffers[bufferIndex]->instanceCount;
+			auto instanceCount = &sortedBuffers[bufferIndex]->counters[viewIndex].instanceCount;
 			auto componentSize = meshSystem->getMeshComponentSize();
 			auto componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
 			// Note: Using task index instead of thread to preserve items order.
@@ -697,7 +1866,7 @@ void MeshRenderSystem::renderSorted(const f32x4x4& viewProj, MeshRenderType rend
 					bufferIndex = mesh.bufferIndex; drawInstanceCount = 0;
 
 					meshSystem = sortedBuffers[bufferIndex]->meshSystem;
-					instanceCount = &sortedBuffers[bufferIndex]->instanceCount;
+					instanceCount = &sortedBuffers[bufferIndex]->counters[viewIndex].instanceCount;
 					componentSize = meshSystem->getMeshComponentSize();
 					componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
 					meshSystem->beginDrawAsync(taskIndex);
@@ -724,7 +1893,7 @@ void MeshRenderSystem::renderSorted(const f32x4x4& viewProj, MeshRenderType rend
 
 		auto bufferIndex = combinedSortedMeshes[0].bufferIndex;
 		auto meshSystem = sortedBuffers[bufferIndex]->meshSystem;
-		auto instanceCount = &sortedBuffers[bufferIndex]->instanceCount;
+		auto instanceCount = &sortedBuffers[bufferIndex]->counters[viewIndex].instanceCount;
 		auto componentSize = meshSystem->getMeshComponentSize();
 		auto componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
 		uint32 drawInstanceCount = 0;
@@ -740,7 +1909,7 @@ void MeshRenderSystem::renderSorted(const f32x4x4& viewProj, MeshRenderType rend
 				bufferIndex = mesh.bufferIndex; drawInstanceCount = 0;
 
 				meshSystem = sortedBuffers[bufferIndex]->meshSystem;
-				instanceCount = &sortedBuffers[bufferIndex]->instanceCount;
+				instanceCount = &sortedBuffers[bufferIndex]->counters[viewIndex].instanceCount;
 				componentSize = meshSystem->getMeshComponentSize();
 				componentData = (uint8*)meshSystem->getMeshComponentPool().getData();
 				meshSystem->beginDrawAsync(-1);
@@ -762,32 +1931,38 @@ void MeshRenderSystem::renderSorted(const f32x4x4& viewProj, MeshRenderType rend
 	for (uint32 bufferIndex = 0; bufferIndex < sortedBufferCount; bufferIndex++)
 	{
 		auto sortedBuffer = sortedBuffers[bufferIndex];
-		auto instanceCount = sortedBuffer->instanceCount.load();
-		if (instanceCount == 0)
+		auto instanceCount = sortedBuffer->counters[viewIndex].instanceCount.load();
+		if (instanceCount == 0 || sortedBuffer->meshSystem->getMeshRenderType() != renderType)
 			continue;
 		sortedBuffer->meshSystem->finalizeDraw(instanceCount);
 	}
 }
 
 //**********************************************************************************************************************
-void MeshRenderSystem::cleanupMeshes()
+static bool hasAnyDraws(const MeshRenderSystem::MeshBuffer* meshBuffer, uint8 viewOffset, uint8 viewCount) noexcept
+{
+	for (uint8 i = viewOffset; i < viewOffset + viewCount; i++)
+	{
+		if (meshBuffer->counters[i].drawCount.load() > 0)
+			return true;
+	}
+	return false;
+}
+void MeshRenderSystem::cleanupMeshes(uint8 viewOffset, uint8 viewCount)
 {
 	for (uint32 i = 0; i < unsortedBufferCount; i++)
 	{
 		auto unsortedBuffer = unsortedBuffers[i];
-		if (unsortedBuffer->drawCount.load() == 0)
+		if (!hasAnyDraws(unsortedBuffer, viewOffset, viewCount))
 			continue;
 		unsortedBuffer->meshSystem->renderCleanup();
 	}
-	if (transDrawIndex.load() > 0 || uiDrawIndex.load() > 0)
+	for (uint32 i = 0; i < sortedBufferCount; i++)
 	{
-		for (uint32 i = 0; i < sortedBufferCount; i++)
-		{
-			auto sortedBuffer = sortedBuffers[i];
-			if (sortedBuffer->drawCount.load() == 0)
-				continue;
-			sortedBuffer->meshSystem->renderCleanup();
-		}
+		auto sortedBuffer = sortedBuffers[i];
+		if (!hasAnyDraws(sortedBuffer, viewOffset, viewCount))
+			continue;
+		sortedBuffer->meshSystem->renderCleanup();
 	}
 }
 
@@ -796,77 +1971,61 @@ void MeshRenderSystem::renderShadows()
 {
 	SET_CPU_ZONE_SCOPED("Shadows Mesh Render");
 
-	auto systemGroup = Manager::Instance::get()->tryGetSystemGroup<IShadowMeshRenderSystem>();
-	if (!systemGroup)
-		return;
-
+	// Note: Shadow pass draw lists are already prepared in the same culling sweep as the camera ones.
 	auto graphicsSystem = GraphicsSystem::Instance::get();
-	for (auto system : *systemGroup)
+	uint8 systemViewOffset = 1;
+
+	for (uint8 viewIndex = 1; viewIndex < viewCount; viewIndex++)
 	{
-		auto shadowSystem = dynamic_cast<IShadowMeshRenderSystem*>(system);
-		auto passCount = shadowSystem->getShadowPassCount();
+		auto view = views[viewIndex];
+		auto shadowSystem = view->shadowSystem;
+		auto passIndex = (uint32)view->shadowPass;
+		const auto& viewProj = view->viewProj;
 
-		for (uint8 passIndex = 0; passIndex < passCount; passIndex++)
+		graphicsSystem->startRecording(CommandBufferType::Frame);
 		{
-			f32x4x4 viewProj; f32x4 cameraOffset;
-			if (!shadowSystem->prepareShadowRender(passIndex, viewProj, cameraOffset))
-				continue;
-
-			prepareMeshes(Frustum(viewProj), nullptr, cameraOffset, passIndex);
+			SET_CPU_ZONE_SCOPED("Opaque Shadow Render");
+			SET_GPU_DEBUG_LABEL("Opaque Shadow Pass");
 
-			graphicsSystem->startRecording(CommandBufferType::Frame);
+			if (shadowSystem->beginShadowRender(passIndex, MeshRenderType::Opaque))
 			{
-				SET_CPU_ZONE_SCOPED("Opaque Shadow Render");
-				SET_GPU_DEBUG_LABEL("Opaque Shadow Pass");
-
-				if (shadowSystem->beginShadowRender(passIndex, MeshRenderType::Opaque))
-				{
-					renderUnsorted(viewProj, MeshRenderType::Opaque, passIndex);
-					renderUnsorted(viewProj, MeshRenderType::Color, passIndex);
-					// Note: No TransDepth rendering for shadows, expected RT instead.
-					shadowSystem->endShadowRender(passIndex, MeshRenderType::Opaque);
-				}
+				renderUnsorted(viewProj, MeshRenderType::Opaque, viewIndex);
+				renderUnsorted(viewProj, MeshRenderType::Color, viewIndex);
+				// Note: No TransDepth rendering for shadows, expected RT instead.
+				shadowSystem->endShadowRender(passIndex, MeshRenderType::Opaque);
 			}
-			{
-				SET_CPU_ZONE_SCOPED("Trans Shadow Render");
-				SET_GPU_DEBUG_LABEL("Trans Shadow Pass");
+		}
+		{
+			SET_CPU_ZONE_SCOPED("Trans Shadow Render");
+			SET_GPU_DEBUG_LABEL("Trans Shadow Pass");
 
-				if (!isNonTranslucent && shadowSystem->beginShadowRender(passIndex, MeshRenderType::Translucent))
-				{
-					renderUnsorted(viewProj, MeshRenderType::Refracted, passIndex);
-					renderUnsorted(viewProj, MeshRenderType::OIT, passIndex);
-					renderSorted(viewProj, MeshRenderType::Translucent, passIndex);
-					shadowSystem->endShadowRender(passIndex, MeshRenderType::Translucent);
-				}
+			if (!isNonTranslucent && shadowSystem->beginShadowRender(passIndex, MeshRenderType::Translucent))
+			{
+				renderUnsorted(viewProj, MeshRenderType::Refracted, viewIndex);
+				renderUnsorted(viewProj, MeshRenderType::OIT, viewIndex);
+				renderSorted(viewProj, MeshRenderType::Translucent, viewIndex);
+				shadowSystem->endShadowRender(passIndex, MeshRenderType::Translucent);
 			}
-			graphicsSystem->stopRecording();
 		}
+		graphicsSystem->stopRecording();
 
-		cleanupMeshes();
+		if (viewIndex + 1 == viewCount || views[viewIndex + 1]->shadowSystem != shadowSystem)
+		{
+			cleanupMeshes(systemViewOffset, viewIndex + 1 - systemViewOffset);
+			systemViewOffset = viewIndex + 1;
+		}
 	}
 }
 
 //**********************************************************************************************************************
-static f32x4x4 calcUiProjView() noexcept
-{
-	auto halfSize = float2(0.5f);
-	auto uiTransformSystem = UiTransformSystem::Instance::tryGet();
-	if (uiTransformSystem)
-		halfSize *= uiTransformSystem->getUiSize();
-	return (f32x4x4)calcOrthoProjRevZ(float2(-halfSize.x, halfSize.x), 
-		float2(-halfSize.y, halfSize.y), float2(-1.0f, 1.0f));
-}
-
 void MeshRenderSystem::preForwardRender()
 {
 	SET_CPU_ZONE_SCOPED("Mesh Pre Forward Render");
 
 	prepareSystems();
+	prepareViews();
+	prepareMeshes();
 	renderShadows();
-
-	auto uiFrustum = Frustum(calcUiProjView());
-	const auto& cc = GraphicsSystem::Instance::get()->getCommonConstants();
-	prepareMeshes(Frustum(cc.viewProj), &uiFrustum, f32x4::zero, -1);
 }
 
 void MeshRenderSystem::forwardRender()
@@ -875,18 +2034,18 @@ void MeshRenderSystem::forwardRender()
 
 	auto graphicsSystem = GraphicsSystem::Instance::get();
 	const auto& cc = graphicsSystem->getCommonConstants();
-	renderUnsorted(cc.viewProj, MeshRenderType::Opaque, -1);
-	renderUnsorted(cc.viewProj, MeshRenderType::Color, -1);
+	renderUnsorted(cc.viewProj, MeshRenderType::Opaque, 0);
+	renderUnsorted(cc.viewProj, MeshRenderType::Color, 0);
 
 	if (!isNonTranslucent)
 	{
-		renderUnsorted(cc.viewProj, MeshRenderType::Refracted, -1);
-		renderUnsorted(cc.viewProj, MeshRenderType::OIT, -1);
-		renderUnsorted(cc.viewProj, MeshRenderType::TransDepth, -1);
-		renderSorted(cc.viewProj, MeshRenderType::Translucent, -1);
+		renderUnsorted(cc.viewProj, MeshRenderType::Refracted, 0);
+		renderUnsorted(cc.viewProj, MeshRenderType::OIT, 0);
+		renderUnsorted(cc.viewProj, MeshRenderType::TransDepth, 0);
+		renderSorted(cc.viewProj, MeshRenderType::Translucent, 0);
 	}
 
-	renderSorted(calcUiProjView(), MeshRenderType::UI, -1);
+	renderSorted(calcUiProjView(), MeshRenderType::UI, 0);
 }
 
 //**********************************************************************************************************************
@@ -895,25 +2054,23 @@ void MeshRenderSystem::preDeferredRender()
 	SET_CPU_ZONE_SCOPED("Mesh Pre Deferred Render");
 
 	prepareSystems();
+	prepareViews();
+	prepareMeshes();
 	renderShadows();
-
-	auto uiFrustum = Frustum(calcUiProjView());
-	const auto& cc = GraphicsSystem::Instance::get()->getCommonConstants();
-	prepareMeshes(Frustum(cc.viewProj), &uiFrustum, f32x4::zero, -1);
 }
 void MeshRenderSystem::deferredRender()
 {
 	SET_CPU_ZONE_SCOPED("Mesh Deferred Render");
 
 	const auto& cc = GraphicsSystem::Instance::get()->getCommonConstants();
-	renderUnsorted(cc.viewProj, MeshRenderType::Opaque, -1);
+	renderUnsorted(cc.viewProj, MeshRenderType::Opaque, 0);
 }
 void MeshRenderSystem::dsHdrRender()
 {
 	SET_CPU_ZONE_SCOPED("Mesh Depth/Stencil HDR Render");
 
 	const auto& cc = GraphicsSystem::Instance::get()->getCommonConstants();
-	renderUnsorted(cc.viewProj, MeshRenderType::Color, -1);
+	renderUnsorted(cc.viewProj, MeshRenderType::Color, 0);
 }
 void MeshRenderSystem::preRefrRender()
 {
@@ -931,7 +2088,7 @@ void MeshRenderSystem::refrRender()
 		return;
 
 	const auto& cc = GraphicsSystem::Instance::get()->getCommonConstants();
-	renderUnsorted(cc.viewProj, MeshRenderType::Refracted, -1);
+	renderUnsorted(cc.viewProj, MeshRenderType::Refracted, 0);
 }
 void MeshRenderSystem::transRender()
 {
@@ -941,7 +2098,7 @@ void MeshRenderSystem::transRender()
 		return;
 
 	const auto& cc = GraphicsSystem::Instance::get()->getCommonConstants();
-	renderSorted(cc.viewProj, MeshRenderType::Translucent, -1);
+	renderSorted(cc.viewProj, MeshRenderType::Translucent, 0);
 }
 void MeshRenderSystem::preTransDepthRender()
 {
@@ -959,7 +2116,7 @@ void MeshRenderSystem::transDepthRender()
 		return;
 
 	const auto& cc = GraphicsSystem::Instance::get()->getCommonConstants();
-	renderUnsorted(cc.viewProj, MeshRenderType::TransDepth, -1);
+	renderUnsorted(cc.viewProj, MeshRenderType::TransDepth, 0);
 }
 void MeshRenderSystem::preOitRender()
 {
@@ -977,14 +2134,22 @@ void MeshRenderSystem::oitRender()
 		return;
 
 	const auto& cc = GraphicsSystem::Instance::get()->getCommonConstants();
-	renderUnsorted(cc.viewProj, MeshRenderType::OIT, -1);
+	renderUnsorted(cc.viewProj, MeshRenderType::OIT, 0);
 }
 void MeshRenderSystem::uiRender()
 {
 	SET_CPU_ZONE_SCOPED("Mesh UI Render");
 
 	auto graphicsSystem = GraphicsSystem::Instance::get();
-	renderSorted(calcUiProjView(), MeshRenderType::UI, -1);
+	renderSorted(calcUiProjView(), MeshRenderType::UI, 0);
+}
+
+void MeshRenderSystem::markStaticMeshesDirty() noexcept
+{
+	for (auto unsortedBuffer : unsortedBuffers)
+		unsortedBuffer->staticTree.isDirty.store(true);
+	for (auto sortedBuffer : sortedBuffers)
+		sortedBuffer->staticTree.isDirty.store(true);
 }
 
 //**********************************************************************************************************************
@@ -17,12 +17,15 @@
 #include "garden/system/render/deferred.hpp"
 #include "garden/system/resource.hpp"
 #include "garden/system/settings.hpp"
+#include "garden/system/app-info.hpp"
 #include "garden/system/thread.hpp"
+#include "garden/system/log.hpp"
 #include "garden/profiler.hpp"
 #include "common/gbuffer.h"
 
 #include "math/brdf.hpp"
 #include "math/sh.hpp"
+#include <fstream>
 
 using namespace garden;
 using namespace math::sh;
@@ -115,47 +118,60 @@ static void computeKi(int32 bandCount) noexcept
 #endif
 
 //**********************************************************************************************************************
-static constexpr float pow5(float x) noexcept
-{
-	float x2 = x * x;
-	return x2 * x2 * x;
-}
 static float log4(float x) noexcept
 {
 	return log2(x) * 0.5f;
 }
 
-static float smithGGXCorrelated(float nov, float nol, float linearRoughness) noexcept
-{
-	auto a2 = linearRoughness * linearRoughness;
-	auto lambdaV = nol * sqrt(fma(nov - nov * a2, nov, a2));
-	auto lambdaL = nov * sqrt(fma(nol - nol * a2, nol, a2));
-	return 0.5f / (lambdaV + lambdaL);
-}
-static float2 dfvMultiscatter(uint32 x, uint32 y, uint32 dfgSize, uint32 sampleCount) noexcept
+static void createDfvSamples(uint32 sampleCount, vector<f32x4>& dfvSamples)
 {
+	GARDEN_ASSERT(sampleCount % 4 == 0);
+	dfvSamples.resize(sampleCount / 2);
 	auto invSampleCount = 1.0f / sampleCount;
-	auto nov = saturate((x + 0.5f) / dfgSize);
-	auto coord = saturate((dfgSize - y + 0.5f) / dfgSize);
-	auto v = f32x4(sqrt(1.0f - nov * nov), 0.0f, nov);
-	auto linearRoughness = coord * coord;
 
-	auto r = float2(0.0f);
-	for (uint32 i = 0; i < sampleCount; i++)
+	// Note: Hammersley points do not depend on the texel, so we precompute them as the SoA table.
+	for (uint32 i = 0; i < sampleCount; i += 4)
 	{
-		auto u = hammersley(i, invSampleCount);
-		auto h = importanceSamplingNdfDggx(u, linearRoughness);
-		auto voh = dot3(v, h); auto l = voh * h * 2.0f - v; voh = saturate(voh);
-		auto nol = saturate(l.getZ()), noh = saturate(h.getZ());
-
-		if (nol > 0.0f)
+		float cosPhi[4], uy[4];
+		for (uint32 j = 0; j < 4; j++)
 		{
-			auto visibility = smithGGXCorrelated(
-				nov, nol, linearRoughness) * nol * (voh / noh);
-			auto fc = pow5(1.0f - voh);
-			r.x += visibility * fc; r.y += visibility;
+			auto u = hammersley(i + j, invSampleCount);
+			cosPhi[j] = cos(u.x * float(M_PI * 2.0)); uy[j] = u.y;
 		}
+		dfvSamples[i / 2] = f32x4(cosPhi[0], cosPhi[1], cosPhi[2], cosPhi[3]);
+		dfvSamples[i / 2 + 1] = f32x4(uy[0], uy[1], uy[2], uy[3]);
 	}
+}
+
+// Note: Integrates 4 GGX samples at a time. View vector lies in the XZ plane, so half vector sin(phi) is not
+//       required. Samples below the horizon have zero NoL which zeroes visibility, so lanes are not masked.
+static float2 dfvMultiscatter(const f32x4* dfvSamples, uint32 x, uint32 y, uint32 dfgSize, uint32 sampleCount) noexcept
+{
+	auto nov = saturate((x + 0.5f) / dfgSize);
+	auto coord = saturate((dfgSize - y + 0.5f) / dfgSize);
+	auto linearRoughness = coord * coord, a2 = linearRoughness * linearRoughness;
+	auto lambdaV = sqrt(fma(nov - nov * a2, nov, a2));
+
+	auto vx = f32x4(sqrt(1.0f - nov * nov)), vz = f32x4(nov);
+	auto a2x4 = f32x4(a2), a2m1 = f32x4(a2 - 1.0f), novx4 = f32x4(nov), lambdaVx4 = f32x4(lambdaV);
+	auto rx = f32x4::zero, ry = f32x4::zero;
+
+	for (uint32 i = 0; i < sampleCount; i += 4)
+	{
+		auto cosPhi = dfvSamples[i / 2], uy = dfvSamples[i / 2 + 1];
+		auto noh2 = (f32x4::one - uy) / (a2m1 * uy + f32x4::one);
+		auto noh = sqrt(noh2), hx = sqrt(f32x4::one - noh2) * cosPhi;
+		auto voh = hx * vx + noh * vz;
+		auto nol = min(max(voh * noh * 2.0f - vz, f32x4::zero), f32x4::one);
+		voh = min(max(voh, f32x4::zero), f32x4::one);
+
+		auto lambdaL = novx4 * sqrt((nol - nol * a2x4) * nol + a2x4);
+		auto visibility = (f32x4(0.5f) / (nol * lambdaVx4 + lambdaL)) * nol * (voh / noh);
+		auto fc = f32x4::one - voh, fc2 = fc * fc;
+		rx += visibility * (fc2 * fc2 * fc); ry += visibility;
+	}
+
+	auto r = float2(rx.getX() + rx.getY() + rx.getZ() + rx.getW(), ry.getX() + ry.getY() + ry.getZ() + ry.getW());
 	return r * (4.0f / sampleCount);
 }
 
@@ -376,6 +392,109 @@ static ID<ComputePipeline> createIblSpecularPipeline()
 	return ResourceSystem::Instance::get()->loadComputePipeline("ibl-specular", options);
 }
 
+//**********************************************************************************************************************
+namespace
+{
+	struct PbrCacheHeader final
+	{
+		uint32 magic = 0;
+		uint32 version = 0;
+		uint64 dataSize = 0;
+		Hash128 dataHash = {};
+	};
+	struct PbrCacheChunk final
+	{
+		void* data = nullptr;
+		psize size = 0;
+	};
+}
+
+static constexpr uint32 pbrCacheMagic = 0x43524250; // PBRC
+static constexpr uint32 pbrCacheVersion = 1;
+
+static fs::path getPbrCachePath(string_view name, const Hash128& key)
+{
+	auto appInfoSystem = AppInfoSystem::Instance::tryGet();
+	if (!appInfoSystem)
+		return {};
+	return appInfoSystem->getCachePath() / "pbr" / (string(name) + "-" + key.toBase64URL() + ".bin");
+}
+static fs::path getPbrCachePath(string_view name, const uint32* keyValues, uint32 keyCount)
+{
+	return getPbrCachePath(name, Hash128(keyValues, keyCount * sizeof(uint32)));
+}
+
+static bool tryLoadPbrCache(const fs::path& filePath, const PbrCacheChunk* chunks, uint32 chunkCount)
+{
+	if (filePath.empty())
+		return false;
+
+	ifstream inputStream(filePath, ios::in | ios::binary);
+	if (!inputStream.is_open())
+		return false;
+
+	uint64 dataSize = 0;
+	for (uint32 i = 0; i < chunkCount; i++)
+		dataSize += chunks[i].size;
+
+	PbrCacheHeader header;
+	if (!inputStream.read((char*)&header, sizeof(PbrCacheHeader)) || header.magic != pbrCacheMagic || 
+		header.version != pbrCacheVersion || header.dataSize != dataSize)
+	{
+		return false;
+	}
+
+	auto hashState = Hash128::getState();
+	Hash128::resetState(hashState);
+
+	for (uint32 i = 0; i < chunkCount; i++)
+	{
+		const auto& chunk = chunks[i];
+		if (!inputStream.read((char*)chunk.data, chunk.size))
+			return false;
+		Hash128::updateState(hashState, chunk.data, chunk.size);
+	}
+
+	// Note: Detects truncated or corrupted files left by the interrupted writes.
+	return header.dataHash == Hash128::digestState(hashState);
+}
+static void tryStorePbrCache(const fs::path& filePath, const PbrCacheChunk* chunks, uint32 chunkCount)
+{
+	if (filePath.empty())
+		return;
+
+	try
+	{
+		PbrCacheHeader header;
+		header.magic = pbrCacheMagic;
+		header.version = pbrCacheVersion;
+
+		auto hashState = Hash128::getState();
+		Hash128::resetState(hashState);
+
+		for (uint32 i = 0; i < chunkCount; i++)
+		{
+			const auto& chunk = chunks[i];
+			Hash128::updateState(hashState, chunk.data, chunk.size);
+			header.dataSize += chunk.size;
+		}
+		header.dataHash = Hash128::digestState(hashState);
+
+		fs::create_directories(filePath.parent_path());
+		ofstream outputStream(filePath, ios::out | ios::binary);
+		if (!outputStream.is_open())
+			return;
+
+		outputStream.write((const char*)&header, sizeof(PbrCacheHeader));
+		for (uint32 i = 0; i < chunkCount; i++)
+			outputStream.write((const char*)chunks[i].data, chunks[i].size);
+	}
+	catch (const exception& e)
+	{
+		GARDEN_LOG_WARN("Failed to store PBR cache file. (error: " + string(e.what()) + ")");
+	}
+}
+
 //**********************************************************************************************************************
 static ID<Image> createDfgLUT(GraphicsSystem* graphicsSystem, uint32 dfgSize)
 {
@@ -383,34 +502,47 @@ static ID<Image> createDfgLUT(GraphicsSystem* graphicsSystem, uint32 dfgSize)
 	vector<float2> pixels(dfgSize * dfgSize);
 	auto pixelData = pixels.data();
 
-	auto threadSystem = ThreadSystem::Instance::tryGet();
-	if (threadSystem)
+	uint32 cacheKey[] = { dfgSize, sampleCount };
+	auto cachePath = getPbrCachePath("dfg-lut", cacheKey, 2);
+	PbrCacheChunk cacheChunk = { pixelData, pixels.size() * sizeof(float2) };
+
+	if (!tryLoadPbrCache(cachePath, &cacheChunk, 1))
 	{
-		auto& threadPool = threadSystem->getForegroundPool();
-		threadPool.addItems([pixelData, dfgSize, sampleCount](const ThreadPool::Task& task)
+		vector<f32x4> dfvSamples;
+		createDfvSamples(sampleCount, dfvSamples);
+		auto dfvSampleData = dfvSamples.data();
+
+		auto threadSystem = ThreadSystem::Instance::tryGet();
+		if (threadSystem)
+		{
+			auto& threadPool = threadSystem->getForegroundPool();
+			threadPool.addItems([pixelData, dfvSampleData, dfgSize, sampleCount](const ThreadPool::Task& task)
+			{
+				SET_CPU_ZONE_SCOPED("DFG LUT Create");
+
+				auto itemCount = task.getItemCount();
+				for (uint32 i = task.getItemOffset(); i < itemCount; i++)
+				{
+					auto y = i / dfgSize, x = i - y * dfgSize;
+					pixelData[i] = dfvMultiscatter(dfvSampleData, x, (dfgSize - 1) - y, dfgSize, sampleCount);
+				}
+			},
+			dfgSize * dfgSize);
+			threadPool.wait();
+		}
+		else
 		{
 			SET_CPU_ZONE_SCOPED("DFG LUT Create");
 
-			auto itemCount = task.getItemCount();
-			for (uint32 i = task.getItemOffset(); i < itemCount; i++)
+			uint32 index = 0;
+			for (int32 y = dfgSize - 1; y >= 0; y--)
 			{
-				auto y = i / dfgSize, x = i - y * dfgSize;
-				pixelData[i] = dfvMultiscatter(x, (dfgSize - 1) - y, dfgSize, sampleCount);
+				for (uint32 x = 0; x < dfgSize; x++)
+					pixelData[index++] = dfvMultiscatter(dfvSampleData, x, y, dfgSize, sampleCount);
 			}
-		},
-		dfgSize * dfgSize);
-		threadPool.wait();
-	}
-	else
-	{
-		SET_CPU_ZONE_SCOPED("DFG LUT Create");
-
-		uint32 index = 0;
-		for (int32 y = dfgSize - 1; y >= 0; y--)
-		{
-			for (uint32 x = 0; x < dfgSize; x++)
-				pixelData[index++] = dfvMultiscatter(x, y, dfgSize, sampleCount);
 		}
+
+		tryStorePbrCache(cachePath, &cacheChunk, 1);
 	}
 	
 	auto image = graphicsSystem->createImage(Image::Format::SfloatR16G16, 
@@ -1294,27 +1426,42 @@ ID<Buffer> PbrLightingSystem::createSpecularCache(uint32 cubemapSize,
 	auto countBufferData = iblCountBuffer.data();
 	auto countBufferSize = (uint8)iblCountBuffer.size();
 
-	auto threadSystem = ThreadSystem::Instance::tryGet();
-	if (threadSystem)
+	// Note: Specular cache depends only on the cubemap size, so it is shared between all loaded skyboxes.
+	uint32 cacheKey[] = { cubemapSize, sampleCount, skyboxMipCount, specularMipCount };
+	auto cachePath = getPbrCachePath("ibl-specular", cacheKey, 4);
+	PbrCacheChunk cacheChunks[] =
 	{
-		auto& threadPool = threadSystem->getForegroundPool();
-		threadPool.addTasks([=](const ThreadPool::Task& task)
-		{
-			SET_CPU_ZONE_SCOPED("IBL Specular Generate");
-			calcIblSpecular(specularMap, weightBufferData, countBufferData, cubemapSize, 
-				sampleCount, skyboxMipCount, specularMipCount, task.getTaskIndex());
-		},
-		countBufferSize);
-		threadPool.wait();
-	}
-	else
+		{ weightBufferData, iblWeightBuffer.size() * sizeof(float) },
+		{ countBufferData, iblCountBuffer.size() * sizeof(uint32) },
+		{ specularMap, specularCacheSize }
+	};
+
+	if (!tryLoadPbrCache(cachePath, cacheChunks, 3))
 	{
-		SET_CPU_ZONE_SCOPED("IBL Specular Generate");
-		for (uint8 i = 0; i < countBufferSize; i++)
+		auto threadSystem = ThreadSystem::Instance::tryGet();
+		if (threadSystem)
+		{
+			auto& threadPool = threadSystem->getForegroundPool();
+			threadPool.addTasks([=](const ThreadPool::Task& task)
+			{
+				SET_CPU_ZONE_SCOPED("IBL Specular Generate");
+				calcIblSpecular(specularMap, weightBufferData, countBufferData, cubemapSize, 
+					sampleCount, skyboxMipCount, specularMipCount, task.getTaskIndex());
+			},
+			countBufferSize);
+			threadPool.wait();
+		}
+		else
 		{
-			calcIblSpecular(specularMap, weightBufferData, countBufferData, 
-				cubemapSize, sampleCount, skyboxMipCount, specularMipCount, i);
+			SET_CPU_ZONE_SCOPED("IBL Specular Generate");
+			for (uint8 i = 0; i < countBufferSize; i++)
+			{
+				calcIblSpecular(specularMap, weightBufferData, countBufferData, 
+					cubemapSize, sampleCount, skyboxMipCount, specularMipCount, i);
+			}
 		}
+
+		tryStorePbrCache(cachePath, cacheChunks, 3);
 	}
 	stagingView->flush();
 
@@ -1532,7 +1679,23 @@ void PbrLightingSystem::loadCubemap(const fs::path& path, Image::Format& format,
 		SET_GPU_DEBUG_LABEL("Load Cubemap PBR");
 
 		vector<f32x4> localShCache; if (!shCache) shCache = &localShCache;
-		generateShDiffuse((const float4* const*)mips[0].data(), cubemapSize, *shCache);
+		auto skyboxFaces = (const float4* const*)mips[0].data();
+
+		auto hashState = Hash128::getState();
+		Hash128::resetState(hashState);
+		for (uint8 i = 0; i < Image::cubemapFaceCount; i++)
+			Hash128::updateState(hashState, skyboxFaces[i], (psize)cubemapSize * cubemapSize * sizeof(float4));
+		Hash128::updateState(hashState, &cubemapSize, sizeof(uint32));
+		auto shCachePath = getPbrCachePath("sh-diffuse", Hash128::digestState(hashState));
+
+		shCache->resize(sh3Count);
+		PbrCacheChunk shCacheChunk = { shCache->data(), sh3Count * sizeof(f32x4) };
+		if (!tryLoadPbrCache(shCachePath, &shCacheChunk, 1))
+		{
+			generateShDiffuse(skyboxFaces, cubemapSize, *shCache);
+			shCacheChunk.data = shCache->data();
+			tryStorePbrCache(shCachePath, &shCacheChunk, 1);
+		}
 		auto shCacheData = shCache->data();
 
 		if (shCoeffs)
@@ -35,14 +35,6 @@ static Ref<Image> createAreaLUT()
 		Image::Strategy::Size, ImageLoadFlags::LoadShared | ImageLoadFlags::LoadAsSrgb, 9.0f);
 }
 
-static ID<Image> createEdgesBuffer(GraphicsSystem* graphicsSystem)
-{
-	auto image = graphicsSystem->createImage(SmaaRenderSystem::edgesBufferFormat, 
-		Image::Usage::ColorAttachment | Image::Usage::Sampled | Image::Usage::Fullscreen, 
-		{ { nullptr } }, graphicsSystem->getScaledFrameSize(), Image::Strategy::Size);
-	SET_RESOURCE_DEBUG_NAME(image, "image.smaa.edgesBuffer");
-	return image;
-}
 static ID<ImageView> getLdrCopyView(GraphicsSystem* graphicsSystem)
 {
 	auto gBuffer = DeferredRenderSystem::Instance::get()->getGBuffers()[G_BUFFER_BASE_COLOR]; 
@@ -50,13 +42,6 @@ static ID<ImageView> getLdrCopyView(GraphicsSystem* graphicsSystem)
 	GARDEN_ASSERT(graphicsSystem->get(gBuffer)->getFormat() == DeferredRenderSystem::ldrBufferFormat);
 	return imageView;
 }
-static ID<ImageView> getWeightsView(GraphicsSystem* graphicsSystem)
-{
-	auto gBuffer = DeferredRenderSystem::Instance::get()->getGBuffers()[G_BUFFER_METALLIC]; 
-	auto imageView = graphicsSystem->get(gBuffer)->getView(); // Note: Reusing G-Buffer memory.
-	GARDEN_ASSERT(graphicsSystem->get(gBuffer)->getFormat() == Image::Format::UnormR8G8B8A8);
-	return imageView;
-}
 
 static ID<Framebuffer> createEdgesFramebuffer(GraphicsSystem* graphicsSystem, ID<Image> edgesBuffer)
 {
@@ -70,9 +55,9 @@ static ID<Framebuffer> createEdgesFramebuffer(GraphicsSystem* graphicsSystem, ID
 	SET_RESOURCE_DEBUG_NAME(framebuffer, "framebuffer.smaa.edges");
 	return framebuffer;
 }
-static ID<Framebuffer> createWeightsFramebuffer(GraphicsSystem* graphicsSystem)
+static ID<Framebuffer> createWeightsFramebuffer(GraphicsSystem* graphicsSystem, ID<Image> weightsBuffer)
 {
-	auto weightsView = getWeightsView(graphicsSystem);
+	auto weightsView = graphicsSystem->get(weightsBuffer)->getView();
 	vector<Framebuffer::Attachment> colorAttachments =
 	{
 		Framebuffer::Attachment(weightsView, Framebuffer::LoadOp::Clear, Framebuffer::StoreOp::Store)
@@ -174,9 +159,9 @@ static DescriptorSet::Uniforms getWeightsUniforms(GraphicsSystem* graphicsSystem
 	};
 	return uniforms;
 }
-static DescriptorSet::Uniforms getBlendUniforms(GraphicsSystem* graphicsSystem)
+static DescriptorSet::Uniforms getBlendUniforms(GraphicsSystem* graphicsSystem, ID<Image> weightsBuffer)
 {
-	auto weightsView = getWeightsView(graphicsSystem);
+	auto weightsView = graphicsSystem->get(weightsBuffer)->getView();
 	auto ldrCopyView = getLdrCopyView(graphicsSystem); 
 
 	DescriptorSet::Uniforms uniforms =
@@ -222,51 +207,13 @@ void SmaaRenderSystem::preUiRender()
 			searchLUT = createSearchLUT();
 		if (!areaLUT)
 			areaLUT = createAreaLUT();
-		if (!edgesBuffer)
-			edgesBuffer = createEdgesBuffer(graphicsSystem);
-		if (!edgesFramebuffer)
-			edgesFramebuffer = createEdgesFramebuffer(graphicsSystem, edgesBuffer);
-		if (!weightsFramebuffer)
-			weightsFramebuffer = createWeightsFramebuffer(graphicsSystem);
 		if (!blendFramebuffer)
 			blendFramebuffer = createBlendFramebuffer(graphicsSystem);
-		if (!edgesPipeline)
-			edgesPipeline = createEdgesPipeline(edgesFramebuffer, quality);
-		if (!weightsPipeline)
-			weightsPipeline = createWeightsPipeline(weightsFramebuffer, quality, cornerRounding);
 		if (!blendPipeline)
 			blendPipeline = createBlendPipeline(blendFramebuffer);
 		isInitialized = true;
 	}
 
-	auto edgesPipelineView = graphicsSystem->get(edgesPipeline);
-	auto weightsPipelineView = graphicsSystem->get(weightsPipeline);
-	auto blendPipelineView = graphicsSystem->get(blendPipeline);
-	if (!edgesPipelineView->isReady() || !weightsPipelineView->isReady() || !blendPipelineView->isReady())
-		return;
-
-	if (!edgesDS)
-	{
-		auto uniforms = getEdgesUniforms(graphicsSystem);
-		edgesDS = graphicsSystem->createDescriptorSet(edgesPipeline, std::move(uniforms));
-		SET_RESOURCE_DEBUG_NAME(edgesDS, "descriptorSet.smaa.edges");
-	}
-	if (!weightsDS)
-	{
-		auto uniforms = getWeightsUniforms(graphicsSystem, 
-			ID<Image>(areaLUT), ID<Image>(searchLUT), edgesBuffer);
-		if (uniforms.empty())
-			return;
-		weightsDS = graphicsSystem->createDescriptorSet(weightsPipeline, std::move(uniforms));
-		SET_RESOURCE_DEBUG_NAME(weightsDS, "descriptorSet.smaa.weights");
-	}
-	if (!blendDS)
-	{
-		auto uniforms = getBlendUniforms(graphicsSystem);
-		blendDS = graphicsSystem->createDescriptorSet(blendPipeline, std::move(uniforms));
-		SET_RESOURCE_DEBUG_NAME(blendDS, "descriptorSet.smaa.blend");
-	}
-
 	auto deferredSystem = DeferredRenderSystem::Instance::get();
 	auto ldrFramebuffer = deferredSystem->getLdrFramebuffer();
 	auto framebufferView = graphicsSystem->get(ldrFramebuffer);
@@ -276,80 +223,176 @@ void SmaaRenderSystem::preUiRender()
 	pc.frameSize = framebufferView->getSize();
 	pc.invFrameSize = float2::one / pc.frameSize;
 
+	auto ldrBuffer = deferredSystem->getLdrBuffer();
+	auto ldrCopyBuffer = ldrCopyView->getImage();
+	auto frameSize = graphicsSystem->getScaledFrameSize();
+
 	graphicsSystem->startRecording(CommandBufferType::Frame);
 	{
 		SET_GPU_DEBUG_LABEL("SMAA");
-		Image::copy(deferredSystem->getLdrBuffer(), ldrCopyView->getImage());
 
+		// Note: Barriers between the passes are precomputed by the graph once.
+		renderGraph.clear();
+		auto ldrResource = renderGraph.importImage(ldrBuffer);
+		auto ldrCopyResource = renderGraph.importImage(ldrCopyBuffer);
+		auto areaResource = renderGraph.importImage(ID<Image>(areaLUT));
+		auto searchResource = renderGraph.importImage(ID<Image>(searchLUT));
+
+		RenderGraph::ImageDesc imageDesc;
+		imageDesc.size = u32x4(frameSize.x, frameSize.y, 1, 1);
+		imageDesc.format = edgesBufferFormat;
+		imageDesc.usage = Image::Usage::Fullscreen;
+		auto edgesResource = renderGraph.createImage(imageDesc, "smaa.edgesBuffer");
+		imageDesc.format = weightsBufferFormat;
+		auto weightsResource = renderGraph.createImage(imageDesc, "smaa.weightsBuffer");
+
+		auto pass = renderGraph.addPass("LDR Copy", [ldrBuffer, ldrCopyBuffer]()
 		{
-			SET_GPU_DEBUG_LABEL("Edges Detection");
-			{
-				RenderPass renderPass(edgesFramebuffer, float4::zero);
-				edgesPipelineView->bind();
-				edgesPipelineView->setViewportScissor();
-				edgesPipelineView->bindDescriptorSet(edgesDS);
-				edgesPipelineView->pushConstants(&pc);
-				edgesPipelineView->drawFullscreen();
-			}
-		}
+			Image::copy(ldrBuffer, ldrCopyBuffer);
+		});
+		renderGraph.read(pass, ldrResource, RenderGraph::Access::Transfer);
+		renderGraph.write(pass, ldrCopyResource, RenderGraph::Access::Transfer);
+
+		pass = renderGraph.addPass("Edges Detection", [this, graphicsSystem, pc]()
 		{
-			SET_GPU_DEBUG_LABEL("Weights Calculation");
-			{
-				RenderPass renderPass(weightsFramebuffer, float4::zero);
-				weightsPipelineView->bind();
-				weightsPipelineView->setViewportScissor();
-				weightsPipelineView->bindDescriptorSet(weightsDS);
-				weightsPipelineView->pushConstants(&pc);
-				weightsPipelineView->drawFullscreen();
-			}
-		}
+			auto pipelineView = graphicsSystem->get(edgesPipeline);
+			RenderPass renderPass(edgesFramebuffer, float4::zero);
+			pipelineView->bind();
+			pipelineView->setViewportScissor();
+			pipelineView->bindDescriptorSet(edgesDS);
+			pipelineView->pushConstants(&pc);
+			pipelineView->drawFullscreen();
+		});
+		renderGraph.read(pass, ldrResource, RenderGraph::Access::Sampled, PipelineStage::Fragment);
+		renderGraph.write(pass, edgesResource, RenderGraph::Access::ColorAttachment);
+
+		pass = renderGraph.addPass("Weights Calculation", [this, graphicsSystem, pc]()
+		{
+			auto pipelineView = graphicsSystem->get(weightsPipeline);
+			RenderPass renderPass(weightsFramebuffer, float4::zero);
+			pipelineView->bind();
+			pipelineView->setViewportScissor();
+			pipelineView->bindDescriptorSet(weightsDS);
+			pipelineView->pushConstants(&pc);
+			pipelineView->drawFullscreen();
+		});
+		renderGraph.read(pass, edgesResource, RenderGraph::Access::Sampled, PipelineStage::Fragment);
+		renderGraph.read(pass, areaResource, RenderGraph::Access::Sampled, PipelineStage::Fragment);
+		renderGraph.read(pass, searchResource, RenderGraph::Access::Sampled, PipelineStage::Fragment);
+		renderGraph.write(pass, weightsResource, RenderGraph::Access::ColorAttachment);
 
 		#if GARDEN_DEBUG || GARDEN_EDITOR
 		if (visualize)
-			graphicsSystem->get(deferredSystem->getLdrBuffer())->clear(float4::zero);
+		{
+			pass = renderGraph.addPass("Visualize Clear", [graphicsSystem, ldrBuffer]()
+			{
+				graphicsSystem->get(ldrBuffer)->clear(float4::zero);
+			});
+			renderGraph.write(pass, ldrResource, RenderGraph::Access::Transfer);
+		}
 		#endif
 
+		pass = renderGraph.addPass("Neighborhood Blending", [this, graphicsSystem, pc]()
 		{
-			SET_GPU_DEBUG_LABEL("Neighborhood Blending");
-			{
-				RenderPass renderPass(blendFramebuffer, float4::zero);
-				blendPipelineView->bind();
-				blendPipelineView->setViewportScissor();
-				blendPipelineView->bindDescriptorSet(blendDS);
-				blendPipelineView->pushConstants(&pc);
-				blendPipelineView->drawFullscreen();
-			}
+			auto pipelineView = graphicsSystem->get(blendPipeline);
+			RenderPass renderPass(blendFramebuffer, float4::zero);
+			pipelineView->bind();
+			pipelineView->setViewportScissor();
+			pipelineView->bindDescriptorSet(blendDS);
+			pipelineView->pushConstants(&pc);
+			pipelineView->drawFullscreen();
+		});
+		renderGraph.read(pass, weightsResource, RenderGraph::Access::Sampled, PipelineStage::Fragment);
+		renderGraph.read(pass, ldrCopyResource, RenderGraph::Access::Sampled, PipelineStage::Fragment);
+		renderGraph.write(pass, ldrResource, RenderGraph::Access::ColorAttachment);
+
+		// Note: Transient images are recreated on the frame size or graph topology change.
+		renderGraph.compile();
+		if (graphVersion != renderGraph.getVersion())
+		{
+			updateGraphImages(renderGraph.getImage(edgesResource), renderGraph.getImage(weightsResource));
+			graphVersion = renderGraph.getVersion();
 		}
+
+		if (isReady())
+			renderGraph.execute();
 	}
 	graphicsSystem->stopRecording();
 }
 
-//**********************************************************************************************************************
-void SmaaRenderSystem::gBufferRecreate()
+void SmaaRenderSystem::updateGraphImages(ID<Image> edgesBuffer, ID<Image> weightsBuffer)
 {
 	auto graphicsSystem = GraphicsSystem::Instance::get();
 	graphicsSystem->destroy(blendDS);
 	graphicsSystem->destroy(weightsDS);
-	graphicsSystem->destroy(edgesDS);
-
-	if (edgesBuffer)
-	{
-		graphicsSystem->destroy(edgesBuffer);
-		edgesBuffer = createEdgesBuffer(graphicsSystem);
-	}
+	this->edgesBuffer = edgesBuffer;
+	this->weightsBuffer = weightsBuffer;
 
 	auto frameSize = graphicsSystem->getScaledFrameSize();
 	if (edgesFramebuffer)
 	{
 		auto framebufferView = graphicsSystem->get(edgesFramebuffer);
-		framebufferView->update(frameSize, graphicsSystem->get(edgesBuffer)->getView());
+		framebufferView->update(frameSize, Framebuffer::Attachment(graphicsSystem->get(edgesBuffer)->getView(), 
+			Framebuffer::LoadOp::Clear, Framebuffer::StoreOp::Store));
 	}
+	else edgesFramebuffer = createEdgesFramebuffer(graphicsSystem, edgesBuffer);
+
 	if (weightsFramebuffer)
 	{
 		auto framebufferView = graphicsSystem->get(weightsFramebuffer);
-		auto weightsView = getWeightsView(graphicsSystem);
-		framebufferView->update(frameSize, weightsView);
+		framebufferView->update(frameSize, Framebuffer::Attachment(graphicsSystem->get(weightsBuffer)->getView(), 
+			Framebuffer::LoadOp::Clear, Framebuffer::StoreOp::Store));
 	}
+	else weightsFramebuffer = createWeightsFramebuffer(graphicsSystem, weightsBuffer);
+
+	if (!edgesPipeline)
+		edgesPipeline = createEdgesPipeline(edgesFramebuffer, quality);
+	if (!weightsPipeline)
+		weightsPipeline = createWeightsPipeline(weightsFramebuffer, quality, cornerRounding);
+}
+
+bool SmaaRenderSystem::isReady()
+{
+	auto graphicsSystem = GraphicsSystem::Instance::get();
+	auto edgesPipelineView = graphicsSystem->get(edgesPipeline);
+	auto weightsPipelineView = graphicsSystem->get(weightsPipeline);
+	auto blendPipelineView = graphicsSystem->get(blendPipeline);
+	if (!edgesPipelineView->isReady() || !weightsPipelineView->isReady() || !blendPipelineView->isReady())
+		return false;
+
+	if (!edgesDS)
+	{
+		auto uniforms = getEdgesUniforms(graphicsSystem);
+		edgesDS = graphicsSystem->createDescriptorSet(edgesPipeline, std::move(uniforms));
+		SET_RESOURCE_DEBUG_NAME(edgesDS, "descriptorSet.smaa.edges");
+	}
+	if (!weightsDS)
+	{
+		auto uniforms = getWeightsUniforms(graphicsSystem, 
+			ID<Image>(areaLUT), ID<Image>(searchLUT), edgesBuffer);
+		if (uniforms.empty())
+			return false;
+		weightsDS = graphicsSystem->createDescriptorSet(weightsPipeline, std::move(uniforms));
+		SET_RESOURCE_DEBUG_NAME(weightsDS, "descriptorSet.smaa.weights");
+	}
+	if (!blendDS)
+	{
+		auto uniforms = getBlendUniforms(graphicsSystem, weightsBuffer);
+		blendDS = graphicsSystem->createDescriptorSet(blendPipeline, std::move(uniforms));
+		SET_RESOURCE_DEBUG_NAME(blendDS, "descriptorSet.smaa.blend");
+	}
+	return true;
+}
+
+//**********************************************************************************************************************
+void SmaaRenderSystem::gBufferRecreate()
+{
+	auto graphicsSystem = GraphicsSystem::Instance::get();
+	graphicsSystem->destroy(blendDS);
+	graphicsSystem->destroy(weightsDS);
+	graphicsSystem->destroy(edgesDS);
+
+	// Note: Edges and weights framebuffers are updated after the render graph recreates its transient images.
 	if (blendFramebuffer)
 	{
 		auto framebufferView = graphicsSystem->get(blendFramebuffer);
@@ -398,25 +441,6 @@ void SmaaRenderSystem::setQuality(GraphicsQuality quality, int cornerRounding)
 }
 
 //**********************************************************************************************************************
-ID<Image> SmaaRenderSystem::getEdgesBuffer()
-{
-	if (!edgesBuffer)
-		edgesBuffer = createEdgesBuffer(GraphicsSystem::Instance::get());
-	return edgesBuffer;
-}
-
-ID<Framebuffer> SmaaRenderSystem::getEdgesFramebuffer()
-{
-	if (!edgesFramebuffer)
-		edgesFramebuffer = createEdgesFramebuffer(GraphicsSystem::Instance::get(), getEdgesBuffer());
-	return edgesFramebuffer;
-}
-ID<Framebuffer> SmaaRenderSystem::getWeightsFramebuffer()
-{
-	if (!weightsFramebuffer)
-		weightsFramebuffer = createWeightsFramebuffer(GraphicsSystem::Instance::get());
-	return weightsFramebuffer;
-}
 ID<Framebuffer> SmaaRenderSystem::getBlendFramebuffer()
 {
 	if (!blendFramebuffer)
@@ -424,18 +448,6 @@ ID<Framebuffer> SmaaRenderSystem::getBlendFramebuffer()
 	return blendFramebuffer;
 }
 
-ID<GraphicsPipeline> SmaaRenderSystem::getEdgesPipeline()
-{
-	if (!edgesPipeline)
-		edgesPipeline = createEdgesPipeline(getEdgesFramebuffer(), quality);
-	return edgesPipeline;
-}
-ID<GraphicsPipeline> SmaaRenderSystem::getWeightsPipeline()
-{
-	if (!weightsPipeline)
-		weightsPipeline = createWeightsPipeline(getWeightsFramebuffer(), quality, cornerRounding);
-	return weightsPipeline;
-}
 ID<GraphicsPipeline> SmaaRenderSystem::getBlendPipeline()
 {
 	if (!blendPipeline)
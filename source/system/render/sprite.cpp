@@ -35,6 +35,7 @@ void SpriteRenderSystem::init()
 
 	auto manager = Manager::Instance::get();
 	ECSM_SUBSCRIBE_TO_EVENT("ImageLoaded", SpriteRenderSystem::imageLoaded);
+	ECSM_SUBSCRIBE_TO_EVENT("ImageRestreamed", SpriteRenderSystem::imageRestreamed);
 
 	#if GARDEN_DEBUG
 	debugResourceName = pipelinePath.generic_string();
@@ -42,6 +43,15 @@ void SpriteRenderSystem::init()
 }
 
 void SpriteRenderSystem::imageLoaded()
+{
+	updateColorMapDS(false);
+}
+void SpriteRenderSystem::imageRestreamed()
+{
+	updateColorMapDS(true);
+}
+
+void SpriteRenderSystem::updateColorMapDS(bool isRestreamed)
 {
 	auto resourceSystem = ResourceSystem::Instance::get();
 	auto image = resourceSystem->getLoadedImage();
@@ -55,10 +65,11 @@ void SpriteRenderSystem::imageLoaded()
 	for (uint32 i = 0; i < componentOccupancy; i++)
 	{
 		auto spriteRenderView = (SpriteRenderComponent*)(componentData + i * componentSize);
-		if (spriteRenderView->colorMap != image || spriteRenderView->descriptorSet)
+		if (spriteRenderView->colorMap != image || (spriteRenderView->descriptorSet && !isRestreamed))
 			continue;
 		if (!descriptorSet)
 			descriptorSet = createSharedDS(imagePath.generic_string(), image);
+		resourceSystem->destroyShared(spriteRenderView->descriptorSet); // Note: Old image views are destroyed.
 		spriteRenderView->descriptorSet = descriptorSet;
 	}
 
@@ -70,10 +81,11 @@ void SpriteRenderSystem::imageLoaded()
 	for (uint32 i = 0; i < componentOccupancy; i++)
 	{
 		auto spriteFrame = (SpriteAnimFrame*)(componentData + i * componentSize);
-		if (spriteFrame->colorMap != image || spriteFrame->descriptorSet)
+		if (spriteFrame->colorMap != image || (spriteFrame->descriptorSet && !isRestreamed))
 			continue;
 		if (!descriptorSet)
 			descriptorSet = createSharedDS(imagePath.generic_string(), image);
+		resourceSystem->destroyShared(spriteFrame->descriptorSet);
 		spriteFrame->descriptorSet = descriptorSet;
 	}
 }
@@ -88,18 +100,34 @@ void SpriteRenderSystem::resetComponent(View<Component> component)
 
 //**********************************************************************************************************************
 uint32 SpriteRenderSystem::getReadyMeshesAsync(MeshRenderComponent* meshRenderView, 
-	const f32x4& cameraPosition, const Frustum& frustum, f32x4x4& model)
+	const f32x4& cameraPosition, f32x4x4& model)
 {
-	if (isBehindFrustum(frustum, meshRenderView->aabb, model))
-		return 0;
 	auto spriteRenderView = (SpriteRenderComponent*)meshRenderView;
 	return spriteRenderView->descriptorSet ? 1 : 0;
 }
+uint32 SpriteRenderSystem::getMeshStateAsync(MeshRenderComponent* meshRenderView) const
+{
+	auto spriteRenderView = (SpriteRenderComponent*)meshRenderView;
+	return *(ID<DescriptorSet>)spriteRenderView->descriptorSet; // Note: Groups sprites with the same texture.
+}
+static uint32 calcSpriteScreenSize(const f32x4x4& mvp, uint2 framebufferSize) noexcept
+{
+	auto clipW = std::max(std::abs(mvp.c3.getW()), 0.0001f);
+	auto sizeX = std::sqrt(mvp.c0.getX() * mvp.c0.getX() + mvp.c0.getY() * mvp.c0.getY());
+	auto sizeY = std::sqrt(mvp.c1.getX() * mvp.c1.getX() + mvp.c1.getY() * mvp.c1.getY());
+	auto screenSize = std::max(sizeX * framebufferSize.x, sizeY * framebufferSize.y) * (0.5f / clipW);
+	return (uint32)std::min(screenSize, 65536.0f);
+}
+
 void SpriteRenderSystem::drawAsync(MeshRenderComponent* meshRenderView,
 	const f32x4x4& viewProj, const f32x4x4& model, uint32 instanceIndex, int32 taskIndex)
 {
 	auto spriteRenderView = (SpriteRenderComponent*)meshRenderView;
 
+	// Note: Reporting sprite on-screen size for the streamed color map mip residency.
+	auto screenSize = calcSpriteScreenSize(viewProj * model, GraphicsSystem::Instance::get()->getFramebufferSize());
+	ResourceSystem::Instance::get()->requestImageSize((ID<Image>)spriteRenderView->colorMap, screenSize);
+
 	DescriptorSet::Range dsRanges[2];
 	dsRanges[0] = DescriptorSet::Range(descriptorSet, 1, inFlightIndex);
 	dsRanges[1] = DescriptorSet::Range((ID<DescriptorSet>)spriteRenderView->descriptorSet);
@@ -182,6 +210,8 @@ void SpriteRenderSystem::serialize(ISerializer& serializer, const View<Component
 		serializer.write("aabb", componentView->aabb);
 	if (!componentView->isEnabled)
 		serializer.write("isEnabled", false);
+	if (componentView->isOccluder)
+		serializer.write("isOccluder", true);
 	if (componentView->colorMapLayer != 0.0f)
 		serializer.write("colorMapLayer", componentView->colorMapLayer);
 	if (componentView->color != f32x4::one)
@@ -205,6 +235,7 @@ void SpriteRenderSystem::deserialize(IDeserializer& deserializer, View<Component
 	deserializer.read("useMipmap", componentView->useMipmap);
 	deserializer.read("aabb", componentView->aabb);
 	deserializer.read("isEnabled", componentView->isEnabled);
+	deserializer.read("isOccluder", componentView->isOccluder);
 	deserializer.read("colorMapLayer", componentView->colorMapLayer);
 	deserializer.read("color", componentView->color);
 	deserializer.read("uvSize", componentView->uvSize);
@@ -25,6 +25,7 @@
 #include "garden/graphics/gslc.hpp"
 #include "garden/graphics/api.hpp"
 #include "garden/json-serialize.hpp"
+#include "garden/binary-scene.hpp"
 #include "garden/profiler.hpp"
 #include "garden/file.hpp"
 #include "math/types.hpp"
@@ -32,6 +33,7 @@
 #include "ft2build.h"
 #include FT_FREETYPE_H
 
+#include <algorithm>
 #include <fstream>
 #include <cstdint>
 #include <cstring>
@@ -50,7 +52,9 @@ namespace garden::graphics
 		Image::Format format = {};
 		Image::Usage usage = {};
 		Image::Strategy strategy = {};
+		uint32 streamBaseSize = 0;
 		uint8 maxMipCount = 0;
+		uint8 streamMip = 0;
 		ImageLoadFlags flags = {};
 	};
 	struct LodBufferLoadData final
@@ -64,6 +68,15 @@ namespace garden::graphics
 		uint8 maxLodCount = 0;
 		BufferLoadFlags flags = {};
 	};
+	struct ModelLoadData final
+	{
+		uint64 vertexBufferVersion = 0;
+		uint64 indexBufferVersion = 0;
+		fs::path path;
+		ID<Buffer> vertexBuffer = {};
+		ID<Buffer> indexBuffer = {};
+		Buffer::Strategy strategy = {};
+	};
 
 	struct PipelineLoadData
 	{
@@ -121,6 +134,7 @@ ResourceSystem::ResourceSystem(bool setSingleton) : Singleton(setSingleton)
 
 	auto manager = Manager::Instance::get();
 	manager->registerEvent("ImageLoaded");
+	manager->registerEvent("ImageRestreamed");
 	manager->registerEvent("BufferLoaded");
 	ECSM_SUBSCRIBE_TO_EVENT("Init", ResourceSystem::init);
 
@@ -145,6 +159,12 @@ ResourceSystem::ResourceSystem(bool setSingleton) : Singleton(setSingleton)
 	appCachePath = appInfoSystem->getCachePath();
 	#endif
 }
+ResourceSystem::~ResourceSystem()
+{
+	for (const auto& pair : streamedImages)
+		delete pair.second;
+}
+
 void ResourceSystem::init()
 {
 	auto manager = Manager::Instance::get();
@@ -154,6 +174,50 @@ void ResourceSystem::init()
 	#endif
 }
 
+//**********************************************************************************************************************
+static void calcLoadedImageDim(psize pathCount, uint2 realSize,
+	ImageLoadFlags flags, uint2& imageSize, uint32& layerCount) noexcept
+{
+	imageSize = realSize; layerCount = (uint32)pathCount;
+	if (hasAnyFlag(flags, ImageLoadFlags::LoadAsArray | ImageLoadFlags::LoadAs3D))
+	{
+		if (realSize.x > realSize.y)
+		{
+			layerCount = realSize.x / realSize.y;
+			imageSize.x = imageSize.y;
+		}
+		else
+		{
+			layerCount = realSize.y / realSize.x;
+			imageSize.y = imageSize.x;
+		}
+
+		if (layerCount == 0) layerCount = 1;
+	}
+}
+
+static uint8 calcStreamBaseMip(uint2 fullSize, uint8 fullMipCount, uint32 baseSize) noexcept
+{
+	uint8 mip = 0; auto maxSize = std::max(fullSize.x, fullSize.y);
+	while (mip + 1 < fullMipCount && (maxSize >> mip) > baseSize)
+		mip++;
+	return mip;
+}
+static uint8 calcStreamTargetMip(uint2 fullSize, uint8 baseMip, uint32 screenSize) noexcept
+{
+	uint8 mip = 0; auto maxSize = std::max(fullSize.x, fullSize.y);
+	while (mip < baseMip && (maxSize >> (mip + 1)) >= screenSize)
+		mip++;
+	return mip;
+}
+static uint64 calcStreamedImageSize(uint64 fullMipSize, uint8 fullMipCount, uint8 residentMip) noexcept
+{
+	uint64 binarySize = 0;
+	for (uint8 i = residentMip; i < fullMipCount; i++)
+		binarySize += std::max(fullMipSize >> (i * 2u), (uint64)1);
+	return binarySize;
+}
+
 //**********************************************************************************************************************
 void ResourceSystem::dequeuePipelines()
 {
@@ -163,75 +227,79 @@ void ResourceSystem::dequeuePipelines()
 	auto graphicsPipelines = graphicsAPI->graphicsPipelinePool.getData();
 	auto graphicsOccupancy = graphicsAPI->graphicsPipelinePool.getOccupancy();
 
-	while (!loadedGraphicsQueue.empty())
+	GraphicsQueueItem graphicsItem;
+	while (loadedGraphicsQueue.tryPop(graphicsItem))
 	{
-		auto& item = loadedGraphicsQueue.front();
-		auto pipeline = *item.instance <= graphicsOccupancy ? 
-			&graphicsPipelines[*item.instance - 1] : nullptr;
+		auto pipeline = *graphicsItem.instance <= graphicsOccupancy ? 
+			&graphicsPipelines[*graphicsItem.instance - 1] : nullptr;
 		
-		if (!pipeline || PipelineExt::getVersion(*pipeline) != PipelineExt::getVersion(item.pipeline))
+		if (!pipeline || PipelineExt::getVersion(*pipeline) != PipelineExt::getVersion(graphicsItem.pipeline))
 		{
 			graphicsAPI->forceResourceDestroy = true;
-			PipelineExt::destroy(item.pipeline);
+			PipelineExt::destroy(graphicsItem.pipeline);
 			graphicsAPI->forceResourceDestroy = false;
-			loadedGraphicsQueue.pop();
 			continue;
 		}
 		
-		GraphicsPipelineExt::moveInternalObjects(item.pipeline, *pipeline);
-		loadedGraphicsQueue.pop();
+		GraphicsPipelineExt::moveInternalObjects(graphicsItem.pipeline, *pipeline);
 		GARDEN_LOG_TRACE("Loaded graphics pipeline. (path: " + pipeline->getPath().generic_string() + ")");
 	}
 
 	auto computePipelines = graphicsAPI->computePipelinePool.getData();
 	auto computeOccupancy = graphicsAPI->computePipelinePool.getOccupancy();
 
-	while (!loadedComputeQueue.empty())
+	ComputeQueueItem computeItem;
+	while (loadedComputeQueue.tryPop(computeItem))
 	{
-		auto& item = loadedComputeQueue.front();
-		auto pipeline = *item.instance <= computeOccupancy ? 
-			&computePipelines[*item.instance - 1] : nullptr;
+		auto pipeline = *computeItem.instance <= computeOccupancy ? 
+			&computePipelines[*computeItem.instance - 1] : nullptr;
 
-		if (!pipeline || PipelineExt::getVersion(*pipeline) != PipelineExt::getVersion(item.pipeline))
+		if (!pipeline || PipelineExt::getVersion(*pipeline) != PipelineExt::getVersion(computeItem.pipeline))
 		{
 			graphicsAPI->forceResourceDestroy = true;
-			PipelineExt::destroy(item.pipeline);
+			PipelineExt::destroy(computeItem.pipeline);
 			graphicsAPI->forceResourceDestroy = false;
-			loadedComputeQueue.pop();
 			continue;
 		}
 
-		ComputePipelineExt::moveInternalObjects(item.pipeline, *pipeline);
-		loadedComputeQueue.pop();
+		ComputePipelineExt::moveInternalObjects(computeItem.pipeline, *pipeline);
 		GARDEN_LOG_TRACE("Loaded compute pipeline. (path: " + pipeline->getPath().generic_string() + ")");
 	}
 
 	auto rayTracingPipelines = graphicsAPI->rayTracingPipelinePool.getData();
 	auto rayTracingOccupancy = graphicsAPI->rayTracingPipelinePool.getOccupancy();
 
-	while (!loadedRayTracingQueue.empty())
+	RayTracingQueueItem rayTracingItem;
+	while (loadedRayTracingQueue.tryPop(rayTracingItem))
 	{
-		auto& item = loadedRayTracingQueue.front();
-		auto pipeline = *item.instance <= rayTracingOccupancy ? 
-			&rayTracingPipelines[*item.instance - 1] : nullptr;
+		auto pipeline = *rayTracingItem.instance <= rayTracingOccupancy ? 
+			&rayTracingPipelines[*rayTracingItem.instance - 1] : nullptr;
 
-		if (!pipeline || PipelineExt::getVersion(*pipeline) != PipelineExt::getVersion(item.pipeline))
+		if (!pipeline || PipelineExt::getVersion(*pipeline) != PipelineExt::getVersion(rayTracingItem.pipeline))
 		{
 			graphicsAPI->forceResourceDestroy = true;
-			PipelineExt::destroy(item.pipeline);
+			PipelineExt::destroy(rayTracingItem.pipeline);
 			graphicsAPI->forceResourceDestroy = false;
-			loadedRayTracingQueue.pop();
 			continue;
 		}
 
-		RayTracingPipelineExt::moveInternalObjects(item.pipeline, *pipeline);
-		loadedRayTracingQueue.pop();
+		RayTracingPipelineExt::moveInternalObjects(rayTracingItem.pipeline, *pipeline);
 		GARDEN_LOG_TRACE("Loaded ray tracing pipeline. (path: " + pipeline->getPath().generic_string() + ")");
 	}
 }
 
 //**********************************************************************************************************************
-void ResourceSystem::dequeueBuffers()
+static bool isDequeueBudgetExceeded(uint64 uploadSize, uint32 uploadCount, 
+	uint64 itemSize, uint64 sizeBudget, uint32 itemBudget) noexcept
+{
+	if (uploadCount == 0)
+		return false; // Note: Always uploading at least one resource per frame to guarantee progress.
+	if (itemBudget > 0 && uploadCount >= itemBudget)
+		return true;
+	return sizeBudget > 0 && uploadSize + itemSize > sizeBudget;
+}
+
+void ResourceSystem::dequeueBuffers(uint64& uploadSize, uint32& uploadCount)
 {
 	SET_CPU_ZONE_SCOPED("Loaded Buffers Dequeue");
 
@@ -240,7 +308,7 @@ void ResourceSystem::dequeueBuffers()
 	auto graphicsSystem = GraphicsSystem::Instance::get();
 
 	#if GARDEN_DEBUG
-	auto hasDequeueItems = !loadedBufferQueue.empty();
+	auto hasDequeueItems = !loadedBufferQueue.isEmpty();
 	if (hasDequeueItems)
 	{
 		graphicsSystem->startRecording(CommandBufferType::TransferOnly);
@@ -249,9 +317,18 @@ void ResourceSystem::dequeueBuffers()
 	}
 	#endif
 
-	while (!loadedBufferQueue.empty())
+	BufferQueueItem item;
+	while (true)
 	{
-		auto& item = loadedBufferQueue.front();
+		auto nextItem = loadedBufferQueue.peek();
+		if (!nextItem || isDequeueBudgetExceeded(uploadSize, uploadCount, 
+			nextItem->staging.getBinarySize(), dequeueSizeBudget, dequeueItemBudget))
+		{
+			break;
+		}
+
+		loadedBufferQueue.tryPop(item);
+		auto itemSize = item.staging.getBinarySize();
 		auto buffer = *item.bufferInstance <= graphicsAPI->bufferPool.getOccupancy() ? // Note: getOccupancy() required, do not optimize!
 			&graphicsAPI->bufferPool.getData()[*item.bufferInstance - 1] : nullptr;
 
@@ -260,7 +337,7 @@ void ResourceSystem::dequeueBuffers()
 			graphicsAPI->forceResourceDestroy = true;
 			BufferExt::destroy(item.buffer);
 			graphicsAPI->forceResourceDestroy = false;
-			loadedBufferQueue.pop();
+			delete item.modelInfo;
 			continue;
 		}
 
@@ -279,12 +356,18 @@ void ResourceSystem::dequeueBuffers()
 		Buffer::copy(stagingBuffer, item.bufferInstance);
 		graphicsSystem->stopRecording();
 		graphicsAPI->bufferPool.destroy(stagingBuffer);
+		uploadSize += itemSize;
+		uploadCount++;
+
+		if (item.modelInfo)
+		{
+			modelInfos[item.bufferInstance] = std::move(*item.modelInfo);
+			delete item.modelInfo;
+		}
 
 		loadedBuffer = item.bufferInstance;
 		loadedBufferPath = std::move(item.path);
 		manager->runEvent("BufferLoaded");
-
-		loadedBufferQueue.pop();
 	}
 
 	#if GARDEN_DEBUG
@@ -301,7 +384,7 @@ void ResourceSystem::dequeueBuffers()
 }
 
 //**********************************************************************************************************************
-void ResourceSystem::dequeueImages()
+void ResourceSystem::dequeueImages(uint64& uploadSize, uint32& uploadCount)
 {
 	SET_CPU_ZONE_SCOPED("Loaded Images Dequeue");
 
@@ -310,7 +393,7 @@ void ResourceSystem::dequeueImages()
 	auto graphicsSystem = GraphicsSystem::Instance::get();
 
 	#if GARDEN_DEBUG
-	auto hasDequeueItems = !loadedImageQueue.empty();
+	auto hasDequeueItems = !loadedImageQueue.isEmpty();
 	if (hasDequeueItems)
 	{
 		graphicsSystem->startRecording(CommandBufferType::TransferOnly);
@@ -322,9 +405,18 @@ void ResourceSystem::dequeueImages()
 	auto images = graphicsAPI->imagePool.getData();
 	auto imageOccupancy = graphicsAPI->imagePool.getOccupancy();
 
-	while (!loadedImageQueue.empty())
+	ImageQueueItem item;
+	while (true)
 	{
-		auto& item = loadedImageQueue.front();
+		auto nextItem = loadedImageQueue.peek();
+		if (!nextItem || isDequeueBudgetExceeded(uploadSize, uploadCount, 
+			nextItem->staging.getBinarySize(), dequeueSizeBudget, dequeueItemBudget))
+		{
+			break;
+		}
+
+		loadedImageQueue.tryPop(item);
+		auto itemSize = item.staging.getBinarySize();
 		auto image = *item.instance <= imageOccupancy ? & images[*item.instance - 1] : nullptr;
 
 		if (!image || MemoryExt::getVersion(*image) != MemoryExt::getVersion(item.image))
@@ -332,10 +424,29 @@ void ResourceSystem::dequeueImages()
 			graphicsAPI->forceResourceDestroy = true;
 			ImageExt::destroy(item.image);
 			graphicsAPI->forceResourceDestroy = false;
-			loadedImageQueue.pop();
 			continue;
 		}
 
+		auto isRestreamed = image->isLoaded();
+		if (isRestreamed)
+		{
+			// Note: Streamed image resolution has changed, destroying old internal objects after frames in flight.
+			evictSharedDescriptorSets(*image);
+			image->freeAllViews();
+			auto oldImage = graphicsAPI->imagePool.create(image->getUsage(), image->getStrategy(), 0);
+			auto oldImageView = graphicsAPI->imagePool.get(oldImage);
+			image = &graphicsAPI->imagePool.getData()[*item.instance - 1];
+			ImageExt::moveInternalObjects(*image, **oldImageView);
+			graphicsAPI->imagePool.destroy(oldImage);
+		}
+
+		uint2 fullSize; uint32 layerCount; calcLoadedImageDim(
+			item.paths.size(), item.realSize, item.flags, fullSize, layerCount);
+
+		images = graphicsAPI->imagePool.getData();
+		imageOccupancy = graphicsAPI->imagePool.getOccupancy();
+		image = &images[*item.instance - 1];
+
 		ImageExt::moveInternalObjects(item.image, *image);
 		#if GARDEN_DEBUG || GARDEN_EDITOR
 		image->setDebugName(image->getDebugName());
@@ -354,12 +465,37 @@ void ResourceSystem::dequeueImages()
 		if (generateMipmap) image->generateMips();
 		graphicsSystem->stopRecording();
 		graphicsAPI->bufferPool.destroy(stagingBuffer);
+		uploadSize += itemSize;
+		uploadCount++;
+
+		if (hasAnyFlag(item.flags, ImageLoadFlags::LoadStreamed))
+		{
+			auto result = streamedImages.find(item.instance);
+			if (result != streamedImages.end())
+			{
+				auto streamedImage = result->second;
+				if (streamedImage->residentMip != UINT8_MAX)
+					streamLoadCount--;
+
+				if (item.fullMipCount > 0)
+				{
+					streamedImage->fullSize = fullSize;
+					streamedImage->fullMipSize = item.fullMipSize;
+					streamedImage->fullMipCount = item.fullMipCount;
+					streamedImage->residentMip = item.streamMip;
+					streamedImage->isLoading = false;
+				}
+				else
+				{
+					delete streamedImage; // Note: Image format can't be streamed, loaded at the full resolution.
+					streamedImages.erase(result);
+				}
+			}
+		}
 
 		loadedImage = item.instance;
 		loadedImagePaths = std::move(item.paths);
-		manager->runEvent("ImageLoaded");
-
-		loadedImageQueue.pop();
+		manager->runEvent(isRestreamed ? "ImageRestreamed" : "ImageLoaded");
 	}
 
 	#if GARDEN_DEBUG
@@ -375,6 +511,207 @@ void ResourceSystem::dequeueImages()
 	loadedImagePaths = {};
 }
 
+void ResourceSystem::evictSharedDescriptorSets(Image& image)
+{
+	vector<ID<Resource>> views;
+	if (ImageExt::getView(image))
+		views.push_back(ID<Resource>(ImageExt::getView(image)));
+	for (const auto& barrierState : ImageExt::getBarrierStates(image))
+	{
+		if (barrierState.view)
+			views.push_back(ID<Resource>(barrierState.view));
+	}
+
+	if (views.empty())
+		return;
+
+	// Note: Shared descriptor set cache should not return sets with the destroyed image views.
+	auto graphicsAPI = GraphicsAPI::get();
+	for (auto i = sharedDescriptorSets.begin(); i != sharedDescriptorSets.end();)
+	{
+		auto descriptorSetView = graphicsAPI->descriptorSetPool.get(ID<DescriptorSet>(i->second));
+		auto isStale = false;
+
+		for (const auto& uniform : descriptorSetView->getUniforms())
+		{
+			for (const auto& resourceSet : uniform.second.resourceSets)
+			{
+				for (auto resource : resourceSet)
+				{
+					if (std::find(views.begin(), views.end(), resource) == views.end())
+						continue;
+					isStale = true;
+					break;
+				}
+				if (isStale)
+					break;
+			}
+			if (isStale)
+				break;
+		}
+
+		if (isStale)
+			i = sharedDescriptorSets.erase(i);
+		else i++;
+	}
+}
+
+//**********************************************************************************************************************
+namespace
+{
+	struct StreamCandidate final
+	{
+		float priority = 0.0f;
+		ID<Image> instance = {};
+		uint8 targetMip = 0;
+		uint8 baseMip = 0;
+	};
+}
+
+void ResourceSystem::updateStreamedImages()
+{
+	if (streamedImages.empty())
+		return;
+
+	SET_CPU_ZONE_SCOPED("Streamed Images Update");
+
+	auto graphicsAPI = GraphicsAPI::get();
+	auto images = graphicsAPI->imagePool.getData();
+	auto imageOccupancy = graphicsAPI->imagePool.getOccupancy();
+	auto frameIndex = GraphicsSystem::Instance::get()->getCurrentFrameIndex();
+	vector<StreamCandidate> candidates;
+	streamedImageSize = 0;
+
+	for (auto i = streamedImages.begin(); i != streamedImages.end();)
+	{
+		auto instance = i->first; auto streamedImage = i->second;
+		auto image = *instance <= imageOccupancy ? &images[*instance - 1] : nullptr;
+
+		if (!image || MemoryExt::getVersion(*image) != streamedImage->imageVersion)
+		{
+			if (streamedImage->isLoading && streamedImage->residentMip != UINT8_MAX)
+				streamLoadCount--;
+			delete streamedImage;
+			i = streamedImages.erase(i);
+			continue;
+		}
+		i++;
+
+		if (streamedImage->residentMip == UINT8_MAX)
+			continue; // Note: Initial image load is not finished yet.
+
+		auto requestedSize = streamedImage->requestedSize.exchange(0, memory_order_relaxed);
+		if (requestedSize > 0)
+		{
+			streamedImage->screenSize = requestedSize;
+			streamedImage->lastRequestFrame = frameIndex;
+		}
+		else if (frameIndex - streamedImage->lastRequestFrame > imageStreamTimeout)
+		{
+			streamedImage->screenSize = 0;
+		}
+
+		streamedImageSize += calcStreamedImageSize(streamedImage->fullMipSize, 
+			streamedImage->fullMipCount, streamedImage->residentMip);
+		if (streamedImage->isLoading)
+			continue;
+
+		StreamCandidate candidate;
+		candidate.instance = instance;
+		candidate.baseMip = calcStreamBaseMip(streamedImage->fullSize, 
+			streamedImage->fullMipCount, imageStreamBaseSize);
+		candidate.targetMip = streamedImage->screenSize > 0 ? calcStreamTargetMip(streamedImage->fullSize, 
+			candidate.baseMip, streamedImage->screenSize) : candidate.baseMip;
+		auto residentSize = std::max(std::max(streamedImage->fullSize.x, 
+			streamedImage->fullSize.y) >> streamedImage->residentMip, 1u);
+		candidate.priority = (float)streamedImage->screenSize / residentSize;
+		candidates.push_back(candidate);
+	}
+
+	if (candidates.empty())
+		return;
+
+	std::sort(candidates.begin(), candidates.end(), [](const StreamCandidate& a, const StreamCandidate& b)
+	{
+		return a.priority < b.priority;
+	});
+
+	auto streamImage = [this](ID<Image> instance, StreamedImage* streamedImage, uint8 mip)
+	{
+		auto data = new ImageLoadData();
+		data->imageVersion = streamedImage->imageVersion;
+		data->paths = streamedImage->paths;
+		data->instance = instance;
+		data->format = streamedImage->format;
+		data->usage = streamedImage->usage;
+		data->strategy = streamedImage->strategy;
+		data->maxMipCount = streamedImage->maxMipCount;
+		data->streamMip = mip;
+		data->flags = streamedImage->flags;
+		streamedImage->isLoading = true;
+		streamLoadCount++;
+		addImageLoadTask(data, streamedImage->taskPriority);
+	};
+
+	// Note: Dropping highest mips of the lowest priority images when out of the memory budget.
+	auto projectedSize = streamedImageSize;
+	for (auto& candidate : candidates)
+	{
+		if (projectedSize <= imageStreamBudget || streamLoadCount >= maxImageStreamLoads)
+			break;
+
+		auto streamedImage = streamedImages.at(candidate.instance);
+		auto residentMip = streamedImage->residentMip;
+		if (residentMip >= candidate.baseMip)
+			continue;
+
+		auto fullMipSize = streamedImage->fullMipSize; auto fullMipCount = streamedImage->fullMipCount;
+		projectedSize -= calcStreamedImageSize(fullMipSize, fullMipCount, residentMip) - 
+			calcStreamedImageSize(fullMipSize, fullMipCount, residentMip + 1);
+		candidate.targetMip = UINT8_MAX; // Note: Marking as already streamed.
+		streamImage(candidate.instance, streamedImage, residentMip + 1);
+	}
+
+	// Note: Refining the most under-resolved images first while memory budget allows it.
+	for (auto i = candidates.rbegin(); i != candidates.rend(); i++)
+	{
+		if (streamLoadCount >= maxImageStreamLoads)
+			break;
+
+		auto streamedImage = streamedImages.at(i->instance);
+		auto residentMip = streamedImage->residentMip;
+		if (i->targetMip >= residentMip)
+			continue;
+
+		auto fullMipSize = streamedImage->fullMipSize; auto fullMipCount = streamedImage->fullMipCount;
+		auto residentSize = calcStreamedImageSize(fullMipSize, fullMipCount, residentMip);
+		auto targetMip = i->targetMip;
+		auto targetSize = calcStreamedImageSize(fullMipSize, fullMipCount, targetMip);
+
+		if (projectedSize + (targetSize - residentSize) > imageStreamBudget)
+		{
+			targetMip = residentMip - 1; // Note: Trying to refine at least one mip level.
+			targetSize = calcStreamedImageSize(fullMipSize, fullMipCount, targetMip);
+			if (projectedSize + (targetSize - residentSize) > imageStreamBudget)
+				continue;
+		}
+
+		projectedSize += targetSize - residentSize;
+		streamImage(i->instance, streamedImage, targetMip);
+	}
+}
+void ResourceSystem::requestImageSize(ID<Image> image, uint32 screenSize) noexcept
+{
+	auto result = streamedImages.find(image);
+	if (result == streamedImages.end())
+		return;
+
+	auto& requestedSize = result->second->requestedSize;
+	auto currentSize = requestedSize.load(memory_order_relaxed);
+	while (currentSize < screenSize && !requestedSize.compare_exchange_weak(
+		currentSize, screenSize, memory_order_relaxed)) { }
+}
+
 //**********************************************************************************************************************
 void ResourceSystem::input()
 {
@@ -397,11 +734,12 @@ void ResourceSystem::input()
 	}
 	loadedImageArray.clear();
 
-	queueLocker.lock();
+	updateStreamedImages();
+
+	uint64 uploadSize = 0; uint32 uploadCount = 0;
 	dequeuePipelines();
-	dequeueBuffers();
-	dequeueImages();
-	queueLocker.unlock();
+	dequeueBuffers(uploadSize, uploadCount);
+	dequeueImages(uploadSize, uploadCount);
 }
 
 #if GARDEN_DEBUG || GARDEN_EDITOR
@@ -869,6 +1207,26 @@ static void loadMissingModel(const vector<BufferChannel>& channels, vector<uint8
 		default: abort();
 		}
 	}
+
+	const uint16 indices[3] = { 0, 1, 2 };
+	indexData.resize(sizeof(indices));
+	memcpy(indexData.data(), indices, sizeof(indices));
+	vertexCount = indexCount = 3;
+}
+static void loadMissingModel(ModelConverter::ModelData& modelData)
+{
+	uint32 indexCount = 0;
+	modelData = {};
+	modelData.channels = { BufferChannel::Positions, BufferChannel::Normals, BufferChannel::TextureCoords };
+	loadMissingModel(modelData.channels, modelData.vertexData, 
+		modelData.indexData, modelData.vertexCount, indexCount);
+
+	ModelConverter::Lod lod;
+	lod.indexCount = indexCount;
+	modelData.lods.push_back(lod);
+	modelData.aabbMin = float3(-1.0f, -1.0f, 0.0f);
+	modelData.aabbMax = float3(1.0f, 1.0f, 0.0f);
+	modelData.indexType = IndexType::Uint16;
 }
 
 #if !GARDEN_PACK_RESOURCES
@@ -1227,26 +1585,93 @@ static void copyLoadedImageData(const vector<vector<uint8>>& pixelArrays, uint8*
 	}
 }
 
-static void calcLoadedImageDim(psize pathCount, uint2 realSize,
-	ImageLoadFlags flags, uint2& imageSize, uint32& layerCount) noexcept
+//**********************************************************************************************************************
+static bool isStreamDownsampleSupported(Image::Format format) noexcept
 {
-	imageSize = realSize; layerCount = (uint32)pathCount;
-	if (hasAnyFlag(flags, ImageLoadFlags::LoadAsArray | ImageLoadFlags::LoadAs3D))
+	switch (format)
+	{
+	case Image::Format::UnormR8: case Image::Format::UnormR8G8: 
+	case Image::Format::UnormR8G8B8A8: case Image::Format::UnormB8G8R8A8:
+	case Image::Format::SrgbR8: case Image::Format::SrgbR8G8: 
+	case Image::Format::SrgbR8G8B8A8: case Image::Format::SrgbB8G8R8A8:
+	case Image::Format::UnormR16: case Image::Format::UnormR16G16: case Image::Format::UnormR16G16B16A16:
+	case Image::Format::SfloatR16: case Image::Format::SfloatR16G16: case Image::Format::SfloatR16G16B16A16:
+	case Image::Format::SfloatR32: case Image::Format::SfloatR32G32: case Image::Format::SfloatR32G32B32A32:
+		return true;
+	default: return false;
+	}
+}
+
+template<typename T>
+static void downsampleImageLayer(const uint8* src, uint8* dst, 
+	uint2 srcSize, uint2 dstSize, uint8 componentCount) noexcept
+{
+	auto srcPixels = (const T*)src; auto dstPixels = (T*)dst;
+	for (uint32 y = 0; y < dstSize.y; y++)
 	{
-		if (realSize.x > realSize.y)
+		auto srcY0 = std::min(y * 2, srcSize.y - 1) * srcSize.x;
+		auto srcY1 = std::min(y * 2 + 1, srcSize.y - 1) * srcSize.x;
+
+		for (uint32 x = 0; x < dstSize.x; x++)
 		{
-			layerCount = realSize.x / realSize.y;
-			imageSize.x = imageSize.y;
+			auto srcX0 = std::min(x * 2, srcSize.x - 1), srcX1 = std::min(x * 2 + 1, srcSize.x - 1);
+			auto dstPixel = dstPixels + ((psize)y * dstSize.x + x) * componentCount;
+
+			for (uint8 c = 0; c < componentCount; c++)
+			{
+				auto sum = (float)srcPixels[(srcY0 + srcX0) * componentCount + c] + 
+					(float)srcPixels[(srcY0 + srcX1) * componentCount + c] + 
+					(float)srcPixels[(srcY1 + srcX0) * componentCount + c] + 
+					(float)srcPixels[(srcY1 + srcX1) * componentCount + c];
+				if constexpr (std::is_integral_v<T>)
+					dstPixel[c] = (T)(sum * 0.25f + 0.5f);
+				else dstPixel[c] = (T)(sum * 0.25f);
+			}
 		}
-		else
+	}
+}
+
+/**
+ * @brief Box filters image layers on the CPU down to the streamed top mip level.
+ * @details Keeps staging and GPU upload size proportional to the streamed mip instead of the full resolution.
+ * @note sRGB data is averaged in the gamma space, same as the GPU blit mip chain in the most drivers.
+ */
+static void downsampleStreamedImage(vector<uint8>& layerData, Image::Format format, 
+	uint2& size, uint32 layerCount, uint8 streamMip)
+{
+	auto componentCount = toComponentCount(format);
+	auto pixelBinarySize = toBinarySize(1, format);
+	vector<uint8> mipData;
+
+	for (uint8 i = 0; i < streamMip; i++)
+	{
+		auto mipSize = uint2(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+		auto srcLayerSize = (psize)size.x * size.y * pixelBinarySize;
+		auto dstLayerSize = (psize)mipSize.x * mipSize.y * pixelBinarySize;
+		mipData.resize(dstLayerSize * layerCount);
+
+		for (uint32 l = 0; l < layerCount; l++)
 		{
-			layerCount = realSize.y / realSize.x;
-			imageSize.y = imageSize.x;
+			auto src = layerData.data() + srcLayerSize * l;
+			auto dst = mipData.data() + dstLayerSize * l;
+			switch (pixelBinarySize / componentCount)
+			{
+			case sizeof(uint8): downsampleImageLayer<uint8>(src, dst, size, mipSize, componentCount); break;
+			case sizeof(uint16):
+				if (isFormatSfloat(format))
+					downsampleImageLayer<half>(src, dst, size, mipSize, componentCount);
+				else downsampleImageLayer<uint16>(src, dst, size, mipSize, componentCount);
+				break;
+			case sizeof(float): downsampleImageLayer<float>(src, dst, size, mipSize, componentCount); break;
+			default: abort();
+			}
 		}
 
-		if (layerCount == 0) layerCount = 1;
+		std::swap(layerData, mipData);
+		size = mipSize;
 	}
 }
+
 static Image::Type calcLoadedImageType(uint32 sizeY, ImageLoadFlags flags) noexcept
 {
 	if (hasAnyFlag(flags, ImageLoadFlags::TypeCubemap))
@@ -1272,6 +1697,93 @@ static Image::Format toSrgbFormat(int componentCount)
 	}
 }
 
+//**********************************************************************************************************************
+void ResourceSystem::addImageLoadTask(ImageLoadData* data, float taskPriority)
+{
+	auto threadSystem = ThreadSystem::Instance::get();
+	threadSystem->getBackgroundPool().addTask([this, data](const ThreadPool::Task& task)
+	{
+		SET_CPU_ZONE_SCOPED("Image Load");
+
+		auto& paths = data->paths; auto flags = data->flags;
+		vector<vector<uint8>> pixelArrays(paths.size()); uint2 realSize;
+		auto dataFormat = hasAnyFlag(flags, ImageLoadFlags::LoadAsSrgb) ? 
+			toSrgbFormat(toComponentCount(data->format)) : data->format;
+
+		if (hasAnyFlag(flags, ImageLoadFlags::TypeCubemap) && paths.size() == 1)
+		{
+			pixelArrays.resize(Image::cubemapFaceCount);
+			loadCubemapData(paths[0], pixelArrays[0], pixelArrays[1], pixelArrays[2], pixelArrays[3], 
+				pixelArrays[4], pixelArrays[5], realSize, dataFormat, task.getThreadIndex());
+			auto p = paths[0].generic_string();
+			paths = { p + "-nx", p + "-px", p + "-ny", p + "-py", p + "-nz", p + "-pz" };
+		}
+		else
+		{
+			loadImageData(paths.data(), paths.size(), pixelArrays, 
+				realSize, dataFormat, task.getThreadIndex());
+		}
+
+		uint2 imageSize; uint32 layerCount; calcLoadedImageDim(
+			paths.size(), realSize, flags, imageSize, layerCount);
+		auto mipCount = calcLoadedImageMipCount(data->maxMipCount, imageSize);
+		auto imageType = calcLoadedImageType(realSize.y, flags);
+		auto pixelCount = (psize)realSize.x * realSize.y;
+		auto imageBinarySize = toBinarySize(pixelCount, dataFormat);
+		GARDEN_ASSERT_MSG(imageBinarySize > 0, "Assert " + paths[0].generic_string());
+		auto fullMipSize = imageBinarySize * paths.size();
+		auto mipSize = imageSize; uint8 fullMipCount = 0, streamMip = 0;
+
+		// Note: Not streaming formats which can't be box filtered on the CPU. (Compressed, packed, integer)
+		if (hasAnyFlag(flags, ImageLoadFlags::LoadStreamed) && isStreamDownsampleSupported(dataFormat))
+		{
+			fullMipCount = mipCount;
+			streamMip = data->streamMip == UINT8_MAX ? calcStreamBaseMip(imageSize, mipCount, 
+				data->streamBaseSize) : std::min(data->streamMip, (uint8)(mipCount - 1));
+			mipCount -= streamMip;
+		}
+
+		vector<uint8> layerData;
+		if (streamMip > 0)
+		{
+			layerData.resize(fullMipSize);
+			copyLoadedImageData(pixelArrays, layerData.data(), realSize, 
+				imageSize, imageBinarySize / pixelCount, imageType, flags);
+			pixelArrays = {}; // Note: Releasing full resolution data before the downsampling.
+			downsampleStreamedImage(layerData, dataFormat, mipSize, layerCount, streamMip);
+		}
+
+		auto stagingSize = streamMip > 0 ? layerData.size() : fullMipSize;
+		if (data->format != Image::Format::Undefined) dataFormat = data->format;
+		
+		ImageQueueItem item =
+		{
+			ImageExt::create(imageType, dataFormat, data->usage, data->strategy, 
+				u32x4(mipSize.x, mipSize.y, layerCount, mipCount), data->imageVersion),
+			BufferExt::create(Buffer::Usage::TransferSrc, Buffer::CpuAccess::SequentialWrite, 
+				Buffer::Location::Auto, Buffer::Strategy::Speed, // Note: Staging does not need TransferQ flag.
+				stagingSize, 0),
+			std::move(paths), realSize, data->instance, flags, fullMipCount, streamMip, fullMipSize
+		};
+
+		if (streamMip > 0)
+		{
+			memcpy(item.staging.getMap(), layerData.data(), layerData.size());
+		}
+		else
+		{
+			copyLoadedImageData(pixelArrays, item.staging.getMap(), realSize, 
+				imageSize, imageBinarySize / pixelCount, imageType, flags);
+		}
+		item.staging.flush();
+
+		loadedImageQueue.push(std::move(item));
+
+		delete data;
+	},
+	taskPriority);
+}
+
 //**********************************************************************************************************************
 Ref<Image> ResourceSystem::loadImage(const fs::path* paths, psize pathCount, Image::Format format, 
 	Image::Usage usage, uint8 maxMipCount, Image::Strategy strategy, ImageLoadFlags flags, float taskPriority)
@@ -1307,6 +1819,11 @@ Ref<Image> ResourceSystem::loadImage(const fs::path* paths, psize pathCount, Ima
 		GARDEN_ASSERT_MSG(!hasAnyFlag(flags, ImageLoadFlags::LoadAsArray | ImageLoadFlags::TypeArray | 
 			ImageLoadFlags::LoadAs3D | ImageLoadFlags::Type3D), "Assert " + paths[0].generic_string());
 	}
+	if (hasAnyFlag(flags, ImageLoadFlags::LoadStreamed))
+	{
+		GARDEN_ASSERT_MSG(!hasAnyFlag(flags, ImageLoadFlags::LoadAs3D | 
+			ImageLoadFlags::Type3D), "Assert " + paths[0].generic_string());
+	}
 	string debugName = hasAnyFlag(flags, ImageLoadFlags::LoadShared) ? "shared." : "";
 	#endif
 
@@ -1341,6 +1858,10 @@ Ref<Image> ResourceSystem::loadImage(const fs::path* paths, psize pathCount, Ima
 		}
 	}
 	
+	// Note: Streamed top mip is downsampled on the CPU, the resident mip chain is still generated with a self blit.
+	if (hasAnyFlag(flags, ImageLoadFlags::LoadStreamed) && maxMipCount != 1)
+		usage |= Image::Usage::TransferSrc;
+
 	auto graphicsAPI = GraphicsAPI::get();
 	auto imageVersion = graphicsAPI->imageVersion++;
 	auto image = graphicsAPI->imagePool.create(usage, strategy, imageVersion);
@@ -1369,59 +1890,25 @@ Ref<Image> ResourceSystem::loadImage(const fs::path* paths, psize pathCount, Ima
 		data->maxMipCount = maxMipCount;
 		data->flags = flags;
 
-		threadSystem->getBackgroundPool().addTask([this, data](const ThreadPool::Task& task)
+		if (hasAnyFlag(flags, ImageLoadFlags::LoadStreamed))
 		{
-			SET_CPU_ZONE_SCOPED("Image Load");
-
-			auto& paths = data->paths; auto flags = data->flags;
-			vector<vector<uint8>> pixelArrays(paths.size()); uint2 realSize;
-			auto dataFormat = hasAnyFlag(flags, ImageLoadFlags::LoadAsSrgb) ? 
-				toSrgbFormat(toComponentCount(data->format)) : data->format;
-
-			if (hasAnyFlag(flags, ImageLoadFlags::TypeCubemap) && paths.size() == 1)
-			{
-				pixelArrays.resize(Image::cubemapFaceCount);
-				loadCubemapData(paths[0], pixelArrays[0], pixelArrays[1], pixelArrays[2], pixelArrays[3], 
-					pixelArrays[4], pixelArrays[5], realSize, dataFormat, task.getThreadIndex());
-				auto p = paths[0].generic_string();
-				paths = { p + "-nx", p + "-px", p + "-ny", p + "-py", p + "-nz", p + "-pz" };
-			}
-			else
-			{
-				loadImageData(paths.data(), paths.size(), pixelArrays, 
-					realSize, dataFormat, task.getThreadIndex());
-			}
-
-			uint2 imageSize; uint32 layerCount; calcLoadedImageDim(
-				paths.size(), realSize, flags, imageSize, layerCount);
-			auto mipCount = calcLoadedImageMipCount(data->maxMipCount, imageSize);
-			auto imageType = calcLoadedImageType(realSize.y, flags);
-			auto pixelCount = (psize)realSize.x * realSize.y;
-			auto imageBinarySize = toBinarySize(pixelCount, dataFormat);
-			if (data->format != Image::Format::Undefined) dataFormat = data->format;
-			GARDEN_ASSERT_MSG(imageBinarySize > 0, "Assert " + paths[0].generic_string());
-			
-			ImageQueueItem item =
-			{
-				ImageExt::create(imageType, dataFormat, data->usage, data->strategy, 
-					u32x4(imageSize.x, imageSize.y, layerCount, mipCount), data->imageVersion),
-				BufferExt::create(Buffer::Usage::TransferSrc, Buffer::CpuAccess::SequentialWrite, 
-					Buffer::Location::Auto, Buffer::Strategy::Speed, // Note: Staging does not need TransferQ flag.
-					imageBinarySize * paths.size(), 0),
-				std::move(paths), realSize, data->instance, flags
-			};
-
-			copyLoadedImageData(pixelArrays, item.staging.getMap(), realSize, 
-				imageSize, imageBinarySize / pixelCount, imageType, flags);
-			item.staging.flush();
-
-			queueLocker.lock();
-			loadedImageQueue.push(std::move(item));
-			queueLocker.unlock();
+			auto streamedImage = new StreamedImage();
+			streamedImage->paths = data->paths;
+			streamedImage->imageVersion = imageVersion;
+			streamedImage->taskPriority = taskPriority;
+			streamedImage->format = format;
+			streamedImage->usage = usage;
+			streamedImage->strategy = strategy;
+			streamedImage->flags = flags;
+			streamedImage->maxMipCount = maxMipCount;
+			auto result = streamedImages.emplace(image, streamedImage);
+			GARDEN_ASSERT_MSG(result.second, "Detected memory corruption");
+
+			data->streamBaseSize = imageStreamBaseSize;
+			data->streamMip = UINT8_MAX;
+		}
 
-			delete data;
-		},
-		taskPriority);
+		addImageLoadTask(data, taskPriority);
 	}
 	else
 	{
@@ -1620,11 +2107,293 @@ void ResourceSystem::destroyShared(Ref<Image>& image)
 }
 
 //**********************************************************************************************************************
-Ref<Buffer> ResourceSystem::loadBuffer(const fs::path& path, 
-	Buffer::Strategy strategy, BufferLoadFlags flags, float taskPriority)
+void ResourceSystem::loadModelData(const fs::path& path, 
+	ModelConverter::ModelData& modelData, int32 threadIndex) const noexcept
 {
 	GARDEN_ASSERT(!path.empty());
-	abort(); // TODO: load plain buffer binary data.
+	GARDEN_ASSERT(threadIndex < (int32)thread::hardware_concurrency());
+
+	auto modelPath = fs::path("models") / path;
+	modelPath += ModelConverter::modelExtension;
+	vector<uint8> dataBuffer;
+
+	#if GARDEN_PACK_RESOURCES
+	if (threadIndex < 0)
+		threadIndex = 0;
+	else threadIndex++;
+
+	uint64 itemIndex = 0;
+	if (!packReader.getItemIndex(modelPath, itemIndex))
+	{
+		GARDEN_LOG_ERROR("Model does not exist. (path: " + path.generic_string() + ")");
+		loadMissingModel(modelData);
+		return;
+	}
+
+	packReader.readItemData(itemIndex, dataBuffer, threadIndex);
+	#else
+	fs::path filePath;
+	if (!File::tryGetResourcePath(appResourcesPath, modelPath, filePath))
+	{
+		#if GARDEN_DEBUG
+		auto sourcePath = fs::path("models") / path; sourcePath += ".ext";
+		fs::path inputFilePath; auto isFound = false;
+
+		for (auto fileExt : modelFileExts)
+		{
+			sourcePath.replace_extension(fileExt);
+			if (!File::tryGetResourcePath(appResourcesPath, sourcePath, inputFilePath))
+				continue;
+			isFound = true;
+			break;
+		}
+
+		if (!isFound)
+		{
+			GARDEN_LOG_ERROR("Model file does not exist. (path: " + path.generic_string() + ")");
+			loadMissingModel(modelData);
+			return;
+		}
+
+		filePath = appCachePath / modelPath;
+		if (!fs::exists(filePath) || fs::last_write_time(inputFilePath) > fs::last_write_time(filePath))
+		{
+			try
+			{
+				ModelConverter::convertModel(inputFilePath.filename(), 
+					inputFilePath.parent_path(), filePath.parent_path());
+				GARDEN_LOG_DEBUG("Converted model. (path: " + path.generic_string() + ")");
+			}
+			catch (exception& e)
+			{
+				GARDEN_LOG_ERROR("Failed to convert model. (path: " + 
+					path.generic_string() + ", error: " + string(e.what()) + ")");
+				loadMissingModel(modelData);
+				return;
+			}
+		}
+		#else
+		GARDEN_LOG_ERROR("Model file does not exist. (path: " + path.generic_string() + ")");
+		loadMissingModel(modelData);
+		return;
+		#endif
+	}
+
+	try
+	{
+		File::loadBinary(filePath, dataBuffer);
+	}
+	catch (exception& e)
+	{
+		GARDEN_LOG_ERROR(string(e.what()));
+		loadMissingModel(modelData);
+		return;
+	}
+	#endif
+
+	if (!ModelConverter::loadModel(dataBuffer.data(), dataBuffer.size(), modelData))
+	{
+		GARDEN_LOG_ERROR("Invalid model data. (path: " + path.generic_string() + ")");
+		loadMissingModel(modelData);
+		return;
+	}
+
+	GARDEN_LOG_TRACE("Loaded model. (path: " + path.generic_string() + ")");
+}
+
+//**********************************************************************************************************************
+static const Buffer::Usage modelVertexUsage = 
+	Buffer::Usage::Vertex | Buffer::Usage::TransferDst | Buffer::Usage::TransferQ;
+static const Buffer::Usage modelIndexUsage = 
+	Buffer::Usage::Index | Buffer::Usage::TransferDst | Buffer::Usage::TransferQ;
+
+static void moveModelInfo(ModelConverter::ModelData& modelData, ResourceSystem::ModelInfo& modelInfo) noexcept
+{
+	modelInfo.channels = std::move(modelData.channels);
+	modelInfo.lods = std::move(modelData.lods);
+	modelInfo.aabbMin = modelData.aabbMin;
+	modelInfo.aabbMax = modelData.aabbMax;
+	modelInfo.vertexCount = modelData.vertexCount;
+	modelInfo.indexType = modelData.indexType;
+}
+
+void ResourceSystem::addModelLoadTask(ModelLoadData* data, float taskPriority)
+{
+	auto threadSystem = ThreadSystem::Instance::get();
+	threadSystem->getBackgroundPool().addTask([this, data](const ThreadPool::Task& task)
+	{
+		SET_CPU_ZONE_SCOPED("Model Load");
+
+		ModelConverter::ModelData modelData;
+		loadModelData(data->path, modelData, task.getThreadIndex());
+		const auto& vertexData = modelData.vertexData; const auto& indexData = modelData.indexData;
+
+		BufferQueueItem vertexItem =
+		{
+			BufferExt::create(modelVertexUsage, Buffer::CpuAccess::None, Buffer::Location::PreferGPU, 
+				data->strategy, vertexData.size(), data->vertexBufferVersion),
+			BufferExt::create(Buffer::Usage::TransferSrc, Buffer::CpuAccess::SequentialWrite, 
+				Buffer::Location::Auto, Buffer::Strategy::Speed, vertexData.size(), 0),
+			data->path, data->vertexBuffer
+		};
+		memcpy(vertexItem.staging.getMap(), vertexData.data(), vertexData.size());
+		vertexItem.staging.flush();
+
+		BufferQueueItem indexItem =
+		{
+			BufferExt::create(modelIndexUsage, Buffer::CpuAccess::None, Buffer::Location::PreferGPU, 
+				data->strategy, indexData.size(), data->indexBufferVersion),
+			BufferExt::create(Buffer::Usage::TransferSrc, Buffer::CpuAccess::SequentialWrite, 
+				Buffer::Location::Auto, Buffer::Strategy::Speed, indexData.size(), 0),
+			std::move(data->path), data->indexBuffer, new ModelInfo()
+		};
+		memcpy(indexItem.staging.getMap(), indexData.data(), indexData.size());
+		indexItem.staging.flush();
+		moveModelInfo(modelData, *indexItem.modelInfo);
+
+		loadedBufferQueue.push(std::move(vertexItem));
+		loadedBufferQueue.push(std::move(indexItem));
+
+		delete data;
+	},
+	taskPriority);
+}
+
+static void uploadModelBuffer(GraphicsAPI* graphicsAPI, ID<Buffer> buffer, 
+	Buffer::Usage usage, Buffer::Strategy strategy, const vector<uint8>& data)
+{
+	auto bufferInstance = BufferExt::create(usage, Buffer::CpuAccess::None, 
+		Buffer::Location::PreferGPU, strategy, data.size(), 0);
+	auto bufferView = graphicsAPI->bufferPool.get(buffer);
+	BufferExt::moveInternalObjects(bufferInstance, **bufferView);
+
+	auto graphicsSystem = GraphicsSystem::Instance::get();
+	auto stagingBuffer = graphicsSystem->createStagingBuffer(Buffer::CpuAccess::SequentialWrite, data.size());
+	SET_RESOURCE_DEBUG_NAME(stagingBuffer, "buffer.staging.loadedModel" + to_string(*stagingBuffer));
+
+	auto stagingView = graphicsAPI->bufferPool.get(stagingBuffer);
+	memcpy(stagingView->getMap(), data.data(), data.size());
+	stagingView->flush();
+
+	graphicsSystem->startRecording(CommandBufferType::TransferOnly);
+	Buffer::copy(stagingBuffer, buffer);
+	graphicsSystem->stopRecording();
+	graphicsAPI->bufferPool.destroy(stagingBuffer);
+}
+
+//**********************************************************************************************************************
+void ResourceSystem::loadModel(const fs::path& path, Ref<Buffer>& vertexBuffer, Ref<Buffer>& indexBuffer, 
+	Buffer::Strategy strategy, BufferLoadFlags flags, float taskPriority)
+{
+	GARDEN_ASSERT(!path.empty());
+
+	#if GARDEN_DEBUG || GARDEN_EDITOR
+	string debugName = hasAnyFlag(flags, BufferLoadFlags::LoadShared) ? "shared." : "";
+	#endif
+
+	Hash128 vertexHash, indexHash;
+	if (hasAnyFlag(flags, BufferLoadFlags::LoadShared))
+	{
+		auto pathString = path.generic_string();
+		auto hashState = Hash128::getState();
+		Hash128::resetState(hashState);
+		Hash128::updateState(hashState, pathString.c_str(), pathString.length());
+		Hash128::updateState(hashState, &modelVertexUsage, sizeof(Buffer::Usage));
+		Hash128::updateState(hashState, &flags, sizeof(BufferLoadFlags));
+		vertexHash = Hash128::digestState(hashState);
+
+		Hash128::resetState(hashState);
+		Hash128::updateState(hashState, pathString.c_str(), pathString.length());
+		Hash128::updateState(hashState, &modelIndexUsage, sizeof(Buffer::Usage));
+		Hash128::updateState(hashState, &flags, sizeof(BufferLoadFlags));
+		indexHash = Hash128::digestState(hashState);
+
+		auto vertexResult = sharedBuffers.find(vertexHash);
+		auto indexResult = sharedBuffers.find(indexHash);
+		if (vertexResult != sharedBuffers.end() && indexResult != sharedBuffers.end())
+		{
+			auto graphicsSystem = GraphicsSystem::Instance::get();
+			if (graphicsSystem->get(vertexResult->second)->isLoaded() && 
+				graphicsSystem->get(indexResult->second)->isLoaded())
+			{
+				LoadedBufferItem item;
+				item.path = path;
+				item.instance = ID<Buffer>(vertexResult->second);
+				loadedBufferArray.push_back(item);
+				item.instance = ID<Buffer>(indexResult->second);
+				loadedBufferArray.push_back(std::move(item));
+			}
+
+			vertexBuffer = vertexResult->second;
+			indexBuffer = indexResult->second;
+			return;
+		}
+	}
+
+	auto graphicsAPI = GraphicsAPI::get();
+	auto vertexBufferVersion = graphicsAPI->bufferVersion++;
+	auto indexBufferVersion = graphicsAPI->bufferVersion++;
+	auto vertexInstance = graphicsAPI->bufferPool.create(modelVertexUsage, 
+		Buffer::CpuAccess::None, Buffer::Location::PreferGPU, strategy, vertexBufferVersion);
+	auto indexInstance = graphicsAPI->bufferPool.create(modelIndexUsage, 
+		Buffer::CpuAccess::None, Buffer::Location::PreferGPU, strategy, indexBufferVersion);
+
+	modelInfos.erase(indexInstance); // Note: Index buffer ID can be reused from the destroyed model.
+
+	#if GARDEN_DEBUG || GARDEN_EDITOR
+	graphicsAPI->bufferPool.get(vertexInstance)->setDebugName(
+		"buffer.vertex." + debugName + path.generic_string());
+	graphicsAPI->bufferPool.get(indexInstance)->setDebugName(
+		"buffer.index." + debugName + path.generic_string());
+	#endif
+
+	auto threadSystem = ThreadSystem::Instance::tryGet();
+	if (!hasAnyFlag(flags, BufferLoadFlags::LoadSync) && threadSystem)
+	{
+		auto data = new ModelLoadData();
+		data->vertexBufferVersion = vertexBufferVersion;
+		data->indexBufferVersion = indexBufferVersion;
+		data->path = path;
+		data->vertexBuffer = vertexInstance;
+		data->indexBuffer = indexInstance;
+		data->strategy = strategy;
+		addModelLoadTask(data, taskPriority);
+	}
+	else
+	{
+		SET_CPU_ZONE_SCOPED("Model Load");
+
+		ModelConverter::ModelData modelData;
+		loadModelData(path, modelData);
+		uploadModelBuffer(graphicsAPI, vertexInstance, modelVertexUsage, strategy, modelData.vertexData);
+		uploadModelBuffer(graphicsAPI, indexInstance, modelIndexUsage, strategy, modelData.indexData);
+		moveModelInfo(modelData, modelInfos[indexInstance]);
+
+		LoadedBufferItem item;
+		item.path = path;
+		item.instance = vertexInstance;
+		loadedBufferArray.push_back(item);
+		item.instance = indexInstance;
+		loadedBufferArray.push_back(std::move(item));
+	}
+
+	vertexBuffer = Ref<Buffer>(vertexInstance);
+	indexBuffer = Ref<Buffer>(indexInstance);
+	if (hasAnyFlag(flags, BufferLoadFlags::LoadShared))
+	{
+		auto result = sharedBuffers.emplace(vertexHash, vertexBuffer);
+		GARDEN_ASSERT_MSG(result.second, "Detected memory corruption");
+		result = sharedBuffers.emplace(indexHash, indexBuffer);
+		GARDEN_ASSERT_MSG(result.second, "Detected memory corruption");
+	}
+}
+
+//**********************************************************************************************************************
+Ref<Buffer> ResourceSystem::loadBuffer(const fs::path& path, 
+	Buffer::Strategy strategy, BufferLoadFlags flags, float taskPriority)
+{
+	GARDEN_ASSERT(!path.empty());
+	abort(); // TODO: load plain buffer binary data.
 }
 void ResourceSystem::destroyShared(Ref<Buffer>& buffer)
 {
@@ -1639,6 +2408,7 @@ void ResourceSystem::destroyShared(Ref<Buffer>& buffer)
 		break;
 	}
 
+	modelInfos.erase(ID<Buffer>(buffer));
 	GraphicsSystem::Instance::get()->destroy(buffer);
 }
 
@@ -1895,9 +2665,7 @@ ID<GraphicsPipeline> ResourceSystem::loadGraphicsPipeline(const fs::path& path,
 				data->instance
 			};
 
-			queueLocker.lock();
 			loadedGraphicsQueue.push(std::move(item));
-			queueLocker.unlock();
 
 			delete data;
 		},
@@ -2077,9 +2845,7 @@ ID<ComputePipeline> ResourceSystem::loadComputePipeline(const fs::path& path, co
 				data->instance
 			};
 
-			queueLocker.lock();
 			loadedComputeQueue.push(std::move(item));
-			queueLocker.unlock();
 
 			delete data;
 		},
@@ -2283,9 +3049,7 @@ ID<RayTracingPipeline> ResourceSystem::loadRayTracingPipeline(const fs::path& pa
 				data->instance
 			};
 
-			queueLocker.lock();
 			loadedRayTracingQueue.push(std::move(item));
-			queueLocker.unlock();
 
 			delete data;
 		},
@@ -2340,10 +3104,223 @@ ID<RayTracingPipeline> ResourceSystem::loadRayTracingPipeline(const fs::path& pa
 	return pipeline;
 }
 
+//**********************************************************************************************************************
+static void deserializeBinaryBlock(Manager* manager, const uint8* data, const BinarySceneBlock& block, 
+	System* system, const ID<Entity>* entities, const fs::path& path)
+{
+	auto serializableSystem = dynamic_cast<ISerializable*>(system);
+	auto componentType = system->getComponentType();
+	auto record = data + block.dataOffset;
+	auto blockEnd = record + block.dataSize;
+	JsonDeserializer deserializer;
+
+	while (record < blockEnd)
+	{
+		const auto& header = *(const BinarySceneRecord*)record;
+		record += header.size;
+
+		auto entity = entities[header.entityIndex];
+		if (!entity)
+			continue;
+		auto componentView = manager->tryGet(entity, componentType);
+		if (!componentView)
+			continue;
+
+		if (block.recordType != BinaryRecordType::Generic)
+		{
+			serializableSystem->deserializeRecord(header, View<Component>(componentView));
+			continue;
+		}
+
+		auto bsonData = (const uint8*)(&header + 1);
+		try
+		{
+			deserializer.load(bsonData, *(const uint32*)bsonData);
+		}
+		catch (exception& e)
+		{
+			GARDEN_LOG_ERROR("Failed to deserialize scene component. (path: " + path.generic_string() + 
+				", entity: " + to_string(header.entityIndex) + ", error: " + string(e.what()) + ")");
+			continue;
+		}
+		serializableSystem->deserialize(deserializer, View<Component>(componentView));
+	}
+}
+
+//**********************************************************************************************************************
+static void loadBinaryScene(Manager* manager, const uint8* data, const fs::path& path, ID<Entity> rootEntity)
+{
+	auto header = (const BinarySceneHeader*)data;
+	auto blocks = BinaryScene::getBlocks(data);
+	const auto& componentNames = manager->getComponentNames();
+	vector<System*> blockSystems(header->blockCount);
+
+	for (uint32 i = 0; i < header->blockCount; i++)
+	{
+		const auto& block = blocks[i];
+		auto type = string((const char*)data + block.nameOffset, block.nameLength);
+		auto result = componentNames.find(type);
+		if (result == componentNames.end())
+		{
+			GARDEN_LOG_ERROR("Unknown scene component type. (path: " + 
+				path.generic_string() + ", type: " + type + ")");
+			continue;
+		}
+
+		auto system = result->second;
+		if (!dynamic_cast<ISerializable*>(system))
+		{
+			GARDEN_LOG_ERROR("Not serializable scene system. (path: " + 
+				path.generic_string() + ", type: " + type + ")");
+			continue;
+		}
+		blockSystems[i] = system;
+	}
+
+	vector<ID<Entity>> entities(header->entityCount);
+	auto componentCounts = BinaryScene::getComponentCounts(data);
+	auto componentTypes = BinaryScene::getComponentTypes(data);
+
+	for (uint32 i = 0; i < header->entityCount; i++)
+	{
+		auto componentCount = componentCounts[i];
+		auto entity = manager->createEntity();
+		manager->reserveComponents(entity, componentCount);
+
+		for (uint32 j = 0; j < componentCount; j++)
+		{
+			auto system = blockSystems[*componentTypes++];
+			if (system)
+				manager->add(entity, system->getComponentType());
+		}
+
+		if (!manager->hasComponents(entity))
+		{
+			GARDEN_LOG_ERROR("Missing scene entity components. (path: " + 
+				path.generic_string() + ", entity: " + to_string(i) + ")");
+			manager->destroy(entity);
+			continue;
+		}
+		entities[i] = entity;
+	}
+
+	auto threadSystem = ThreadSystem::Instance::tryGet();
+	auto threadPool = threadSystem ? &threadSystem->getForegroundPool() : nullptr;
+	auto entityData = entities.data();
+	const BinarySceneBlock* transformBlock = nullptr;
+	vector<uint32> serialBlocks;
+
+	ThreadPool::Job transformJob;
+	vector<ThreadPool::Task::Function> asyncBlocks;
+
+	for (uint32 i = 0; i < header->blockCount; i++)
+	{
+		auto system = blockSystems[i];
+		if (!system || blocks[i].recordCount == 0)
+			continue;
+
+		const auto& block = blocks[i];
+		if (block.recordType == BinaryRecordType::Transform)
+		{
+			// Note: Transform records are independent, deserializing them before other systems which read transforms.
+			transformBlock = &block;
+			if (!threadPool)
+			{
+				serialBlocks.push_back(i);
+				continue;
+			}
+
+			auto records = data + block.dataOffset;
+			auto serializableSystem = dynamic_cast<ISerializable*>(system);
+			auto componentType = system->getComponentType();
+			auto recordSize = ((const BinarySceneRecord*)records)->size;
+			GARDEN_ASSERT(recordSize == sizeof(BinaryTransformRecord));
+
+			transformJob = threadPool->addItems([=](const ThreadPool::Task& task)
+			{
+				SET_CPU_ZONE_SCOPED("Binary Scene Transforms");
+
+				auto itemCount = task.getItemCount();
+				auto manager = Manager::Instance::get();
+
+				for (uint32 j = task.getItemOffset(); j < itemCount; j++)
+				{
+					const auto& record = *(const BinarySceneRecord*)(records + (psize)j * recordSize);
+					auto entity = entityData[record.entityIndex];
+					if (!entity)
+						continue;
+					auto componentView = manager->tryGet(entity, componentType);
+					if (componentView)
+						serializableSystem->deserializeRecord(record, View<Component>(componentView));
+				}
+			},
+			block.recordCount, ThreadPool::priorityHigh, {}, ThreadPool::defaultGrainSize);
+		}
+		else if (threadPool && dynamic_cast<ISerializable*>(system)->isDeserializeAsync())
+		{
+			asyncBlocks.push_back([data, &block, system, entityData, &path](const ThreadPool::Task& task)
+			{
+				SET_CPU_ZONE_SCOPED("Binary Scene Block");
+				deserializeBinaryBlock(Manager::Instance::get(), data, block, system, entityData, path);
+			});
+		}
+		else
+		{
+			serialBlocks.push_back(i);
+		}
+	}
+
+	if (threadPool)
+	{
+		if (!asyncBlocks.empty())
+		{
+			auto asyncJob = threadPool->addTasks(std::move(asyncBlocks), ThreadPool::priorityHigh, transformJob);
+			threadPool->wait(asyncJob);
+		}
+		else
+		{
+			threadPool->wait(transformJob);
+		}
+	}
+
+	// Note: Not async systems may access other systems state, deserializing them on the calling thread.
+	for (auto blockIndex : serialBlocks)
+	{
+		deserializeBinaryBlock(manager, data, blocks[blockIndex], 
+			blockSystems[blockIndex], entityData, path);
+	}
+
+	if (transformBlock)
+	{
+		auto record = data + transformBlock->dataOffset;
+		auto blockEnd = record + transformBlock->dataSize;
+
+		while (record < blockEnd)
+		{
+			const auto& transformRecord = *(const BinaryTransformRecord*)record;
+			record += transformRecord.header.size;
+
+			auto entity = entities[transformRecord.header.entityIndex];
+			if (!entity)
+				continue;
+
+			auto parent = transformRecord.parentIndex == BinaryTransformRecord::noParent ? 
+				rootEntity : entities[transformRecord.parentIndex];
+			if (!parent)
+				continue;
+
+			auto transformView = manager->tryGet<TransformComponent>(entity);
+			if (transformView)
+				transformView->setParent(parent);
+		}
+	}
+}
+
 //**********************************************************************************************************************
 ID<Entity> ResourceSystem::loadScene(const fs::path& path, bool addRootEntity)
 {
 	GARDEN_ASSERT(!path.empty());
+	SET_CPU_ZONE_SCOPED("Scene Load");
 
 	auto manager = Manager::Instance::get();
 	auto systemGroup = manager->tryGetSystemGroup<ISerializable>();
@@ -2353,7 +3330,6 @@ ID<Entity> ResourceSystem::loadScene(const fs::path& path, bool addRootEntity)
 		return {};
 	}
 
-	JsonDeserializer deserializer;
 	fs::path filePath = "scenes" / path; filePath += ".scene";
 
 	#if GARDEN_PACK_RESOURCES
@@ -2364,17 +3340,7 @@ ID<Entity> ResourceSystem::loadScene(const fs::path& path, bool addRootEntity)
 		return {};
 	}
 	packReader.readItemData(itemIndex, dataBuffer);
-
-	try
-	{
-		deserializer.load(dataBuffer);
-		dataBuffer = {};
-	}
-	catch (exception& e)
-	{
-		GARDEN_LOG_ERROR("Failed to deserialize scene. (path: " + path.generic_string() + ")");
-		return {};
-	}
+	auto sceneData = dataBuffer.data(); auto sceneSize = (psize)dataBuffer.size();
 	#else
 	fs::path scenePath;
 	if (!File::tryGetResourcePath(appResourcesPath, filePath, scenePath))
@@ -2383,18 +3349,47 @@ ID<Entity> ResourceSystem::loadScene(const fs::path& path, bool addRootEntity)
 		return {};
 	}
 
-	try
+	MappedFile mappedFile;
+	if (!mappedFile.tryMap(scenePath))
 	{
-		deserializer.load(scenePath);
-	}
-	catch (exception& e)
-	{
-		GARDEN_LOG_ERROR("Failed to deserialize scene. (path: " + 
-			path.generic_string() + ", error: " + string(e.what()) + ")");
+		GARDEN_LOG_ERROR("Failed to map scene file. (path: " + path.generic_string() + ")");
 		return {};
 	}
+	auto sceneData = mappedFile.getData(); auto sceneSize = mappedFile.getSize();
 	#endif
 
+	JsonDeserializer deserializer;
+	auto isBinary = BinaryScene::isBinary(sceneData, sceneSize);
+
+	if (isBinary)
+	{
+		string error;
+		if (!BinaryScene::validate(sceneData, sceneSize, error))
+		{
+			GARDEN_LOG_ERROR("Invalid binary scene. (path: " + path.generic_string() + ", error: " + error + ")");
+			return {};
+		}
+	}
+	else
+	{
+		try
+		{
+			#if GARDEN_PACK_RESOURCES
+			deserializer.load(dataBuffer);
+			dataBuffer = {};
+			#else
+			deserializer.load(string_view((const char*)sceneData, sceneSize));
+			mappedFile.unmap();
+			#endif
+		}
+		catch (exception& e)
+		{
+			GARDEN_LOG_ERROR("Failed to deserialize scene. (path: " + 
+				path.generic_string() + ", error: " + string(e.what()) + ")");
+			return {};
+		}
+	}
+
 	ID<Entity> rootEntity = {};
 	if (addRootEntity)
 	{
@@ -2418,90 +3413,97 @@ ID<Entity> ResourceSystem::loadScene(const fs::path& path, bool addRootEntity)
 		serializableSystem->preDeserialize(deserializer);
 	}
 
-	if (deserializer.beginChild("entities"))
+	if (isBinary)
 	{
-		const auto& componentNames = manager->getComponentNames();
-		auto entityCount = (uint32)deserializer.getArraySize();
-
-		string type;
-		for (uint32 i = 0; i < entityCount; i++)
+		loadBinaryScene(manager, sceneData, path, rootEntity);
+	}
+	else
+	{
+		if (deserializer.beginChild("entities"))
 		{
-			if (!deserializer.beginArrayElement(i))
-				break;
+			const auto& componentNames = manager->getComponentNames();
+			auto entityCount = (uint32)deserializer.getArraySize();
 
-			if (deserializer.beginChild("components"))
+			string type;
+			for (uint32 i = 0; i < entityCount; i++)
 			{
-				auto componentCount = (uint32)deserializer.getArraySize();
-				if (componentCount == 0)
-				{
-					deserializer.endChild();
-					GARDEN_LOG_ERROR("Missing scene entity components. (path: " + 
-						path.generic_string() + ", entity: " + to_string(i) + ")");
-					continue;
-				}
+				if (!deserializer.beginArrayElement(i))
+					break;
 
-				auto entity = manager->createEntity();
-				manager->reserveComponents(entity, componentCount);
-
-				for (uint32 j = 0; j < componentCount; j++)
+				if (deserializer.beginChild("components"))
 				{
-					if (!deserializer.beginArrayElement(j))
-						break;
-
-					if (!deserializer.read(".type", type))
+					auto componentCount = (uint32)deserializer.getArraySize();
+					if (componentCount == 0)
 					{
-						deserializer.endArrayElement();
-						GARDEN_LOG_ERROR("Missing scene component type. (path: " + path.generic_string() + 
-							", entity: " + to_string(i) + ", component: " + to_string(j) + ")");
+						deserializer.endChild();
+						GARDEN_LOG_ERROR("Missing scene entity components. (path: " + 
+							path.generic_string() + ", entity: " + to_string(i) + ")");
 						continue;
 					}
 
-					auto result = componentNames.find(type);
-					if (result == componentNames.end())
+					auto entity = manager->createEntity();
+					manager->reserveComponents(entity, componentCount);
+
+					for (uint32 j = 0; j < componentCount; j++)
 					{
+						if (!deserializer.beginArrayElement(j))
+							break;
+
+						if (!deserializer.read(".type", type))
+						{
+							deserializer.endArrayElement();
+							GARDEN_LOG_ERROR("Missing scene component type. (path: " + path.generic_string() + 
+								", entity: " + to_string(i) + ", component: " + to_string(j) + ")");
+							continue;
+						}
+
+						auto result = componentNames.find(type);
+						if (result == componentNames.end())
+						{
+							deserializer.endArrayElement();
+							GARDEN_LOG_ERROR("Unknown scene component type. (path: " + path.generic_string() + 
+								", entity: " + to_string(i) + ", component: " + to_string(j) + ")");
+							continue;
+						}
+
+						auto system = result->second;
+						auto serializableSystem = dynamic_cast<ISerializable*>(system);
+						if (!serializableSystem)
+						{
+							deserializer.endArrayElement();
+							GARDEN_LOG_ERROR("Not serializable scene system. (path: " + path.generic_string() + 
+								", entity: " + to_string(i) + ", component: " + to_string(j) + ")");
+							continue;
+						}
+
+						auto componentView = manager->add(entity, system->getComponentType());
+						serializableSystem->deserialize(deserializer, componentView);
 						deserializer.endArrayElement();
-						GARDEN_LOG_ERROR("Unknown scene component type. (path: " + path.generic_string() + 
-							", entity: " + to_string(i) + ", component: " + to_string(j) + ")");
-						continue;
 					}
 
-					auto system = result->second;
-					auto serializableSystem = dynamic_cast<ISerializable*>(system);
-					if (!serializableSystem)
+					if (!manager->hasComponents(entity))
 					{
-						deserializer.endArrayElement();
-						GARDEN_LOG_ERROR("Not serializable scene system. (path: " + path.generic_string() + 
-							", entity: " + to_string(i) + ", component: " + to_string(j) + ")");
-						continue;
+						GARDEN_LOG_ERROR("Missing scene entity components. (path: " + 
+							path.generic_string() + ", entity: " + to_string(i) + ")");
+						manager->destroy(entity);
 					}
-
-					auto componentView = manager->add(entity, system->getComponentType());
-					serializableSystem->deserialize(deserializer, componentView);
-					deserializer.endArrayElement();
-				}
-
-				if (!manager->hasComponents(entity))
-				{
-					GARDEN_LOG_ERROR("Missing scene entity components. (path: " + 
-						path.generic_string() + ", entity: " + to_string(i) + ")");
-					manager->destroy(entity);
-				}
-				else
-				{
-					if (addRootEntity)
+					else
 					{
-						auto transformView = manager->tryGet<TransformComponent>(entity);
-						if (transformView)
-							transformView->setParent(rootEntity);
+						if (addRootEntity)
+						{
+							auto transformView = manager->tryGet<TransformComponent>(entity);
+							if (transformView)
+								transformView->setParent(rootEntity);
+						}
 					}
+
+					deserializer.endChild();
 				}
 
-				deserializer.endChild();
+				deserializer.endArrayElement();
 			}
-
-			deserializer.endArrayElement();
+			deserializer.endChild();
 		}
-		deserializer.endChild();
 	}
 
 	for (auto system : *systemGroup)
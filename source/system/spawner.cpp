@@ -78,45 +78,37 @@ void SpawnerComponent::spawn(uint32 count)
 	auto transformSystem = TransformSystem::Instance::get();
 	auto physicsSystem = PhysicsSystem::Instance::tryGet();
 	auto characterSystem = CharacterSystem::Instance::tryGet();
+	auto& duplicates = SpawnerSystem::Instance::get()->spawnDuplicates;
 
-	for (uint32 i = 0; i < count; i++)
-	{
-		auto duplicateEntity = transformSystem->duplicateRecursive(prefabEntity);
+	if (physicsSystem)
+		physicsSystem->beginSimulationBatch();
+	transformSystem->duplicateRecursive(prefabEntity, count, duplicates);
+
+	// if (physicsSystem)... TODO: Duplicate constraints recursive.
 
-		// if (physicsSystem)... TODO: Duplicate constraints recursive.
+	auto position = f32x4::zero, scale = f32x4::one; auto rotation = quat::identity;
+	auto thisTransformView = manager->tryGet<TransformComponent>(entity);
+	if (thisTransformView && !spawnAsChild)
+	{
+		auto model = thisTransformView->calcModel();
+		extractTransform(model, position, rotation, scale);
+	}
+	auto parent = thisTransformView && spawnAsChild ? entity : ID<Entity>();
+	auto hasSpawnTransform = (bool)thisTransformView;
+	spawnedEntities.reserve(spawnedEntities.size() + count);
 
+	for (auto duplicateEntity : duplicates)
+	{
 		auto dupTransformView = manager->tryGet<TransformComponent>(duplicateEntity);
 		if (dupTransformView)
 		{
-			if (spawnAsChild)
-			{
-				if (manager->has<TransformComponent>(entity))
-				{
-					dupTransformView->setPosition(f32x4::zero);
-					dupTransformView->setScale(f32x4::one);
-					dupTransformView->setRotation(quat::identity);
-					dupTransformView->setParent(entity);
-				}
-				else
-				{
-					dupTransformView->setParent({});
-				}
-			}
-			else
+			if (hasSpawnTransform)
 			{
-				auto thisTransformView = manager->tryGet<TransformComponent>(entity);
-				if (thisTransformView)
-				{
-					auto model = thisTransformView->calcModel();
-					f32x4 position, scale; quat rotation;
-					extractTransform(model, position, rotation, scale);
-					dupTransformView->setPosition(position);
-					dupTransformView->setScale(scale);
-					dupTransformView->setRotation(rotation);
-				}
-				dupTransformView->setParent({});
+				dupTransformView->setPosition(position);
+				dupTransformView->setScale(scale);
+				dupTransformView->setRotation(rotation);
 			}
-			
+			dupTransformView->setParent(parent);
 			dupTransformView->setActive(true);
 		}
 
@@ -133,6 +125,10 @@ void SpawnerComponent::spawn(uint32 count)
 		spawnedEntities.push_back(dupLinkView->getUUID());
 	}
 
+	if (physicsSystem)
+		physicsSystem->endSimulationBatch();
+	duplicates.clear();
+
 	if (delay != 0.0f)
 		delayTime = InputSystem::Instance::get()->getCurrentTime() + delay;
 }
@@ -24,30 +24,53 @@
 #include FT_FREETYPE_H
 #include "freetype/ftmm.h"
 
+#include <algorithm>
+
 using namespace garden;
 
 //**********************************************************************************************************************
-static void prepareGlyphs(u32string_view chars, FontAtlas::GlyphMap& glyphs)
+namespace
+{
+	struct RasterGlyph final
+	{
+		vector<uint8> pixels;
+		uint2 size = uint2::zero;
+		int32 left = 0, top = 0;
+		float advance = 0.0f;
+	};
+}
+
+static void prepareGlyphs(u32string_view chars, vector<uint32>& values)
 {
-	Glyph glyph; glyph.value = '\0';
-	glyphs.emplace('\0', glyph); // Note: tofu symbol.
+	values.reserve(chars.size() + 1);
+	values.push_back('\0'); // Note: tofu symbol.
 
 	for (auto value : chars)
 	{
 		if (value == '\n') continue;
 		if (value == '\t') value = ' ';
-		glyph.value = value;
-		glyphs.emplace(value, glyph);
+		values.push_back(value);
 	}
+
+	std::sort(values.begin(), values.end());
+	values.erase(std::unique(values.begin(), values.end()), values.end());
 }
 
 static constexpr float fixedToFloat(FT_Fixed fixed) noexcept { return (float)fixed / 65536.0f; }
 static constexpr FT_Fixed floatToFixed(float f) noexcept { return (FT_Fixed)(f * 65536.0f + 0.5f); }
-static uint32 calcGlyphLength(psize glyphCount) noexcept { return (uint32)ceil(sqrt((double)glyphCount)); }
 
-static bool fillFontAtlas(const LinearPool<Font>& fontPool, FT_Library ftLibrary, const vector<Ref<Font>>& fonts, 
-	FontAtlas::GlyphMap& glyphs, uint8* pixels, uint32 fontSize, uint32 glyphLength, uint2 pixelSize, 
-	uint8 fontIndex, uint32 itemOffset, uint32 itemCount, uint32 threadIndex)
+static uint32 calcAtlasLength(uint64 value) noexcept
+{
+	uint32 length = 64;
+	while (length < value)
+		length <<= 1u;
+	return length;
+}
+
+//**********************************************************************************************************************
+static bool rasterizeGlyphs(const LinearPool<Font>& fontPool, FT_Library ftLibrary, const vector<Ref<Font>>& fonts, 
+	const uint32* values, RasterGlyph* rasterGlyphs, uint32 fontSize, uint8 fontIndex, 
+	uint32 itemOffset, uint32 itemCount, uint32 threadIndex)
 {
 	for (const auto& font : fonts)
 	{
@@ -108,26 +131,21 @@ static bool fillFontAtlas(const LinearPool<Font>& fontPool, FT_Library ftLibrary
 		}
 	}
 
-	auto invFontSize = 1.0f / fontSize; auto invPixelSize = float2::one / pixelSize;
+	auto invFontSize = 1.0f / fontSize;
 	auto mainFace = (FT_Face)fontPool.get(fonts[0])->faces.at(threadIndex);
-	auto i = glyphs.begin(); pixels += fontIndex;
-
-	for (uint32 j = 0; j < itemOffset; j++)
-		i++; // TODO: solve this somehow, suboptimal!
 
-	for (uint32 index = itemOffset; index < itemCount; index++, i++)
+	for (uint32 i = itemOffset; i < itemCount; i++)
 	{
-		GARDEN_ASSERT_MSG(i != glyphs.end(), "Detected memory corruption");
-		Glyph glyph; glyph.value = i->second.value;
-		auto charIndex = FT_Get_Char_Index(mainFace, (FT_ULong)glyph.value);
+		auto value = values[i];
+		auto charIndex = FT_Get_Char_Index(mainFace, (FT_ULong)value);
 
 		auto charFace = mainFace;
-		if (charIndex == 0 && glyph.value != '\0')
+		if (charIndex == 0 && value != '\0')
 		{
 			for (auto j = fonts.begin() + 1; j != fonts.end(); j++)
 			{
 				auto face = (FT_Face)fontPool.get(*j)->faces.at(threadIndex);
-				charIndex = FT_Get_Char_Index(face, (FT_ULong)glyph.value);
+				charIndex = FT_Get_Char_Index(face, (FT_ULong)value);
 				if (charIndex == 0)
 					continue;
 				charFace = face;
@@ -144,41 +162,30 @@ static bool fillFontAtlas(const LinearPool<Font>& fontPool, FT_Library ftLibrary
 
 		const auto glyphSlot = charFace->glyph; auto baseWidth = glyphSlot->bitmap.width;
 		auto glyphWidth = min(baseWidth, fontSize), glyphHeight = min(glyphSlot->bitmap.rows, fontSize);
-		glyph.advance = ((float)glyphSlot->advance.x * (1.0f / 64.0f)) * invFontSize;
+
+		auto& rasterGlyph = rasterGlyphs[i];
+		rasterGlyph.advance = ((float)glyphSlot->advance.x * (1.0f / 64.0f)) * invFontSize;
+		rasterGlyph.left = glyphSlot->bitmap_left; rasterGlyph.top = glyphSlot->bitmap_top;
 
 		if (glyphWidth * glyphHeight == 0)
-		{
-			glyph.value = Glyph::invisible;
-		}
-		else
-		{
-			auto glyphPosY = index / glyphLength, glyphPosX = (uint32)(index - (psize)glyphPosY * glyphLength);
-			auto pixelPosX = glyphPosX * fontSize, pixelPosY = glyphPosY * fontSize;
-			glyph.position.x = (float)glyphSlot->bitmap_left * invFontSize;
-			glyph.position.y = ((float)glyphSlot->bitmap_top - glyphHeight) * invFontSize;
-			glyph.position.z = glyph.position.x + ((float)glyphWidth * invFontSize);
-			glyph.position.w = glyph.position.y + ((float)glyphHeight * invFontSize);
-			glyph.texCoords.x = (float)pixelPosX * invPixelSize.x;
-			glyph.texCoords.y = (float)pixelPosY * invPixelSize.y;
-			glyph.texCoords.z = glyph.texCoords.x + ((float)glyphWidth * invPixelSize.x);
-			glyph.texCoords.w = glyph.texCoords.y + ((float)glyphHeight * invPixelSize.y);
-
-			const auto bitmap = glyphSlot->bitmap.buffer;
-			for (uint32 y = 0; y < glyphHeight; y++)
-			{
-				for (uint32 x = 0; x < glyphWidth; x++)
-					pixels[((y + pixelPosY) * pixelSize.x + x + pixelPosX) * 4] = bitmap[x + y * baseWidth];
-			}
-		}
+			continue;
 
-		i.value() = glyph;
+		rasterGlyph.size = uint2(glyphWidth, glyphHeight);
+		rasterGlyph.pixels.resize((psize)glyphWidth * glyphHeight);
+		auto pixels = rasterGlyph.pixels.data(); const auto bitmap = glyphSlot->bitmap.buffer;
+
+		for (uint32 y = 0; y < glyphHeight; y++)
+			memcpy(pixels + y * glyphWidth, bitmap + y * baseWidth, glyphWidth);
 	}
 
 	return true;
 }
-static bool fillFontAtlas(const LinearPool<Font>& fontPool, FT_Library ftLibrary, const FontArray& fonts, 
-	vector<FontAtlas::GlyphMap>& glyphs, uint8* pixels, uint32 fontSize, uint32 glyphLength, uint2 pixelSize)
+static bool rasterizeGlyphs(const LinearPool<Font>& fontPool, FT_Library ftLibrary, 
+	const FontArray& fonts, const vector<uint32>& values, vector<RasterGlyph>& rasterGlyphs, uint32 fontSize)
 {
+	auto glyphCount = (uint32)values.size();
+	rasterGlyphs.clear(); rasterGlyphs.resize((psize)glyphCount * 4);
+
 	auto threadSystem = ThreadSystem::Instance::tryGet();
 	if (threadSystem)
 	{
@@ -187,28 +194,28 @@ static bool fillFontAtlas(const LinearPool<Font>& fontPool, FT_Library ftLibrary
 
 		for (uint8 i = 0; i < 4; i++)
 		{
-			const auto& fontArray = fonts[i]; auto& glyphMap = glyphs[i];
-			threadPool.addItems([&fontPool, ftLibrary, &fontArray, &glyphMap, pixels, fontSize, 
-				glyphLength, pixelSize, i, &result](const ThreadPool::Task& task)
+			const auto& fontArray = fonts[i];
+			auto glyphData = rasterGlyphs.data() + (psize)glyphCount * i;
+			threadPool.addItems([&fontPool, ftLibrary, &fontArray, &values, 
+				glyphData, fontSize, i, &result](const ThreadPool::Task& task)
 			{
-				if (fillFontAtlas(fontPool, ftLibrary, fontArray, glyphMap, pixels, fontSize, glyphLength, 
-					pixelSize, i, task.getItemOffset(), task.getItemCount(), task.getThreadIndex()))
+				if (rasterizeGlyphs(fontPool, ftLibrary, fontArray, values.data(), glyphData, fontSize, 
+					i, task.getItemOffset(), task.getItemCount(), task.getThreadIndex()))
 				{
 					result += task.getItemCount() - task.getItemOffset();
 				}
 			},
-			(uint32)glyphMap.size());
+			glyphCount);
 		}
 
 		threadPool.wait();
-		return result == glyphs[0].size() * 4;
+		return result == (int64)glyphCount * 4;
 	}
 
-	auto glyphCount = (uint32)glyphs[0].size();
 	for (uint8 i = 0; i < 4; i++)
 	{
-		if (!fillFontAtlas(fontPool, ftLibrary, fonts[i], glyphs[i], pixels, 
-			fontSize, glyphLength, pixelSize, i, 0, glyphCount, 0))
+		if (!rasterizeGlyphs(fontPool, ftLibrary, fonts[i], values.data(), 
+			rasterGlyphs.data() + (psize)glyphCount * i, fontSize, i, 0, glyphCount, 0))
 		{
 			return false;
 		}
@@ -216,8 +223,137 @@ static bool fillFontAtlas(const LinearPool<Font>& fontPool, FT_Library ftLibrary
 	return true;
 }
 
+static uint64 prepareSlots(const vector<RasterGlyph>& rasterGlyphs, 
+	uint32 glyphCount, vector<uint2>& slotSizes, vector<uint32>& packOrder)
+{
+	slotSizes.assign(glyphCount, uint2::zero);
+	packOrder.clear(); packOrder.reserve(glyphCount);
+	uint64 packArea = 0;
+
+	for (uint32 i = 0; i < glyphCount; i++)
+	{
+		auto size = uint2::zero;
+		for (uint8 j = 0; j < 4; j++)
+		{
+			auto glyphSize = rasterGlyphs[(psize)glyphCount * j + i].size;
+			size = uint2(std::max(size.x, glyphSize.x), std::max(size.y, glyphSize.y));
+		}
+		if (size.x * size.y == 0)
+			continue; // Note: invisible glyph, no need to store it in the atlas.
+
+		size = uint2(size.x + FontAtlas::glyphPadding * 2, size.y + FontAtlas::glyphPadding * 2);
+		slotSizes[i] = size;
+		packOrder.push_back(i);
+		packArea += (uint64)size.x * size.y;
+	}
+
+	std::sort(packOrder.begin(), packOrder.end(), [&slotSizes](uint32 a, uint32 b)
+	{
+		return slotSizes[a].y > slotSizes[b].y;
+	});
+	return packArea;
+}
+
 //**********************************************************************************************************************
-bool FontAtlas::update(u32string_view chars, uint32 fontSize, Image::Usage imageUsage, bool shrink)
+bool FontAtlas::packGlyph(uint2 size, uint2& position)
+{
+	auto bestIndex = SIZE_MAX; auto bestArea = UINT64_MAX;
+	for (psize i = 0; i < freeRects.size(); i++)
+	{
+		const auto& rect = freeRects[i];
+		if (size.x > rect.size.x || size.y > rect.size.y)
+			continue;
+		auto area = (uint64)rect.size.x * rect.size.y;
+		if (area < bestArea)
+		{
+			bestIndex = i; bestArea = area;
+		}
+	}
+
+	if (bestIndex != SIZE_MAX)
+	{
+		auto rect = freeRects[bestIndex];
+		freeRects[bestIndex] = freeRects.back();
+		freeRects.pop_back();
+
+		if (rect.size.x > size.x)
+		{
+			freeRects.push_back({ uint2(rect.position.x + size.x, rect.position.y), 
+				uint2(rect.size.x - size.x, size.y) });
+		}
+		if (rect.size.y > size.y)
+		{
+			freeRects.push_back({ uint2(rect.position.x, rect.position.y + size.y), 
+				uint2(rect.size.x, rect.size.y - size.y) });
+		}
+
+		position = rect.position;
+		return true;
+	}
+
+	Shelf* bestShelf = nullptr;
+	for (auto& shelf : shelves)
+	{
+		if (size.y > shelf.height || shelf.width + size.x > pixelSize.x)
+			continue;
+		if (!bestShelf || shelf.height < bestShelf->height)
+			bestShelf = &shelf;
+	}
+
+	if (bestShelf)
+	{
+		position = uint2(bestShelf->width, bestShelf->posY);
+		bestShelf->width += size.x;
+		return true;
+	}
+
+	auto posY = shelves.empty() ? 0u : shelves.back().posY + shelves.back().height;
+	if (size.x > pixelSize.x || posY + size.y > pixelSize.y)
+		return false;
+
+	Shelf shelf;
+	shelf.posY = posY;
+	shelf.height = size.y;
+	shelf.width = size.x;
+	shelves.push_back(shelf);
+
+	position = uint2(0, posY);
+	return true;
+}
+bool FontAtlas::evictGlyphs(uint2 size, uint64 useIndex, uint2& position)
+{
+	vector<pair<uint64, uint32>> candidates;
+	for (const auto& pair : slots)
+	{
+		if (pair.second.lastUse != useIndex && pair.first != '\0')
+			candidates.emplace_back(pair.second.lastUse, pair.first);
+	}
+	std::sort(candidates.begin(), candidates.end());
+
+	for (const auto& candidate : candidates)
+	{
+		auto searchResult = slots.find(candidate.second);
+		freeRects.push_back(searchResult->second.rect);
+		slots.erase(searchResult);
+
+		for (auto& glyphMap : glyphs)
+			glyphMap.erase(candidate.second);
+
+		if (packGlyph(size, position))
+			return true;
+	}
+	return false;
+}
+void FontAtlas::resetLayout(uint2 pixelSize)
+{
+	glyphs.clear(); glyphs.resize(4);
+	slots.clear(); shelves.clear(); freeRects.clear();
+	this->pixelSize = pixelSize;
+}
+
+//**********************************************************************************************************************
+bool FontAtlas::updateAtlas(u32string_view chars, uint32 fontSize, 
+	Image::Usage imageUsage, bool shrink, bool canRelayout)
 {
 	GARDEN_ASSERT(!chars.empty());
 	GARDEN_ASSERT(fontSize > 0);
@@ -225,6 +361,7 @@ bool FontAtlas::update(u32string_view chars, uint32 fontSize, Image::Usage image
 	SET_CPU_ZONE_SCOPED("Font Atlas Update");
 
 	auto textSystem = TextSystem::Instance::get();
+	auto graphicsSystem = GraphicsSystem::Instance::get();
 	auto defaultFace = (FT_Face)textSystem->fonts.get(fonts[0][0])->faces[0];
 
 	auto result = FT_Set_Pixel_Sizes(defaultFace, 0, (FT_UInt)fontSize);
@@ -236,66 +373,212 @@ bool FontAtlas::update(u32string_view chars, uint32 fontSize, Image::Usage image
 	}
 	auto newLineAdvance = ((float)defaultFace->size->metrics.height * (1.0f / 64.0f)) / fontSize;
 
-	vector<GlyphMap> glyphs(4); prepareGlyphs(chars, glyphs[0]);
-	if (glyphs[0].empty())
-	{
-		GARDEN_LOG_DEBUG("Failed to create font atlas, no visible glyphs.");
-		return false;
-	}
-	
-	constexpr auto imageFormat = Image::Format::UnormR8G8B8A8;
-	auto graphicsSystem = GraphicsSystem::Instance::get();
-	auto glyphLength = calcGlyphLength(glyphs[0].size());
-	auto newPixelSize = uint2(glyphLength * fontSize, (uint32)
-		ceil((double)glyphs[0].size() / glyphLength) * fontSize); 
 	auto currPixelSize = uint2::zero;
-
-	if (image && !shrink)
+	if (image)
 	{
 		auto imageView = graphicsSystem->get(image);
 		if (imageView->isReady()) // Note: it may be async transfering right now.
 			currPixelSize = (uint2)imageView->getSize();
 	}
 
-	if (areAnyTrue(newPixelSize > currPixelSize) && !Image::isSupported(
-		Image::Type::Texture2D, imageFormat, imageUsage, uint3(newPixelSize, 1)))
-	{
-		GARDEN_LOG_DEBUG("Failed to create font atlas, resulting image is not supported.");
+	auto isRebuild = shrink || currPixelSize == uint2::zero || this->fontSize != fontSize || glyphs.size() != 4;
+	if (isRebuild && !canRelayout)
 		return false;
-	}
-	
-	auto pixelSize = max(currPixelSize, newPixelSize);
-	auto binarySize = (uint64)pixelSize.x * newPixelSize.y * 4;
-	auto stagingBuffer = graphicsSystem->createStagingBuffer(Buffer::CpuAccess::RandomReadWrite, binarySize);
-	SET_RESOURCE_DEBUG_NAME(stagingBuffer, "buffer.staging.fontAtlas" + to_string(*stagingBuffer));
 
-	auto stagingView = graphicsSystem->get(stagingBuffer);
-	auto pixels = (uint8*)stagingView->getMap(); memset(pixels, 0, binarySize);
-	glyphs[1] = glyphs[0]; glyphs[2] = glyphs[0]; glyphs[3] = glyphs[0];
+	vector<uint32> values; prepareGlyphs(chars, values);
+	auto useIndex = ++useCounter; auto isPartial = false;
 
-	if (!fillFontAtlas(textSystem->fonts, (FT_Library)textSystem->ftLibrary, 
-		fonts, glyphs, pixels, fontSize, glyphLength, pixelSize))
+	if (!isRebuild)
 	{
-		graphicsSystem->destroy(stagingBuffer);
+		psize missingCount = 0;
+		for (auto value : values)
+		{
+			auto searchResult = slots.find(value);
+			if (searchResult != slots.end())
+				searchResult.value().lastUse = useIndex;
+			else if (glyphs[0].find(value) == glyphs[0].end())
+				values[missingCount++] = value;
+		}
+
+		if (missingCount == 0)
+		{
+			this->newLineAdvance = newLineAdvance;
+			return true;
+		}
+		values.resize(missingCount);
+		isPartial = true;
+	}
+
+	auto ftLibrary = (FT_Library)textSystem->ftLibrary;
+	vector<RasterGlyph> rasterGlyphs;
+	if (!rasterizeGlyphs(textSystem->fonts, ftLibrary, fonts, values, rasterGlyphs, fontSize))
 		return false;
+
+	vector<uint2> slotSizes, slotPositions; vector<uint32> packOrder;
+	auto packArea = prepareSlots(rasterGlyphs, (uint32)values.size(), slotSizes, packOrder);
+	slotPositions.resize(values.size());
+
+	if (!isRebuild)
+	{
+		auto prevShelves = shelves; auto prevFreeRects = freeRects;
+		for (auto i : packOrder)
+		{
+			if (packGlyph(slotSizes[i], slotPositions[i]))
+				continue;
+			if (canRelayout && evictGlyphs(slotSizes[i], useIndex, slotPositions[i]))
+				continue;
+
+			if (!canRelayout)
+			{
+				shelves = std::move(prevShelves); freeRects = std::move(prevFreeRects);
+				return false;
+			}
+			isRebuild = true;
+			break;
+		}
+	}
+
+	constexpr auto imageFormat = Image::Format::UnormR8G8B8A8;
+	if (isRebuild)
+	{
+		if (isPartial) // Note: atlas is out of space, repacking all text glyphs.
+		{
+			values.clear(); prepareGlyphs(chars, values);
+			if (!rasterizeGlyphs(textSystem->fonts, ftLibrary, fonts, values, rasterGlyphs, fontSize))
+				return false;
+			packArea = prepareSlots(rasterGlyphs, (uint32)values.size(), slotSizes, packOrder);
+			slotPositions.resize(values.size());
+		}
+
+		auto minLength = fontSize + glyphPadding * 2;
+		auto length = calcAtlasLength(std::max((uint64)ceil(sqrt((double)packArea)), (uint64)minLength));
+		auto newPixelSize = uint2(length, calcAtlasLength(std::max(packArea / length, (uint64)minLength)));
+		if (!shrink)
+		{
+			newPixelSize = uint2(std::max(newPixelSize.x, currPixelSize.x), 
+				std::max(newPixelSize.y, currPixelSize.y));
+		}
+
+		while (true)
+		{
+			if (areAnyTrue(newPixelSize > currPixelSize) && !Image::isSupported(
+				Image::Type::Texture2D, imageFormat, imageUsage, uint3(newPixelSize, 1)))
+			{
+				GARDEN_LOG_DEBUG("Failed to create font atlas, resulting image is not supported.");
+				return false;
+			}
+
+			resetLayout(newPixelSize);
+			auto isPacked = true;
+			for (auto i : packOrder)
+			{
+				if (packGlyph(slotSizes[i], slotPositions[i]))
+					continue;
+				isPacked = false;
+				break;
+			}
+
+			if (isPacked)
+				break;
+			if (newPixelSize.y < newPixelSize.x)
+				newPixelSize.y <<= 1u;
+			else
+				newPixelSize.x <<= 1u;
+		}
 	}
-	stagingView->flush();
 
-	if (areAnyTrue(newPixelSize > currPixelSize))
+	auto glyphCount = (uint32)values.size();
+	uint64 binarySize = 0;
+	for (auto i : packOrder)
+		binarySize += (uint64)slotSizes[i].x * slotSizes[i].y * 4;
+
+	if (isRebuild && currPixelSize != pixelSize)
 	{
 		graphicsSystem->destroy(image);
 		image = graphicsSystem->createImage(imageFormat, imageUsage, 
-			{ { nullptr } }, newPixelSize, Image::Strategy::Size);
+			{ { nullptr } }, pixelSize, Image::Strategy::Size);
 		SET_RESOURCE_DEBUG_NAME(image, "image.fontAtlas" + to_string(*image));
-		pixelSize = newPixelSize; // Note: needed for Y size difference!
 	}
 
-	Image::CopyBufferRegion copyRegion;
-	copyRegion.imageExtent = uint3(pixelSize.x, newPixelSize.y, 1);
-	Image::copy(stagingBuffer, image, copyRegion);
-	graphicsSystem->destroy(stagingBuffer);
+	if (binarySize > 0)
+	{
+		auto stagingBuffer = graphicsSystem->createStagingBuffer(Buffer::CpuAccess::RandomReadWrite, binarySize);
+		SET_RESOURCE_DEBUG_NAME(stagingBuffer, "buffer.staging.fontAtlas" + to_string(*stagingBuffer));
+
+		auto stagingView = graphicsSystem->get(stagingBuffer);
+		auto stagingMap = (uint8*)stagingView->getMap(); memset(stagingMap, 0, binarySize);
+		vector<Image::CopyBufferRegion> copyRegions(packOrder.size());
+		uint64 bufferOffset = 0;
+
+		for (psize i = 0; i < packOrder.size(); i++)
+		{
+			auto index = packOrder[i]; auto slotSize = slotSizes[index];
+			auto pixels = stagingMap + bufferOffset;
+
+			for (uint8 j = 0; j < 4; j++)
+			{
+				const auto& rasterGlyph = rasterGlyphs[(psize)glyphCount * j + index];
+				auto glyphPixels = rasterGlyph.pixels.data();
+				for (uint32 y = 0; y < rasterGlyph.size.y; y++)
+				{
+					auto line = pixels + ((psize)(y + glyphPadding) * slotSize.x + glyphPadding) * 4 + j;
+					for (uint32 x = 0; x < rasterGlyph.size.x; x++)
+						line[x * 4] = glyphPixels[x + y * rasterGlyph.size.x];
+				}
+			}
+
+			auto& copyRegion = copyRegions[i];
+			copyRegion.bufferOffset = bufferOffset;
+			copyRegion.imageOffset = uint3(slotPositions[index], 0);
+			copyRegion.imageExtent = uint3(slotSize, 1);
+			bufferOffset += (uint64)slotSize.x * slotSize.y * 4;
+		}
+
+		stagingView->flush();
+		Image::copy(stagingBuffer, image, copyRegions);
+		graphicsSystem->destroy(stagingBuffer);
+	}
+
+	auto invFontSize = 1.0f / fontSize; auto invPixelSize = float2::one / pixelSize;
+	for (uint32 i = 0; i < glyphCount; i++)
+	{
+		auto value = values[i]; auto slotSize = slotSizes[i];
+		auto glyphPosition = uint2(slotPositions[i].x + glyphPadding, slotPositions[i].y + glyphPadding);
+
+		for (uint8 j = 0; j < 4; j++)
+		{
+			const auto& rasterGlyph = rasterGlyphs[(psize)glyphCount * j + i];
+			Glyph glyph; glyph.value = value; glyph.advance = rasterGlyph.advance;
+
+			if (rasterGlyph.size.x * rasterGlyph.size.y == 0)
+			{
+				glyph.value = Glyph::invisible;
+			}
+			else
+			{
+				auto glyphWidth = (float)rasterGlyph.size.x, glyphHeight = (float)rasterGlyph.size.y;
+				glyph.position.x = (float)rasterGlyph.left * invFontSize;
+				glyph.position.y = ((float)rasterGlyph.top - glyphHeight) * invFontSize;
+				glyph.position.z = glyph.position.x + glyphWidth * invFontSize;
+				glyph.position.w = glyph.position.y + glyphHeight * invFontSize;
+				glyph.texCoords.x = (float)glyphPosition.x * invPixelSize.x;
+				glyph.texCoords.y = (float)glyphPosition.y * invPixelSize.y;
+				glyph.texCoords.z = glyph.texCoords.x + glyphWidth * invPixelSize.x;
+				glyph.texCoords.w = glyph.texCoords.y + glyphHeight * invPixelSize.y;
+			}
+			glyphs[j][value] = glyph;
+		}
+
+		if (slotSize.x * slotSize.y == 0)
+			continue;
+
+		Slot slot;
+		slot.rect.position = slotPositions[i];
+		slot.rect.size = slotSize;
+		slot.lastUse = useIndex;
+		slots[value] = slot;
+	}
 
-	this->glyphs = std::move(glyphs);
 	this->fontSize = fontSize;
 	this->newLineAdvance = newLineAdvance;
 	return true;
@@ -534,6 +817,26 @@ static bool fillTextInstances(u32string_view value, Text::Properties properties,
 }
 
 //**********************************************************************************************************************
+static bool isSameFonts(const FontArray& a, const FontArray& b) noexcept
+{
+	if (a.size() != b.size())
+		return false;
+
+	for (psize i = 0; i < a.size(); i++)
+	{
+		const auto& variantsA = a[i]; const auto& variantsB = b[i];
+		if (variantsA.size() != variantsB.size())
+			return false;
+
+		for (psize j = 0; j < variantsA.size(); j++)
+		{
+			if (ID<Font>(variantsA[j]) != ID<Font>(variantsB[j]))
+				return false;
+		}
+	}
+	return true;
+}
+
 bool Text::isReady() const noexcept
 {
 	auto graphicsSystem = GraphicsSystem::Instance::get();
@@ -559,19 +862,36 @@ bool Text::update(u32string_view value, uint32 fontSize, Properties properties,
 	auto textSystem = TextSystem::Instance::get();
 
 	ID<FontAtlas> newFontAtlas = {}; OptView<FontAtlas> fontAtlasView = {};
-	if (atlasShared || shrink || !fontAtlas)
+	auto isAppended = false;
+
+	if (atlasShared && !shrink && fontAtlas)
 	{
-		auto fontArray = fonts;
-		newFontAtlas = textSystem->createFontAtlas(value, std::move(fontArray), fontSize, atlasUsage);
-		if (!newFontAtlas)
-			return false;
-		fontAtlasView = OptView<FontAtlas>(textSystem->get(newFontAtlas));
+		// Note: shared atlas glyphs can't be moved or evicted, other texts are using them.
+		auto sharedAtlasView = textSystem->get(fontAtlas);
+		if (sharedAtlasView->getFontSize() == fontSize && isSameFonts(sharedAtlasView->getFonts(), fonts) && 
+			sharedAtlasView->append(value))
+		{
+			fontAtlasView = OptView<FontAtlas>(sharedAtlasView);
+			isAppended = true;
+		}
 	}
-	else
+
+	if (!isAppended)
 	{
-		fontAtlasView = OptView<FontAtlas>(textSystem->get(fontAtlas));
-		if (!fontAtlasView->update(value, fontSize, atlasUsage, shrink))
-			return false;
+		if (atlasShared || shrink || !fontAtlas)
+		{
+			auto fontArray = fonts;
+			newFontAtlas = textSystem->createFontAtlas(value, std::move(fontArray), fontSize, atlasUsage);
+			if (!newFontAtlas)
+				return false;
+			fontAtlasView = OptView<FontAtlas>(textSystem->get(newFontAtlas));
+		}
+		else
+		{
+			fontAtlasView = OptView<FontAtlas>(textSystem->get(fontAtlas));
+			if (!fontAtlasView->update(value, fontSize, atlasUsage, shrink))
+				return false;
+		}
 	}
 
 	auto graphicsSystem = GraphicsSystem::Instance::get();
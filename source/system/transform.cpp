@@ -14,8 +14,11 @@
 
 #include "garden/system/transform.hpp"
 #include "garden/system/ui/transform.hpp"
+#include "garden/system/thread.hpp"
 #include "garden/system/log.hpp"
+#include "garden/binary-scene.hpp"
 #include "garden/base64.hpp"
+#include "garden/profiler.hpp"
 
 #if GARDEN_EDITOR
 #include "garden/editor/system/transform.hpp"
@@ -25,6 +28,7 @@ using namespace ecsm;
 using namespace garden;
 
 static thread_local vector<ID<Entity>> entityStack;
+static thread_local vector<TransformComponent*> transformQueue;
 
 //**********************************************************************************************************************
 bool TransformComponent::destroy()
@@ -64,6 +68,7 @@ REMOVED_FROM_PARENT:
 			auto childTransformView = manager->get<TransformComponent>(childs[i]);
 			childTransformView->parent = {};
 			childTransformView->ancestorsActive = true;
+			childTransformView->markModelDirty();
 		}
 
 		free(childs); // Warning: assuming that ID<> has no damageable constructor!
@@ -126,6 +131,54 @@ void TransformComponent::setActive(bool isActive) noexcept
 	}
 }
 
+//**********************************************************************************************************************
+void TransformComponent::markDescendantsDirty() noexcept
+{
+	auto manager = Manager::Instance::get();
+	auto thisChildCount = childCount();
+	for (uint32 i = 0; i < thisChildCount; i++)
+		manager->get<TransformComponent>(childs[i])->markModelDirty(); // Note: Stops at already dirty subtrees.
+}
+bool TransformComponent::isParentDirty() const noexcept
+{
+	return Manager::Instance::get()->get<TransformComponent>(parent)->modelDirty;
+}
+f32x4x4 TransformComponent::calcWorldModel() const noexcept
+{
+	if (!modelDirty)
+		return f32x4x4(worldModel, f32x4(0.0f, 0.0f, 0.0f, 1.0f));
+
+	// Note: Dirty entity descendants are always dirty, so dirty ancestors form a continuous chain.
+	auto manager = Manager::Instance::get();
+	const TransformComponent* topDirtyView = this;
+	while (topDirtyView->parent)
+	{
+		auto parentView = manager->get<TransformComponent>(topDirtyView->parent);
+		if (!parentView->modelDirty)
+			break;
+		topDirtyView = *parentView;
+	}
+
+	// Note: Topmost dirty entity ancestors are clean, so their cached matrices are up to date.
+	auto model = math::calcModel(posChildCount, rotation, scaleChildCap);
+	auto transformView = this;
+
+	while (transformView != topDirtyView)
+	{
+		transformView = *manager->get<TransformComponent>(transformView->parent);
+		auto parentModel = math::calcModel(transformView->posChildCount,
+			transformView->rotation, transformView->scaleChildCap);
+		model = parentModel * model;
+	}
+
+	if (topDirtyView->parent)
+	{
+		auto parentView = manager->get<TransformComponent>(topDirtyView->parent);
+		model = f32x4x4(parentView->worldModel, f32x4(0.0f, 0.0f, 0.0f, 1.0f)) * model;
+	}
+	return model;
+}
+
 //**********************************************************************************************************************
 void TransformComponent::setParent(ID<Entity> parent)
 {
@@ -192,6 +245,7 @@ REMOVED_FROM_PARENT:
 	}
 
 	this->parent = parent;
+	markModelDirty();
 }
 
 //**********************************************************************************************************************
@@ -224,6 +278,7 @@ bool TransformComponent::tryAddChild(ID<Entity> child)
 	childs[childCount()++] = entity;
 	childTransformView->parent = entity;
 	childTransformView->ancestorsActive = selfActive && ancestorsActive;
+	childTransformView->markModelDirty();
 	return true;
 }
 
@@ -257,6 +312,7 @@ bool TransformComponent::tryRemoveChild(uint32 index) noexcept
 	auto childTransformView = Manager::Instance::get()->get<TransformComponent>(child);
 	childTransformView->parent = {};
 	childTransformView->ancestorsActive = true;
+	childTransformView->markModelDirty();
 
 	childCount()--;
 	return true;
@@ -289,6 +345,7 @@ void TransformComponent::removeAllChilds() noexcept
 		auto childTransformView = manager->get<TransformComponent>(childs[i]);
 		childTransformView->parent = {};
 		childTransformView->ancestorsActive = true;
+		childTransformView->markModelDirty();
 	}
 
 	childCount() = 0;
@@ -409,6 +466,15 @@ TransformSystem::TransformSystem(bool setSingleton) : Singleton(setSingleton)
 	auto manager = Manager::Instance::get();
 	manager->addGroupSystem<ISerializable>(this);
 	manager->addGroupSystem<IAnimatable>(this);
+	ECSM_SUBSCRIBE_TO_EVENT("PreInit", TransformSystem::preInit);
+}
+
+void TransformSystem::preInit()
+{
+	// Note: Subscribing before render systems, so that matrices are updated before the frame rendering.
+	auto manager = Manager::Instance::get();
+	if (manager->hasEvent("Render"))
+		ECSM_SUBSCRIBE_TO_EVENT("Render", TransformSystem::updateModels);
 }
 
 //**********************************************************************************************************************
@@ -449,6 +515,7 @@ void TransformSystem::copyComponent(View<Component> source, View<Component> dest
 	#endif
 	destinationView->uid = 0;
 	destinationView->selfActive = sourceView->selfActive;
+	destinationView->modelDirty = true;
 }
 string_view TransformSystem::getComponentName() const
 {
@@ -560,6 +627,42 @@ void TransformSystem::deserialize(IDeserializer& deserializer, View<Component> c
 	deserializer.read("debugName", componentView->debugName);
 	#endif
 }
+void TransformSystem::deserializeRecord(const BinarySceneRecord& record, View<Component> component)
+{
+	// Note: Called concurrently for different components, parents inside the scene are set by the scene loader.
+	const auto& transformRecord = (const BinaryTransformRecord&)record;
+	auto componentView = View<TransformComponent>(component);
+	componentView->uid = transformRecord.uid;
+	componentView->setPosition(transformRecord.position);
+	componentView->setRotation(BinaryScene::toQuat(transformRecord.rotation));
+	componentView->setScale(transformRecord.scale);
+	componentView->selfActive = transformRecord.isActive;
+
+	#if GARDEN_DEBUG || GARDEN_EDITOR
+	if (transformRecord.debugNameLength > 0)
+		componentView->debugName = transformRecord.getDebugName();
+	#endif
+
+	if (!transformRecord.uid && !transformRecord.parentUID)
+		return;
+
+	// Note: Registering UIDs the same way as the JSON scene, not found parents are resolved by postDeserialize().
+	auto isRegistered = true;
+	deserializeLocker.lock();
+	if (transformRecord.uid)
+		isRegistered = deserializedEntities.emplace(transformRecord.uid, componentView->entity).second;
+	if (transformRecord.parentUID)
+		deserializedParents.emplace_back(make_pair(componentView->entity, transformRecord.parentUID));
+	deserializeLocker.unlock();
+
+	if (!isRegistered)
+	{
+		string uidString;
+		encodeBase64URL(uidString, &transformRecord.uid, sizeof(uint64));
+		uidString.resize(uidString.length() - 1);
+		GARDEN_LOG_ERROR("Deserialized entity with already existing UID. (uid: " + uidString + ")");
+	}
+}
 void TransformSystem::postDeserialize(IDeserializer& deserializer)
 {
 	auto manager = Manager::Instance::get();
@@ -617,11 +720,40 @@ void TransformSystem::animateAsync(View<Component> component, View<AnimationFram
 	if (frameA->animateScale)
 		componentView->setScale(lerp(frameA->scale, frameB->scale, t));
 	if (frameA->animateRotation)
-		componentView->rotation = slerp(frameA->rotation, frameB->rotation, t);
+		componentView->setRotation(slerp(frameA->rotation, frameB->rotation, t));
 	if (frameA->animateIsActive)
 		componentView->setActive((bool)round(t) ? frameB->isActive : frameA->isActive);
 }
 
+uint8 TransformSystem::getBakedProps(AnimationInterp* interps)
+{
+	interps[0] = AnimationInterp::Lerp; interps[1] = AnimationInterp::Lerp;
+	interps[2] = AnimationInterp::Slerp; interps[3] = AnimationInterp::Step;
+	return 4;
+}
+uint32 TransformSystem::bakeAnimation(View<AnimationFrame> frame, f32x4* values)
+{
+	const auto frameView = View<TransformFrame>(frame);
+	values[0] = frameView->position;
+	values[1] = frameView->scale;
+	values[2] = (f32x4)frameView->rotation;
+	values[3] = f32x4(frameView->isActive ? 1.0f : 0.0f);
+	return (uint32)frameView->animatePosition | (uint32)frameView->animateScale << 1u | 
+		(uint32)frameView->animateRotation << 2u | (uint32)frameView->animateIsActive << 3u;
+}
+void TransformSystem::animateBaked(View<Component> component, const f32x4* values, uint32 mask)
+{
+	auto componentView = View<TransformComponent>(component);
+	if (mask & 0x1u)
+		componentView->setPosition(values[0]);
+	if (mask & 0x2u)
+		componentView->setScale(values[1]);
+	if (mask & 0x4u)
+		componentView->setRotation(quat(values[2]));
+	if (mask & 0x8u)
+		componentView->setActive(values[3].getX() != 0.0f);
+}
+
 //**********************************************************************************************************************
 void TransformSystem::destroyRecursive(ID<Entity>& entity)
 {
@@ -712,6 +844,185 @@ ID<Entity> TransformSystem::duplicateRecursive(ID<Entity> entity)
 
 	return entityDuplicate;
 }
+void TransformSystem::duplicateRecursive(ID<Entity> entity, uint32 count, vector<ID<Entity>>& duplicates)
+{
+	GARDEN_ASSERT(entity);
+	GARDEN_ASSERT(count > 0);
+
+	auto manager = Manager::Instance::get();
+	GARDEN_ASSERT(!manager->has<DoNotDuplicateComponent>(entity));
+	duplicates.reserve(duplicates.size() + count);
+
+	auto entityTransformView = manager->tryGet<TransformComponent>(entity);
+	if (!entityTransformView)
+	{
+		for (uint32 i = 0; i < count; i++)
+			duplicates.push_back(manager->duplicate(entity));
+		return;
+	}
+
+	// Note: Breadth-first, parents are always placed before their childs in the template.
+	duplicateTemplate.emplace_back(entity, UINT32_MAX);
+	for (psize i = 0; i < duplicateTemplate.size(); i++)
+	{
+		auto templateEntity = duplicateTemplate[i].first;
+		if (i > 0 && manager->has<DoNotDuplicateComponent>(templateEntity))
+			continue;
+
+		auto transformView = manager->get<TransformComponent>(templateEntity);
+		for (auto child : **transformView)
+			duplicateTemplate.emplace_back(child, (uint32)i);
+	}
+
+	auto entityParent = entityTransformView->getParent();
+	auto templateSize = duplicateTemplate.size();
+	templateDuplicates.resize(templateSize);
+
+	for (uint32 i = 0; i < count; i++)
+	{
+		for (psize j = 0; j < templateSize; j++)
+		{
+			auto pair = duplicateTemplate[j];
+			auto duplicate = manager->duplicate(pair.first);
+			auto duplicateTransformView = manager->get<TransformComponent>(duplicate);
+			duplicateTransformView->setParent(pair.second == UINT32_MAX ? 
+				entityParent : templateDuplicates[pair.second]);
+			templateDuplicates[j] = duplicate;
+		}
+		duplicates.push_back(templateDuplicates[0]);
+	}
+
+	duplicateTemplate.clear();
+}
+
+//**********************************************************************************************************************
+bool TransformSystem::updateDirtySubtree(Manager* manager, 
+	TransformComponent* rootView, uint32 modelStamp, bool checkStatic)
+{
+	auto& queue = transformQueue;
+	auto isStaticMoved = false;
+	queue.push_back(rootView);
+	for (psize i = 0; i < queue.size(); i++) // Note: Breadth-first, parents are updated before children.
+	{
+		auto transformView = queue[i];
+		auto model = calcModel(transformView->getPosition(), transformView->getRotation(), transformView->getScale());
+
+		auto parent = transformView->getParent();
+		if (parent)
+		{
+			auto parentView = manager->get<TransformComponent>(parent);
+			model = f32x4x4(parentView->worldModel, f32x4(0.0f, 0.0f, 0.0f, 1.0f)) * model;
+		}
+
+		transformView->worldModel = (float4x3)model;
+		transformView->modelStamp = modelStamp;
+		transformView->modelDirty = false;
+
+		if (checkStatic && !isStaticMoved)
+			isStaticMoved = manager->has<StaticTransformComponent>(transformView->getEntity());
+
+		auto childCount = transformView->getChildCount();
+		auto childs = transformView->getChilds();
+		for (uint32 j = 0; j < childCount; j++)
+			queue.push_back(*manager->get<TransformComponent>(childs[j]));
+	}
+	queue.clear();
+	return isStaticMoved;
+}
+
+void TransformSystem::updateModels()
+{
+	SET_CPU_ZONE_SCOPED("Transform Models Update");
+
+	if (components.getCount() == 0)
+		return;
+
+	auto manager = Manager::Instance::get();
+	auto componentData = components.getData();
+	auto threadSystem = ThreadSystem::Instance::tryGet();
+	auto stamp = ++modelStamp; // Note: Unique per update, so that recreated components are also detected.
+	auto staticSystem = StaticTransformSystem::Instance::tryGet();
+	auto checkStatic = staticSystem && staticSystem->getComponents().getCount() > 0;
+	atomic<bool> isStaticMoved = false;
+	dirtyRoots.clear();
+
+	// Note: Dirty entity with clean ancestors is a root of the dirty subtree, subtrees are not overlapping.
+	//       Each subtree is updated by one task, so that each entity is written only once.
+	if (threadSystem)
+	{
+		auto& threadPool = threadSystem->getForegroundPool();
+		if (threadDirtyRoots.size() < threadPool.getThreadCount())
+			threadDirtyRoots.resize(threadPool.getThreadCount());
+		auto threadDirtyRootData = threadDirtyRoots.data();
+
+		threadPool.addItems([componentData, threadDirtyRootData](const ThreadPool::Task& task)
+		{
+			SET_CPU_ZONE_SCOPED("Dirty Transforms Search");
+
+			auto& roots = threadDirtyRootData[task.getThreadIndex()];
+			auto itemCount = task.getItemCount();
+
+			for (uint32 i = task.getItemOffset(); i < itemCount; i++)
+			{
+				auto transformView = &componentData[i];
+				if (!transformView->getEntity() || !transformView->isModelDirty())
+					continue;
+
+				if (!transformView->hasDirtyAncestor())
+					roots.push_back(transformView);
+			}
+		},
+		components.getOccupancy(), ThreadPool::priorityNormal, {}, ThreadPool::defaultGrainSize);
+		threadPool.wait();
+
+		for (auto& roots : threadDirtyRoots)
+		{
+			dirtyRoots.insert(dirtyRoots.end(), roots.begin(), roots.end());
+			roots.clear();
+		}
+
+		if (dirtyRoots.empty())
+			return;
+
+		auto dirtyRootData = dirtyRoots.data();
+		threadPool.addItems([manager, dirtyRootData, stamp, checkStatic, &isStaticMoved](const ThreadPool::Task& task)
+		{
+			SET_CPU_ZONE_SCOPED("Dirty Transforms Update");
+
+			auto itemCount = task.getItemCount();
+			for (uint32 i = task.getItemOffset(); i < itemCount; i++)
+			{
+				if (updateDirtySubtree(manager, dirtyRootData[i], stamp, checkStatic))
+					isStaticMoved.store(true);
+			}
+		},
+		(uint32)dirtyRoots.size(), ThreadPool::priorityNormal, {}, ThreadPool::defaultGrainSize);
+		threadPool.wait();
+	}
+	else
+	{
+		auto componentOccupancy = components.getOccupancy();
+		for (uint32 i = 0; i < componentOccupancy; i++)
+		{
+			auto transformView = &componentData[i];
+			if (!transformView->getEntity() || !transformView->isModelDirty())
+				continue;
+
+			if (!transformView->hasDirtyAncestor())
+				dirtyRoots.push_back(transformView);
+		}
+
+		for (auto rootView : dirtyRoots)
+		{
+			if (updateDirtySubtree(manager, rootView, stamp, checkStatic))
+				isStaticMoved.store(true);
+		}
+	}
+
+	// Note: Static spatial structures are rebuilt when a static entity or its ancestor is moved.
+	if (isStaticMoved.load())
+		staticSystem->version++;
+}
 
 //**********************************************************************************************************************
 StaticTransformSystem::StaticTransformSystem(bool setSingleton) : Singleton(setSingleton)
@@ -719,6 +1030,17 @@ StaticTransformSystem::StaticTransformSystem(bool setSingleton) : Singleton(setS
 	Manager::Instance::get()->addGroupSystem<ISerializable>(this);
 }
 
+ID<Component> StaticTransformSystem::createComponent(ID<Entity> entity)
+{
+	version++;
+	return ID<Component>(components.create());
+}
+void StaticTransformSystem::destroyComponent(ID<Component> instance)
+{
+	version++;
+	components.destroy(ID<StaticTransformComponent>(instance));
+}
+
 string_view StaticTransformSystem::getComponentName() const
 {
 	return "Static Transform";
@@ -37,12 +37,12 @@ static void setUiButtonAnimation(ID<Entity> element, string_view animationPath,
 	transState += currState; transState.push_back('-'); transState += newState;
 	if (animationView->hasAnimation(transState))
 	{
-		animationView->active = std::move(transState);
+		animationView->setActive(transState);
 	}
 	else
 	{
-		animationView->active = animationPath; animationView->active.push_back('/');
-		animationView->active += newState;
+		auto active = string(animationPath); active.push_back('/'); active += newState;
+		animationView->setActive(active);
 	}
 
 	animationView->frame = 0.0f;
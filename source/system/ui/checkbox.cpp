@@ -36,8 +36,9 @@ static void setUiCheckboxAnimation(ID<Entity> element, string_view animationPath
 	if (!animationView)
 		return;
 
-	animationView->active = animationPath; animationView->active.push_back('/');
-	animationView->active += state ? "set" : "unset";
+	auto active = string(animationPath); active.push_back('/');
+	active += state ? "set" : "unset";
+	animationView->setActive(active);
 	animationView->frame = 0.0f;
 	animationView->isPlaying = true;
 }
@@ -38,9 +38,8 @@ static void setUiInputAnimation(ID<Entity> element, string_view animationPath, u
 	auto animationView = manager->tryGet<AnimationComponent>(element);
 	if (animationView)
 	{
-		animationView->active = animationPath;
-		animationView->active.push_back('/');
-		animationView->active += state;
+		auto active = string(animationPath); active.push_back('/'); active += state;
+		animationView->setActive(active);
 
 		animationView->frame = 0.0f;
 		animationView->isPlaying = true;
@@ -52,9 +51,9 @@ static void setUiInputAnimation(ID<Entity> element, string_view animationPath, u
 		animationView = manager->tryGet<AnimationComponent>(label);
 		if (animationView)
 		{
-			animationView->active = animationPath;
-			animationView->active.push_back('/');
-			animationView->active += text.empty() ? "text" : "placeholder";
+			auto active = string(animationPath); active.push_back('/');
+			active += text.empty() ? "text" : "placeholder";
+			animationView->setActive(active);
 			animationView->frame = 0.0f;
 			animationView->isPlaying = true;
 		}
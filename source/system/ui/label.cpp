@@ -269,10 +269,10 @@ bool UiLabelSystem::isDrawReady(int8 shadowPass)
 	return GraphicsSystem::Instance::get()->get(pipeline)->isReady();
 }
 uint32 UiLabelSystem::getReadyMeshesAsync(MeshRenderComponent* meshRenderView, 
-	const f32x4& cameraPosition, const Frustum& frustum, f32x4x4& model)
+	const f32x4& cameraPosition, f32x4x4& model)
 {
 	auto uiLabelView = (UiLabelComponent*)meshRenderView;
-	if (!uiLabelView->textData || isBehindFrustum(frustum, uiLabelView->aabb, model))
+	if (!uiLabelView->textData)
 		return 0;
 	auto textView = textSystem->get(uiLabelView->textData);
 	return (textView->isReady() && textView->getInstanceCount() > 0) ? 1 : 0;
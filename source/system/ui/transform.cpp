@@ -179,4 +179,33 @@ void UiTransformSystem::animateAsync(View<Component> component, View<AnimationFr
 		componentiew->rotation = slerp(frameA->rotation, frameB->rotation, t);
 	if (frameA->animateAnchor)
 		componentiew->anchor = (bool)round(t) ? frameB->anchor : frameA->anchor;
+}
+
+uint8 UiTransformSystem::getBakedProps(AnimationInterp* interps)
+{
+	interps[0] = AnimationInterp::Lerp; interps[1] = AnimationInterp::Lerp;
+	interps[2] = AnimationInterp::Slerp; interps[3] = AnimationInterp::Step;
+	return 4;
+}
+uint32 UiTransformSystem::bakeAnimation(View<AnimationFrame> frame, f32x4* values)
+{
+	const auto frameView = View<UiTransformFrame>(frame);
+	values[0] = frameView->position;
+	values[1] = frameView->scale;
+	values[2] = (f32x4)frameView->rotation;
+	values[3] = f32x4((float)(uint32)frameView->anchor);
+	return (uint32)frameView->animatePosition | (uint32)frameView->animateScale << 1u | 
+		(uint32)frameView->animateRotation << 2u | (uint32)frameView->animateAnchor << 3u;
+}
+void UiTransformSystem::animateBaked(View<Component> component, const f32x4* values, uint32 mask)
+{
+	auto componentView = View<UiTransformComponent>(component);
+	if (mask & 0x1u)
+		componentView->position = values[0];
+	if (mask & 0x2u)
+		componentView->scale = values[1];
+	if (mask & 0x4u)
+		componentView->rotation = quat(values[2]);
+	if (mask & 0x8u)
+		componentView->anchor = (UiAnchor)(uint32)values[3].getX();
 }
\ No newline at end of file
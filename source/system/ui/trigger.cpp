@@ -18,6 +18,7 @@
 #include "garden/system/thread.hpp"
 #include "garden/system/input.hpp"
 #include "garden/profiler.hpp"
+#include <algorithm>
 
 using namespace garden;
 
@@ -31,130 +32,309 @@ UiTriggerSystem::UiTriggerSystem(bool setSingleton) : Singleton(setSingleton)
 	ECSM_SUBSCRIBE_TO_EVENT("Update", UiTriggerSystem::update);
 }
 
-static void triggerUiComponent(Manager* manager, ID<Entity>& newElement, 
-	float& newPosZ, UiTriggerComponent& uiTriggerComp, float2 cursorPosition)
+static uint64 toCellKey(int32 x, int32 y) noexcept
+{
+	return ((uint64)(uint32)x << 32u) | (uint64)(uint32)y;
+}
+
+//**********************************************************************************************************************
+bool UiTriggerSystem::updateItem(Manager* manager, const UiTriggerComponent& uiTriggerComp, Item& item)
 {
 	auto entity = uiTriggerComp.getEntity();
+	f32x4x4 model; uint32 modelStamp = 0;
+
+	if (entity)
+	{
+		auto transformView = manager->tryGet<TransformComponent>(entity);
+		if (!transformView || !transformView->isActive())
+		{
+			entity = {};
+		}
+		else
+		{
+			// Note: Clean model with the same stamp means that trigger entity and its ancestors have not moved.
+			if (!transformView->isModelDirty())
+				modelStamp = transformView->getModelStamp();
+			if (modelStamp != 0 && item.modelStamp == modelStamp && item.entity == entity && 
+				item.offset == uiTriggerComp.offset && item.scale == uiTriggerComp.scale)
+			{
+				return false;
+			}
+			model = transformView->calcModel();
+		}
+	}
 	if (!entity)
-		return;
+	{
+		if (!item.entity)
+			return false;
+		item.entity = {};
+		return true;
+	}
 
-	auto transformView = manager->tryGet<TransformComponent>(entity);
-	if (!transformView || !transformView->isActive())
-		return;
+	if (item.entity == entity && item.offset == uiTriggerComp.offset && item.scale == uiTriggerComp.scale &&
+		memcmp(&item.model, &model, sizeof(f32x4x4)) == 0)
+	{
+		item.modelStamp = modelStamp;
+		return false;
+	}
 
-	auto model = transformView->calcModel(); auto modelPosZ = getTranslation(model).getZ();
-	auto invModel = inverse4x4(model * scale(translate(
-		f32x4(uiTriggerComp.offset.x, uiTriggerComp.offset.y, 1.0f)), 
-		f32x4(uiTriggerComp.scale.x, uiTriggerComp.scale.y, 1.0f)));
-	auto modelCursorPos = float2(invModel * f32x4(cursorPosition.x, cursorPosition.y, 0.0f, 1.0f));
+	auto triggerModel = model * scale(translate(f32x4(uiTriggerComp.offset.x, uiTriggerComp.offset.y, 1.0f)), 
+		f32x4(uiTriggerComp.scale.x, uiTriggerComp.scale.y, 1.0f));
+	item.model = model;
+	item.invModel = inverse4x4(triggerModel);
+	item.offset = uiTriggerComp.offset;
+	item.scale = uiTriggerComp.scale;
+	item.entity = entity;
+	item.modelStamp = modelStamp;
+	item.posZ = getTranslation(model).getZ();
 
-	if (abs(modelCursorPos.x) > 0.5f || abs(modelCursorPos.y) > 0.5f || modelPosZ >= newPosZ)
-		return;
-	newElement = entity; newPosZ = modelPosZ;
+	auto corner = triggerModel * f32x4(-0.5f, -0.5f, 0.0f, 1.0f);
+	auto boundsMin = float2(corner.getX(), corner.getY()), boundsMax = boundsMin;
+	const float2 corners[3] = { float2(0.5f, -0.5f), float2(-0.5f, 0.5f), float2(0.5f, 0.5f) };
+	for (uint8 i = 0; i < 3; i++)
+	{
+		corner = triggerModel * f32x4(corners[i].x, corners[i].y, 0.0f, 1.0f);
+		boundsMin.x = std::min(boundsMin.x, corner.getX()); boundsMin.y = std::min(boundsMin.y, corner.getY());
+		boundsMax.x = std::max(boundsMax.x, corner.getX()); boundsMax.y = std::max(boundsMax.y, corner.getY());
+	}
+	item.boundsMin = boundsMin; item.boundsMax = boundsMax;
+	return true;
+}
+bool UiTriggerSystem::isInside(const Item& item, float2 point) noexcept
+{
+	if (point.x < item.boundsMin.x || point.y < item.boundsMin.y || 
+		point.x > item.boundsMax.x || point.y > item.boundsMax.y)
+	{
+		return false;
+	}
+
+	auto modelPoint = float2(item.invModel * f32x4(point.x, point.y, 0.0f, 1.0f));
+	return abs(modelPoint.x) <= 0.5f && abs(modelPoint.y) <= 0.5f;
 }
 
 //**********************************************************************************************************************
-void UiTriggerSystem::update()
+void UiTriggerSystem::addGridItem(uint32 index)
 {
-	SET_CPU_ZONE_SCOPED("UI Trigger Update");
+	auto& item = items[index];
+	GARDEN_ASSERT(!item.isInGrid);
+	item.cellMin = int2((int32)floor(item.boundsMin.x / gridCellSize), (int32)floor(item.boundsMin.y / gridCellSize));
+	item.cellMax = int2((int32)floor(item.boundsMax.x / gridCellSize), (int32)floor(item.boundsMax.y / gridCellSize));
+	item.isInGrid = true;
 
-	if (components.getCount() == 0)
+	auto cellCount = (uint64)(item.cellMax.x - item.cellMin.x + 1) * (uint64)(item.cellMax.y - item.cellMin.y + 1);
+	if (cellCount > maxItemCells)
+	{
+		oversizedItems.push_back(index);
+		item.isOversized = true;
 		return;
+	}
 
-	auto inputSystem = InputSystem::Instance::get();
-	if (inputSystem->cursorCapturers > 0 || inputSystem->getCursorMode() != CursorMode::Normal)
+	item.isOversized = false;
+	for (auto y = item.cellMin.y; y <= item.cellMax.y; y++)
 	{
-		if (currElement)
+		for (auto x = item.cellMin.x; x <= item.cellMax.x; x++)
+			gridCells[toCellKey(x, y)].push_back(index);
+	}
+}
+static void removeCellIndex(vector<uint32>& indices, uint32 index) noexcept
+{
+	auto result = find(indices.begin(), indices.end(), index);
+	GARDEN_ASSERT_MSG(result != indices.end(), "Detected memory corruption");
+	*result = indices.back(); indices.pop_back();
+}
+void UiTriggerSystem::removeGridItem(uint32 index)
+{
+	auto& item = items[index];
+	GARDEN_ASSERT(item.isInGrid);
+	item.isInGrid = false;
+
+	if (item.isOversized)
+	{
+		removeCellIndex(oversizedItems, index);
+		return;
+	}
+
+	for (auto y = item.cellMin.y; y <= item.cellMax.y; y++)
+	{
+		for (auto x = item.cellMin.x; x <= item.cellMax.x; x++)
 		{
-			auto uiTriggerView = Manager::Instance::get()->tryGet<UiTriggerComponent>(currElement);
-			if (uiTriggerView && !uiTriggerView->onExit.empty())
-				Manager::Instance::get()->tryRunEvent(uiTriggerView->onExit);
-			currElement = {};
+			auto searchResult = gridCells.find(toCellKey(x, y));
+			GARDEN_ASSERT_MSG(searchResult != gridCells.end(), "Detected memory corruption");
+			auto& indices = searchResult.value();
+			removeCellIndex(indices, index);
+			if (indices.empty())
+				gridCells.erase(searchResult);
 		}
-		return;
 	}
+}
+
+//**********************************************************************************************************************
+void UiTriggerSystem::updateGrid()
+{
+	SET_CPU_ZONE_SCOPED("UI Trigger Grid Update");
+
+	auto componentOccupancy = components.getOccupancy();
+	for (auto i = componentOccupancy; i < (uint32)items.size(); i++)
+	{
+		if (items[i].isInGrid)
+			removeGridItem(i);
+	}
+	items.resize(componentOccupancy);
 
 	auto componentData = components.getData();
+	auto itemData = items.data();
 	auto threadSystem = ThreadSystem::Instance::tryGet();
-	auto cursorPosition = UiTransformSystem::Instance::get()->getCursorPosition();
-	ID<Entity> newElement = {}; float newPosZ = FLT_MAX;
 
+	// Note: Only triggers with changed transform, offset or scale are moved inside the grid.
 	if (threadSystem && components.getCount() > threadSystem->getForegroundPool().getThreadCount())
 	{
 		auto& threadPool = threadSystem->getForegroundPool();
-		newElements.assign(threadPool.getThreadCount(), make_pair(ID<Entity>(), FLT_MAX));
-		auto newElementData = newElements.data();
+		threadChangedItems.resize(threadPool.getThreadCount());
+		auto threadChangedData = threadChangedItems.data();
 
-		threadPool.addItems([componentData, newElementData, cursorPosition](const ThreadPool::Task& task)
+		threadPool.addItems([componentData, itemData, threadChangedData](const ThreadPool::Task& task)
 		{
-			SET_CPU_ZONE_SCOPED("UI Trigger Update");
+			SET_CPU_ZONE_SCOPED("UI Trigger Grid Update");
 
 			auto itemCount = task.getItemCount();
 			auto manager = Manager::Instance::get();
-			auto& threadElement = newElementData[task.getThreadIndex()];
-			auto& newElement = threadElement.first; auto& newPosZ = threadElement.second;
+			auto& changedItems = threadChangedData[task.getThreadIndex()];
 
 			for (uint32 i = task.getItemOffset(); i < itemCount; i++)
-				triggerUiComponent(manager, newElement, newPosZ, componentData[i], cursorPosition);
+			{
+				if (updateItem(manager, componentData[i], itemData[i]))
+					changedItems.push_back(i);
+			}
 		},
-		components.getOccupancy());
+		componentOccupancy);
 		threadPool.wait();
 
-		auto firstElement = newElements.begin();
-		newElement = firstElement->first; newPosZ = firstElement->second;
-
-		for (auto i = newElements.begin() + 1; i != newElements.end(); i++)
+		for (auto& changedItems : threadChangedItems)
 		{
-			if (i->second >= newPosZ)
-				continue;
-			newElement = i->first; newPosZ = i->second;
+			for (auto index : changedItems)
+			{
+				if (itemData[index].isInGrid)
+					removeGridItem(index);
+				if (itemData[index].entity)
+					addGridItem(index);
+			}
+			changedItems.clear();
 		}
 	}
 	else
 	{
-		auto componentOccupancy = components.getOccupancy();
 		auto manager = Manager::Instance::get();
-
 		for (uint32 i = 0; i < componentOccupancy; i++)
-			triggerUiComponent(manager, newElement, newPosZ, componentData[i], cursorPosition);
+		{
+			if (!updateItem(manager, componentData[i], itemData[i]))
+				continue;
+			if (itemData[i].isInGrid)
+				removeGridItem(i);
+			if (itemData[i].entity)
+				addGridItem(i);
+		}
 	}
+}
 
-	if (newElement)
+//**********************************************************************************************************************
+ID<Entity> UiTriggerSystem::findElement(float2 point) const
+{
+	ID<Entity> element = {}; auto elementPosZ = FLT_MAX;
+	auto itemData = items.data();
+
+	auto searchResult = gridCells.find(toCellKey(
+		(int32)floor(point.x / gridCellSize), (int32)floor(point.y / gridCellSize)));
+	if (searchResult != gridCells.end())
 	{
-		auto manager = Manager::Instance::get();
-		if (newElement == currElement)
+		for (auto index : searchResult->second)
 		{
-			auto uiTriggerView = manager->tryGet<UiTriggerComponent>(currElement);
-			if (uiTriggerView && !uiTriggerView->onStay.empty())
-				manager->tryRunEvent(uiTriggerView->onStay);
+			const auto& item = itemData[index];
+			if (item.posZ >= elementPosZ || !isInside(item, point))
+				continue;
+			element = item.entity; elementPosZ = item.posZ;
 		}
-		else
-		{
-			auto manager = Manager::Instance::get();
-			if (currElement)
-			{
-				auto uiTriggerView = manager->tryGet<UiTriggerComponent>(currElement);
-				if (uiTriggerView && !uiTriggerView->onExit.empty())
-					manager->tryRunEvent(uiTriggerView->onExit);
-			}
-			currElement = newElement;
+	}
+	for (auto index : oversizedItems)
+	{
+		const auto& item = itemData[index];
+		if (item.posZ >= elementPosZ || !isInside(item, point))
+			continue;
+		element = item.entity; elementPosZ = item.posZ;
+	}
+	return element;
+}
+void UiTriggerSystem::findElements(const float2* points, uint32 pointCount, ID<Entity>* elements) const
+{
+	GARDEN_ASSERT(points || pointCount == 0);
+	GARDEN_ASSERT(elements || pointCount == 0);
 
-			auto uiTriggerView = manager->get<UiTriggerComponent>(currElement);
-			if (!uiTriggerView->onEnter.empty())
-				manager->tryRunEvent(uiTriggerView->onEnter);
-		}
+	for (uint32 i = 0; i < pointCount; i++)
+		elements[i] = findElement(points[i]);
+}
+
+//**********************************************************************************************************************
+static void updateHovered(Manager* manager, ID<Entity>& currElement, ID<Entity> newElement)
+{
+	if (newElement == currElement)
+	{
+		if (!currElement)
+			return;
+
+		auto uiTriggerView = manager->tryGet<UiTriggerComponent>(currElement);
+		if (uiTriggerView && !uiTriggerView->onStay.empty())
+			manager->tryRunEvent(uiTriggerView->onStay);
+		return;
+	}
+
+	if (currElement)
+	{
+		auto uiTriggerView = manager->tryGet<UiTriggerComponent>(currElement);
+		if (uiTriggerView && !uiTriggerView->onExit.empty())
+			manager->tryRunEvent(uiTriggerView->onExit);
+	}
+	currElement = newElement;
+
+	if (currElement)
+	{
+		auto uiTriggerView = manager->get<UiTriggerComponent>(currElement);
+		if (!uiTriggerView->onEnter.empty())
+			manager->tryRunEvent(uiTriggerView->onEnter);
+	}
+}
+
+void UiTriggerSystem::update()
+{
+	SET_CPU_ZONE_SCOPED("UI Trigger Update");
+
+	auto manager = Manager::Instance::get();
+	auto cursorCount = (uint32)virtualCursors.size() + 1;
+	for (auto i = cursorCount; i < (uint32)hoveredElements.size(); i++)
+		updateHovered(manager, hoveredElements[i], {});
+	hoveredElements.resize(cursorCount);
+
+	if (components.getCount() == 0)
+	{
+		for (auto& hoveredElement : hoveredElements)
+			updateHovered(manager, hoveredElement, {});
+		items.clear(); gridCells.clear(); oversizedItems.clear();
+		return;
+	}
+
+	updateGrid();
+
+	auto inputSystem = InputSystem::Instance::get();
+	if (inputSystem->cursorCapturers > 0 || inputSystem->getCursorMode() != CursorMode::Normal)
+	{
+		updateHovered(manager, hoveredElements[0], {});
 	}
 	else
 	{
-		if (currElement)
-		{
-			auto manager = Manager::Instance::get();
-			auto uiTriggerView = manager->tryGet<UiTriggerComponent>(currElement);
-			if (uiTriggerView && !uiTriggerView->onExit.empty())
-				manager->tryRunEvent(uiTriggerView->onExit);
-			currElement = {};
-		}
+		auto cursorPosition = UiTransformSystem::Instance::get()->getCursorPosition();
+		updateHovered(manager, hoveredElements[0], findElement(cursorPosition));
 	}
+
+	for (uint32 i = 1; i < cursorCount; i++)
+		updateHovered(manager, hoveredElements[i], findElement(virtualCursors[i - 1]));
 }
 
 //**********************************************************************************************************************
@@ -162,11 +342,13 @@ void UiTriggerSystem::destroyComponent(ID<Component> instance)
 {
 	auto uiTrigger = ID<UiTriggerComponent>(instance);
 	auto uiTriggerView = components.get(uiTrigger);
-	if (currElement == uiTriggerView->getEntity())
+	for (auto& hoveredElement : hoveredElements)
 	{
+		if (hoveredElement != uiTriggerView->getEntity())
+			continue;
 		if (!uiTriggerView->onExit.empty())
 			Manager::Instance::get()->tryRunEvent(uiTriggerView->onExit);
-		currElement = {};
+		hoveredElement = {};
 	}
 	resetComponent(View<Component>(uiTriggerView), false);
 	components.destroy(uiTrigger);
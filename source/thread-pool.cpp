@@ -16,7 +16,6 @@
 #include "garden/profiler.hpp"
 
 #include "mpmt/thread.hpp"
-#include <cmath>
 
 #if GARDEN_OS_LINUX || GARDEN_OS_APPLE
 #include <signal.h>
@@ -24,8 +23,125 @@
 
 using namespace garden;
 
-// TODO: maybe add queue for each thread to reduce sync count.
-// This is useful if we have a lot of tasks.
+static thread_local const ThreadPool* currentPool = nullptr;
+static thread_local uint32 currentThreadIndex = 0;
+
+static uint8 toPriorityLane(float priority) noexcept
+{
+	if (priority >= ThreadPool::priorityCritical)
+		return 0;
+	if (priority >= ThreadPool::priorityHigh)
+		return 1;
+	if (priority >= ThreadPool::priorityNormal)
+		return 2;
+	return 3;
+}
+
+//**********************************************************************************************************************
+template<typename T, uint32 Capacity>
+ThreadPool::BoundedQueue<T, Capacity>::BoundedQueue()
+{
+	static_assert((Capacity & (Capacity - 1)) == 0, "Queue capacity should be power of 2");
+	cells = new Cell[Capacity];
+	for (uint32 i = 0; i < Capacity; i++)
+		cells[i].sequence.store(i, memory_order_relaxed);
+}
+template<typename T, uint32 Capacity>
+ThreadPool::BoundedQueue<T, Capacity>::~BoundedQueue()
+{
+	delete[] cells;
+}
+
+template<typename T, uint32 Capacity>
+bool ThreadPool::BoundedQueue<T, Capacity>::tryPush(const T& value) noexcept
+{
+	Cell* cell; auto position = enqueuePos.load(memory_order_relaxed);
+	while (true)
+	{
+		cell = &cells[position & (Capacity - 1)];
+		auto sequence = cell->sequence.load(memory_order_acquire);
+		auto difference = (int32)(sequence - position);
+
+		if (difference == 0)
+		{
+			if (enqueuePos.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+				break;
+		}
+		else if (difference < 0)
+		{
+			return false; // Note: Queue is full.
+		}
+		else
+		{
+			position = enqueuePos.load(memory_order_relaxed);
+		}
+	}
+
+	cell->value = value;
+	cell->sequence.store(position + 1, memory_order_release);
+	return true;
+}
+template<typename T, uint32 Capacity>
+bool ThreadPool::BoundedQueue<T, Capacity>::tryPop(T& value) noexcept
+{
+	Cell* cell; auto position = dequeuePos.load(memory_order_relaxed);
+	while (true)
+	{
+		cell = &cells[position & (Capacity - 1)];
+		auto sequence = cell->sequence.load(memory_order_acquire);
+		auto difference = (int32)(sequence - (position + 1));
+
+		if (difference == 0)
+		{
+			if (dequeuePos.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+				break;
+		}
+		else if (difference < 0)
+		{
+			return false; // Note: Queue is empty.
+		}
+		else
+		{
+			position = dequeuePos.load(memory_order_relaxed);
+		}
+	}
+
+	value = cell->value;
+	cell->sequence.store(position + Capacity, memory_order_release);
+	return true;
+}
+
+//**********************************************************************************************************************
+ThreadPool::BlockPool ThreadPool::blockPool = {};
+
+ThreadPool::BlockPool::~BlockPool()
+{
+	JobBlock* block;
+	while (blocks.tryPop(block))
+		delete block;
+}
+
+ThreadPool::JobBlock* ThreadPool::allocateBlock()
+{
+	JobBlock* block;
+	if (blockPool.blocks.tryPop(block))
+		return block;
+	return new JobBlock();
+}
+void ThreadPool::releaseBlock(JobBlock* block) noexcept
+{
+	// Note: Destroying function captures now, they can own resources.
+	block->function = {};
+	block->threadPool = nullptr;
+	block->continuations.clear();
+	block->priority = 0.0f;
+	block->taskCount = block->countPerTask = block->itemCount = block->grainSize = 0;
+	block->isDone.store(false, memory_order_relaxed);
+	block->nextItemOffset.store(0, memory_order_relaxed);
+
+	if (!blockPool.blocks.tryPush(block))
+		delete block;
+}
 
 //**********************************************************************************************************************
 void ThreadPool::threadFunction(uint32 threadIndex)
@@ -42,43 +158,238 @@ void ThreadPool::threadFunction(uint32 threadIndex)
 	signal(SIGPIPE, SIG_IGN);
 	#endif
 
-	while (isRunning)
+	currentPool = this;
+	currentThreadIndex = threadIndex;
+
+	while (true)
 	{
+		Task task;
+		if (tryPopTask(threadIndex, task))
+		{
+			#if GARDEN_USE_TRACY_PROFILER
+			TracyFiberEnterHint(threadName.c_str(), threadIndex);
+			#endif
+
+			executeTask(task, threadIndex);
+
+			#if GARDEN_USE_TRACY_PROFILER
+			TracyFiberLeave;
+			#endif
+			continue;
+		}
+
 		unique_lock locker(mutex);
+		sleepingCount.fetch_add(1);
 		workCond.wait(locker, [this]()
 		{
-			return !taskQueue.empty() || !isRunning;
+			return hasPendingTasks() || !isRunning;
 		});
+		sleepingCount.fetch_sub(1);
 
 		if (!isRunning)
 			return;
+	}
+}
+void ThreadPool::executeTask(Task& task, uint32 threadIndex)
+{
+	auto block = task.block;
+	task.threadIndex = threadIndex;
 
-		#if GARDEN_USE_TRACY_PROFILER
-		TracyFiberEnterHint(threadName.c_str(), threadIndex);
-		#endif
+	if (block->grainSize == 0)
+	{
+		block->function(task);
+	}
+	else
+	{
+		// Note: Claiming decreasing item chunks until all items are processed. (Guided scheduling)
+		auto itemCount = block->itemCount, grainSize = block->grainSize, chunkDivisor = block->taskCount * 2;
+		auto itemOffset = block->nextItemOffset.load(memory_order_relaxed);
+
+		while (itemOffset < itemCount)
+		{
+			auto remainingCount = itemCount - itemOffset;
+			auto chunkSize = std::min(std::max(remainingCount / chunkDivisor, grainSize), remainingCount);
+			if (!block->nextItemOffset.compare_exchange_weak(itemOffset, 
+				itemOffset + chunkSize, memory_order_relaxed))
+			{
+				continue;
+			}
+
+			task.itemOffset = itemOffset;
+			task.itemCount = itemOffset + chunkSize;
+			block->function(task);
+			itemOffset = block->nextItemOffset.load(memory_order_relaxed);
+		}
+	}
+
+	finishTask(block);
+}
+void ThreadPool::finishTask(JobBlock* block)
+{
+	if (block->remainingCount.fetch_sub(1) == 1)
+		completeJob(block);
+	if (block->refCount.fetch_sub(1) == 1)
+		releaseBlock(block);
+
+	if (unfinishedCount.fetch_sub(1) == 1)
+	{
+		waitMutex.lock(); // Note: Prevents lost wake up of the waiting thread.
+		waitMutex.unlock();
+		waitCond.notify_all();
+	}
+}
+
+//**********************************************************************************************************************
+ThreadPool::Job ThreadPool::submitJob(JobBlock* block, const Job* dependencies, uint32 dependencyCount)
+{
+	block->threadPool = this;
+	block->refCount.store(block->taskCount, memory_order_relaxed);
+	block->remainingCount.store(block->taskCount, memory_order_relaxed);
+	block->dependencyCount.store(dependencyCount + 1, memory_order_relaxed);
+	unfinishedCount.fetch_add(block->taskCount);
+	auto job = Job(block);
+
+	for (uint32 i = 0; i < dependencyCount; i++)
+	{
+		auto dependency = dependencies[i].block;
+		if (dependency)
+		{
+			dependency->mutex.lock();
+			if (!dependency->isDone.load())
+			{
+				block->refCount.fetch_add(1); // Note: Keeping continuation alive until it's queued.
+				dependency->continuations.push_back(block);
+				dependency->mutex.unlock();
+				continue;
+			}
+			dependency->mutex.unlock();
+		}
+		block->dependencyCount.fetch_sub(1);
+	}
 
-		executeTask(threadIndex);
+	if (block->dependencyCount.fetch_sub(1) == 1)
+		pushTasks(block);
+	return job;
+}
+void ThreadPool::completeJob(JobBlock* block)
+{
+	block->mutex.lock();
+	block->isDone.store(true);
+	auto continuations = std::move(block->continuations);
+	block->mutex.unlock();
 
-		#if GARDEN_USE_TRACY_PROFILER
-		TracyFiberLeave;
-		#endif
+	for (auto continuation : continuations)
+	{
+		if (continuation->dependencyCount.fetch_sub(1) == 1)
+			continuation->threadPool->pushTasks(continuation);
+		if (continuation->refCount.fetch_sub(1) == 1)
+			releaseBlock(continuation);
+	}
 
-		workingCond.notify_all();
+	auto threadPool = block->threadPool;
+	if (threadPool->jobWaitingCount.load() > 0)
+	{
+		threadPool->waitMutex.lock();
+		threadPool->waitMutex.unlock();
+		threadPool->waitCond.notify_all();
 	}
 }
-void ThreadPool::executeTask(uint32 threadIndex)
+
+//**********************************************************************************************************************
+void ThreadPool::pushTasks(JobBlock* block)
 {
-	workingCount++;
-	auto iterator = taskQueue.begin();
-	auto task = iterator->second;
-	taskQueue.erase(iterator);
+	auto count = block->taskCount;
+	if (count == 0)
+	{
+		completeJob(block);
+		return;
+	}
+
+	auto lane = toPriorityLane(block->priority);
+	laneCounts[lane].fetch_add(count);
+
+	// Note: Spreading tasks across thread queues, so that each thread starts with its own work.
+	auto queueIndex = currentPool == this ? currentThreadIndex : nextQueueIndex.fetch_add(count);
+	auto countPerTask = block->countPerTask, itemCount = block->itemCount;
+	auto task = Task(block);
+
+	for (uint32 i = 0; i < count; i++)
+	{
+		task.taskIndex = i;
+		if (countPerTask > 0)
+		{
+			task.itemOffset = countPerTask * i;
+			task.itemCount = std::min(itemCount, task.itemOffset + countPerTask);
+		}
 
+		auto& queue = threadQueues[(queueIndex + i) % threadCount].lanes[lane];
+		if (!queue.tryPush(task))
+		{
+			overflowMutex.lock();
+			overflowQueues[lane].push_back(task);
+			overflowCount.fetch_add(1);
+			overflowMutex.unlock();
+		}
+	}
+
+	if (sleepingCount.load() == 0)
+		return;
+
+	mutex.lock(); // Note: Prevents lost wake up of the sleeping thread.
 	mutex.unlock();
-	task.threadIndex = threadIndex;
-	task.function(task);
-	mutex.lock();
 
-	workingCount--;
+	if (count > 1)
+		workCond.notify_all();
+	else workCond.notify_one();
+}
+bool ThreadPool::tryPopTask(uint32 threadIndex, Task& task)
+{
+	for (uint8 lane = 0; lane < laneCount; lane++)
+	{
+		if (laneCounts[lane].load(memory_order_relaxed) == 0)
+			continue;
+
+		// Note: Checking own queue first, then stealing from other thread queues.
+		for (uint32 i = 0; i < threadCount; i++)
+		{
+			auto& queue = threadQueues[(threadIndex + i) % threadCount].lanes[lane];
+			if (queue.tryPop(task))
+			{
+				laneCounts[lane].fetch_sub(1);
+				return true;
+			}
+		}
+
+		if (overflowCount.load(memory_order_relaxed) == 0)
+			continue;
+
+		overflowMutex.lock();
+		auto& overflowQueue = overflowQueues[lane];
+		auto hasTask = !overflowQueue.empty();
+		if (hasTask)
+		{
+			task = overflowQueue.front();
+			overflowQueue.pop_front();
+			overflowCount.fetch_sub(1);
+		}
+		overflowMutex.unlock();
+
+		if (hasTask)
+		{
+			laneCounts[lane].fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+bool ThreadPool::hasPendingTasks() const noexcept
+{
+	for (uint8 lane = 0; lane < laneCount; lane++)
+	{
+		if (laneCounts[lane].load() > 0)
+			return true;
+	}
+	return false;
 }
 
 //**********************************************************************************************************************
@@ -91,6 +402,10 @@ ThreadPool::ThreadPool(bool isBackground, string_view name, uint32 threadCount)
 		threadCount = thread::hardware_concurrency();
 	this->threadCount = threadCount;
 
+	for (uint8 i = 0; i < laneCount; i++)
+		laneCounts[i].store(0);
+	threadQueues = new ThreadQueues[threadCount];
+
 	auto offset = isBackground ? 0 : 1;
 	threadCount -= offset; // Note: foreground pool also uses main thread.
 	threads.resize(threadCount);
@@ -102,101 +417,102 @@ ThreadPool::ThreadPool(bool isBackground, string_view name, uint32 threadCount)
 ThreadPool::~ThreadPool()
 {
 	stop();
+	removeAll();
+	delete[] threadQueues;
 }
 
 uint32 ThreadPool::getPendingTaskCount()
 {
-	mutex.lock();
-	auto count = (uint32)taskQueue.size();
-	mutex.unlock();
+	uint32 count = 0;
+	for (uint8 lane = 0; lane < laneCount; lane++)
+		count += laneCounts[lane].load(memory_order_relaxed);
 	return count;
 }
 uint32 ThreadPool::getWorkingTaskCount()
 {
-	mutex.lock();
-	auto count = workingCount;
-	mutex.unlock();
-	return count;
+	auto pendingCount = getPendingTaskCount();
+	auto count = unfinishedCount.load(memory_order_relaxed);
+	return count > pendingCount ? count - pendingCount : 0;
 }
 
 //**********************************************************************************************************************
-void ThreadPool::addTask(const Task::Function& function, float priority)
+ThreadPool::Job ThreadPool::addTask(Task::Function function, float priority, const Job& dependency)
 {
 	GARDEN_ASSERT(function);
 	GARDEN_ASSERT(isRunning);
-	auto task = Task(function, priority);
-	mutex.lock();
-	taskQueue.emplace(priority, task);
-	mutex.unlock();
-	workCond.notify_one();
+
+	auto block = allocateBlock();
+	block->function = std::move(function);
+	block->priority = priority;
+	block->taskCount = 1;
+	return submitJob(block, &dependency, 1);
 }
-void ThreadPool::addTasks(const vector<Task::Function>& functions, float priority)
+ThreadPool::Job ThreadPool::addTasks(vector<Task::Function> functions, float priority, const Job& dependency)
 {
 	GARDEN_ASSERT(!functions.empty());
 	GARDEN_ASSERT(isRunning);
 
-	mutex.lock();
-	auto functionCount = (uint32)functions.size();
-	auto functionData = functions.data();
-	for (uint32 i = 0; i < functionCount; i++)
-	{
-		auto task = Task(functionData[i], priority);
-		task.taskIndex = i;
-		GARDEN_ASSERT(task.function);
-		taskQueue.emplace(priority, task);
-	}
-	mutex.unlock();
+	#if GARDEN_DEBUG
+	for (const auto& function : functions)
+		GARDEN_ASSERT(function);
+	#endif
 
-	if (functionCount > 1)
-		workCond.notify_all();
-	else workCond.notify_one();
+	auto block = allocateBlock();
+	block->taskCount = (uint32)functions.size();
+	block->function = [functions = std::move(functions)](const Task& task)
+	{
+		functions[task.getTaskIndex()](task);
+	};
+	block->priority = priority;
+	return submitJob(block, &dependency, 1);
 }
-void ThreadPool::addTasks(const Task::Function& function, uint32 count, float priority)
+ThreadPool::Job ThreadPool::addTasks(Task::Function function, uint32 count, float priority, const Job& dependency)
 {
 	GARDEN_ASSERT(function);
 	GARDEN_ASSERT(count != 0);
 	GARDEN_ASSERT(isRunning);
-	auto task = Task(function, priority);
 
-	mutex.lock();
-	for (uint32 i = 0; i < count; i++)
-	{
-		task.taskIndex = i;
-		taskQueue.emplace(priority, task); 
-	}
-	mutex.unlock();
-
-	if (count > 1)
-		workCond.notify_all();
-	else workCond.notify_one();
+	auto block = allocateBlock();
+	block->function = std::move(function);
+	block->priority = priority;
+	block->taskCount = count;
+	return submitJob(block, &dependency, 1);
 }
-void ThreadPool::addItems(const Task::Function& function, uint32 count, float priority)
+ThreadPool::Job ThreadPool::addItems(Task::Function function, 
+	uint32 count, float priority, const Job& dependency, uint32 grainSize)
 {
 	GARDEN_ASSERT(function);
 	GARDEN_ASSERT(count != 0);
 	GARDEN_ASSERT(isRunning);
 
-	auto task = Task(function, priority);
-	auto taskCount = count > threads.size() ? (uint32)threads.size() : count;
-	auto countPerThread = (uint32)std::ceil((float)count / (float)taskCount);
-
-	mutex.lock();
-	for (uint32 i = 0; i < taskCount; i++)
+	if (grainSize > 0)
 	{
-		task.itemOffset = countPerThread * i;
-		task.itemCount = std::min(count, task.itemOffset + countPerThread);
-
-		if (task.itemOffset >= task.itemCount)
-			continue;
-
-		task.taskIndex = i;
-		taskQueue.emplace(priority, task); 
+		auto block = allocateBlock();
+		block->function = std::move(function);
+		block->priority = priority;
+		block->taskCount = std::min((count + grainSize - 1) / grainSize, threadCount);
+		block->itemCount = count;
+		block->grainSize = grainSize;
+		return submitJob(block, &dependency, 1);
 	}
-	mutex.unlock();
 
-	if (taskCount > 1)
-		workCond.notify_all();
-	else workCond.notify_one();
+	auto taskCount = count > threads.size() ? (uint32)threads.size() : count;
+	taskCount = std::max(taskCount, 1u);
+	auto countPerTask = (count + taskCount - 1) / taskCount;
+
+	auto block = allocateBlock();
+	block->function = std::move(function);
+	block->priority = priority;
+	block->taskCount = (count + countPerTask - 1) / countPerTask; // Note: Skipping empty tasks.
+	block->countPerTask = countPerTask;
+	block->itemCount = count;
+	return submitJob(block, &dependency, 1);
+}
+ThreadPool::Job ThreadPool::whenAll(const vector<Job>& jobs)
+{
+	GARDEN_ASSERT(isRunning);
+	auto block = allocateBlock();
+	return submitJob(block, jobs.data(), (uint32)jobs.size());
 }
 
 //**********************************************************************************************************************
@@ -205,25 +521,82 @@ void ThreadPool::wait()
 	GARDEN_ASSERT(isRunning);
 	SET_CPU_ZONE_SCOPED("Thread Pool Wait");
 
-	auto locker = unique_lock(mutex);
 	if (!background)
 	{
-		while(!taskQueue.empty())
-			executeTask(0);
-		while (workingCount > 0)
-			workingCond.wait(locker);
+		Task task;
+		while (tryPopTask(0, task))
+			executeTask(task, 0);
 	}
-	else
+
+	if (unfinishedCount.load() == 0)
+		return;
+
+	unique_lock locker(waitMutex);
+	waitCond.wait(locker, [this]()
 	{
-		while (!taskQueue.empty() || workingCount > 0)
-			workingCond.wait(locker);
+		return unfinishedCount.load() == 0;
+	});
+}
+void ThreadPool::wait(const Job& job)
+{
+	GARDEN_ASSERT(isRunning);
+	if (job.isDone())
+		return;
+
+	GARDEN_ASSERT_MSG(job.block->threadPool == this, "Job belongs to a different thread pool");
+	SET_CPU_ZONE_SCOPED("Thread Pool Job Wait");
+
+	if (!background)
+	{
+		Task task;
+		while (!job.isDone() && tryPopTask(0, task))
+			executeTask(task, 0);
 	}
+
+	if (job.isDone())
+		return;
+
+	jobWaitingCount.fetch_add(1);
+	unique_lock locker(waitMutex);
+	waitCond.wait(locker, [&job]()
+	{
+		return job.isDone();
+	});
+	locker.unlock();
+	jobWaitingCount.fetch_sub(1);
 }
 void ThreadPool::removeAll()
 {
-	mutex.lock();
-	taskQueue.clear();
-	mutex.unlock();
+	uint32 removedCount; Task task;
+	do // Note: Dropping tasks of the dependent jobs too.
+	{
+		removedCount = 0;
+		for (uint8 lane = 0; lane < laneCount; lane++)
+		{
+			for (uint32 i = 0; i < threadCount; i++)
+			{
+				auto& queue = threadQueues[i].lanes[lane];
+				while (queue.tryPop(task))
+				{
+					laneCounts[lane].fetch_sub(1);
+					finishTask(task.block); removedCount++;
+				}
+			}
+
+			std::deque<Task> overflowQueue;
+			overflowMutex.lock();
+			std::swap(overflowQueue, overflowQueues[lane]);
+			overflowCount.fetch_sub((uint32)overflowQueue.size());
+			overflowMutex.unlock();
+
+			for (const auto& overflowTask : overflowQueue)
+			{
+				laneCounts[lane].fetch_sub(1);
+				finishTask(overflowTask.block); removedCount++;
+			}
+		}
+	}
+	while (removedCount > 0);
 }
 void ThreadPool::stop()
 {